@@ -539,7 +539,7 @@ static int spiflash_init_spi_flash_op_block_task(int cpu)
 
   /* Allocate a TCB for the new task. */
 
-  tcb = kmm_zalloc(sizeof(struct tcb_s));
+  tcb = nxsched_alloc_tcb(sizeof(struct tcb_s));
   if (!tcb)
     {
       serr("ERROR: Failed to allocate TCB\n");
@@ -558,7 +558,7 @@ static int spiflash_init_spi_flash_op_block_task(int cpu)
                     spi_flash_op_block_task, argv, environ, NULL);
   if (ret < OK)
     {
-      kmm_free(tcb);
+      nxsched_free_tcb(tcb);
       return ret;
     }
 
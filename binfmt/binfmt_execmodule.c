@@ -179,7 +179,7 @@ int exec_module(FAR struct binary_s *binp,
 
   /* Allocate a TCB for the new task. */
 
-  tcb = kmm_zalloc(sizeof(struct tcb_s));
+  tcb = nxsched_alloc_tcb(sizeof(struct tcb_s));
   if (!tcb)
     {
       return -ENOMEM;
@@ -381,7 +381,7 @@ errout_with_envp:
 errout_with_args:
   binfmt_freeargv(argv);
 errout_with_tcb:
-  kmm_free(tcb);
+  nxsched_free_tcb(tcb);
   return ret;
 }
 
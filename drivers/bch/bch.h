@@ -35,6 +35,7 @@
 
 #include <nuttx/mutex.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/pagecache.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -42,22 +43,59 @@
 
 #define MAX_OPENCNT       (255)                  /* Limit of uint8_t */
 
+/* The data of a line of the sector cache */
+
+#define BCH_LINE(bch, i)  (&(bch)->buffer[(size_t)(i) * (bch)->sectsize])
+
+/* Transfer sectors from or to the block driver, through the page cache if
+ * enabled.
+ */
+
+#ifdef CONFIG_BCH_PAGECACHE
+#  define bchlib_hwread(bch, buf, start, n) \
+     pagecache_read((bch)->inode, buf, start, n, (bch)->sectsize)
+#  define bchlib_hwwrite(bch, buf, start, n) \
+     pagecache_write((bch)->inode, buf, start, n, (bch)->sectsize)
+#else
+#  define bchlib_hwread(bch, buf, start, n) \
+     (bch)->inode->u.i_bops->read((bch)->inode, buf, start, n)
+#  define bchlib_hwwrite(bch, buf, start, n) \
+     (bch)->inode->u.i_bops->write((bch)->inode, buf, start, n)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+/* One line of the sector cache */
+
+struct bchlib_line_s
+{
+  size_t sector;           /* The sector in the line, (size_t)-1 if none */
+  uint32_t stamp;          /* Time of the last access, for LRU eviction */
+  bool dirty;              /* true: Data has been written to the line */
+};
+
 struct bchlib_s
 {
   FAR struct inode *inode; /* I-node of the block driver */
   uint32_t sectsize;       /* The size of one sector on the device */
   size_t nsectors;         /* Number of sectors supported by the device */
-  size_t sector;           /* The current sector in the buffer */
+  size_t seqnext;          /* The next sector of a sequential access */
+  uint32_t stamp;          /* Access counter of the sector cache */
   mutex_t lock;            /* For atomic accesses to this structure */
   uint8_t refs;            /* Number of references */
-  bool dirty;              /* true: Data has been written to the buffer */
+  uint8_t nlines;          /* Number of sectors in the cache */
+  uint8_t readahead;       /* Maximum number of sectors read ahead */
+  uint8_t seqcount;        /* Number of sequential accesses in a row */
+  uint8_t lastline;        /* The line of the last access */
   bool readonly;           /* true: Only read operations are supported */
   bool unlinked;           /* true: The driver has been unlinked */
-  FAR uint8_t *buffer;     /* One sector buffer */
+
+  /* The lines of the sector cache */
+
+  FAR struct bchlib_line_s *lines;
+  FAR uint8_t *buffer;     /* The data of the lines, nlines sectors */
 
 #if defined(CONFIG_BCH_ENCRYPTION)
   uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];  /* Encryption key */
@@ -84,7 +122,13 @@ EXTERN const struct file_operations g_bch_fops;
  ****************************************************************************/
 
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch, bool discard);
-EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector,
+                              bool read);
+EXTERN void bchlib_discardsectors(FAR struct bchlib_s *bch, size_t sector,
+                                  size_t nsectors);
+EXTERN void bchlib_readdirty(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                             size_t sector, size_t nsectors);
+EXTERN int  bchlib_setcache(FAR struct bchlib_s *bch, size_t nlines);
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -173,6 +173,9 @@ static int bch_close(FAR struct file *filep)
   /* Flush any dirty pages remaining in the cache */
 
   bchlib_flushsector(bch, false);
+#ifdef CONFIG_BCH_PAGECACHE
+  pagecache_flush(bch->inode);
+#endif
 
   /* Decrement the reference count (I don't use bchlib_decref() because I
    * want the entire close operation to be atomic wrt other driver
@@ -437,17 +440,59 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
       case BIOC_DISCARD:
         {
-          /* Invalidate the sector so next read is from the device- */
+          /* Invalidate the sectors so next read is from the device- */
+
+          bchlib_discardsectors(bch, 0, bch->nsectors);
+#ifdef CONFIG_BCH_PAGECACHE
+          pagecache_invalidate(bch->inode, false);
+#endif
 
-          bch->sector = (size_t)-1;
           goto ioctl_default;
         }
 
+      /* Resize the sector cache of this device */
+
+      case BIOC_SETCACHE:
+        {
+          ret = nxmutex_lock(&bch->lock);
+          if (ret >= 0)
+            {
+              ret = bchlib_setcache(bch, (size_t)arg);
+              nxmutex_unlock(&bch->lock);
+            }
+        }
+        break;
+
+      /* Change the readahead of sequential accesses, it is also limited by
+       * the size of the cache.
+       */
+
+      case BIOC_SETREADAHEAD:
+        {
+          if (arg > UINT8_MAX)
+            {
+              ret = -EINVAL;
+            }
+          else
+            {
+              bch->readahead = (uint8_t)arg;
+              ret = OK;
+            }
+        }
+        break;
+
       case BIOC_FLUSH:
         {
           /* Flush any dirty pages remaining in the cache */
 
           ret = bchlib_flushsector(bch, false);
+#ifdef CONFIG_BCH_PAGECACHE
+          if (ret >= 0)
+            {
+              ret = pagecache_flush(bch->inode);
+            }
+#endif
+
           if (ret < 0)
             {
               break;
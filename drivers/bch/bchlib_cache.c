@@ -27,8 +27,11 @@
 #include <nuttx/config.h>
 #include <nuttx/kmalloc.h>
 
+#include <sys/param.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -62,10 +65,11 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
  ****************************************************************************/
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+static int bch_cypher(FAR struct bchlib_s *bch, FAR uint8_t *data,
+                      size_t sector, int encrypt)
 {
   int blocks = bch->sectsize / 16;
-  FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
+  FAR uint32_t *buffer = (FAR uint32_t *)data;
   int i;
 
   for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t) )
@@ -73,7 +77,7 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
       uint32_t T[4];
       uint32_t X[4] =
       {
-        bch->sector, 0, 0, i
+        sector, 0, 0, i
       };
 
       aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
@@ -91,6 +95,117 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 }
 #endif
 
+/****************************************************************************
+ * Name: bchlib_alloccache
+ *
+ * Description:
+ *   Allocate the sector cache on first use.
+ *
+ ****************************************************************************/
+
+static int bchlib_alloccache(FAR struct bchlib_s *bch)
+{
+  int i;
+
+  if (bch->buffer != NULL)
+    {
+      return OK;
+    }
+
+  bch->lines = kmm_malloc(bch->nlines * sizeof(struct bchlib_line_s));
+  if (bch->lines == NULL)
+    {
+      ferr("Failed to allocate sector cache\n");
+      return -ENOMEM;
+    }
+
+#if CONFIG_BCH_BUFFER_ALIGNMENT != 0
+  bch->buffer = kmm_memalign(CONFIG_BCH_BUFFER_ALIGNMENT,
+                             bch->nlines * bch->sectsize);
+#else
+  bch->buffer = kmm_malloc(bch->nlines * bch->sectsize);
+#endif
+  if (bch->buffer == NULL)
+    {
+      ferr("Failed to allocate sector buffer\n");
+      kmm_free(bch->lines);
+      bch->lines = NULL;
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < bch->nlines; i++)
+    {
+      bch->lines[i].sector = (size_t)-1;
+      bch->lines[i].stamp  = 0;
+      bch->lines[i].dirty  = false;
+    }
+
+  bch->lastline = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_findline
+ *
+ * Description:
+ *   Return the line holding a sector, or -1 if it is not cached.
+ *
+ ****************************************************************************/
+
+static int bchlib_findline(FAR struct bchlib_s *bch, size_t sector)
+{
+  int i;
+
+  for (i = 0; i < bch->nlines; i++)
+    {
+      if (bch->lines[i].sector == sector)
+        {
+          return i;
+        }
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: bchlib_victim
+ *
+ * Description:
+ *   Select the first of n contiguous lines to receive the sectors missed
+ *   by an access.  A sequential access continues after the line of the
+ *   previous one so that its sectors stay contiguous in the buffer and can
+ *   be written back in one transfer, otherwise the least recently used
+ *   line is replaced.
+ *
+ ****************************************************************************/
+
+static int bchlib_victim(FAR struct bchlib_s *bch, int n, bool seq)
+{
+  int victim = 0;
+  int i;
+
+  if (seq && bch->lastline + 1 + n <= bch->nlines)
+    {
+      return bch->lastline + 1;
+    }
+
+  for (i = 0; i < bch->nlines; i++)
+    {
+      if (bch->lines[i].sector == (size_t)-1)
+        {
+          victim = i;
+          break;
+        }
+
+      if ((int32_t)(bch->lines[i].stamp - bch->lines[victim].stamp) < 0)
+        {
+          victim = i;
+        }
+    }
+
+  return MIN(victim, bch->nlines - n);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -99,7 +214,9 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
  * Name: bchlib_flushsector
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Write the dirty sectors of the cache back to the media.  Dirty lines
+ *   holding consecutive sectors are written in a single transfer.  If
+ *   discard is true, the cache is emptied as well.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
@@ -108,106 +225,324 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 
 int bchlib_flushsector(FAR struct bchlib_s *bch, bool discard)
 {
-  FAR struct inode *inode;
+  FAR struct bchlib_line_s *line;
   ssize_t ret = OK;
+  int n;
+  int i;
+  int j;
 
-  /* Check if the sector has been modified and is out of synch with the
-   * media.
-   */
+  if (bch->buffer == NULL)
+    {
+      return OK;
+    }
 
-  if (bch->dirty && bch->buffer != NULL)
+  for (i = 0; i < bch->nlines; i += n)
     {
-      inode = bch->inode;
+      /* Check if the sector has been modified and is out of synch with the
+       * media.
+       */
+
+      line = &bch->lines[i];
+      n    = 1;
+
+      if (!line->dirty)
+        {
+          continue;
+        }
+
+      while (i + n < bch->nlines && line[n].dirty &&
+             line[n].sector == line->sector + n)
+        {
+          n++;
+        }
 
 #if defined(CONFIG_BCH_ENCRYPTION)
       /* Encrypt data as necessary */
 
-      bch_cypher(bch, CYPHER_ENCRYPT);
+      for (j = 0; j < n; j++)
+        {
+          bch_cypher(bch, BCH_LINE(bch, i + j), line[j].sector,
+                     CYPHER_ENCRYPT);
+        }
 #endif
 
-      /* Write the sector to the media */
+      /* Write the sectors to the media */
 
-      ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
-      if (ret < 0)
-        {
-          ferr("Write failed: %zd\n", ret);
-          return (int)ret;
-        }
+      ret = bchlib_hwwrite(bch, BCH_LINE(bch, i), line->sector, n);
 
 #if defined(CONFIG_BCH_ENCRYPTION)
       /* Computation overhead to save memory for extra sector buffer
        * TODO: Add configuration switch for extra sector buffer
        */
 
-      bch_cypher(bch, CYPHER_DECRYPT);
+      for (j = 0; j < n; j++)
+        {
+          bch_cypher(bch, BCH_LINE(bch, i + j), line[j].sector,
+                     CYPHER_DECRYPT);
+        }
 #endif
 
-      /* The sector is now in sync with the media */
+      if (ret < 0)
+        {
+          ferr("Write failed: %zd\n", ret);
+          return (int)ret;
+        }
 
-      bch->dirty = false;
+      /* The sectors are now in sync with the media */
+
+      for (j = 0; j < n; j++)
+        {
+          line[j].dirty = false;
+        }
     }
 
   if (discard)
     {
-      bch->sector = (size_t)-1;
+      for (i = 0; i < bch->nlines; i++)
+        {
+          bch->lines[i].sector = (size_t)-1;
+        }
     }
 
-  return (int)ret;
+  return OK;
 }
 
 /****************************************************************************
  * Name: bchlib_readsector
  *
  * Description:
- *   Read the current sector contents into buffer
+ *   Bring a sector into the cache, and return the line holding it.  When
+ *   the sector follows the previous accesses, up to readahead of the next
+ *   sectors are read with it, twice as many as the last time.  If read is
+ *   false, the caller overwrites the whole sector and it is not read from
+ *   the media.
+ *
+ * Returned Value:
+ *   The line of the sector, or a negated errno value on failure.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
  *
  ****************************************************************************/
 
-int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
+int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector, bool read)
 {
-  FAR struct inode *inode;
-  ssize_t ret = OK;
+  ssize_t ret;
+  bool seq;
+  int n = 1;
+  int start;
+  int i;
 
-  if (bch->buffer == NULL)
+  ret = bchlib_alloccache(bch);
+  if (ret < 0)
     {
-#if CONFIG_BCH_BUFFER_ALIGNMENT != 0
-      bch->buffer = kmm_memalign(CONFIG_BCH_BUFFER_ALIGNMENT, bch->sectsize);
-#else
-      bch->buffer = kmm_malloc(bch->sectsize);
-#endif
-      if (bch->buffer == NULL)
+      return (int)ret;
+    }
+
+  /* Detect sequential accesses, an access to the same sector as the last
+   * one does not break the sequence.
+   */
+
+  seq = sector == bch->seqnext;
+  if (seq)
+    {
+      if (bch->seqcount < UINT8_MAX)
         {
-          ferr("Failed to allocate sector buffer\n");
-          return -ENOMEM;
+          bch->seqcount++;
         }
     }
+  else if (sector + 1 != bch->seqnext)
+    {
+      bch->seqcount = 0;
+    }
+
+  bch->seqnext = sector + 1;
+
+  i = bchlib_findline(bch, sector);
+  if (i >= 0)
+    {
+      bch->lines[i].stamp = ++bch->stamp;
+      bch->lastline = i;
+      return i;
+    }
 
-  if (bch->sector != sector)
+  /* Read ahead the sectors that are not cached yet */
+
+  if (read && seq && bch->readahead > 0)
     {
-      inode = bch->inode;
+      n = MIN(bch->nlines, bch->readahead + 1);
+      n = MIN(n, 1 << MIN(bch->seqcount, 7));
+      n = MIN(n, bch->nsectors - sector);
 
-      ret = bchlib_flushsector(bch, true);
-      if (ret < 0)
+      for (i = 1; i < n; i++)
         {
-          ferr("Flush failed: %zd\n", ret);
-          return (int)ret;
+          if (bchlib_findline(bch, sector + i) >= 0)
+            {
+              n = i;
+              break;
+            }
         }
+    }
+
+  /* Write back the dirty lines before they are replaced.  The whole cache
+   * is flushed so that the dirty sectors are written in as few transfers
+   * as possible.
+   */
+
+  start = bchlib_victim(bch, n, seq);
+  for (i = start; i < start + n; i++)
+    {
+      if (bch->lines[i].dirty)
+        {
+          ret = bchlib_flushsector(bch, false);
+          if (ret < 0)
+            {
+              ferr("Flush failed: %zd\n", ret);
+              return (int)ret;
+            }
+
+          break;
+        }
+    }
 
-      ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
+  for (i = start; i < start + n; i++)
+    {
+      bch->lines[i].sector = (size_t)-1;
+    }
+
+  if (read)
+    {
+      ret = bchlib_hwread(bch, BCH_LINE(bch, start), sector, n);
       if (ret < 0)
         {
           ferr("Read failed: %zd\n", ret);
           return (int)ret;
         }
+    }
 
-      bch->sector = sector;
+  bch->stamp++;
+  for (i = 0; i < n; i++)
+    {
+      bch->lines[start + i].sector = sector + i;
+      bch->lines[start + i].stamp  = bch->stamp;
 #if defined(CONFIG_BCH_ENCRYPTION)
-      bch_cypher(bch, CYPHER_DECRYPT);
+      if (read)
+        {
+          bch_cypher(bch, BCH_LINE(bch, start + i), sector + i,
+                     CYPHER_DECRYPT);
+        }
 #endif
     }
 
-  return (int)ret;
+  bch->lastline = start;
+  return start;
+}
+
+/****************************************************************************
+ * Name: bchlib_discardsectors
+ *
+ * Description:
+ *   Drop a range of sectors from the cache without writing them back,
+ *   because the media holds newer data.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+void bchlib_discardsectors(FAR struct bchlib_s *bch, size_t sector,
+                           size_t nsectors)
+{
+  FAR struct bchlib_line_s *line;
+  int i;
+
+  if (bch->buffer == NULL)
+    {
+      return;
+    }
+
+  for (i = 0; i < bch->nlines; i++)
+    {
+      line = &bch->lines[i];
+      if (line->sector != (size_t)-1 && line->sector >= sector &&
+          line->sector - sector < nsectors)
+        {
+          line->sector = (size_t)-1;
+          line->dirty  = false;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: bchlib_readdirty
+ *
+ * Description:
+ *   Copy the dirty cached sectors of a range over the data just read from
+ *   the media into buffer.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+void bchlib_readdirty(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                      size_t sector, size_t nsectors)
+{
+  FAR struct bchlib_line_s *line;
+  int i;
+
+  if (bch->buffer == NULL)
+    {
+      return;
+    }
+
+  for (i = 0; i < bch->nlines; i++)
+    {
+      line = &bch->lines[i];
+      if (line->dirty && line->sector >= sector &&
+          line->sector - sector < nsectors)
+        {
+          memcpy(buffer + (line->sector - sector) * bch->sectsize,
+                 BCH_LINE(bch, i), bch->sectsize);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: bchlib_setcache
+ *
+ * Description:
+ *   Change the number of sectors cached.  The cache is written back and
+ *   freed, it is allocated again with the new size on the next access.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_setcache(FAR struct bchlib_s *bch, size_t nlines)
+{
+  int ret;
+
+  if (nlines < 1 || nlines > UINT8_MAX)
+    {
+      return -EINVAL;
+    }
+
+  ret = bchlib_flushsector(bch, true);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (bch->buffer != NULL)
+    {
+      kmm_free(bch->buffer);
+      kmm_free(bch->lines);
+      bch->buffer = NULL;
+      bch->lines  = NULL;
+    }
+
+  bch->nlines = nlines;
+  return OK;
 }
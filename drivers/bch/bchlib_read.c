@@ -101,9 +101,9 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
   bytesread = 0;
   if (sectoffset > 0)
     {
-      /* Read the sector into the sector buffer */
+      /* Read the sector into the sector cache */
 
-      ret = bchlib_readsector(bch, sector);
+      ret = bchlib_readsector(bch, sector, true);
       if (ret < 0)
         {
           return ret;
@@ -120,7 +120,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
           nbytes = len;
         }
 
-      memcpy(buffer, &bch->buffer[sectoffset], nbytes);
+      memcpy(buffer, BCH_LINE(bch, ret) + sectoffset, nbytes);
 
       /* Adjust pointers and counts */
 
@@ -148,20 +148,25 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
           nsectors = bch->nsectors - sector;
         }
 
-      ret = bch->inode->u.i_bops->read(bch->inode, (FAR uint8_t *)buffer,
-                                       sector, nsectors);
+      ret = bchlib_hwread(bch, (FAR uint8_t *)buffer, sector, nsectors);
       if (ret < 0)
         {
           ferr("ERROR: Read failed: %d\n", ret);
           return ret;
         }
 
+      /* The cached sectors written but not flushed yet are newer */
+
+      bchlib_readdirty(bch, (FAR uint8_t *)buffer, sector, nsectors);
+
       /* Adjust pointers and counts */
 
       sector    += nsectors;
       nbytes     = nsectors * bch->sectsize;
       bytesread += nbytes;
 
+      bch->seqnext = sector;
+
       if (sector >= bch->nsectors)
         {
           return bytesread;
@@ -175,9 +180,9 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
 
   if (len > 0)
     {
-      /* Read the sector into the sector buffer */
+      /* Read the sector into the sector cache */
 
-      ret = bchlib_readsector(bch, sector);
+      ret = bchlib_readsector(bch, sector, true);
       if (ret < 0)
         {
           return ret;
@@ -185,7 +190,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
 
       /* Copy the head end of the sector to the user buffer */
 
-      memcpy(buffer, bch->buffer, len);
+      memcpy(buffer, BCH_LINE(bch, ret), len);
 
       /* Adjust counts */
 
@@ -109,10 +109,12 @@ int bchlib_setup(FAR const char *blkdev, int oflags, FAR void **handle)
   /* Save the geometry info and complete initialization of the structure */
 
   nxmutex_init(&bch->lock);
-  bch->nsectors = geo.geo_nsectors;
-  bch->sectsize = geo.geo_sectorsize;
-  bch->sector   = (size_t)-1;
-  bch->readonly = readonly;
+  bch->nsectors  = geo.geo_nsectors;
+  bch->sectsize  = geo.geo_sectorsize;
+  bch->nlines    = CONFIG_BCH_CACHE_NSECTORS;
+  bch->readahead = CONFIG_BCH_CACHE_READAHEAD;
+  bch->seqnext   = (size_t)-1;
+  bch->readonly  = readonly;
   *handle = bch;
   return OK;
 
@@ -65,6 +65,9 @@ int bchlib_teardown(FAR void *handle)
   /* Flush any pending data to the block driver */
 
   bchlib_flushsector(bch, false);
+#ifdef CONFIG_BCH_PAGECACHE
+  pagecache_invalidate(bch->inode, true);
+#endif
 
   /* Close the block driver */
 
@@ -75,6 +78,7 @@ int bchlib_teardown(FAR void *handle)
   if (bch->buffer)
     {
       kmm_free(bch->buffer);
+      kmm_free(bch->lines);
     }
 
   nxmutex_destroy(&bch->lock);
@@ -87,9 +87,9 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
   byteswritten = 0;
   if (sectoffset > 0)
     {
-      /* Read the full sector into the sector buffer */
+      /* Read the full sector into the sector cache */
 
-      ret = bchlib_readsector(bch, sector);
+      ret = bchlib_readsector(bch, sector, true);
       if (ret < 0)
         {
           return ret;
@@ -106,8 +106,8 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
           nbytes = len;
         }
 
-      memcpy(&bch->buffer[sectoffset], buffer, nbytes);
-      bch->dirty = true;
+      memcpy(BCH_LINE(bch, ret) + sectoffset, buffer, nbytes);
+      bch->lines[ret].dirty = true;
 
       /* Adjust pointers and counts */
 
@@ -127,32 +127,38 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
 
 #ifdef CONFIG_BCH_FORCE_INDIRECT
 
-  /* indirectly by using sector buffer.
+  /* indirectly by using the sector cache.  The sectors are written back
+   * when they are replaced, several at once if they are consecutive.  A
+   * single line cache can't coalesce anything, each sector is written
+   * through as before.
    */
 
   while (len > 0)
     {
-      /* Read the sector into the sector buffer */
+      /* Read the sector into the sector cache, unless it is completely
+       * overwritten.
+       */
 
-      ret = bchlib_readsector(bch, sector);
+      nbytes = len > bch->sectsize ? bch->sectsize : len;
+      ret = bchlib_readsector(bch, sector, nbytes < bch->sectsize);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Copy the data from the user buffer to the sector buffer */
-
-      nbytes = len > bch->sectsize ? bch->sectsize : len;
-      memcpy(bch->buffer, buffer, nbytes);
-      bch->dirty = true;
+      /* Copy the data from the user buffer to the sector cache */
 
-      /* Write the sector back to the block device */
+      memcpy(BCH_LINE(bch, ret), buffer, nbytes);
+      bch->lines[ret].dirty = true;
 
-      ret = bchlib_flushsector(bch, false);
-      if (ret < 0)
+      if (bch->nlines == 1)
         {
-          ferr("ERROR: Flush failed: %d\n", ret);
-          return ret;
+          ret = bchlib_flushsector(bch, false);
+          if (ret < 0)
+            {
+              ferr("ERROR: Flush failed: %d\n", ret);
+              return ret;
+            }
         }
 
       /* Adjust pointers and counts */
@@ -175,10 +181,12 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
           nsectors = bch->nsectors - sector;
         }
 
-      /* Flush the dirty sector to keep the sector sequence */
+      /* Drop the cached sectors that are overwritten, and flush the other
+       * dirty sectors to keep the sector sequence.
+       */
 
-      ret = bchlib_flushsector(bch, sector <= bch->sector &&
-                               bch->sector < (sector + nsectors));
+      bchlib_discardsectors(bch, sector, nsectors);
+      ret = bchlib_flushsector(bch, false);
       if (ret < 0)
         {
           ferr("ERROR: Flush failed: %d\n", ret);
@@ -187,8 +195,7 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
 
       /* Write the contiguous sectors */
 
-      ret = bch->inode->u.i_bops->write(bch->inode, (FAR uint8_t *)buffer,
-                                        sector, nsectors);
+      ret = bchlib_hwwrite(bch, (FAR uint8_t *)buffer, sector, nsectors);
       if (ret < 0)
         {
           ferr("ERROR: Write failed: %d\n", ret);
@@ -201,6 +208,8 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
       nbytes        = nsectors * bch->sectsize;
       byteswritten += nbytes;
 
+      bch->seqnext = sector;
+
       if (sector >= bch->nsectors)
         {
           return byteswritten;
@@ -214,9 +223,9 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
 
   if (len > 0)
     {
-      /* Read the sector into the sector buffer */
+      /* Read the sector into the sector cache */
 
-      ret = bchlib_readsector(bch, sector);
+      ret = bchlib_readsector(bch, sector, true);
       if (ret < 0)
         {
           return ret;
@@ -224,8 +233,8 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, off_t offset,
 
       /* Copy the head end of the sector from the user buffer */
 
-      memcpy(bch->buffer, buffer, len);
-      bch->dirty = true;
+      memcpy(BCH_LINE(bch, ret), buffer, len);
+      bch->lines[ret].dirty = true;
 
       /* Adjust counts */
 
@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
 #include <sys/types.h>
 #include <inttypes.h>
 #include <stdint.h>
@@ -58,12 +59,27 @@
 #  error "Worker thread support is required (CONFIG_SCHED_WORKQUEUE)"
 #endif
 
+/* The number of blocks read ahead when a stream starts */
+
+#ifdef CONFIG_DRVR_READAHEAD
+#  if CONFIG_DRVR_READAHEAD_MINBLOCKS > 0
+#    define RWB_RHWINDOW(rwb) \
+       MIN(CONFIG_DRVR_READAHEAD_MINBLOCKS, (rwb)->rhmaxblocks)
+#  else
+#    define RWB_RHWINDOW(rwb) ((rwb)->rhmaxblocks)
+#  endif
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
 
 static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
                          size_t nblocks, FAR uint8_t *rdbuffer);
+#ifdef CONFIG_DRVR_READAHEAD
+static void rwb_rhinvalidate(FAR struct rwbuffer_s *rwb,
+                             off_t startblock, size_t blockcount);
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -73,7 +89,7 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
  * Name: rwb_lock
  ****************************************************************************/
 
-#if defined(CONFIG_DRVR_WRITEBUFFER)
+#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD_PREFETCH)
 #  define rwb_lock(l) nxmutex_lock(l)
 #else
 #  define rwb_lock(l) OK
@@ -83,7 +99,7 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
  * Name: rwb_unlock
  ****************************************************************************/
 
-#if defined(CONFIG_DRVR_WRITEBUFFER)
+#if defined(CONFIG_DRVR_WRITEBUFFER) || defined(CONFIG_DRVR_READAHEAD_PREFETCH)
 #  define rwb_unlock(l) nxmutex_unlock(l)
 #else
 #  define rwb_unlock(l)
@@ -164,11 +180,25 @@ static void rwb_wrflush(FAR struct rwbuffer_s *rwb)
 
       ret = rwb->wrflush(rwb->dev, rwb->wrbuffer, rwb->wrblockstart,
                          rwb->wrnblocks);
+      rwb->stats.wrflushes++;
       if (ret != rwb->wrnblocks)
         {
           ferr("ERROR: Error flushing write buffer: %d\n", ret);
         }
 
+#ifdef CONFIG_DRVR_READAHEAD
+      /* The read-ahead buffers may hold the blocks as they were on the
+       * media before the flush.
+       */
+
+      if (rwb->rhmaxblocks > 0)
+        {
+          rwb_lock(&rwb->rhlock);
+          rwb_rhinvalidate(rwb, rwb->wrblockstart, rwb->wrnblocks);
+          rwb_unlock(&rwb->rhlock);
+        }
+#endif
+
       rwb_resetwrbuffer(rwb);
     }
 }
@@ -267,7 +297,7 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
 
       /* 2. We update the entire write buffer. */
 
-      else if (rwb->wrblockstart > startblock && wrbend < newend)
+      else if (rwb->wrblockstart > startblock && wrbend <= newend)
         {
           rwb->wrnblocks = 0;
         }
@@ -332,6 +362,7 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
   if (nblocks > rwb->wrmaxblocks)
     {
       ssize_t ret = rwb->wrflush(rwb->dev, wrbuffer, startblock, nblocks);
+      rwb->stats.wrflushes++;
       if (ret < 0)
         {
           return ret;
@@ -386,17 +417,101 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
 }
 #endif
 
+/****************************************************************************
+ * Name: rwb_rhdrop
+ *
+ * Description:
+ *   Empty the buffer of a stream, counting the blocks read ahead that were
+ *   never read.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD
+static void rwb_rhdrop(FAR struct rwbuffer_s *rwb,
+                       FAR struct rwb_rhstream_s *stream)
+{
+  off_t bufferend = stream->blockstart + stream->nblocks;
+  off_t unread    = MAX(stream->next, stream->blockstart);
+
+  /* We assume that the caller holds the rhlock */
+
+  if (stream->nblocks > 0 && unread < bufferend)
+    {
+      rwb->stats.rhwasted += bufferend - unread;
+    }
+
+  stream->nblocks    = 0;
+  stream->blockstart = -1;
+}
+#endif
+
 /****************************************************************************
  * Name: rwb_resetrhbuffer
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_READAHEAD
-static inline void rwb_resetrhbuffer(FAR struct rwbuffer_s *rwb)
+static void rwb_resetrhbuffer(FAR struct rwbuffer_s *rwb)
 {
-  /* We assume that the caller holds the readAheadBufferSemaphore */
+  FAR struct rwb_rhstream_s *stream;
+  int i;
+
+  /* We assume that the caller holds the rhlock */
 
-  rwb->rhnblocks    = 0;
-  rwb->rhblockstart = -1;
+  for (i = 0; i < CONFIG_DRVR_READAHEAD_NSTREAMS; i++)
+    {
+      stream = &rwb->rhstream[i];
+      rwb_rhdrop(rwb, stream);
+      stream->next       = -1;
+      stream->window     = RWB_RHWINDOW(rwb);
+      stream->sequential = false;
+    }
+
+  rwb->rhgen++;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_rhstream
+ *
+ * Description:
+ *   Return the stream of a read: the one whose buffer holds startblock or
+ *   whose last read ended at startblock.  Otherwise, a new stream replaces
+ *   the one that was read least recently.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD
+static FAR struct rwb_rhstream_s *
+rwb_rhstream(FAR struct rwbuffer_s *rwb, off_t startblock)
+{
+  FAR struct rwb_rhstream_s *victim = &rwb->rhstream[0];
+  FAR struct rwb_rhstream_s *stream;
+  int i;
+
+  /* We assume that the caller holds the rhlock */
+
+  for (i = 0; i < CONFIG_DRVR_READAHEAD_NSTREAMS; i++)
+    {
+      stream = &rwb->rhstream[i];
+      if (startblock == stream->next ||
+          (startblock >= stream->blockstart &&
+           startblock < stream->blockstart + stream->nblocks))
+        {
+          stream->sequential = startblock == stream->next;
+          return stream;
+        }
+
+      if ((int32_t)(stream->stamp - victim->stamp) < 0)
+        {
+          victim = stream;
+        }
+    }
+
+  rwb_rhdrop(rwb, victim);
+  victim->next       = startblock;
+  victim->window     = RWB_RHWINDOW(rwb);
+  victim->sequential = false;
+  return victim;
 }
 #endif
 
@@ -406,26 +521,27 @@ static inline void rwb_resetrhbuffer(FAR struct rwbuffer_s *rwb)
 
 #ifdef CONFIG_DRVR_READAHEAD
 static inline void
-rwb_bufferread(FAR struct rwbuffer_s *rwb,  off_t startblock,
+rwb_bufferread(FAR struct rwbuffer_s *rwb,
+               FAR struct rwb_rhstream_s *stream, off_t startblock,
                size_t nblocks, FAR uint8_t **rdbuffer)
 {
   FAR uint8_t *rhbuffer;
 
   /* We assume that:
-   * (1) the caller holds the readAheadBufferSemaphore, and
+   * (1) the caller holds the rhlock, and
    * (2) the caller already knows that all of the blocks are in the
-   *     read-ahead buffer.
+   *     read-ahead buffer of the stream.
    */
 
   /* Convert the units from blocks to bytes */
 
-  off_t  blockoffset = startblock - rwb->rhblockstart;
+  off_t  blockoffset = startblock - stream->blockstart;
   off_t  byteoffset  = rwb->blocksize * blockoffset;
   size_t nbytes      = rwb->blocksize * nblocks;
 
   /* Get the byte address in the read-ahead buffer */
 
-  rhbuffer           = rwb->rhbuffer + byteoffset;
+  rhbuffer           = stream->buffer + byteoffset;
 
   /* Copy the data from the read-ahead buffer into the IO buffer */
 
@@ -439,13 +555,21 @@ rwb_bufferread(FAR struct rwbuffer_s *rwb,  off_t startblock,
 
 /****************************************************************************
  * Name: rwb_rhreload
+ *
+ * Description:
+ *   Load the blocks from startblock into the buffer of the stream, while
+ *   the reader waits for the first remaining ones.  The window read ahead
+ *   doubles each time a sequential stream reaches the end of its buffer.
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_READAHEAD
-static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
+static int rwb_rhreload(FAR struct rwbuffer_s *rwb,
+                        FAR struct rwb_rhstream_s *stream,
+                        off_t startblock, size_t remaining)
 {
-  off_t  endblock;
   size_t nblocks;
+  size_t nwanted;
   int    ret;
 
   /* Check for attempts to read beyond the end of the media */
@@ -455,34 +579,42 @@ static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
       return -ESPIPE;
     }
 
-  /* Get the block number +1 of the last block that will fit in the
-   * read-ahead buffer
-   */
-
-  endblock = startblock + rwb->rhmaxblocks;
-
-  /* Make sure that we don't read past the end of the device */
-
-  if (endblock > rwb->nblocks)
+  if (stream->sequential)
     {
-      endblock = rwb->nblocks;
+      stream->window = MIN(2 * stream->window, rwb->rhmaxblocks);
     }
 
-  nblocks = endblock - startblock;
+  /* Get the number of blocks that will fit in the read-ahead buffer, make
+   * sure that we don't read past the end of the device.
+   */
+
+  nblocks = MAX(remaining, stream->window);
+  nblocks = MIN(nblocks, rwb->rhmaxblocks);
+  nblocks = MIN(nblocks, rwb->nblocks - startblock);
+  nwanted = MIN(nblocks, remaining);
 
   /* Reset the read buffer */
 
-  rwb_resetrhbuffer(rwb);
+  rwb_rhdrop(rwb, stream);
 
-  /* Now perform the read */
+  /* Now perform the read, a prefetch may be reading the media too */
 
-  ret = rwb->rhreload(rwb->dev, rwb->rhbuffer, startblock, nblocks);
+#ifdef CONFIG_DRVR_READAHEAD_PREFETCH
+  rwb_lock(&rwb->rhiolock);
+#endif
+  ret = rwb->rhreload(rwb->dev, stream->buffer, startblock, nblocks);
+#ifdef CONFIG_DRVR_READAHEAD_PREFETCH
+  rwb_unlock(&rwb->rhiolock);
+#endif
   if (ret == nblocks)
     {
       /* Update information about what is in the read-ahead buffer */
 
-      rwb->rhnblocks    = nblocks;
-      rwb->rhblockstart = startblock;
+      stream->nblocks    = nblocks;
+      stream->blockstart = startblock;
+
+      rwb->stats.rhmisses     += nwanted;
+      rwb->stats.rhprefetched += nblocks - nwanted;
 
       /* The return value is not the number of blocks we asked to be
        * loaded.
@@ -495,6 +627,207 @@ static int rwb_rhreload(FAR struct rwbuffer_s *rwb, off_t startblock)
 }
 #endif
 
+/****************************************************************************
+ * Name: rwb_rhprefetch
+ *
+ * Description:
+ *   Load the next window of a sequential stream on the work queue.  The
+ *   blocks of the stream not read yet are copied to the spare buffer, the
+ *   next ones are read after them without holding the rhlock, then the
+ *   spare buffer becomes the buffer of the stream.  The result is dropped
+ *   if the stream or the media changed in the meantime.  The rhiolock
+ *   keeps the read from running concurrently with the one of a reader.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD_PREFETCH
+static void rwb_rhprefetch(FAR void *arg)
+{
+  FAR struct rwbuffer_s *rwb = (FAR struct rwbuffer_s *)arg;
+  FAR struct rwb_rhstream_s *stream;
+  FAR uint8_t *buffer;
+  off_t blockstart;
+  off_t bufferend;
+  size_t nkeep;
+  size_t nblocks;
+  uint32_t gen;
+  ssize_t ret;
+
+  rwb_lock(&rwb->rhlock);
+
+  stream     = &rwb->rhstream[rwb->rhprefetch];
+  blockstart = stream->next;
+  bufferend  = stream->blockstart + stream->nblocks;
+
+  if (stream->nblocks == 0 || blockstart < stream->blockstart ||
+      blockstart > bufferend || bufferend >= rwb->nblocks)
+    {
+      goto out;
+    }
+
+  stream->window = MIN(2 * stream->window, rwb->rhmaxblocks);
+
+  nkeep   = bufferend - blockstart;
+  nblocks = MIN(stream->window, rwb->rhmaxblocks - nkeep);
+  nblocks = MIN(nblocks, rwb->nblocks - bufferend);
+
+  memcpy(rwb->rhspare,
+         stream->buffer + (blockstart - stream->blockstart) * rwb->blocksize,
+         nkeep * rwb->blocksize);
+  gen = rwb->rhgen;
+
+  rwb_unlock(&rwb->rhlock);
+
+  rwb_lock(&rwb->rhiolock);
+  ret = rwb->rhreload(rwb->dev, rwb->rhspare + nkeep * rwb->blocksize,
+                      bufferend, nblocks);
+  rwb_unlock(&rwb->rhiolock);
+
+  rwb_lock(&rwb->rhlock);
+
+  if (ret != nblocks)
+    {
+      ferr("ERROR: Failed to prefetch: %zd\n", ret);
+    }
+  else if (gen != rwb->rhgen || stream->blockstart > blockstart ||
+           stream->blockstart + stream->nblocks != bufferend)
+    {
+      rwb->stats.rhwasted += nblocks;
+    }
+  else
+    {
+      buffer             = stream->buffer;
+      stream->buffer     = rwb->rhspare;
+      stream->blockstart = blockstart;
+      stream->nblocks    = nkeep + nblocks;
+      rwb->rhspare       = buffer;
+
+      rwb->stats.rhprefetched += nblocks;
+    }
+
+out:
+  rwb->rhprefetch = -1;
+  rwb_unlock(&rwb->rhlock);
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_rhstartprefetch
+ *
+ * Description:
+ *   Start loading the next window of a sequential stream once half of the
+ *   current one has been read.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD_PREFETCH
+static void rwb_rhstartprefetch(FAR struct rwbuffer_s *rwb,
+                                FAR struct rwb_rhstream_s *stream)
+{
+  off_t bufferend = stream->blockstart + stream->nblocks;
+
+  /* We assume that the caller holds the rhlock */
+
+  if (!stream->sequential || rwb->rhprefetch >= 0 ||
+      stream->nblocks == 0 || bufferend >= rwb->nblocks ||
+      stream->next < stream->blockstart || stream->next > bufferend ||
+      2 * (bufferend - stream->next) > stream->window)
+    {
+      return;
+    }
+
+  rwb->rhprefetch = stream - rwb->rhstream;
+  work_queue(LPWORK, &rwb->rhwork, rwb_rhprefetch, rwb, 0);
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_rhinvalidate
+ *
+ * Description:
+ *   Invalidate a region of the read-ahead buffers
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD
+static void rwb_rhinvalidate(FAR struct rwbuffer_s *rwb,
+                             off_t startblock, size_t blockcount)
+{
+  FAR struct rwb_rhstream_s *stream;
+  off_t rhbend;
+  off_t invend;
+  int i;
+
+  /* We assume that the caller holds the rhlock.  A prefetch in progress
+   * is dropped.
+   */
+
+  rwb->rhgen++;
+
+  invend = startblock + blockcount;
+  for (i = 0; i < CONFIG_DRVR_READAHEAD_NSTREAMS; i++)
+    {
+      stream = &rwb->rhstream[i];
+      rhbend = stream->blockstart + stream->nblocks;
+
+      /* Now there are four cases:
+       *
+       * 1. We invalidate nothing
+       */
+
+      if (stream->nblocks == 0 || rhbend <= startblock ||
+          stream->blockstart >= invend)
+        {
+          continue;
+        }
+
+      /* 2. We invalidate the entire read-ahead buffer. */
+
+      else if (stream->blockstart >= startblock && rhbend <= invend)
+        {
+          stream->nblocks = 0;
+        }
+
+      /* 3. We invalidate a portion in the middle or at the end of the
+       *    read-ahead buffer.  Keep the blocks at the beginning of the
+       *    buffer up the start of the invalidated region.
+       */
+
+      else if (stream->blockstart < startblock)
+        {
+          stream->nblocks = startblock - stream->blockstart;
+        }
+
+      /* 4. We invalidate a portion at the begin of the read-ahead buffer */
+
+      else
+        {
+          size_t ninval;
+          size_t nkeep;
+
+          /* Move the blocks that we don't invalidate to the beginning of
+           * the read buffer.
+           */
+
+          ninval = invend - stream->blockstart;
+          nkeep  = stream->nblocks - ninval;
+
+          memmove(stream->buffer,
+                  stream->buffer + ninval * rwb->blocksize,
+                  nkeep * rwb->blocksize);
+
+          /* Update the block info.  The first block is now the one just
+           * after the invalidation region and the number buffered blocks
+           * is the number that we kept.
+           */
+
+          stream->blockstart = invend;
+          stream->nblocks    = nkeep;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: rwb_invalidate_writebuffer
  *
@@ -653,11 +986,8 @@ int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
 {
   int ret = OK;
 
-  if (rwb->rhmaxblocks > 0 && rwb->rhnblocks > 0)
+  if (rwb->rhmaxblocks > 0)
     {
-      off_t rhbend;
-      off_t invend;
-
       finfo("startblock=%" PRIdOFF " blockcount=%zu\n",
             startblock, blockcount);
 
@@ -667,90 +997,7 @@ int rwb_invalidate_readahead(FAR struct rwbuffer_s *rwb,
           return ret;
         }
 
-      /* Now there are five cases:
-       *
-       * 1. We invalidate nothing
-       */
-
-      rhbend = rwb->rhblockstart + rwb->rhnblocks;
-      invend = startblock + blockcount;
-
-      if (rhbend <= startblock || rwb->rhblockstart >= invend)
-        {
-          ret = OK;
-        }
-
-      /* 2. We invalidate the entire read-ahead buffer. */
-
-      else if (rwb->rhblockstart >= startblock && rhbend <= invend)
-        {
-          rwb->rhnblocks = 0;
-          ret = OK;
-        }
-
-      /* We are going to invalidate a subset of the read-ahead buffer.
-       * Three more cases to consider:
-       *
-       * 2. We invalidate a portion in the middle of the read-ahead buffer
-       */
-
-      else if (rwb->rhblockstart < startblock && rhbend > invend)
-        {
-          /* Keep the blocks at the beginning of the buffer up the
-           * start of the invalidated region.
-           */
-
-          rwb->rhnblocks = startblock - rwb->rhblockstart;
-          ret = OK;
-        }
-
-      /* 3. We invalidate a portion at the end of the read-ahead buffer */
-
-      else if (rhbend > startblock && rhbend <= invend)
-        {
-          rwb->rhnblocks -= rhbend - startblock;
-          ret = OK;
-        }
-
-      /* 4. We invalidate a portion at the begin of the read-ahead buffer */
-
-      else /* if (rwb->rhblockstart >= startblock && rhbend > invend) */
-        {
-          FAR uint8_t *src;
-          size_t ninval;
-          size_t nkeep;
-
-          DEBUGASSERT(rwb->rhblockstart >= startblock && rhbend > invend);
-          /* Copy the data from the uninvalidated region to the beginning
-           * of the read buffer.
-           *
-           * First calculate the source and destination of the transfer.
-           */
-
-          ninval = invend - rwb->rhblockstart;
-          src    = rwb->rhbuffer + ninval * rwb->blocksize;
-
-          /* Calculate the number of blocks we are keeping.  We keep
-           * the ones that we don't invalidate.
-           */
-
-          nkeep  = rwb->rhnblocks - ninval;
-
-          /* Then move the data that we are keeping to the beginning
-           * the read buffer.
-           */
-
-          memmove(rwb->rhbuffer, src, nkeep * rwb->blocksize);
-
-          /* Update the block info.  The first block is now the one just
-           * after the invalidation region and the number buffered blocks
-           * is the number that we kept.
-           */
-
-          rwb->rhblockstart = invend;
-          rwb->rhnblocks    = nkeep;
-        }
-
+      rwb_rhinvalidate(rwb, startblock, blockcount);
       rwb_unlock(&rwb->rhlock);
     }
 
@@ -788,6 +1035,8 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
   rwb->rhbuffer = NULL;
 #endif
 
+  memset(&rwb->stats, 0, sizeof(rwb->stats));
+
 #ifdef CONFIG_DRVR_WRITEBUFFER
   if (rwb->wrmaxblocks > 0)
     {
@@ -827,25 +1076,36 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 #ifdef CONFIG_DRVR_READAHEAD
   if (rwb->rhmaxblocks > 0)
     {
+      int nbuffers = CONFIG_DRVR_READAHEAD_NSTREAMS;
+      int i;
+
       finfo("Initialize the read-ahead buffer\n");
 
       /* Initialize the read-ahead buffer access mutex */
 
       nxmutex_init(&rwb->rhlock);
+#ifdef CONFIG_DRVR_READAHEAD_PREFETCH
+      nxmutex_init(&rwb->rhiolock);
+#endif
 
-      /* Initialize read-ahead buffer parameters */
-
-      rwb_resetrhbuffer(rwb);
+      /* Allocate the read-ahead buffers, one per stream and the spare one
+       * of the prefetch.
+       */
 
-      /* Allocate the read-ahead buffer */
+#ifdef CONFIG_DRVR_READAHEAD_PREFETCH
+      nbuffers++;
+#endif
 
-      allocsize     = rwb->rhmaxblocks * rwb->blocksize;
+      allocsize     = nbuffers * rwb->rhmaxblocks * rwb->blocksize;
       rwb->rhbuffer = kmm_malloc(allocsize);
       if (!rwb->rhbuffer)
         {
           ferr("Read-ahead buffer kmm_malloc(%" PRIu32 ") failed\n",
           allocsize);
           nxmutex_destroy(&rwb->rhlock);
+#ifdef CONFIG_DRVR_READAHEAD_PREFETCH
+          nxmutex_destroy(&rwb->rhiolock);
+#endif
 #ifdef CONFIG_DRVR_WRITEBUFFER
           if (rwb->wrmaxblocks > 0)
             {
@@ -861,10 +1121,34 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
           return -ENOMEM;
         }
 
+      /* Initialize read-ahead buffer parameters */
+
+      for (i = 0; i < CONFIG_DRVR_READAHEAD_NSTREAMS; i++)
+        {
+          rwb->rhstream[i].buffer  = rwb->rhbuffer +
+                                     i * rwb->rhmaxblocks * rwb->blocksize;
+          rwb->rhstream[i].nblocks = 0;
+          rwb->rhstream[i].stamp   = 0;
+        }
+
+#ifdef CONFIG_DRVR_READAHEAD_PREFETCH
+      rwb->rhspare    = rwb->rhbuffer +
+                        i * rwb->rhmaxblocks * rwb->blocksize;
+      rwb->rhprefetch = -1;
+#endif
+
+      rwb->rhstamp = 0;
+      rwb->rhgen   = 0;
+      rwb_resetrhbuffer(rwb);
+
       finfo("Read-ahead buffer size: %" PRIu32 " bytes\n", allocsize);
     }
 #endif /* CONFIG_DRVR_READAHEAD */
 
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_RWBUFFER)
+  rwb_procfs_register(rwb);
+#endif
+
   return OK;
 }
 
@@ -874,6 +1158,10 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 
 void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
 {
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_RWBUFFER)
+  rwb_procfs_unregister(rwb);
+#endif
+
 #ifdef CONFIG_DRVR_WRITEBUFFER
   if (rwb->wrmaxblocks > 0)
     {
@@ -890,6 +1178,11 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
 #ifdef CONFIG_DRVR_READAHEAD
   if (rwb->rhmaxblocks > 0)
     {
+#ifdef CONFIG_DRVR_READAHEAD_PREFETCH
+      work_cancel_sync(LPWORK, &rwb->rhwork);
+      nxmutex_destroy(&rwb->rhiolock);
+#endif
+
       nxmutex_destroy(&rwb->rhlock);
       if (rwb->rhbuffer)
         {
@@ -911,28 +1204,38 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
 #ifdef CONFIG_DRVR_READAHEAD
   if (rwb->rhmaxblocks > 0)
     {
+      FAR struct rwb_rhstream_s *stream;
+      uint32_t misses;
       size_t remaining;
 
+      if (nblocks == 0)
+        {
+          return 0;
+        }
+
       ret = rwb_lock(&rwb->rhlock);
       if (ret < 0)
         {
           return ret;
         }
 
+      stream = rwb_rhstream(rwb, startblock);
+      misses = rwb->stats.rhmisses;
+
       /* Loop until we have read all of the requested blocks */
 
       for (remaining = nblocks; remaining > 0; )
         {
-          /* Is there anything in the read-ahead buffer? */
+          /* Is there anything in the read-ahead buffer of the stream? */
 
-          if (rwb->rhnblocks > 0)
+          if (stream->nblocks > 0)
             {
               off_t bufferend;
 
               /* How many blocks are available in this buffer? */
 
-              bufferend = rwb->rhblockstart + rwb->rhnblocks;
-              if (startblock >= rwb->rhblockstart && startblock < bufferend)
+              bufferend = stream->blockstart + stream->nblocks;
+              if (startblock >= stream->blockstart && startblock < bufferend)
                 {
                   size_t rdblocks = bufferend - startblock;
                   if (rdblocks > remaining)
@@ -942,7 +1245,8 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
 
                   /* Then read the data from the read-ahead buffer */
 
-                  rwb_bufferread(rwb, startblock, rdblocks, &rdbuffer);
+                  rwb_bufferread(rwb, stream, startblock, rdblocks,
+                                 &rdbuffer);
                   startblock += rdblocks;
                   remaining  -= rdblocks;
                 }
@@ -954,7 +1258,7 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
 
           if (remaining > 0)
             {
-              ret = rwb_rhreload(rwb, startblock);
+              ret = rwb_rhreload(rwb, stream, startblock, remaining);
               if (ret < 0)
                 {
                   ferr("ERROR: Failed to fill the read-ahead buffer: %d\n",
@@ -966,6 +1270,17 @@ static ssize_t rwb_read_(FAR struct rwbuffer_s *rwb, off_t startblock,
             }
         }
 
+      /* The blocks that were not missed were hits */
+
+      rwb->stats.rhhits += nblocks - (rwb->stats.rhmisses - misses);
+
+      stream->next  = startblock;
+      stream->stamp = ++rwb->rhstamp;
+
+#ifdef CONFIG_DRVR_READAHEAD_PREFETCH
+      rwb_rhstartprefetch(rwb, stream);
+#endif
+
       /* On success, return the number of blocks that we were requested to
        * read. This is for compatibility with the normal return of a block
        * driver read method
@@ -1078,13 +1393,14 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
 {
   int ret = OK;
 
+  rwb->stats.wrblocks += nblocks;
+
 #ifdef CONFIG_DRVR_READAHEAD
   if (rwb->rhmaxblocks > 0)
     {
-      /* If the new write data overlaps any part of the read buffer, then
-       * flush the data from the read buffer.  We could attempt some more
-       * exotic handling -- but this simple logic is well-suited for simple
-       * streaming applications.
+      /* If the new write data overlaps any part of the read buffers, then
+       * invalidate the data from the read buffers.  A prefetch in progress
+       * is dropped, it may have read the old data.
        */
 
       ret = rwb_lock(&rwb->rhlock);
@@ -1093,24 +1409,7 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
           return ret;
         }
 
-      if (rwb_overlap(rwb->rhblockstart, rwb->rhnblocks, startblock,
-                      nblocks))
-        {
-#ifdef CONFIG_DRVR_INVALIDATE
-          /* Just invalidate the read buffer startblock + nblocks data */
-
-          ret = rwb_invalidate_readahead(rwb, startblock, nblocks);
-          if (ret < 0)
-            {
-              ferr("ERROR: rwb_invalidate_readahead failed: %d\n", ret);
-              rwb_unlock(&rwb->rhlock);
-              return ret;
-            }
-#else
-          rwb_resetrhbuffer(rwb);
-#endif
-        }
-
+      rwb_rhinvalidate(rwb, startblock, nblocks);
       rwb_unlock(&rwb->rhlock);
     }
 #endif
@@ -1142,6 +1441,7 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
        */
 
       ret = rwb->wrflush(rwb->dev, wrbuffer, startblock, nblocks);
+      rwb->stats.wrflushes++;
     }
 
   return ret;
@@ -0,0 +1,302 @@
+/****************************************************************************
+ * drivers/misc/rwbuffer_procfs.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <inttypes.h>
+#include <string.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/fs/procfs.h>
+#include <nuttx/drivers/rwbuffer.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define RWBUFFER_LINELEN 112
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct rwbuffer_file_s
+{
+  struct procfs_file_s base;       /* Base open file structure */
+  char line[RWBUFFER_LINELEN];     /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     rwbuffer_open(FAR struct file *filep, FAR const char *relpath,
+                             int oflags, mode_t mode);
+static int     rwbuffer_close(FAR struct file *filep);
+static int     rwbuffer_dup(FAR const struct file *oldp,
+                            FAR struct file *newp);
+static int     rwbuffer_stat(FAR const char *relpath, FAR struct stat *buf);
+static ssize_t rwbuffer_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct procfs_operations g_rwbuffer_operations =
+{
+  rwbuffer_open,   /* open */
+  rwbuffer_close,  /* close */
+  rwbuffer_read,   /* read */
+  NULL,            /* write */
+  NULL,            /* poll */
+  rwbuffer_dup,    /* dup */
+  NULL,            /* opendir */
+  NULL,            /* closedir */
+  NULL,            /* readdir */
+  NULL,            /* rewinddir */
+  rwbuffer_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct rwbuffer_s *g_rwbuffer_procfs;
+static mutex_t g_rwbuffer_lock = NXMUTEX_INITIALIZER;
+static unsigned int g_rwbuffer_nextid;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rwbuffer_open
+ ****************************************************************************/
+
+static int rwbuffer_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct rwbuffer_file_s *procfile;
+
+  /* This file is read-only */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      return -EACCES;
+    }
+
+  procfile = kmm_zalloc(sizeof(struct rwbuffer_file_s));
+  if (procfile == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  filep->f_priv = procfile;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: rwbuffer_close
+ ****************************************************************************/
+
+static int rwbuffer_close(FAR struct file *filep)
+{
+  kmm_free(filep->f_priv);
+  filep->f_priv = NULL;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: rwbuffer_read
+ *
+ * Description:
+ *   List the statistics of each buffer, identified by the device state
+ *   passed to its callouts.  The hit ratio is the percentage of the blocks
+ *   read that were already in a read-ahead buffer.
+ *
+ ****************************************************************************/
+
+static ssize_t rwbuffer_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct rwbuffer_file_s *procfile;
+  FAR struct rwbuffer_s *rwb;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int ret;
+
+  offset    = filep->f_pos;
+  procfile  = filep->f_priv;
+  linesize  = procfs_snprintf(procfile->line, RWBUFFER_LINELEN,
+                              "%4s%7s%11s%11s%11s%11s%6s%11s%11s\n",
+                              "id", "bsize", "rhhits", "rhmisses",
+                              "prefetch", "wasted", "hit%",
+                              "wrblocks", "wrflushes");
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+  ret = nxmutex_lock(&g_rwbuffer_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (rwb = g_rwbuffer_procfs; rwb != NULL; rwb = rwb->flink)
+    {
+      FAR const struct rwb_stats_s *stats = &rwb->stats;
+      uint32_t nread;
+
+      if (totalsize >= buflen)
+        {
+          break;
+        }
+
+      buffer   += copysize;
+      buflen   -= copysize;
+
+      nread     = stats->rhhits + stats->rhmisses;
+      linesize  = procfs_snprintf(procfile->line, RWBUFFER_LINELEN,
+                                  "%4u%7u%11" PRIu32 "%11" PRIu32
+                                  "%11" PRIu32 "%11" PRIu32 "%6u"
+                                  "%11" PRIu32 "%11" PRIu32 "\n",
+                                  rwb->id, (unsigned int)rwb->blocksize,
+                                  stats->rhhits, stats->rhmisses,
+                                  stats->rhprefetched, stats->rhwasted,
+                                  nread > 0 ? (unsigned int)
+                                  ((uint64_t)stats->rhhits * 100 / nread) :
+                                  0,
+                                  stats->wrblocks, stats->wrflushes);
+      copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                &offset);
+      totalsize += copysize;
+    }
+
+  nxmutex_unlock(&g_rwbuffer_lock);
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: rwbuffer_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int rwbuffer_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct rwbuffer_file_s *oldattr;
+  FAR struct rwbuffer_file_s *newattr;
+
+  oldattr = oldp->f_priv;
+  newattr = kmm_malloc(sizeof(struct rwbuffer_file_s));
+  if (newattr == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memcpy(newattr, oldattr, sizeof(struct rwbuffer_file_s));
+  newp->f_priv = newattr;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: rwbuffer_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int rwbuffer_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rwb_procfs_register
+ *
+ * Description:
+ *   List a buffer in /proc/rwbuffer, numbered in the order the buffers
+ *   were registered.
+ *
+ ****************************************************************************/
+
+void rwb_procfs_register(FAR struct rwbuffer_s *rwb)
+{
+  nxmutex_lock(&g_rwbuffer_lock);
+  rwb->id    = g_rwbuffer_nextid++;
+  rwb->flink = g_rwbuffer_procfs;
+  g_rwbuffer_procfs = rwb;
+  nxmutex_unlock(&g_rwbuffer_lock);
+}
+
+/****************************************************************************
+ * Name: rwb_procfs_unregister
+ *
+ * Description:
+ *   Remove a buffer from /proc/rwbuffer.
+ *
+ ****************************************************************************/
+
+void rwb_procfs_unregister(FAR struct rwbuffer_s *rwb)
+{
+  FAR struct rwbuffer_s **cur;
+
+  nxmutex_lock(&g_rwbuffer_lock);
+  for (cur = &g_rwbuffer_procfs; *cur != NULL; cur = &(*cur)->flink)
+    {
+      if (*cur == rwb)
+        {
+          *cur = rwb->flink;
+          break;
+        }
+    }
+
+  nxmutex_unlock(&g_rwbuffer_lock);
+}
@@ -39,6 +39,7 @@
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev_lowerhalf.h>
 #include <nuttx/net/pkt.h>
+#include <nuttx/net/tcp.h>
 #include <nuttx/net/vlan.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/spinlock.h>
@@ -51,6 +52,15 @@
 
 #define NETDEV_THREAD_NAME_FMT "netdev-%s"
 
+#ifdef CONFIG_NETDEV_GRO
+/* The TCP/IPv4 segments which may be coalesced have no IP options */
+
+#  define NETDEV_GRO_VHL    (IPv4_VERSION | (IPv4_HDRLEN >> 2))
+#  define NETDEV_GRO_IPLEN(ipv4) \
+     (((uint16_t)(ipv4)->len[0] << 8) + (ipv4)->len[1])
+#  define NETDEV_GRO_TCPHDRLEN(tcp) (((tcp)->tcpoffset >> 4) << 2)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -88,6 +98,15 @@ struct netdev_upperhalf_s
 
   bool txing;
 
+#ifdef CONFIG_NETDEV_GRO
+  /* TCP segment being coalesced by the receive path */
+
+  FAR struct iob_s *gro_iob;    /* The coalesced segment, NULL if none */
+  uint32_t gro_nextseq;         /* Sequence number of the next segment */
+  uint16_t gro_sum;             /* Raw checksum of the coalesced payload */
+  uint8_t  gro_nsegs;           /* Number of segments coalesced */
+#endif
+
   /* Deferring process to work queue or thread */
 
   union
@@ -687,6 +706,319 @@ static void ip_input(FAR struct net_driver_s *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: netdev_upper_input
+ *
+ * Description:
+ *   Hand the received packet in d_iob to the handler of the link type.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX network driver state structure
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_input(FAR struct net_driver_s *dev)
+{
+  switch (dev->d_lltype)
+    {
+#ifdef CONFIG_NET_LOOPBACK
+    case NET_LL_LOOPBACK:
+#endif
+#ifdef CONFIG_NET_ETHERNET
+    case NET_LL_ETHERNET:
+#endif
+#ifdef CONFIG_DRIVERS_IEEE80211
+    case NET_LL_IEEE80211:
+#endif
+#if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
+    defined(CONFIG_DRIVERS_IEEE80211)
+      eth_input(dev);
+      break;
+#endif
+#ifdef CONFIG_NET_MBIM
+    case NET_LL_MBIM:
+      ip_input(dev);
+      break;
+#endif
+#ifdef CONFIG_NET_CAN
+    case NET_LL_CAN:
+      ninfo("CAN frame");
+      can_input(dev);
+      break;
+#endif
+    default:
+      nerr("Unknown link type %d\n", dev->d_lltype);
+      break;
+    }
+}
+
+#ifdef CONFIG_NETDEV_GRO
+/****************************************************************************
+ * Name: netdev_upper_gro_add
+ *
+ * Description:
+ *   Add two raw (one's complement) checksums.
+ *
+ ****************************************************************************/
+
+static inline uint16_t netdev_upper_gro_add(uint16_t sum, uint16_t t)
+{
+  sum += t;
+  return sum < t ? sum + 1 : sum;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_seq
+ *
+ * Description:
+ *   Return the sequence number of a TCP header.
+ *
+ ****************************************************************************/
+
+static inline uint32_t netdev_upper_gro_seq(FAR struct tcp_hdr_s *tcp)
+{
+  return ((uint32_t)tcp->seqno[0] << 24) | ((uint32_t)tcp->seqno[1] << 16) |
+         ((uint32_t)tcp->seqno[2] << 8) | tcp->seqno[3];
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_hdrsum
+ *
+ * Description:
+ *   Return the raw checksum of the TCP pseudo-header and of the TCP header
+ *   of a segment.  If the checksum of the segment is valid, the raw
+ *   checksum of its payload is the complement of this value, which saves
+ *   summing the payload of each coalesced segment.  A segment corrupted
+ *   on the wire still makes the checksum of the coalesced segment fail.
+ *
+ ****************************************************************************/
+
+static uint16_t netdev_upper_gro_hdrsum(FAR struct ipv4_hdr_s *ipv4,
+                                        FAR struct tcp_hdr_s *tcp)
+{
+  uint16_t sum = NETDEV_GRO_IPLEN(ipv4) - IPv4_HDRLEN + IP_PROTO_TCP;
+
+  sum = chksum(sum, (FAR uint8_t *)ipv4->srcipaddr, 2 * sizeof(in_addr_t));
+  return chksum(sum, (FAR uint8_t *)tcp, NETDEV_GRO_TCPHDRLEN(tcp));
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_tcp
+ *
+ * Description:
+ *   Return the TCP header of the packet in d_iob if it is a TCP/IPv4
+ *   segment with payload for this host that may be coalesced: no IP
+ *   options, not fragmented, only the ACK and PSH flags set and all the
+ *   headers in the first IOB.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_hdr_s *
+netdev_upper_gro_tcp(FAR struct net_driver_s *dev)
+{
+  FAR struct eth_hdr_s *eth_hdr = (FAR struct eth_hdr_s *)NETLLBUF;
+  FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct tcp_hdr_s *tcp;
+  uint16_t hdrlen;
+
+  if (dev->d_lltype != NET_LL_ETHERNET || IFF_IS_NAT(dev->d_flags) ||
+      eth_hdr->type != HTONS(ETHTYPE_IP) ||
+      iob->io_len < IPv4_HDRLEN + TCP_HDRLEN ||
+      ipv4->vhl != NETDEV_GRO_VHL || ipv4->proto != IP_PROTO_TCP ||
+      (ipv4->ipoffset[0] & 0x3f) != 0 || ipv4->ipoffset[1] != 0 ||
+      NETDEV_GRO_IPLEN(ipv4) != iob->io_pktlen ||
+      !net_ipv4addr_hdrcmp(ipv4->destipaddr, &dev->d_ipaddr))
+    {
+      return NULL;
+    }
+
+#ifdef CONFIG_NET_IPV4_CHECKSUMS
+  if (ipv4_chksum(ipv4) != 0xffff)
+    {
+      return NULL;
+    }
+#endif
+
+  tcp    = (FAR struct tcp_hdr_s *)IPBUF(IPv4_HDRLEN);
+  hdrlen = IPv4_HDRLEN + NETDEV_GRO_TCPHDRLEN(tcp);
+  if ((tcp->flags & ~TCP_PSH) != TCP_ACK ||
+      hdrlen < IPv4_HDRLEN + TCP_HDRLEN || hdrlen > iob->io_len ||
+      hdrlen >= iob->io_pktlen)
+    {
+      return NULL;
+    }
+
+  return tcp;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_flush
+ *
+ * Description:
+ *   Hand the coalesced segment, if any, to the network stack.  The headers
+ *   of the first segment are fixed up to cover the whole payload.  The
+ *   packet in d_iob, if any, is preserved.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_gro_flush(FAR struct netdev_upperhalf_s *upper,
+                                   FAR struct net_driver_s *dev)
+{
+  FAR struct iob_s *iob = upper->gro_iob;
+  FAR struct iob_s *cur = dev->d_iob;
+  uint16_t len = dev->d_len;
+  FAR struct ipv4_hdr_s *ipv4;
+  FAR struct tcp_hdr_s *tcp;
+  uint16_t sum;
+
+  if (iob == NULL)
+    {
+      return;
+    }
+
+  upper->gro_iob = NULL;
+
+  if (upper->gro_nsegs > 1)
+    {
+      ipv4 = (FAR struct ipv4_hdr_s *)IOB_DATA(iob);
+      tcp  = (FAR struct tcp_hdr_s *)(IOB_DATA(iob) + IPv4_HDRLEN);
+
+      ipv4->len[0]   = iob->io_pktlen >> 8;
+      ipv4->len[1]   = iob->io_pktlen & 0xff;
+      ipv4->ipchksum = 0;
+      ipv4->ipchksum = ~ipv4_chksum(ipv4);
+
+      tcp->tcpchksum = 0;
+      sum = netdev_upper_gro_add(netdev_upper_gro_hdrsum(ipv4, tcp),
+                                 upper->gro_sum);
+      tcp->tcpchksum = ~((sum == 0) ? 0xffff : HTONS(sum));
+    }
+
+  netdev_iob_clear(dev);
+  netdev_iob_replace_l2(dev, iob);
+  netdev_upper_input(dev);
+
+  if (cur != NULL)
+    {
+      netdev_iob_replace_l2(dev, cur);
+      dev->d_len = len;
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_receive
+ *
+ * Description:
+ *   Coalesce the received packet in d_iob with the segment held by the
+ *   upper half if it is the next segment of the same flow, or hold it if
+ *   it may be coalesced with the following ones.  The payload is linked
+ *   to the IOB chain of the held segment, the window and flags of the last
+ *   segment are kept.  A segment with PSH set ends the coalescing.
+ *
+ * Returned Value:
+ *   True if the packet was taken, false if it must be handed to the
+ *   network stack (any held segment has then been handed over first).
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static bool netdev_upper_gro_receive(FAR struct netdev_upperhalf_s *upper,
+                                     FAR struct net_driver_s *dev)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct ipv4_hdr_s *ipv4;
+  FAR struct ipv4_hdr_s *held;
+  FAR struct tcp_hdr_s *htcp;
+  FAR struct tcp_hdr_s *tcp;
+  uint16_t hdrlen;
+  uint16_t paylen;
+  uint16_t sum;
+
+  tcp = netdev_upper_gro_tcp(dev);
+  if (tcp == NULL)
+    {
+      /* Not a segment to coalesce, the held segment goes first */
+
+      netdev_upper_gro_flush(upper, dev);
+      return false;
+    }
+
+  ipv4   = IPv4BUF;
+  hdrlen = IPv4_HDRLEN + NETDEV_GRO_TCPHDRLEN(tcp);
+  paylen = iob->io_pktlen - hdrlen;
+
+  if (upper->gro_iob != NULL)
+    {
+      held = (FAR struct ipv4_hdr_s *)IOB_DATA(upper->gro_iob);
+      htcp = (FAR struct tcp_hdr_s *)((FAR uint8_t *)held + IPv4_HDRLEN);
+
+      if (memcmp(held->srcipaddr, ipv4->srcipaddr,
+                 2 * sizeof(in_addr_t)) == 0 &&
+          htcp->srcport == tcp->srcport && htcp->destport == tcp->destport &&
+          held->tos == ipv4->tos && held->ttl == ipv4->ttl &&
+          netdev_upper_gro_seq(tcp) == upper->gro_nextseq &&
+          memcmp(htcp->ackno, tcp->ackno, 4) == 0 &&
+          htcp->tcpoffset == tcp->tcpoffset &&
+          memcmp(htcp->optdata, tcp->optdata,
+                 hdrlen - IPv4_HDRLEN - TCP_HDRLEN) == 0 &&
+          upper->gro_iob->io_pktlen + paylen <= CONFIG_NETDEV_GRO_MAXSIZE)
+        {
+          /* The payload of a segment following an odd length payload
+           * starts at an odd offset, its checksum is byte swapped.
+           */
+
+          sum = ~netdev_upper_gro_hdrsum(ipv4, tcp);
+          if (((upper->gro_iob->io_pktlen - hdrlen) & 1) != 0)
+            {
+              sum = (sum << 8) | (sum >> 8);
+            }
+
+          upper->gro_sum      = netdev_upper_gro_add(upper->gro_sum, sum);
+          upper->gro_nextseq += paylen;
+          upper->gro_nsegs++;
+
+          memcpy(htcp->wnd, tcp->wnd, sizeof(htcp->wnd));
+          htcp->flags |= tcp->flags;
+
+          netdev_iob_clear(dev);
+          iob_concat(upper->gro_iob, iob_trimhead(iob, hdrlen));
+
+          if ((htcp->flags & TCP_PSH) != 0 ||
+              upper->gro_nsegs >= CONFIG_NETDEV_GRO_MAXSEGS)
+            {
+              netdev_upper_gro_flush(upper, dev);
+            }
+
+          return true;
+        }
+
+      netdev_upper_gro_flush(upper, dev);
+    }
+
+  if ((tcp->flags & TCP_PSH) != 0)
+    {
+      return false;
+    }
+
+  upper->gro_iob     = iob;
+  upper->gro_nextseq = netdev_upper_gro_seq(tcp) + paylen;
+  upper->gro_sum     = ~netdev_upper_gro_hdrsum(ipv4, tcp);
+  upper->gro_nsegs   = 1;
+
+  netdev_iob_clear(dev);
+  return true;
+}
+#endif /* CONFIG_NETDEV_GRO */
+
 /****************************************************************************
  * Function: netdev_upper_rxpoll_work
  *
@@ -732,39 +1064,22 @@ static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
       pkt_input(dev);
 #endif
 
-      switch (dev->d_lltype)
+#ifdef CONFIG_NETDEV_GRO
+      if (netdev_upper_gro_receive(upper, dev))
         {
-#ifdef CONFIG_NET_LOOPBACK
-        case NET_LL_LOOPBACK:
-#endif
-#ifdef CONFIG_NET_ETHERNET
-        case NET_LL_ETHERNET:
-#endif
-#ifdef CONFIG_DRIVERS_IEEE80211
-        case NET_LL_IEEE80211:
-#endif
-#if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
-    defined(CONFIG_DRIVERS_IEEE80211)
-          eth_input(dev);
-          break;
-#endif
-#ifdef CONFIG_NET_MBIM
-        case NET_LL_MBIM:
-          ip_input(dev);
-          break;
-#endif
-#ifdef CONFIG_NET_CAN
-        case NET_LL_CAN:
-          ninfo("CAN frame");
-          can_input(dev);
-          break;
-#endif
-        default:
-          nerr("Unknown link type %d\n", dev->d_lltype);
-          break;
+          continue;
         }
+#endif
+
+      netdev_upper_input(dev);
     }
 
+#ifdef CONFIG_NETDEV_GRO
+  /* The segment coalesced last is not held beyond the batch */
+
+  netdev_upper_gro_flush(upper, dev);
+#endif
+
   netdev_unlock(dev);
 }
 
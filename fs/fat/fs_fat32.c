@@ -27,6 +27,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/param.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <sys/mount.h>
@@ -42,6 +43,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/fat.h>
+#include <nuttx/fs/pagecache.h>
 
 #include "inode/inode.h"
 #include "fs_fat32.h"
@@ -113,6 +115,9 @@ static int     fat_stat_root(FAR struct fat_mountpt_s *fs,
                  FAR struct stat *buf);
 static int     fat_stat(struct inode *mountpt, const char *relpath,
                  FAR struct stat *buf);
+#ifdef CONFIG_FAT_PAGECACHE
+static int     fat_syncfs(FAR struct inode *mountpt);
+#endif
 
 /****************************************************************************
  * Public Data
@@ -156,7 +161,12 @@ const struct mountpt_operations g_fat_operations =
   fat_rmdir,         /* rmdir */
   fat_rename,        /* rename */
   fat_stat,          /* stat */
-  NULL               /* chstat */
+  NULL,              /* chstat */
+#ifdef CONFIG_FAT_PAGECACHE
+  fat_syncfs         /* syncfs */
+#else
+  NULL               /* syncfs */
+#endif
 };
 
 /****************************************************************************
@@ -618,7 +628,28 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
 
       cluster = ff->ff_startcluster;
       num_traversed = 1;
+#ifdef CONFIG_FAT_RUNCACHE
+      fat_ffrunadd(ff, 0, cluster);
+#endif
+    }
+
+#ifdef CONFIG_FAT_RUNCACHE
+  /* Skip the part of the chain known from its runs */
+
+  if (num_traversed > 0 && num_clu > 0)
+    {
+      uint32_t runcluster;
+      uint32_t known;
+
+      known = fat_ffrunfind(ff, MIN(num_clu, new_num_clu) - 1,
+                            &runcluster);
+      if ((int)known > num_traversed)
+        {
+          cluster       = runcluster;
+          num_traversed = known;
+        }
     }
+#endif
 
   /* Traverse the existing chain */
 
@@ -632,6 +663,10 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
         {
           return -EIO;
         }
+
+#ifdef CONFIG_FAT_RUNCACHE
+      fat_ffrunadd(ff, i, cluster);
+#endif
     }
 
   if (read)
@@ -684,6 +719,10 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
           return -EIO;
         }
 
+#ifdef CONFIG_FAT_RUNCACHE
+      fat_ffrunadd(ff, i, cluster);
+#endif
+
       /* zero area (2) */
 
       ret = fat_zero_cluster(fs, cluster, 0, clu_size);
@@ -707,6 +746,10 @@ static int fat_get_sectors(FAR struct file *filep, bool read)
           return -EIO;
         }
 
+#ifdef CONFIG_FAT_RUNCACHE
+      fat_ffrunadd(ff, i, cluster);
+#endif
+
       /* zero area (3) */
 
       zero_end = filep->f_pos & (clu_size -1);
@@ -1492,6 +1535,15 @@ static int fat_sync(FAR struct file *filep)
       ret          = fat_updatefsinfo(fs);
     }
 
+#ifdef CONFIG_FAT_PAGECACHE
+  /* Write back the sectors delayed in the page cache */
+
+  if (ret >= 0)
+    {
+      ret = pagecache_flush(fs->fs_blkdriver);
+    }
+#endif
+
 errout_with_lock:
   nxmutex_unlock(&fs->fs_lock);
   return ret;
@@ -1599,6 +1651,10 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
   newff->ff_startcluster     = oldff->ff_startcluster;     /* Start cluster of file on media */
   newff->ff_currentsector    = oldff->ff_currentsector;    /* Current sector */
   newff->ff_cachesector      = 0;                          /* Sector in file buffer */
+#ifdef CONFIG_FAT_RUNCACHE
+  newff->ff_nextrun          = oldff->ff_nextrun;          /* Run replaced next */
+  memcpy(newff->ff_runs, oldff->ff_runs, sizeof(newff->ff_runs));
+#endif
 
   /* Attach the private date to the struct file instance */
 
@@ -2333,6 +2389,12 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
       FAR struct inode *inode = fs->fs_blkdriver;
       if (inode)
         {
+#ifdef CONFIG_FAT_PAGECACHE
+          /* Write back and drop the sectors of the volume */
+
+          pagecache_invalidate(inode, true);
+#endif
+
           if (inode->u.i_bops && inode->u.i_bops->close)
             {
               inode->u.i_bops->close(inode);
@@ -2358,6 +2420,22 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
       fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
     }
 
+#ifdef CONFIG_FAT_FATCACHE
+  if (fs->fs_fatbuffer)
+    {
+      fat_io_free(fs->fs_fatbuffer,
+                  CONFIG_FAT_FATCACHE_NSECTORS * fs->fs_hwsectorsize);
+    }
+#endif
+
+#ifdef CONFIG_FAT_DIRCACHE
+  if (fs->fs_dircache)
+    {
+      fat_dircacheinvalidate(fs);
+      fs_heap_free(fs->fs_dircache);
+    }
+#endif
+
   nxmutex_destroy(&fs->fs_lock);
   fs_heap_free(fs);
   return OK;
@@ -3092,6 +3170,47 @@ errout_with_lock:
   return ret;
 }
 
+/****************************************************************************
+ * Name: fat_syncfs
+ *
+ * Description: Write back the sector cache, the FSINFO sector and the
+ *   sectors delayed in the page cache.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_PAGECACHE
+static int fat_syncfs(FAR struct inode *mountpt)
+{
+  FAR struct fat_mountpt_s *fs;
+  int ret;
+
+  /* Get the mountpoint private data from the inode structure */
+
+  fs = mountpt->i_private;
+  DEBUGASSERT(fs != NULL);
+
+  ret = nxmutex_lock(&fs->fs_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = fat_checkmount(fs);
+  if (ret == OK)
+    {
+      ret = fat_updatefsinfo(fs);
+    }
+
+  if (ret == OK)
+    {
+      ret = pagecache_flush(fs->fs_blkdriver);
+    }
+
+  nxmutex_unlock(&fs->fs_lock);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -857,12 +857,37 @@
  * Public Types
  ****************************************************************************/
 
+#ifdef CONFIG_FAT_FATCACHE
+/* This structure describes one sector of the FAT table cache */
+
+struct fat_fatcache_s
+{
+  off_t    fc_sector;              /* The FAT sector buffered, -1: unused */
+  uint32_t fc_stamp;               /* Stamp of the last access */
+  bool     fc_dirty;               /* true: The sector must be written back */
+};
+#endif
+
+#ifdef CONFIG_FAT_RUNCACHE
+/* This structure describes a run of contiguous clusters in the cluster
+ * chain of a file.
+ */
+
+struct fat_clusterrun_s
+{
+  uint32_t fr_index;               /* Index of the first cluster in the chain */
+  uint32_t fr_cluster;             /* Number of the first cluster */
+  uint32_t fr_count;               /* Number of clusters, 0: unused */
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a fat32 filesystem.
  */
 
 struct fat_file_s;
+struct fat_dircache_s;
 struct fat_mountpt_s
 {
   FAR struct inode      *fs_blkdriver; /* The block driver inode that hosts the FAT32 fs */
@@ -891,6 +916,18 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one
                                     * sector from the device */
+#ifdef CONFIG_FAT_FATCACHE
+  uint32_t fs_fatstamp;            /* Access stamp of the FAT table cache */
+  uint8_t *fs_fatbuffer;           /* The sectors of the FAT table cache */
+  struct fat_fatcache_s fs_fatcache[CONFIG_FAT_FATCACHE_NSECTORS];
+#endif
+#ifdef CONFIG_FAT_DIRCACHE
+  uint32_t fs_dirstamp;            /* Access stamp of the lookup cache */
+
+  /* The directory lookup cache */
+
+  FAR struct fat_dircache_s *fs_dircache;
+#endif
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -913,6 +950,10 @@ struct fat_file_s
   off_t    ff_cachesector;         /* Current sector in the file buffer */
   off_t    ff_pos;                 /* Current position in the file */
   uint8_t *ff_buffer;              /* File buffer (for partial sector accesses) */
+#ifdef CONFIG_FAT_RUNCACHE
+  uint8_t  ff_nextrun;             /* The run replaced next */
+  struct fat_clusterrun_s ff_runs[CONFIG_FAT_RUNCACHE_NRUNS];
+#endif
 };
 
 /* This structure holds the sequence of directory entries used by one
@@ -1003,6 +1044,19 @@ struct fat_dirinfo_s
   struct fs_fatdir_s dir;          /* Used with opendir, readdir, etc. */
 };
 
+#ifdef CONFIG_FAT_DIRCACHE
+/* This structure describes the directory entry of a path looked up */
+
+struct fat_dircache_s
+{
+  FAR char *dc_path;               /* The path, NULL: unused */
+  uint32_t dc_hash;                /* Hash of the path */
+  uint32_t dc_stamp;               /* Stamp of the last access */
+  struct fat_dirseq_s dc_seq;      /* The directory entries of the path */
+  struct fs_fatdir_s dc_dir;       /* The directory position after them */
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -1074,6 +1128,9 @@ EXTERN int    fat_freedirentry(FAR struct fat_mountpt_s *fs,
 EXTERN int    fat_dirname2path(FAR struct fat_mountpt_s *fs,
                                FAR struct fs_dirent_s *dir,
                                FAR struct dirent *entry);
+#ifdef CONFIG_FAT_DIRCACHE
+EXTERN void   fat_dircacheinvalidate(FAR struct fat_mountpt_s *fs);
+#endif
 
 /* File creation and removal helpers */
 
@@ -1100,6 +1157,26 @@ EXTERN int    fat_ffcacheread(FAR struct fat_mountpt_s *fs,
 EXTERN int    fat_ffcacheinvalidate(FAR struct fat_mountpt_s *fs,
                                     FAR struct fat_file_s *ff);
 
+/* FAT table sector cache */
+
+EXTERN int    fat_fatcacheread(FAR struct fat_mountpt_s *fs, off_t sector,
+                               bool modify, FAR uint8_t **buffer);
+#ifdef CONFIG_FAT_FATCACHE
+EXTERN int    fat_fatcacheflush(FAR struct fat_mountpt_s *fs);
+EXTERN void   fat_fatcacheinvalidate(FAR struct fat_mountpt_s *fs);
+#endif
+
+/* Cluster chain runs of the open files */
+
+#ifdef CONFIG_FAT_RUNCACHE
+EXTERN uint32_t fat_ffrunfind(FAR struct fat_file_s *ff, uint32_t index,
+                              FAR uint32_t *cluster);
+EXTERN void   fat_ffrunadd(FAR struct fat_file_s *ff, uint32_t index,
+                           uint32_t cluster);
+EXTERN void   fat_ffruninvalidate(FAR struct fat_mountpt_s *fs,
+                                  uint32_t startcluster);
+#endif
+
 /* FSINFO sector support */
 
 EXTERN int    fat_updatefsinfo(FAR struct fat_mountpt_s *fs);
@@ -146,6 +146,15 @@ static int fat_putlfname(FAR struct fat_mountpt_s *fs,
 static int fat_putsfdirentry(FAR struct fat_mountpt_s *fs,
                              FAR struct fat_dirinfo_s *dirinfo,
                              uint8_t attributes, uint32_t fattime);
+#ifdef CONFIG_FAT_DIRCACHE
+static uint32_t fat_dircachehash(FAR const char *path);
+static int fat_dircachelookup(FAR struct fat_mountpt_s *fs,
+                              FAR struct fat_dirinfo_s *dirinfo,
+                              FAR const char *path, uint32_t hash);
+static void fat_dircacheadd(FAR struct fat_mountpt_s *fs,
+                            FAR struct fat_dirinfo_s *dirinfo,
+                            FAR const char *path, uint32_t hash);
+#endif
 
 #if defined(CONFIG_FAT_LFN) && defined(CONFIG_FAT_LFN_UTF8)
 static int fat_utf8toucs(FAR const char **str, FAR lfnchar *ucs);
@@ -2519,6 +2528,152 @@ static int fat_putsfdirentry(FAR struct fat_mountpt_s *fs,
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_dircachehash
+ *
+ * Description:
+ *   Return the hash of a path, FNV-1a.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_DIRCACHE
+static uint32_t fat_dircachehash(FAR const char *path)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*path != '\0')
+    {
+      hash = (hash ^ (uint8_t)*path++) * 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: fat_dircachelookup
+ *
+ * Description:
+ *   Look up a path in the directory lookup cache.  On a hit, dirinfo is
+ *   set up and the sector containing the short file name directory entry
+ *   is brought in the cache, as fat_finddirentry() would.
+ *
+ * Returned Value:
+ *   OK on a hit, -ENOENT on a miss, or another negated errno value if the
+ *   directory entry could not be read.
+ *
+ ****************************************************************************/
+
+static int fat_dircachelookup(FAR struct fat_mountpt_s *fs,
+                              FAR struct fat_dirinfo_s *dirinfo,
+                              FAR const char *path, uint32_t hash)
+{
+  FAR struct fat_dircache_s *entry;
+  FAR uint8_t *direntry;
+  char terminator;
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_DIRCACHE_NENTRIES; i++)
+    {
+      entry = &fs->fs_dircache[i];
+      if (entry->dc_path != NULL && entry->dc_hash == hash &&
+          strcmp(entry->dc_path, path) == 0)
+        {
+          break;
+        }
+    }
+
+  if (i == CONFIG_FAT_DIRCACHE_NENTRIES)
+    {
+      return -ENOENT;
+    }
+
+  ret = fat_fscacheread(fs, entry->dc_seq.ds_sector);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* The entries are forgotten when directory entries are freed, but make
+   * sure that this one is still in use.
+   */
+
+  direntry = &fs->fs_buffer[entry->dc_seq.ds_offset];
+  if (direntry[DIR_NAME] == DIR0_EMPTY ||
+      direntry[DIR_NAME] == DIR0_ALLEMPTY)
+    {
+      fs_heap_free(entry->dc_path);
+      entry->dc_path = NULL;
+      return -ENOENT;
+    }
+
+  /* Parse the names of the last path segment into dirinfo */
+
+  do
+    {
+      ret = fat_path2dirname(&path, dirinfo, &terminator);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+  while (terminator != '\0');
+
+  dirinfo->fd_root = false;
+  dirinfo->fd_seq  = entry->dc_seq;
+  dirinfo->dir     = entry->dc_dir;
+  entry->dc_stamp  = ++fs->fs_dirstamp;
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_dircacheadd
+ *
+ * Description:
+ *   Add the directory entry of a path to the directory lookup cache, in
+ *   place of the least recently used one.
+ *
+ ****************************************************************************/
+
+static void fat_dircacheadd(FAR struct fat_mountpt_s *fs,
+                            FAR struct fat_dirinfo_s *dirinfo,
+                            FAR const char *path, uint32_t hash)
+{
+  FAR struct fat_dircache_s *entry = &fs->fs_dircache[0];
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_DIRCACHE_NENTRIES; i++)
+    {
+      if (fs->fs_dircache[i].dc_path == NULL)
+        {
+          entry = &fs->fs_dircache[i];
+          break;
+        }
+
+      if ((uint32_t)(fs->fs_dirstamp - fs->fs_dircache[i].dc_stamp) >
+          (uint32_t)(fs->fs_dirstamp - entry->dc_stamp))
+        {
+          entry = &fs->fs_dircache[i];
+        }
+    }
+
+  if (entry->dc_path != NULL)
+    {
+      fs_heap_free(entry->dc_path);
+    }
+
+  entry->dc_path = fs_heap_strdup(path);
+  if (entry->dc_path != NULL)
+    {
+      entry->dc_hash  = hash;
+      entry->dc_stamp = ++fs->fs_dirstamp;
+      entry->dc_seq   = dirinfo->fd_seq;
+      entry->dc_dir   = dirinfo->dir;
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -2543,6 +2698,10 @@ int fat_finddirentry(FAR struct fat_mountpt_s *fs,
   off_t cluster;
   char terminator;
   int ret;
+#ifdef CONFIG_FAT_DIRCACHE
+  FAR const char *relpath = path;
+  uint32_t hash;
+#endif
 
   /* Initialize to traverse the chain.  Set it to the cluster of the root
    * directory
@@ -2591,6 +2750,17 @@ int fat_finddirentry(FAR struct fat_mountpt_s *fs,
 
   dirinfo->fd_root = false;
 
+#ifdef CONFIG_FAT_DIRCACHE
+  /* Check if the directory entry was looked up recently */
+
+  hash = fat_dircachehash(path);
+  ret  = fat_dircachelookup(fs, dirinfo, path, hash);
+  if (ret != -ENOENT)
+    {
+      return ret;
+    }
+#endif
+
   /* Now loop until the directory entry corresponding to the path is found */
 
   for (; ; )
@@ -2661,6 +2831,9 @@ int fat_finddirentry(FAR struct fat_mountpt_s *fs,
            * directory entry is in dirinfo.
            */
 
+#ifdef CONFIG_FAT_DIRCACHE
+          fat_dircacheadd(fs, dirinfo, relpath, hash);
+#endif
           return OK;
         }
 
@@ -2856,6 +3029,12 @@ int fat_freedirentry(FAR struct fat_mountpt_s *fs, struct fat_dirseq_s *seq)
   off_t startsector;
   int ret;
 
+#ifdef CONFIG_FAT_DIRCACHE
+  /* The paths looked up may lead to the entries freed */
+
+  fat_dircacheinvalidate(fs);
+#endif
+
   /* Set it to the cluster containing the "last" LFN entry (that appears
    * first on the media).
    */
@@ -2920,6 +3099,12 @@ int fat_freedirentry(FAR struct fat_mountpt_s *fs, struct fat_dirseq_s *seq)
   FAR uint8_t *direntry;
   int ret;
 
+#ifdef CONFIG_FAT_DIRCACHE
+  /* The paths looked up may lead to the entry freed */
+
+  fat_dircacheinvalidate(fs);
+#endif
+
   /* Free the single short file name entry.
    *
    * Make sure that the sector containing the directory entry is in the
@@ -3286,3 +3471,27 @@ int fat_remove(FAR struct fat_mountpt_s *fs, FAR const char *relpath,
 
   return OK;
 }
+
+/****************************************************************************
+ * Name: fat_dircacheinvalidate
+ *
+ * Description:
+ *   Forget all of the paths of the directory lookup cache
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_DIRCACHE
+void fat_dircacheinvalidate(FAR struct fat_mountpt_s *fs)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_DIRCACHE_NENTRIES; i++)
+    {
+      if (fs->fs_dircache[i].dc_path != NULL)
+        {
+          fs_heap_free(fs->fs_dircache[i].dc_path);
+          fs->fs_dircache[i].dc_path = NULL;
+        }
+    }
+}
+#endif
@@ -27,6 +27,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/param.h>
 #include <inttypes.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -40,6 +41,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/fat.h>
+#include <nuttx/fs/pagecache.h>
 
 #include "inode/inode.h"
 #include "fs_fat32.h"
@@ -270,6 +272,55 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_fatcachewrite
+ *
+ * Description:
+ *   Write back a sector of the FAT table cache, if it is dirty, to each
+ *   copy of the FAT.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_FATCACHE
+static int fat_fatcachewrite(FAR struct fat_mountpt_s *fs, int index)
+{
+  FAR struct fat_fatcache_s *slot = &fs->fs_fatcache[index];
+  FAR uint8_t *buffer = fs->fs_fatbuffer + index * fs->fs_hwsectorsize;
+  off_t sector = slot->fc_sector;
+  int ret;
+  int i;
+
+  if (slot->fc_dirty)
+    {
+      /* Write the dirty sector */
+
+      ret = fat_hwwrite(fs, buffer, sector, 1);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      /* Then make the change in the FAT copies as well */
+
+      for (i = fs->fs_fatnumfats; i >= 2; i--)
+        {
+          sector += fs->fs_nfatsects;
+          ret = fat_hwwrite(fs, buffer, sector, 1);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+
+      /* No longer dirty */
+
+      slot->fc_dirty = false;
+    }
+
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -520,6 +571,32 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
       goto errout;
     }
 
+#ifdef CONFIG_FAT_FATCACHE
+  /* Allocate the sectors of the FAT table cache */
+
+  fs->fs_fatbuffer = (FAR uint8_t *)
+    fat_io_alloc(CONFIG_FAT_FATCACHE_NSECTORS * fs->fs_hwsectorsize);
+  if (!fs->fs_fatbuffer)
+    {
+      ret = -ENOMEM;
+      goto errout_with_buffer;
+    }
+
+  fat_fatcacheinvalidate(fs);
+#endif
+
+#ifdef CONFIG_FAT_DIRCACHE
+  /* Allocate the directory lookup cache */
+
+  fs->fs_dircache = fs_heap_zalloc(CONFIG_FAT_DIRCACHE_NENTRIES *
+                                   sizeof(struct fat_dircache_s));
+  if (!fs->fs_dircache)
+    {
+      ret = -ENOMEM;
+      goto errout_with_buffer;
+    }
+#endif
+
   /* Search FAT boot record on the drive.  First check the MBR at sector
    * zero.  This could be either the boot record or a partition that refers
    * to the boot record.
@@ -658,6 +735,24 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
+#ifdef CONFIG_FAT_DIRCACHE
+  if (fs->fs_dircache)
+    {
+      fat_dircacheinvalidate(fs);
+      fs_heap_free(fs->fs_dircache);
+      fs->fs_dircache = NULL;
+    }
+#endif
+
+#ifdef CONFIG_FAT_FATCACHE
+  if (fs->fs_fatbuffer)
+    {
+      fat_io_free(fs->fs_fatbuffer,
+                  CONFIG_FAT_FATCACHE_NSECTORS * fs->fs_hwsectorsize);
+      fs->fs_fatbuffer = NULL;
+    }
+#endif
+
   fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
   fs->fs_buffer = NULL;
 
@@ -706,6 +801,19 @@ int fat_checkmount(struct fat_mountpt_s *fs)
       /* If we get here, the mount is NOT healthy */
 
       fs->fs_mounted = false;
+
+#ifdef CONFIG_FAT_FATCACHE
+      fat_fatcacheinvalidate(fs);
+#endif
+#ifdef CONFIG_FAT_DIRCACHE
+      fat_dircacheinvalidate(fs);
+#endif
+
+#ifdef CONFIG_FAT_PAGECACHE
+      /* The cached sectors are those of the old media */
+
+      pagecache_invalidate(fs->fs_blkdriver, false);
+#endif
     }
 
   return -ENODEV;
@@ -728,8 +836,14 @@ int fat_hwread(struct fat_mountpt_s *fs, uint8_t *buffer,  off_t sector,
       struct inode *inode = fs->fs_blkdriver;
       if (inode && inode->u.i_bops && inode->u.i_bops->read)
         {
+#ifdef CONFIG_FAT_PAGECACHE
+          ssize_t nsectorsread = pagecache_read(inode, buffer, sector,
+                                                nsectors,
+                                                fs->fs_hwsectorsize);
+#else
           ssize_t nsectorsread = inode->u.i_bops->read(inode, buffer,
                                                        sector, nsectors);
+#endif
           if (nsectorsread == nsectors)
             {
               ret = OK;
@@ -761,8 +875,14 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
       struct inode *inode = fs->fs_blkdriver;
       if (inode && inode->u.i_bops && inode->u.i_bops->write)
         {
+#ifdef CONFIG_FAT_PAGECACHE
+          ssize_t nsectorswritten =
+              pagecache_write(inode, buffer, sector, nsectors,
+                              fs->fs_hwsectorsize);
+#else
           ssize_t nsectorswritten =
               inode->u.i_bops->write(inode, buffer, sector, nsectors);
+#endif
 
           if (nsectorswritten == nsectors)
             {
@@ -826,6 +946,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
               unsigned int fatoffset;
               unsigned int cluster;
               unsigned int fatindex;
+              FAR uint8_t *buffer;
 
               /* FAT12 is more complex because it has 12-bits (1.5 bytes)
                * per FAT entry. Get the offset to the first byte:
@@ -836,7 +957,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
 
               /* Read the sector at this offset */
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, false, &buffer) < 0)
                 {
                   /* Read error */
 
@@ -846,7 +967,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
               /* Get the first, LS byte of the cluster from the FAT */
 
               fatindex = fatoffset & SEC_NDXMASK(fs);
-              cluster  = fs->fs_buffer[fatindex];
+              cluster  = buffer[fatindex];
 
               /* With FAT12, the second byte of the cluster number may lie in
                * a different sector than the first byte.
@@ -858,7 +979,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
                   fatsector++;
                   fatindex = 0;
 
-                  if (fat_fscacheread(fs, fatsector) < 0)
+                  if (fat_fatcacheread(fs, fatsector, false, &buffer) < 0)
                     {
                       /* Read error */
 
@@ -871,7 +992,7 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
                * on the fact that the byte stream is little-endian.
                */
 
-              cluster |= (unsigned int)fs->fs_buffer[fatindex] << 8;
+              cluster |= (unsigned int)buffer[fatindex] << 8;
 
               /* Now, pick out the correct 12 bit cluster start sector
                * value.
@@ -901,15 +1022,16 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
               off_t        fatsector = fs->fs_fatbase +
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
+              FAR uint8_t *buffer;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, false, &buffer) < 0)
                 {
                   /* Read error */
 
                   break;
                 }
 
-              return FAT_GETFAT16(fs->fs_buffer, fatindex);
+              return FAT_GETFAT16(buffer, fatindex);
             }
 
           case FSTYPE_FAT32 :
@@ -920,15 +1042,16 @@ off_t fat_getcluster(struct fat_mountpt_s *fs, uint32_t clusterno)
               off_t        fatsector = fs->fs_fatbase +
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
+              FAR uint8_t *buffer;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, false, &buffer) < 0)
                 {
                   /* Read error */
 
                   break;
                 }
 
-              return FAT_GETFAT32(fs->fs_buffer, fatindex) & 0x0fffffff;
+              return FAT_GETFAT32(buffer, fatindex) & 0x0fffffff;
             }
 
           default:
@@ -970,6 +1093,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
               unsigned int fatoffset;
               unsigned int fatindex;
               uint8_t      value;
+              FAR uint8_t *buffer;
 
               /* FAT12 is more complex because it has 12-bits (1.5 bytes)
                * per FAT entry. Get the offset to the first byte:
@@ -980,7 +1104,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
 
               /* Make sure that the sector at this offset is in the cache */
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, true, &buffer) < 0)
                 {
                   /* Read error */
 
@@ -996,7 +1120,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                 {
                   /* Save the LS four bits of the next cluster */
 
-                  value = (fs->fs_buffer[fatindex] & 0x0f) |
+                  value = (buffer[fatindex] & 0x0f) |
                            (uint8_t)nextcluster << 4;
                 }
               else
@@ -1006,7 +1130,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                   value = (uint8_t)nextcluster;
                 }
 
-              fs->fs_buffer[fatindex] = value;
+              buffer[fatindex] = value;
 
               /* With FAT12, the second byte of the cluster number may lie in
                * a different sector than the first byte.
@@ -1020,12 +1144,7 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                   fatsector++;
                   fatindex = 0;
 
-                  /* Set the dirty flag to make sure the sector that we
-                   * just modified is written out.
-                   */
-
-                  fs->fs_dirty = true;
-                  if (fat_fscacheread(fs, fatsector) < 0)
+                  if (fat_fatcacheread(fs, fatsector, true, &buffer) < 0)
                     {
                       /* Read error */
 
@@ -1047,11 +1166,11 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                 {
                   /* Save the MS four bits of the next cluster */
 
-                  value = (fs->fs_buffer[fatindex] & 0xf0) |
+                  value = (buffer[fatindex] & 0xf0) |
                           ((nextcluster >> 8) & 0x0f);
                 }
 
-              fs->fs_buffer[fatindex] = value;
+              buffer[fatindex] = value;
             }
           break;
 
@@ -1061,15 +1180,16 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
               off_t        fatsector = fs->fs_fatbase +
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
+              FAR uint8_t *buffer;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, true, &buffer) < 0)
                 {
                   /* Read error */
 
                   break;
                 }
 
-              FAT_PUTFAT16(fs->fs_buffer, fatindex, nextcluster & 0xffff);
+              FAT_PUTFAT16(buffer, fatindex, nextcluster & 0xffff);
             }
           break;
 
@@ -1080,8 +1200,9 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                                        SEC_NSECTORS(fs, fatoffset);
               unsigned int fatindex  = fatoffset & SEC_NDXMASK(fs);
               uint32_t     val;
+              FAR uint8_t *buffer;
 
-              if (fat_fscacheread(fs, fatsector) < 0)
+              if (fat_fatcacheread(fs, fatsector, true, &buffer) < 0)
                 {
                   /* Read error */
 
@@ -1090,8 +1211,8 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
 
               /* Keep the top 4 bits */
 
-              val = FAT_GETFAT32(fs->fs_buffer, fatindex) & 0xf0000000;
-              FAT_PUTFAT32(fs->fs_buffer, fatindex,
+              val = FAT_GETFAT32(buffer, fatindex) & 0xf0000000;
+              FAT_PUTFAT32(buffer, fatindex,
                            val | (nextcluster & 0x0fffffff));
             }
           break;
@@ -1100,9 +1221,8 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
             return -EINVAL;
         }
 
-      /* Mark the modified sector as "dirty" and return success */
+      /* The modified sectors were marked "dirty" as they were read */
 
-      fs->fs_dirty = true;
       return OK;
     }
 
@@ -1445,6 +1565,12 @@ int fat_dirtruncate(struct fat_mountpt_s *fs, FAR uint8_t *direntry)
   startcluster = ((uint32_t)DIR_GETFSTCLUSTHI(direntry) << 16) |
                   DIR_GETFSTCLUSTLO(direntry);
 
+#ifdef CONFIG_FAT_RUNCACHE
+  /* The runs of the chain of the open files are about to be wrong */
+
+  fat_ffruninvalidate(fs, startcluster);
+#endif
+
   /* Clear the cluster start value in the directory and set the file size
    * to zero.  This makes the file look empty but also have to dispose of
    * all of the clusters in the chain.
@@ -1511,6 +1637,12 @@ int fat_dirshrink(struct fat_mountpt_s *fs, FAR uint8_t *direntry,
   lastcluster = ((uint32_t)DIR_GETFSTCLUSTHI(direntry) << 16) |
                  DIR_GETFSTCLUSTLO(direntry);
 
+#ifdef CONFIG_FAT_RUNCACHE
+  /* The runs of the chain of the open files are about to be wrong */
+
+  fat_ffruninvalidate(fs, lastcluster);
+#endif
+
   /* Set the file size to the new length.  */
 
   DIR_PUTFILESIZE(direntry, length);
@@ -1975,6 +2107,259 @@ int fat_ffcacheinvalidate(struct fat_mountpt_s *fs, struct fat_file_s *ff)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_fatcacheread
+ *
+ * Description:
+ *   Get a sector of the FAT table, in the FAT table cache if enabled, or
+ *   in the sector cache otherwise.  The sector is marked dirty if the
+ *   caller is going to modify it.
+ *
+ ****************************************************************************/
+
+int fat_fatcacheread(FAR struct fat_mountpt_s *fs, off_t sector,
+                     bool modify, FAR uint8_t **buffer)
+{
+#ifdef CONFIG_FAT_FATCACHE
+  FAR struct fat_fatcache_s *slot;
+  int lru = 0;
+  int ret;
+  int i;
+
+  /* Look for the sector, and for the least recently used one meanwhile */
+
+  for (i = 0; i < CONFIG_FAT_FATCACHE_NSECTORS; i++)
+    {
+      slot = &fs->fs_fatcache[i];
+      if (slot->fc_sector == sector)
+        {
+          break;
+        }
+
+      if ((uint32_t)(fs->fs_fatstamp - slot->fc_stamp) >
+          (uint32_t)(fs->fs_fatstamp - fs->fs_fatcache[lru].fc_stamp))
+        {
+          lru = i;
+        }
+    }
+
+  if (i == CONFIG_FAT_FATCACHE_NSECTORS)
+    {
+      /* Not cached, replace the least recently used sector */
+
+      i    = lru;
+      slot = &fs->fs_fatcache[i];
+
+      ret = fat_fatcachewrite(fs, i);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      ret = fat_hwread(fs, fs->fs_fatbuffer + i * fs->fs_hwsectorsize,
+                       sector, 1);
+      if (ret < 0)
+        {
+          slot->fc_sector = -1;
+          return ret;
+        }
+
+      slot->fc_sector = sector;
+    }
+
+  slot->fc_stamp = ++fs->fs_fatstamp;
+  if (modify)
+    {
+      slot->fc_dirty = true;
+    }
+
+  *buffer = fs->fs_fatbuffer + i * fs->fs_hwsectorsize;
+#else
+  int ret;
+
+  ret = fat_fscacheread(fs, sector);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (modify)
+    {
+      fs->fs_dirty = true;
+    }
+
+  *buffer = fs->fs_buffer;
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_fatcacheflush
+ *
+ * Description:
+ *   Write back the dirty sectors of the FAT table cache
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FAT_FATCACHE
+int fat_fatcacheflush(FAR struct fat_mountpt_s *fs)
+{
+  int ret;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_FATCACHE_NSECTORS; i++)
+    {
+      ret = fat_fatcachewrite(fs, i);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_fatcacheinvalidate
+ *
+ * Description:
+ *   Discard the content of the FAT table cache, without writing it back
+ *
+ ****************************************************************************/
+
+void fat_fatcacheinvalidate(FAR struct fat_mountpt_s *fs)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_FATCACHE_NSECTORS; i++)
+    {
+      fs->fs_fatcache[i].fc_sector = -1;
+      fs->fs_fatcache[i].fc_stamp  = 0;
+      fs->fs_fatcache[i].fc_dirty  = false;
+    }
+
+  fs->fs_fatstamp = 0;
+}
+#endif
+
+#ifdef CONFIG_FAT_RUNCACHE
+/****************************************************************************
+ * Name: fat_ffrunfind
+ *
+ * Description:
+ *   Find the cluster at the given index of the chain of a file, or the
+ *   last one known before it, from the runs of the chain seen so far.
+ *
+ * Returned Value:
+ *   The index of the cluster found plus one, that is the number of
+ *   clusters of the chain that do not have to be walked, or zero if none
+ *   is known.
+ *
+ ****************************************************************************/
+
+uint32_t fat_ffrunfind(FAR struct fat_file_s *ff, uint32_t index,
+                       FAR uint32_t *cluster)
+{
+  FAR struct fat_clusterrun_s *run;
+  uint32_t known = 0;
+  uint32_t last;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_RUNCACHE_NRUNS; i++)
+    {
+      run = &ff->ff_runs[i];
+      if (run->fr_count == 0 || run->fr_index > index)
+        {
+          continue;
+        }
+
+      last = MIN(index, run->fr_index + run->fr_count - 1);
+      if (last + 1 > known)
+        {
+          known    = last + 1;
+          *cluster = run->fr_cluster + (last - run->fr_index);
+        }
+    }
+
+  return known;
+}
+
+/****************************************************************************
+ * Name: fat_ffrunadd
+ *
+ * Description:
+ *   Record the cluster at the given index of the chain of a file.  It
+ *   extends the run that it follows, or starts a new one in place of the
+ *   oldest.
+ *
+ ****************************************************************************/
+
+void fat_ffrunadd(FAR struct fat_file_s *ff, uint32_t index,
+                  uint32_t cluster)
+{
+  FAR struct fat_clusterrun_s *run;
+  int i;
+
+  for (i = 0; i < CONFIG_FAT_RUNCACHE_NRUNS; i++)
+    {
+      run = &ff->ff_runs[i];
+      if (run->fr_count == 0)
+        {
+          continue;
+        }
+
+      if (index >= run->fr_index && index < run->fr_index + run->fr_count)
+        {
+          /* Already known */
+
+          return;
+        }
+
+      if (index == run->fr_index + run->fr_count &&
+          cluster == run->fr_cluster + run->fr_count)
+        {
+          run->fr_count++;
+          return;
+        }
+    }
+
+  run = &ff->ff_runs[ff->ff_nextrun];
+  run->fr_index   = index;
+  run->fr_cluster = cluster;
+  run->fr_count   = 1;
+
+  if (++ff->ff_nextrun >= CONFIG_FAT_RUNCACHE_NRUNS)
+    {
+      ff->ff_nextrun = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: fat_ffruninvalidate
+ *
+ * Description:
+ *   Forget the runs of the open files whose chain starts with the given
+ *   cluster, when the chain is shortened.
+ *
+ ****************************************************************************/
+
+void fat_ffruninvalidate(FAR struct fat_mountpt_s *fs,
+                         uint32_t startcluster)
+{
+  FAR struct fat_file_s *ff;
+
+  for (ff = fs->fs_head; ff; ff = ff->ff_next)
+    {
+      if (ff->ff_startcluster == startcluster)
+        {
+          memset(ff->ff_runs, 0, sizeof(ff->ff_runs));
+          ff->ff_nextrun = 0;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: fat_updatefsinfo
  *
@@ -1988,9 +2373,16 @@ int fat_updatefsinfo(struct fat_mountpt_s *fs)
 {
   int ret;
 
-  /* Flush the fs_buffer if it is dirty */
+  /* Flush the fs_buffer and the FAT table cache if they are dirty */
 
   ret = fat_fscacheflush(fs);
+#ifdef CONFIG_FAT_FATCACHE
+  if (ret == OK)
+    {
+      ret = fat_fatcacheflush(fs);
+    }
+#endif
+
   if (ret == OK)
     {
       /* The FSINFO sector only has to be update for the case of a FAT32 file
@@ -2061,6 +2453,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
       unsigned int cluster;
       off_t        fatsector;
       unsigned int offset;
+      FAR uint8_t *buffer = NULL;
       int          ret;
 
       fatsector    = fs->fs_fatbase;
@@ -2070,13 +2463,11 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
 
       for (cluster = fs->fs_nclusters; cluster > 0; cluster--)
         {
-          /* If we are starting a new sector, then read the new sector in
-           * fs_buffer
-           */
+          /* If we are starting a new sector, then read the new sector */
 
           if (offset >= fs->fs_hwsectorsize)
             {
-              ret = fat_fscacheread(fs, fatsector);
+              ret = fat_fatcacheread(fs, fatsector, false, &buffer);
               if (ret < 0)
                 {
                   return ret;
@@ -2096,7 +2487,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
 
           if (fs->fs_type == FSTYPE_FAT16)
             {
-              if (FAT_GETFAT16(fs->fs_buffer, offset) == 0)
+              if (FAT_GETFAT16(buffer, offset) == 0)
                 {
                   nfreeclusters++;
                 }
@@ -2105,7 +2496,7 @@ int fat_computefreeclusters(struct fat_mountpt_s *fs)
             }
           else
             {
-              if (FAT_GETFAT32(fs->fs_buffer, offset) == 0)
+              if (FAT_GETFAT32(buffer, offset) == 0)
                 {
                   nfreeclusters++;
                 }
@@ -40,6 +40,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/cancelpt.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/fs/pagecache.h>
 #include <nuttx/mutex.h>
 #include <nuttx/sched.h>
 #include <nuttx/spawn.h>
@@ -979,4 +980,8 @@ int fdlist_close(FAR struct fdlist *list, int fd)
 void sync(void)
 {
   nxsched_foreach(task_fssync, NULL);
+
+#ifdef CONFIG_FS_PAGECACHE
+  pagecache_flush(NULL);
+#endif
 }
@@ -0,0 +1,226 @@
+/****************************************************************************
+ * fs/inode/fs_inodehash.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_PSEUDOFS_HASH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if (CONFIG_PSEUDOFS_HASH_SIZE & (CONFIG_PSEUDOFS_HASH_SIZE - 1)) != 0
+#  error CONFIG_PSEUDOFS_HASH_SIZE must be a power of two
+#endif
+
+#define INODE_HASH_MASK (CONFIG_PSEUDOFS_HASH_SIZE - 1)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The hash buckets, protected by the inode lock */
+
+static FAR struct inode *g_inode_hash[CONFIG_PSEUDOFS_HASH_SIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_hash_bucket
+ *
+ * Description:
+ *   Return the bucket of the path segment name below parent.  The segment
+ *   ends at the '/' delimiter or at the NUL terminator.
+ *
+ ****************************************************************************/
+
+static FAR struct inode **inode_hash_bucket(FAR const struct inode *parent,
+                                            FAR const char *name)
+{
+  uint32_t hash = 2166136261u;
+
+  /* FNV-1a of the name, seeded with the parent address */
+
+  hash = (hash ^ (uint32_t)((uintptr_t)parent >> 4)) * 16777619u;
+  while (*name != '\0' && *name != '/')
+    {
+      hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    }
+
+  return &g_inode_hash[(hash ^ (hash >> 16)) & INODE_HASH_MASK];
+}
+
+/****************************************************************************
+ * Name: inode_hash_match
+ *
+ * Description:
+ *   Return true if the path segment name is the name of inode.
+ *
+ ****************************************************************************/
+
+static bool inode_hash_match(FAR const char *name,
+                             FAR const struct inode *inode)
+{
+  FAR const char *nname = inode->i_name;
+
+  while (*nname != '\0' && *nname == *name)
+    {
+      nname++;
+      name++;
+    }
+
+  return *nname == '\0' && (*name == '\0' || *name == '/');
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_hash_add
+ *
+ * Description:
+ *   Add an inode linked below its parent to the hash table.
+ *
+ * Assumptions:
+ *   The caller holds the inode lock for writing.
+ *
+ ****************************************************************************/
+
+void inode_hash_add(FAR struct inode *inode)
+{
+  FAR struct inode **bucket;
+
+  DEBUGASSERT(inode->i_parent != NULL);
+
+  bucket        = inode_hash_bucket(inode->i_parent, inode->i_name);
+  inode->i_hash = *bucket;
+  *bucket       = inode;
+}
+
+/****************************************************************************
+ * Name: inode_hash_remove
+ *
+ * Description:
+ *   Remove an inode from the hash table.  Nothing is done if the inode is
+ *   not in the hash table.
+ *
+ * Assumptions:
+ *   The caller holds the inode lock for writing.
+ *
+ ****************************************************************************/
+
+void inode_hash_remove(FAR struct inode *inode)
+{
+  FAR struct inode **link;
+
+  if (inode->i_parent == NULL)
+    {
+      return;
+    }
+
+  for (link = inode_hash_bucket(inode->i_parent, inode->i_name);
+       *link != NULL; link = &(*link)->i_hash)
+    {
+      if (*link == inode)
+        {
+          *link         = inode->i_hash;
+          inode->i_hash = NULL;
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: inode_hash_addtree and inode_hash_removetree
+ *
+ * Description:
+ *   Add or remove the inode, its peers and all their descendants.
+ *
+ * Assumptions:
+ *   The caller holds the inode lock for writing.
+ *
+ ****************************************************************************/
+
+void inode_hash_addtree(FAR struct inode *inode)
+{
+  for (; inode != NULL; inode = inode->i_peer)
+    {
+      inode_hash_add(inode);
+      inode_hash_addtree(inode->i_child);
+    }
+}
+
+void inode_hash_removetree(FAR struct inode *inode)
+{
+  for (; inode != NULL; inode = inode->i_peer)
+    {
+      inode_hash_remove(inode);
+      inode_hash_removetree(inode->i_child);
+    }
+}
+
+/****************************************************************************
+ * Name: inode_hash_find
+ *
+ * Description:
+ *   Find the inode of the path segment name below parent.
+ *
+ * Returned Value:
+ *   The inode, or NULL if there is no such inode.
+ *
+ * Assumptions:
+ *   The caller holds the inode lock.
+ *
+ ****************************************************************************/
+
+FAR struct inode *inode_hash_find(FAR const struct inode *parent,
+                                  FAR const char *name)
+{
+  FAR struct inode *inode;
+
+  for (inode = *inode_hash_bucket(parent, name); inode != NULL;
+       inode = inode->i_hash)
+    {
+      if (inode->i_parent == parent && inode_hash_match(name, inode))
+        {
+          break;
+        }
+    }
+
+  return inode;
+}
+
+#endif /* CONFIG_PSEUDOFS_HASH */
@@ -60,6 +60,9 @@ static FAR struct inode *inode_unlink(FAR const char *path)
 {
   struct inode_search_s desc;
   FAR struct inode *inode = NULL;
+#ifdef CONFIG_PSEUDOFS_HASH
+  FAR struct inode **link;
+#endif
   int ret;
 
   /* Verify parameters.  Ignore null paths */
@@ -79,6 +82,34 @@ static FAR struct inode *inode_unlink(FAR const char *path)
       inode = desc.node;
       DEBUGASSERT(inode != NULL);
 
+      /* The parent could be null if we are trying to remove the root
+       * inode. In that case, fail because we cannot remove it.
+       */
+
+      if (desc.parent == NULL)
+        {
+          inode = NULL;
+          goto errout;
+        }
+
+#ifdef CONFIG_PSEUDOFS_HASH
+      /* The peer is not known if the inode was found by the hash, find
+       * the link to the inode in the list of children.
+       */
+
+      for (link = &desc.parent->i_child; *link != inode;
+           link = &(*link)->i_peer)
+        {
+          DEBUGASSERT(*link != NULL);
+        }
+
+      *link = inode->i_peer;
+
+      /* Nothing can be found below an unlinked inode anymore */
+
+      inode_hash_remove(inode);
+      inode_hash_removetree(inode->i_child);
+#else
       /* If peer is non-null, then remove the node from the right of
        * of that peer node.
        */
@@ -92,18 +123,9 @@ static FAR struct inode *inode_unlink(FAR const char *path)
 
       else
         {
-          /* The parent could be null if we are trying to remove the
-           * root inode. In that case, fail because we cannot remove it.
-           */
-
-          if (desc.parent == NULL)
-            {
-              inode = NULL;
-              goto errout;
-            }
-
           desc.parent->i_child = inode->i_peer;
         }
+#endif
 
       inode->i_peer   = NULL;
       inode->i_parent = NULL;
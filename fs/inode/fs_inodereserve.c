@@ -129,6 +129,10 @@ static void inode_insert(FAR struct inode *inode,
       inode->i_parent = parent;
       parent->i_child = inode;
     }
+
+#ifdef CONFIG_PSEUDOFS_HASH
+  inode_hash_add(inode);
+#endif
 }
 
 /****************************************************************************
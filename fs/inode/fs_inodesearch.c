@@ -386,7 +386,19 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
               above = inode;
               left  = NULL;
+#ifdef CONFIG_PSEUDOFS_HASH
+              /* Go directly to the matching child if it is indexed, else
+               * walk the children to find the insertion point.
+               */
+
+              inode = inode_hash_find(above, name);
+              if (inode == NULL)
+                {
+                  inode = above->i_child;
+                }
+#else
               inode = inode->i_child;
+#endif
             }
         }
     }
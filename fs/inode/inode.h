@@ -100,7 +100,9 @@
  *  node     - INPUT:  (not used)
  *             OUTPUT: On success, holds the pointer to the inode found.
  *  peer     - INPUT:  (not used)
- *             OUTPUT: The inode to the "left" of the inode found.
+ *             OUTPUT: The inode to the "left" of the inode found, or of
+ *                     the insertion point if not found.  Not set when the
+ *                     inode is found by the hash (CONFIG_PSEUDOFS_HASH).
  *  parent   - INPUT:  (not used)
  *             OUTPUT: The inode to the "above" of the inode found.
  *  relpath  - INPUT:  (not used)
@@ -388,6 +390,29 @@ int inode_reserve(FAR const char *path,
 
 int inode_remove(FAR const char *path);
 
+/****************************************************************************
+ * Name: inode_hash_add, inode_hash_remove, inode_hash_addtree,
+ *       inode_hash_removetree and inode_hash_find
+ *
+ * Description:
+ *   Maintain and query the hash table indexing the inodes by their parent
+ *   and name.  The tree variants also handle the peers of the inode and
+ *   all their descendants.
+ *
+ * Assumptions/Limitations:
+ *   The caller must hold the inode semaphore (for writing to modify)
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PSEUDOFS_HASH
+void inode_hash_add(FAR struct inode *inode);
+void inode_hash_remove(FAR struct inode *inode);
+void inode_hash_addtree(FAR struct inode *inode);
+void inode_hash_removetree(FAR struct inode *inode);
+FAR struct inode *inode_hash_find(FAR const struct inode *parent,
+                                  FAR const char *name);
+#endif
+
 /****************************************************************************
  * Name: inode_addref
  *
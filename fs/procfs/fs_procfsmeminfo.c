@@ -40,6 +40,7 @@
 #include <debug.h>
 #include <ctype.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/pgalloc.h>
 #include <nuttx/progmem.h>
@@ -106,6 +107,10 @@ static ssize_t memdump_read(FAR struct file *filep, FAR char *buffer,
 static ssize_t memdump_write(FAR struct file *filep, FAR const char *buffer,
                              size_t buflen);
 #endif
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+static ssize_t memstat_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen);
+#endif
 static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
 static int     meminfo_dup(FAR const struct file *oldp,
@@ -153,6 +158,23 @@ const struct procfs_operations g_memdump_operations =
 };
 #endif
 
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+const struct procfs_operations g_memstat_operations =
+{
+  meminfo_open,   /* open */
+  meminfo_close,  /* close */
+  memstat_read,   /* read */
+  NULL,           /* write */
+  NULL,           /* poll */
+  meminfo_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  meminfo_stat    /* stat */
+};
+#endif
+
 static FAR struct procfs_meminfo_entry_s *g_procfs_meminfo = NULL;
 
 /****************************************************************************
@@ -345,6 +367,48 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
         }
     }
 
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  /* Followed by the statistics of the per-CPU chunk caches */
+
+  if (buflen > 0)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%11s%11s%11s%11s%11s%11s%s\n",
+                                   "cached", "nchunks", "hits", "misses",
+                                   "refills", "flushes", " name");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (entry = g_procfs_meminfo; entry != NULL; entry = entry->next)
+    {
+      if (buflen > 0)
+        {
+          struct mm_cacheinfo_s info;
+
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          mm_cacheinfo(entry->heap, &info);
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%11lu%11lu%11lu%11lu%11lu%11lu"
+                                       " %s\n",
+                                       (unsigned long)info.cached,
+                                       (unsigned long)info.nchunks,
+                                       info.hits, info.misses,
+                                       info.refills, info.flushes,
+                                       entry->name);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
 #ifdef CONFIG_MM_PGALLOC
   if (buflen > 0)
     {
@@ -647,6 +711,133 @@ dump:
 }
 #endif
 
+/****************************************************************************
+ * Name: memstat_nsec and memstat_usec
+ *
+ * Description:
+ *   Convert perf counter ticks to nanoseconds or microseconds.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+static unsigned long memstat_nsec(clock_t elapsed)
+{
+  struct timespec ts;
+
+  perf_convert(elapsed, &ts);
+  return ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static unsigned long memstat_usec(clock_t elapsed)
+{
+  struct timespec ts;
+
+  perf_convert(elapsed, &ts);
+  return ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+
+/****************************************************************************
+ * Name: memstat_read
+ *
+ * Description:
+ *   Show the telemetry of every heap: one summary line with the heap mutex
+ *   contention and the p50/p99 allocation latency (the upper bound of the
+ *   latency class), followed by one line per non-empty size class with the
+ *   allocations, frees and free chunks of [size, 2 * size) bytes.
+ *
+ ****************************************************************************/
+
+static ssize_t memstat_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR const struct procfs_meminfo_entry_s *entry;
+  FAR struct meminfo_file_s *procfile;
+  FAR struct mm_telemetryinfo_s *info;
+  FAR struct mm_telemetry_s *total;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize = 0;
+  off_t offset;
+  int ndx;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct meminfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  info = fs_heap_malloc(sizeof(struct mm_telemetryinfo_s));
+  if (info == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  total = &info->total;
+
+  for (entry = g_procfs_meminfo; entry != NULL && buflen > 0;
+       entry = entry->next)
+    {
+      mm_telemetry(entry->heap, info);
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%s: nlocks %lu ncontended %lu "
+                                   "wait %luus p50 %luns p99 %luns\n",
+                                   entry->name, total->nlocks,
+                                   total->ncontended,
+                                   memstat_usec(total->waittime),
+                                   memstat_nsec(
+                                     mm_telemetry_latency(total, 50)),
+                                   memstat_nsec(
+                                     mm_telemetry_latency(total, 99)));
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                   "%11s%11s%11s%11s\n", "size", "nalloc",
+                                   "nfree", "nchunks");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      for (ndx = 0; ndx < MM_TELEMETRY_NCLASSES && buflen > 0; ndx++)
+        {
+          if (total->nalloc[ndx] == 0 && total->nfree[ndx] == 0 &&
+              info->nchunks[ndx] == 0)
+            {
+              continue;
+            }
+
+          linesize   = procfs_snprintf(procfile->line, MEMINFO_LINELEN,
+                                       "%11lu%11lu%11lu%11lu\n",
+                                       1ul << ndx, total->nalloc[ndx],
+                                       total->nfree[ndx],
+                                       info->nchunks[ndx]);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     buflen, &offset);
+          totalsize += copysize;
+          buffer    += copysize;
+          buflen    -= copysize;
+        }
+    }
+
+  fs_heap_free(info);
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: meminfo_dup
  *
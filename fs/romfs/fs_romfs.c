@@ -42,6 +42,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/fs/pagecache.h>
 
 #include "fs_romfs.h"
 #include "fs_heap.h"
@@ -1156,6 +1157,10 @@ errout_with_mount:
   fs_heap_free(rm);
 
 errout:
+#ifdef CONFIG_FS_ROMFS_PAGECACHE
+  pagecache_invalidate(blkdriver, false);
+#endif
+
   if (blkdriver->u.i_bops->close != NULL)
     {
       blkdriver->u.i_bops->close(blkdriver);
@@ -1217,6 +1222,12 @@ static int romfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
           FAR struct inode *inode = rm->rm_blkdriver;
           if (inode)
             {
+#ifdef CONFIG_FS_ROMFS_PAGECACHE
+              /* The image may be rewritten once unmounted */
+
+              pagecache_invalidate(inode, false);
+#endif
+
               if (INODE_IS_BLOCK(inode) && inode->u.i_bops->close != NULL)
                 {
                   inode->u.i_bops->close(inode);
@@ -38,6 +38,7 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/fs/pagecache.h>
 
 #include "fs_romfs.h"
 #include "fs_heap.h"
@@ -539,8 +540,14 @@ int romfs_hwread(FAR struct romfs_mountpt_s *rm, FAR uint8_t *buffer,
       /* In non-XIP mode, we have to read the data from the device */
 
       FAR struct inode *inode = rm->rm_blkdriver;
+#ifdef CONFIG_FS_ROMFS_PAGECACHE
+      ssize_t nsectorsread =
+        pagecache_read(inode, buffer, sector, nsectors,
+                       rm->rm_hwsectorsize);
+#else
       ssize_t nsectorsread =
         inode->u.i_bops->read(inode, buffer, sector, nsectors);
+#endif
 
       if (nsectorsread < 0)
         {
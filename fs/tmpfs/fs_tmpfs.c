@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <stdint.h>
@@ -58,6 +59,17 @@
 #  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+#  if (CONFIG_FS_TMPFS_PAGESIZE & (CONFIG_FS_TMPFS_PAGESIZE - 1)) != 0
+#    error CONFIG_FS_TMPFS_PAGESIZE must be a power of two
+#  endif
+
+#  define TMPFS_PAGESIZE      CONFIG_FS_TMPFS_PAGESIZE
+#  define TMPFS_NPAGES(size)  (((size) + TMPFS_PAGESIZE - 1) / TMPFS_PAGESIZE)
+#else
+#  define tmpfs_free_data(tfo) fs_heap_free((tfo)->tfo_data)
+#endif
+
 #define tmpfs_lock(fs) \
            nxrmutex_lock(&fs->tfs_lock)
 #define tmpfs_lock_object(to) \
@@ -96,6 +108,17 @@ static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
               unsigned int nentries);
 static int  tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
               size_t newsize);
+#ifdef CONFIG_FS_TMPFS_PAGED
+static void tmpfs_free_page(FAR struct tmpfs_file_s *tfo, size_t index);
+static void tmpfs_free_data(FAR struct tmpfs_file_s *tfo);
+static int  tmpfs_grow_pages(FAR struct tmpfs_file_s *tfo, size_t npages);
+static void tmpfs_read_pages(FAR struct tmpfs_file_s *tfo,
+              FAR char *buffer, off_t pos, size_t len);
+static ssize_t tmpfs_write_pages(FAR struct tmpfs_file_s *tfo,
+              FAR const char *buffer, off_t pos, size_t len);
+static int  tmpfs_map_pages(FAR struct tmpfs_file_s *tfo, off_t offset,
+              size_t length, FAR void **vaddr);
+#endif
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
 static int  tmpfs_release_file(FAR struct tmpfs_file_s *tfo);
@@ -268,6 +291,349 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
   return ret;
 }
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+/****************************************************************************
+ * Name: tmpfs_free_page
+ *
+ * Description:
+ *   Free a page of the file, unless it is part of the base extent.
+ *
+ ****************************************************************************/
+
+static void tmpfs_free_page(FAR struct tmpfs_file_s *tfo, size_t index)
+{
+  if (index >= tfo->tfo_nbase && tfo->tfo_pages[index] != NULL)
+    {
+      fs_heap_free(tfo->tfo_pages[index]);
+      tfo->tfo_pages[index] = NULL;
+      tfo->tfo_alloc -= TMPFS_PAGESIZE;
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_free_data
+ ****************************************************************************/
+
+static void tmpfs_free_data(FAR struct tmpfs_file_s *tfo)
+{
+  size_t i;
+
+  for (i = tfo->tfo_nbase; i < tfo->tfo_nslot; i++)
+    {
+      tmpfs_free_page(tfo, i);
+    }
+
+  fs_heap_free(tfo->tfo_base);
+  fs_heap_free(tfo->tfo_pages);
+
+  tfo->tfo_base   = NULL;
+  tfo->tfo_pages  = NULL;
+  tfo->tfo_nbase  = 0;
+  tfo->tfo_nslot  = 0;
+  tfo->tfo_alloc  = 0;
+  tfo->tfo_size   = 0;
+}
+
+/****************************************************************************
+ * Name: tmpfs_grow_pages
+ *
+ * Description:
+ *   Make room for npages pages in the page table.  The table at least
+ *   doubles, so that appending to a file takes amortized constant time and
+ *   never moves the file data.
+ *
+ ****************************************************************************/
+
+static int tmpfs_grow_pages(FAR struct tmpfs_file_s *tfo, size_t npages)
+{
+  FAR uint8_t **newpages;
+  size_t newsize;
+
+  if (npages <= tfo->tfo_nslot)
+    {
+      return OK;
+    }
+
+  newsize = MAX(npages, 2 * tfo->tfo_nslot);
+  if (newsize > SIZE_MAX / sizeof(FAR uint8_t *))
+    {
+      /* There would be an integer overflow */
+
+      return -ENOMEM;
+    }
+
+  newpages = fs_heap_realloc(tfo->tfo_pages,
+                             newsize * sizeof(FAR uint8_t *));
+  if (newpages == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* The new pages are holes until written */
+
+  memset(&newpages[tfo->tfo_nslot], 0,
+         (newsize - tfo->tfo_nslot) * sizeof(FAR uint8_t *));
+
+  tfo->tfo_pages  = newpages;
+  tfo->tfo_nslot  = newsize;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_realloc_file
+ ****************************************************************************/
+
+static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
+                              size_t newsize)
+{
+  size_t npages = TMPFS_NPAGES(newsize);
+  size_t offset;
+  size_t i;
+  int ret;
+
+  /* Growing ... The new part of the file is a hole, no page is allocated
+   * until it is written.
+   */
+
+  if (newsize > tfo->tfo_size)
+    {
+      ret = tmpfs_grow_pages(tfo, npages);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      tfo->tfo_size = newsize;
+      return OK;
+    }
+
+  /* Shrinking ... Free everything if the size is shrinking to zero, unless
+   * the file is mapped.
+   */
+
+  if (newsize == 0 && tfo->tfo_nmaps == 0)
+    {
+      tmpfs_free_data(tfo);
+      return OK;
+    }
+
+  /* Otherwise free the pages past the end of the file.  The base extent,
+   * and any page while the file is mapped, are kept, but cleared.
+   */
+
+  for (i = npages; i < TMPFS_NPAGES(tfo->tfo_size); i++)
+    {
+      if (i >= tfo->tfo_nbase && tfo->tfo_nmaps == 0)
+        {
+          tmpfs_free_page(tfo, i);
+        }
+      else if (tfo->tfo_pages[i] != NULL)
+        {
+          memset(tfo->tfo_pages[i], 0, TMPFS_PAGESIZE);
+        }
+    }
+
+  /* And clear the end of the last page */
+
+  offset = newsize % TMPFS_PAGESIZE;
+  if (offset != 0 && tfo->tfo_pages[npages - 1] != NULL)
+    {
+      memset(tfo->tfo_pages[npages - 1] + offset, 0,
+             TMPFS_PAGESIZE - offset);
+    }
+
+  tfo->tfo_size = newsize;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_read_pages
+ ****************************************************************************/
+
+static void tmpfs_read_pages(FAR struct tmpfs_file_s *tfo,
+                             FAR char *buffer, off_t pos, size_t len)
+{
+  FAR uint8_t *page;
+  size_t offset;
+  size_t n;
+
+  while (len > 0)
+    {
+      page   = tfo->tfo_pages[pos / TMPFS_PAGESIZE];
+      offset = pos % TMPFS_PAGESIZE;
+      n      = MIN(len, TMPFS_PAGESIZE - offset);
+
+      /* Holes read as zeroes */
+
+      if (page != NULL)
+        {
+          memcpy(buffer, page + offset, n);
+        }
+      else
+        {
+          memset(buffer, 0, n);
+        }
+
+      buffer += n;
+      pos    += n;
+      len    -= n;
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_write_pages
+ *
+ * Description:
+ *   Write len bytes at pos, allocating the pages written for the first
+ *   time.  The size of the file is not updated.
+ *
+ * Returned Value:
+ *   The number of bytes written, or -ENOMEM if none could be.
+ *
+ ****************************************************************************/
+
+static ssize_t tmpfs_write_pages(FAR struct tmpfs_file_s *tfo,
+                                 FAR const char *buffer, off_t pos,
+                                 size_t len)
+{
+  FAR uint8_t *page;
+  size_t nwritten = 0;
+  size_t index;
+  size_t offset;
+  size_t n;
+  int ret;
+
+  ret = tmpfs_grow_pages(tfo, TMPFS_NPAGES((size_t)pos + len));
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  while (nwritten < len)
+    {
+      index  = pos / TMPFS_PAGESIZE;
+      offset = pos % TMPFS_PAGESIZE;
+      n      = MIN(len - nwritten, TMPFS_PAGESIZE - offset);
+
+      page = tfo->tfo_pages[index];
+      if (page == NULL)
+        {
+          /* Only the part of a new page not written needs to be cleared */
+
+          if (n < TMPFS_PAGESIZE)
+            {
+              page = fs_heap_zalloc(TMPFS_PAGESIZE);
+            }
+          else
+            {
+              page = fs_heap_malloc(TMPFS_PAGESIZE);
+            }
+
+          if (page == NULL)
+            {
+              break;
+            }
+
+          tfo->tfo_pages[index] = page;
+          tfo->tfo_alloc       += TMPFS_PAGESIZE;
+        }
+
+      memcpy(page + offset, buffer + nwritten, n);
+      nwritten += n;
+      pos      += n;
+    }
+
+  return nwritten > 0 || len == 0 ? (ssize_t)nwritten : -ENOMEM;
+}
+
+/****************************************************************************
+ * Name: tmpfs_map_pages
+ *
+ * Description:
+ *   Return the address of length bytes of the file at offset, which must be
+ *   contiguous.  A range spanning several pages past the base extent is
+ *   made contiguous by moving the start of the file, up to the end of the
+ *   range, into a new base extent.
+ *
+ * Returned Value:
+ *   Zero on success.  -EBUSY if the base extent would have to move but is
+ *   mapped, -ENOMEM if the memory could not be allocated.
+ *
+ ****************************************************************************/
+
+static int tmpfs_map_pages(FAR struct tmpfs_file_s *tfo, off_t offset,
+                           size_t length, FAR void **vaddr)
+{
+  FAR uint8_t *base;
+  size_t first = offset / TMPFS_PAGESIZE;
+  size_t last = (offset + length - 1) / TMPFS_PAGESIZE;
+  size_t i;
+
+  /* Is the range already contiguous? */
+
+  if (last < tfo->tfo_nbase)
+    {
+      *vaddr = tfo->tfo_base + offset;
+      return OK;
+    }
+
+  if (first == last)
+    {
+      if (tfo->tfo_pages[first] == NULL)
+        {
+          tfo->tfo_pages[first] = fs_heap_zalloc(TMPFS_PAGESIZE);
+          if (tfo->tfo_pages[first] == NULL)
+            {
+              return -ENOMEM;
+            }
+
+          tfo->tfo_alloc += TMPFS_PAGESIZE;
+        }
+
+      *vaddr = tfo->tfo_pages[first] + offset % TMPFS_PAGESIZE;
+      return OK;
+    }
+
+  /* No.. Build a new base extent, unless the current one is mapped */
+
+  if (tfo->tfo_nmaps > 0)
+    {
+      return -EBUSY;
+    }
+
+  base = fs_heap_malloc((last + 1) * TMPFS_PAGESIZE);
+  if (base == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i <= last; i++)
+    {
+      if (tfo->tfo_pages[i] != NULL)
+        {
+          memcpy(base + i * TMPFS_PAGESIZE, tfo->tfo_pages[i],
+                 TMPFS_PAGESIZE);
+        }
+      else
+        {
+          memset(base + i * TMPFS_PAGESIZE, 0, TMPFS_PAGESIZE);
+        }
+
+      tmpfs_free_page(tfo, i);
+      tfo->tfo_pages[i] = base + i * TMPFS_PAGESIZE;
+    }
+
+  fs_heap_free(tfo->tfo_base);
+
+  tfo->tfo_alloc += (last + 1 - tfo->tfo_nbase) * TMPFS_PAGESIZE;
+  tfo->tfo_base   = base;
+  tfo->tfo_nbase  = last + 1;
+
+  *vaddr = base + offset;
+  return OK;
+}
+
+#else
 /****************************************************************************
  * Name: tmpfs_realloc_file
  ****************************************************************************/
@@ -345,6 +711,7 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
   tfo->tfo_data  = newdata;
   return OK;
 }
+#endif
 
 /****************************************************************************
  * Name: tmpfs_release_lockedobject
@@ -383,7 +750,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
     {
       tmpfs_unlock_file(tfo);
       nxrmutex_destroy(&tfo->tfo_lock);
-      fs_heap_free(tfo->tfo_data);
+      tmpfs_free_data(tfo);
       fs_heap_free(tfo);
     }
 
@@ -582,7 +949,9 @@ tmpfs_alloc_file(FAR struct tmpfs_directory_s *parent)
   tfo->tfo_parent = parent;
   tfo->tfo_flags  = 0;
   tfo->tfo_size   = 0;
+#ifndef CONFIG_FS_TMPFS_PAGED
   tfo->tfo_data   = NULL;
+#endif
 
   nxrmutex_init(&tfo->tfo_lock);
   tmpfs_lock_file(tfo);
@@ -1189,7 +1558,18 @@ static int tmpfs_statfs_callout(FAR struct tmpfs_directory_s *tdo,
 
       tmptfo             = (FAR struct tmpfs_file_s *)to;
       tmpbuf->tsf_alloc += sizeof(struct tmpfs_file_s);
+#ifdef CONFIG_FS_TMPFS_PAGED
+      tmpbuf->tsf_alloc += tmptfo->tfo_nslot * sizeof(FAR uint8_t *);
+
+      /* The holes of a sparse file use no memory */
+
+      if (to->to_alloc > tmptfo->tfo_size)
+        {
+          tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+        }
+#else
       tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+#endif
       tmpbuf->tsf_files++;
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
@@ -1265,7 +1645,7 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
           return TMPFS_UNLINKED;
         }
 
-      fs_heap_free(tfo->tfo_data);
+      tmpfs_free_data(tfo);
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
     {
@@ -1586,6 +1966,10 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Copy data from the memory object to the user buffer */
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+  tmpfs_read_pages(tfo, buffer, startpos, nread);
+  filep->f_pos += nread;
+#else
   if (tfo->tfo_data != NULL)
     {
       memcpy(buffer, &tfo->tfo_data[startpos], nread);
@@ -1595,6 +1979,7 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
     {
       DEBUGASSERT(tfo->tfo_size == 0 && nread == 0);
     }
+#endif
 
   /* Release the lock on the file */
 
@@ -1642,6 +2027,22 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
       startpos = filep->f_pos;
     }
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+  /* Copy data to the pages of the file, which are allocated as needed */
+
+  nwritten = tmpfs_write_pages(tfo, buffer, startpos, buflen);
+  if (nwritten < 0)
+    {
+      ret = nwritten;
+      goto errout_with_lock;
+    }
+
+  endpos = startpos + nwritten;
+  if (endpos > tfo->tfo_size)
+    {
+      tfo->tfo_size = endpos;
+    }
+#else
   nwritten = buflen;
   endpos   = startpos + buflen;
 
@@ -1666,6 +2067,7 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
     {
       DEBUGASSERT(tfo->tfo_size == 0 && nwritten == 0);
     }
+#endif
 
   filep->f_pos = endpos;
 
@@ -1753,7 +2155,16 @@ static int tmpfs_unmap(FAR struct task_group_s *group,
       ret = mm_map_remove(get_group_mm(group), entry);
       if (ret >= 0)
         {
+#ifdef CONFIG_FS_TMPFS_PAGED
+          ret = tmpfs_lock_file(tfo);
+          if (ret >= 0)
+            {
+              tfo->tfo_nmaps--;
+              tmpfs_release_lockedfile(tfo);
+            }
+#else
           ret = tmpfs_release_file(tfo);
+#endif
         }
     }
 
@@ -1788,17 +2199,48 @@ static int tmpfs_mmap(FAR struct file *filep, FAR struct mm_map_entry_s *map)
   if (map->offset >= 0 && map->offset < tfo->tfo_size &&
       map->length && map->offset + map->length <= tfo->tfo_size)
     {
+#ifdef CONFIG_FS_TMPFS_PAGED
+      /* Map the pages in place.  If they cannot be made contiguous, let
+       * mmap() fall back to a copy of the file.
+       */
+
+      ret = tmpfs_lock_file(tfo);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      ret = tmpfs_map_pages(tfo, map->offset, map->length, &map->vaddr);
+      if (ret >= 0)
+        {
+          tfo->tfo_nmaps++;
+        }
+
+      tmpfs_unlock_file(tfo);
+      if (ret < 0)
+        {
+          return ret == -EBUSY ? -ENOTTY : ret;
+        }
+#else
       map->vaddr = tfo->tfo_data + map->offset;
+#endif
       map->priv.p = tfo;
       map->munmap = tmpfs_unmap;
       ret = mm_map_add(get_current_mm(), map);
 
+      tmpfs_lock_file(tfo);
       if (ret >= 0)
         {
-          tmpfs_lock_file(tfo);
           tfo->tfo_refs++;
-          tmpfs_unlock_file(tfo);
         }
+#ifdef CONFIG_FS_TMPFS_PAGED
+      else
+        {
+          tfo->tfo_nmaps--;
+        }
+#endif
+
+      tmpfs_unlock_file(tfo);
     }
 
   return ret;
@@ -1841,8 +2283,40 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
   else if (cmd == FIOC_XIPBASE)
     {
       FAR uintptr_t *ptr = (FAR uintptr_t *)arg;
+#ifdef CONFIG_FS_TMPFS_PAGED
+      FAR void *base = NULL;
+
+      /* The whole file must be contiguous, move it into the base extent.
+       * The caller keeps using the address with no way to release it, so
+       * the file data stays mapped until the file is destroyed.
+       */
+
+      ret = tmpfs_lock_file(tfo);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      if (tfo->tfo_size > 0)
+        {
+          ret = tmpfs_map_pages(tfo, 0, tfo->tfo_size, &base);
+          if (ret >= 0 && (tfo->tfo_flags & TFO_FLAG_XIPBASE) == 0)
+            {
+              tfo->tfo_flags |= TFO_FLAG_XIPBASE;
+              tfo->tfo_nmaps++;
+            }
+        }
+
+      tmpfs_unlock_file(tfo);
+      if (ret < 0)
+        {
+          return ret == -EBUSY ? -ENOTTY : ret;
+        }
 
+      *ptr = (uintptr_t)base;
+#else
       *ptr = (uintptr_t)tfo->tfo_data;
+#endif
       return OK;
     }
 
@@ -1976,14 +2450,16 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
           goto errout_with_lock;
         }
 
+#ifndef CONFIG_FS_TMPFS_PAGED
       /* If the size has increased, then we need to zero the newly added
-       * memory.
+       * memory.  The paged storage leaves a hole instead.
        */
 
       if (length > oldsize)
         {
           memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
         }
+#endif
 
       ret = OK;
     }
@@ -2430,7 +2906,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   else
     {
       nxrmutex_destroy(&tfo->tfo_lock);
-      fs_heap_free(tfo->tfo_data);
+      tmpfs_free_data(tfo);
       fs_heap_free(tfo);
     }
 
@@ -2796,6 +3272,16 @@ static void tmpfs_stat_common(FAR struct tmpfs_object_s *to,
   buf->st_blksize = CONFIG_FS_TMPFS_BLOCKSIZE;
   buf->st_blocks  = (objsize + CONFIG_FS_TMPFS_BLOCKSIZE - 1) /
                     CONFIG_FS_TMPFS_BLOCKSIZE;
+
+#ifdef CONFIG_FS_TMPFS_PAGED
+  /* Only the pages written use memory, not the holes */
+
+  if (to->to_type == TMPFS_REGULAR)
+    {
+      buf->st_blocks = (to->to_alloc + CONFIG_FS_TMPFS_BLOCKSIZE - 1) /
+                       CONFIG_FS_TMPFS_BLOCKSIZE;
+    }
+#endif
 }
 
 /****************************************************************************
@@ -41,6 +41,7 @@
 /* Bit definitions for file object flags */
 
 #define TFO_FLAG_UNLINKED (1 << 0)  /* Bit 0: File is unlinked */
+#define TFO_FLAG_XIPBASE  (1 << 1)  /* Bit 1: File data address returned */
 
 /****************************************************************************
  * Public Types
@@ -111,6 +112,13 @@ struct tmpfs_directory_s
  * state.  The file memory object also serves as the open file object,
  * saving an allocation.  This has the negative side effect that no per-
  * open state can be retained (such as open flags).
+ *
+ * With CONFIG_FS_TMPFS_PAGED, the file data is held in pages of
+ * CONFIG_FS_TMPFS_PAGESIZE bytes, allocated when written.  The first
+ * tfo_nbase pages are carved out of the single allocation tfo_base, built
+ * when a range of several pages is mapped.  The bytes of a page past the
+ * end of the file are always zero.  No page is freed or moved while the
+ * file data is mapped.
  */
 
 struct tmpfs_file_s
@@ -128,7 +136,15 @@ struct tmpfs_file_s
 
   uint8_t       tfo_flags; /* See TFO_FLAG_* definitions */
   size_t        tfo_size;  /* Valid file size */
+#ifdef CONFIG_FS_TMPFS_PAGED
+  size_t        tfo_nmaps; /* Number of mappings of the file data */
+  size_t        tfo_nslot; /* Number of slots in tfo_pages */
+  size_t        tfo_nbase; /* Number of pages held in tfo_base */
+  FAR uint8_t  *tfo_base;  /* Contiguous extent of the first pages */
+  FAR uint8_t **tfo_pages; /* File data pages, NULL for holes */
+#else
   FAR uint8_t  *tfo_data;  /* File data starts here */
+#endif
 };
 
 /* This structure represents one instance of a TMPFS file system */
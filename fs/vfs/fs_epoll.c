@@ -38,24 +38,45 @@
 #include <nuttx/nuttx.h>
 #include <nuttx/clock.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/hashtable.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/list.h>
 #include <nuttx/mutex.h>
+#include <nuttx/queue.h>
 #include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/tls.h>
 
 #include "inode/inode.h"
 #include "fs_heap.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The list an epoll node is on */
+
+#define EPOLL_NODE_FREE     0 /* Not used */
+#define EPOLL_NODE_SETUP    1 /* Polled, may be on the ready list */
+#define EPOLL_NODE_TEARDOWN 2 /* To be polled again by epoll_wait() */
+#define EPOLL_NODE_ONESHOT  3 /* Reported, disabled until epoll_ctl() */
+
+/* The events that can be combined with EPOLLEXCLUSIVE */
+
+#define EPOLL_EXCLUSIVE_OK  (EPOLLIN | EPOLLOUT | EPOLLERR | EPOLLHUP | \
+                             EPOLLWAKEUP | EPOLLET | EPOLLEXCLUSIVE)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
 struct epoll_node_s
 {
-  struct list_node         node;
+  struct list_node         node;   /* Entry of the list of the state */
+  struct list_node         rnode;  /* Entry of the ready list */
+  dq_entry_t               hnode;  /* Entry of the fd hash bucket */
   epoll_data_t             data;
-  bool                     notified;
+  uint8_t                  state;  /* See EPOLL_NODE_* definitions */
   struct pollfd            pfd;
   FAR struct file         *filep;
   FAR struct epoll_head_s *eph;
@@ -90,6 +111,15 @@ struct epoll_head_s
                                    * first node, used to free the malloced
                                    * memory in epoll_do_close().
                                    */
+  struct list_node      ready;    /* The ready list, store the setup epoll
+                                   * nodes notified by the poll callback, so
+                                   * that epoll_wait only visits them.
+                                   */
+  spinlock_t            rlock;    /* Protect the ready list, the poll
+                                   * callback may run in interrupt context.
+                                   */
+  FAR dq_queue_t       *hash;     /* The epoll nodes in use by fd */
+  uint8_t               hashbits; /* log2 of the number of hash buckets */
 };
 
 typedef struct epoll_head_s epoll_head_t;
@@ -164,6 +194,177 @@ static FAR epoll_head_t *epoll_head_from_fd(int fd, FAR struct file **filep)
   return (*filep)->f_priv;
 }
 
+/****************************************************************************
+ * Name: epoll_hash_alloc
+ *
+ * Description:
+ *   Allocate the fd hash buckets for size epoll nodes, one per node, and
+ *   move the nodes of the current buckets, if any, to them.
+ *
+ * Returned Value:
+ *   Zero on success, -ENOMEM if the buckets could not be allocated.
+ *
+ ****************************************************************************/
+
+static int epoll_hash_alloc(FAR epoll_head_t *eph, int size)
+{
+  FAR dq_queue_t *hash;
+  FAR epoll_node_t *epn;
+  FAR dq_entry_t *entry;
+  uint8_t bits = 1;
+  int i;
+
+  while ((1 << bits) < size)
+    {
+      bits++;
+    }
+
+  if (eph->hash != NULL && bits <= eph->hashbits)
+    {
+      return OK;
+    }
+
+  hash = fs_heap_malloc(sizeof(dq_queue_t) << bits);
+  if (hash == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < (1 << bits); i++)
+    {
+      dq_init(&hash[i]);
+    }
+
+  if (eph->hash != NULL)
+    {
+      for (i = 0; i < (1 << eph->hashbits); i++)
+        {
+          while ((entry = dq_remfirst(&eph->hash[i])) != NULL)
+            {
+              epn = container_of(entry, epoll_node_t, hnode);
+              dq_addfirst(entry, &hash[HASH(epn->pfd.fd, bits)]);
+            }
+        }
+
+      fs_heap_free(eph->hash);
+    }
+
+  eph->hash     = hash;
+  eph->hashbits = bits;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: epoll_find
+ *
+ * Description:
+ *   Find the epoll node of the fd, or return NULL if the fd was not added.
+ *
+ ****************************************************************************/
+
+static FAR epoll_node_t *epoll_find(FAR epoll_head_t *eph, int fd)
+{
+  FAR epoll_node_t *epn;
+  FAR dq_entry_t *entry;
+
+  sq_for_every(&eph->hash[HASH(fd, eph->hashbits)], entry)
+    {
+      epn = container_of(entry, epoll_node_t, hnode);
+      if (epn->pfd.fd == fd)
+        {
+          return epn;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: epoll_move
+ *
+ * Description:
+ *   Move the epoll node to the list of the state, and add it to or remove
+ *   it from the fd hash as it starts or stops being used.
+ *
+ ****************************************************************************/
+
+static void epoll_move(FAR epoll_head_t *eph, FAR epoll_node_t *epn,
+                       uint8_t state)
+{
+  FAR dq_queue_t *bucket = &eph->hash[HASH(epn->pfd.fd, eph->hashbits)];
+  FAR struct list_node *list;
+
+  switch (state)
+    {
+      case EPOLL_NODE_SETUP:
+        list = &eph->setup;
+        break;
+
+      case EPOLL_NODE_TEARDOWN:
+        list = &eph->teardown;
+        break;
+
+      case EPOLL_NODE_ONESHOT:
+        list = &eph->oneshot;
+        break;
+
+      default:
+        list = &eph->free;
+        break;
+    }
+
+  if (epn->state == EPOLL_NODE_FREE && state != EPOLL_NODE_FREE)
+    {
+      dq_addfirst(&epn->hnode, bucket);
+    }
+  else if (epn->state != EPOLL_NODE_FREE && state == EPOLL_NODE_FREE)
+    {
+      dq_rem(&epn->hnode, bucket);
+    }
+
+  list_delete(&epn->node);
+  list_add_tail(list, &epn->node);
+  epn->state = state;
+}
+
+/****************************************************************************
+ * Name: epoll_unready
+ *
+ * Description:
+ *   Remove the epoll node from the ready list, if the poll callback queued
+ *   it.
+ *
+ ****************************************************************************/
+
+static void epoll_unready(FAR epoll_head_t *eph, FAR epoll_node_t *epn)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  if (list_in_list(&epn->rnode))
+    {
+      list_delete(&epn->rnode);
+    }
+
+  spin_unlock_irqrestore(&eph->rlock, flags);
+}
+
+/****************************************************************************
+ * Name: epoll_poll_teardown
+ *
+ * Description:
+ *   Stop polling the fd of the setup epoll node and remove it from the
+ *   ready list, the poll callback could queue it again until the teardown.
+ *
+ ****************************************************************************/
+
+static void epoll_poll_teardown(FAR epoll_head_t *eph,
+                                FAR epoll_node_t *epn)
+{
+  file_poll(epn->filep, &epn->pfd, false);
+  epoll_unready(eph, epn);
+}
+
 static int epoll_do_open(FAR struct file *filep)
 {
   FAR epoll_head_t *eph = filep->f_priv;
@@ -220,6 +421,7 @@ static int epoll_do_close(FAR struct file *filep)
           fs_heap_free(epn);
         }
 
+      fs_heap_free(eph->hash);
       fs_heap_free(eph);
     }
 
@@ -247,9 +449,17 @@ static int epoll_do_create(int size, int flags)
       return ERROR;
     }
 
+  if (epoll_hash_alloc(eph, size) < 0)
+    {
+      fs_heap_free(eph);
+      set_errno(ENOMEM);
+      return ERROR;
+    }
+
   eph->size = size;
   nxmutex_init(&eph->lock);
   nxsem_init(&eph->sem, 0, 0);
+  spin_lock_init(&eph->rlock);
 
   /* List initialize */
 
@@ -260,6 +470,7 @@ static int epoll_do_create(int size, int flags)
   list_initialize(&eph->oneshot);
   list_initialize(&eph->extend);
   list_initialize(&eph->free);
+  list_initialize(&eph->ready);
   for (i = 0; i < size; i++)
     {
       list_add_tail(&eph->free, &epn[i].node);
@@ -273,6 +484,7 @@ static int epoll_do_create(int size, int flags)
   if (fd < 0)
     {
       nxmutex_destroy(&eph->lock);
+      fs_heap_free(eph->hash);
       fs_heap_free(eph);
       set_errno(-fd);
       return ERROR;
@@ -313,7 +525,6 @@ static int epoll_setup(FAR epoll_head_t *eph)
        * cover the situation several poll event pending on one fd.
        */
 
-      epn->notified    = false;
       epn->pfd.revents = 0;
       ret = file_poll(epn->filep, &epn->pfd, true);
       if (ret < 0)
@@ -323,8 +534,7 @@ static int epoll_setup(FAR epoll_head_t *eph)
           break;
         }
 
-      list_delete(&epn->node);
-      list_add_tail(&eph->setup, &epn->node);
+      epoll_move(eph, epn, EPOLL_NODE_SETUP);
     }
 
   nxmutex_unlock(&eph->lock);
@@ -335,8 +545,9 @@ static int epoll_setup(FAR epoll_head_t *eph)
  * Name: epoll_teardown
  *
  * Description:
- *   Teardown all the notified fd and check the notified fd's event with user
- *   expected event.
+ *   Teardown the notified fd of the ready list and check the notified fd's
+ *   event with user expected event.  The fd that do not fit in the events
+ *   array are left on the ready list for the next epoll_wait().
  *
  * Input Parameters:
  *   eph       - The epoll head pointer
@@ -352,42 +563,58 @@ static int epoll_setup(FAR epoll_head_t *eph)
 static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
                           int maxevents)
 {
-  FAR epoll_node_t *tepn;
+  FAR struct list_node *node;
   FAR epoll_node_t *epn;
+  irqstate_t flags;
+  bool pending;
   int i = 0;
 
   nxmutex_lock(&eph->lock);
 
-  list_for_every_entry_safe(&eph->setup, epn, tepn, epoll_node_t, node)
+  while (i < maxevents)
     {
-      /* Only check the notified fd */
+      flags = spin_lock_irqsave(&eph->rlock);
+      node  = list_remove_head(&eph->ready);
+      spin_unlock_irqrestore(&eph->rlock, flags);
 
-      if (!epn->notified)
+      if (node == NULL)
         {
-          continue;
+          break;
         }
 
-      /* Teradown all the notified fd */
+      /* Teardown the notified fd */
 
-      file_poll(epn->filep, &epn->pfd, false);
-      list_delete(&epn->node);
+      epn = container_of(node, epoll_node_t, rnode);
+      epoll_poll_teardown(eph, epn);
 
-      if (epn->pfd.revents != 0 && i < maxevents)
+      if (epn->pfd.revents != 0)
         {
           evs[i].data     = epn->data;
           evs[i++].events = epn->pfd.revents;
           if ((epn->pfd.events & EPOLLONESHOT) != 0)
             {
-              list_add_tail(&eph->oneshot, &epn->node);
-            }
-          else
-            {
-              list_add_tail(&eph->teardown, &epn->node);
+              epoll_move(eph, epn, EPOLL_NODE_ONESHOT);
+              continue;
             }
         }
-      else
+
+      epoll_move(eph, epn, EPOLL_NODE_TEARDOWN);
+    }
+
+  /* Keep the wakeup for the remaining notified fd */
+
+  flags   = spin_lock_irqsave(&eph->rlock);
+  pending = !list_is_empty(&eph->ready);
+  spin_unlock_irqrestore(&eph->rlock, flags);
+
+  if (pending)
+    {
+      int semcount = 0;
+
+      nxsem_get_value(&eph->sem, &semcount);
+      if (semcount < 1)
         {
-          list_add_tail(&eph->teardown, &epn->node);
+          nxsem_post(&eph->sem);
         }
     }
 
@@ -413,7 +640,7 @@ static void epoll_cleanup(FAR void *arg)
  *
  * Description:
  *   The default epoll callback function, this function do the final step of
- *   poll notification.
+ *   poll notification: queue the epoll node to the ready list.
  *
  * Input Parameters:
  *   fds - The fds
@@ -426,15 +653,24 @@ static void epoll_cleanup(FAR void *arg)
 static void epoll_default_cb(FAR struct pollfd *fds)
 {
   FAR epoll_node_t *epn = fds->arg;
+  FAR epoll_head_t *eph = epn->eph;
+  irqstate_t flags;
   int semcount = 0;
 
-  epn->notified = true;
+  flags = spin_lock_irqsave(&eph->rlock);
+  if (!list_in_list(&epn->rnode))
+    {
+      list_add_tail(&eph->ready, &epn->rnode);
+    }
+
+  spin_unlock_irqrestore(&eph->rlock, flags);
+
   if (fds->revents != 0)
     {
-      nxsem_get_value(&epn->eph->sem, &semcount);
+      nxsem_get_value(&eph->sem, &semcount);
       if (semcount < 1)
         {
-          nxsem_post(&epn->eph->sem);
+          nxsem_post(&eph->sem);
         }
     }
 }
@@ -529,33 +765,21 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
       case EPOLL_CTL_ADD:
         finfo("%p CTL ADD: fd=%d ev=%08" PRIx32 "\n", eph, fd, ev->events);
 
-        /* Check repetition */
+        /* EPOLLEXCLUSIVE only goes with the events of a wakeup */
 
-        list_for_every_entry(&eph->setup, epn, epoll_node_t, node)
+        if ((ev->events & EPOLLEXCLUSIVE) != 0 &&
+            (ev->events & ~EPOLL_EXCLUSIVE_OK) != 0)
           {
-            if (epn->pfd.fd == fd)
-              {
-                ret = -EEXIST;
-                goto err;
-              }
+            ret = -EINVAL;
+            goto err;
           }
 
-        list_for_every_entry(&eph->teardown, epn, epoll_node_t, node)
-          {
-            if (epn->pfd.fd == fd)
-              {
-                ret = -EEXIST;
-                goto err;
-              }
-          }
+        /* Check repetition */
 
-        list_for_every_entry(&eph->oneshot, epn, epoll_node_t, node)
+        if (epoll_find(eph, fd) != NULL)
           {
-            if (epn->pfd.fd == fd)
-              {
-                ret = -EEXIST;
-                goto err;
-              }
+            ret = -EEXIST;
+            goto err;
           }
 
         if (list_is_empty(&eph->free))
@@ -580,12 +804,17 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
               {
                 list_add_tail(&eph->free, &epn[i].node);
               }
+
+            /* Keep about one node per hash bucket, the current buckets
+             * still work if they cannot be extended.
+             */
+
+            epoll_hash_alloc(eph, eph->size);
           }
 
-        epn = container_of(list_remove_head(&eph->free), epoll_node_t, node);
+        epn = list_first_entry(&eph->free, epoll_node_t, node);
         epn->eph         = eph;
         epn->data        = ev->data;
-        epn->notified    = false;
         epn->pfd.events  = ev->events | POLLALWAYS;
         epn->pfd.fd      = fd;
         epn->pfd.arg     = epn;
@@ -595,131 +824,76 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
         ret = file_get(fd, &epn->filep);
         if (ret < 0)
           {
-            list_add_tail(&eph->free, &epn->node);
             goto err;
           }
 
         ret = file_poll(epn->filep, &epn->pfd, true);
         if (ret < 0)
           {
+            epoll_unready(eph, epn);
             file_put(epn->filep);
-            list_add_tail(&eph->free, &epn->node);
             goto err;
           }
 
-        list_add_tail(&eph->setup, &epn->node);
+        epoll_move(eph, epn, EPOLL_NODE_SETUP);
         break;
 
       case EPOLL_CTL_DEL:
         finfo("%p CTL DEL: fd=%d\n", eph, fd);
-        list_for_every_entry(&eph->setup, epn, epoll_node_t, node)
+        epn = epoll_find(eph, fd);
+        if (epn != NULL)
           {
-            if (epn->pfd.fd == fd)
+            if (epn->state == EPOLL_NODE_SETUP)
               {
-                file_poll(epn->filep, &epn->pfd, false);
-                file_put(epn->filep);
-                list_delete(&epn->node);
-                list_add_tail(&eph->free, &epn->node);
-                goto out;
+                epoll_poll_teardown(eph, epn);
               }
+
+            file_put(epn->filep);
+            epoll_move(eph, epn, EPOLL_NODE_FREE);
           }
 
-        list_for_every_entry(&eph->teardown, epn, epoll_node_t, node)
+        break;
+
+      case EPOLL_CTL_MOD:
+        finfo("%p CTL MOD: fd=%d ev=%08" PRIx32 "\n", eph, fd, ev->events);
+        epn = epoll_find(eph, fd);
+        if (epn == NULL)
           {
-            if (epn->pfd.fd == fd)
-              {
-                file_put(epn->filep);
-                list_delete(&epn->node);
-                list_add_tail(&eph->free, &epn->node);
-                goto out;
-              }
+            break;
           }
 
-        list_for_every_entry(&eph->oneshot, epn, epoll_node_t, node)
+        /* EPOLLEXCLUSIVE cannot be changed */
+
+        if (((ev->events | epn->pfd.events) & EPOLLEXCLUSIVE) != 0)
           {
-            if (epn->pfd.fd == fd)
-              {
-                file_put(epn->filep);
-                list_delete(&epn->node);
-                list_add_tail(&eph->free, &epn->node);
-                goto out;
-              }
+            ret = -EINVAL;
+            goto err;
           }
 
-        break;
-
-      case EPOLL_CTL_MOD:
-        finfo("%p CTL MOD: fd=%d ev=%08" PRIx32 "\n", eph, fd, ev->events);
-        list_for_every_entry(&eph->setup, epn, epoll_node_t, node)
+        epn->data = ev->data;
+        if (epn->state != EPOLL_NODE_ONESHOT &&
+            epn->pfd.events == (ev->events | POLLALWAYS))
           {
-            if (epn->pfd.fd == fd)
-              {
-                if (epn->pfd.events != (ev->events | POLLALWAYS))
-                  {
-                    file_poll(epn->filep, &epn->pfd, false);
-
-                    epn->notified    = false;
-                    epn->data        = ev->data;
-                    epn->pfd.events  = ev->events | POLLALWAYS;
-                    epn->pfd.revents = 0;
-
-                    ret = file_poll(epn->filep, &epn->pfd, true);
-                    if (ret < 0)
-                      {
-                        goto err;
-                      }
-                  }
-
-                goto out;
-              }
+            break;
           }
 
-        list_for_every_entry(&eph->teardown, epn, epoll_node_t, node)
+        if (epn->state == EPOLL_NODE_SETUP)
           {
-            if (epn->pfd.fd == fd)
-              {
-                if (epn->pfd.events != (ev->events | POLLALWAYS))
-                  {
-                    epn->notified    = false;
-                    epn->data        = ev->data;
-                    epn->pfd.events  = ev->events | POLLALWAYS;
-                    epn->pfd.revents = 0;
-
-                    ret = file_poll(epn->filep, &epn->pfd, true);
-                    if (ret < 0)
-                      {
-                        goto err;
-                      }
-
-                    list_delete(&epn->node);
-                    list_add_tail(&eph->setup, &epn->node);
-                  }
-
-                goto out;
-              }
+            epoll_poll_teardown(eph, epn);
           }
 
-        list_for_every_entry(&eph->oneshot, epn, epoll_node_t, node)
+        epn->pfd.events  = ev->events | POLLALWAYS;
+        epn->pfd.revents = 0;
+
+        ret = file_poll(epn->filep, &epn->pfd, true);
+        if (ret < 0)
           {
-            if (epn->pfd.fd == fd)
-              {
-                epn->notified    = false;
-                epn->data        = ev->data;
-                epn->pfd.events  = ev->events | POLLALWAYS;
-                epn->pfd.revents = 0;
-
-                ret = file_poll(epn->filep, &epn->pfd, true);
-                if (ret < 0)
-                  {
-                    goto err;
-                  }
-
-                list_delete(&epn->node);
-                list_add_tail(&eph->setup, &epn->node);
-                break;
-              }
+            epoll_unready(eph, epn);
+            epoll_move(eph, epn, EPOLL_NODE_TEARDOWN);
+            goto err;
           }
 
+        epoll_move(eph, epn, EPOLL_NODE_SETUP);
         break;
 
       default:
@@ -0,0 +1,885 @@
+/****************************************************************************
+ * fs/vfs/fs_pagecache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/pagecache.h>
+#include <nuttx/hashtable.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/semaphore.h>
+
+#ifdef CONFIG_FS_PAGECACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PAGECACHE_KEY(inode, sector) \
+  ((uint32_t)(uintptr_t)(inode) ^ (uint32_t)(sector))
+
+#define PAGECACHE_DATA(page) ((FAR unsigned char *)((page) + 1))
+
+/* The transfers of more than a quarter of the cache go to the driver
+ * directly, so that a large file read once does not evict the pages used
+ * again and again.  They only update the pages already cached.
+ */
+
+#define PAGECACHE_BYPASS(nsectors, sectorsize) \
+  ((size_t)(nsectors) * (sectorsize) > CONFIG_FS_PAGECACHE_SIZE / 4)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A cached sector, followed by its data.
+ *
+ * The lock is not held while a driver transfers data, so that a driver
+ * may itself use the cache, e.g. a loop device on a file of a cached
+ * volume, and so that the drivers transfer data concurrently.  A page
+ * being read from the driver or written back is marked busy instead, its
+ * other users wait until the transfer is done.
+ */
+
+struct pagecache_page_s
+{
+  hash_node_t hnode;          /* Entry of g_pagecache_hash */
+  dq_entry_t lnode;           /* Entry of g_pagecache_lru */
+  FAR struct inode *inode;    /* The block driver */
+  blkcnt_t sector;            /* The sector cached */
+  uint32_t pass;              /* Last writeback attempt, see g_pagecache_pass */
+  uint16_t size;              /* The size of the sector */
+  bool dirty;                 /* Not written back yet */
+  bool busy;                  /* Transfer in progress */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static DECLARE_HASHTABLE(g_pagecache_hash, CONFIG_FS_PAGECACHE_HASH_BITS);
+
+/* The pages, the most recently used first */
+
+static dq_queue_t g_pagecache_lru;
+
+static size_t g_pagecache_used;    /* Bytes allocated to the pages */
+static size_t g_pagecache_ndirty;  /* Number of pages not written back */
+static mutex_t g_pagecache_lock = NXMUTEX_INITIALIZER;
+
+/* The tasks waiting for the transfer of a busy page */
+
+static sem_t g_pagecache_waitsem = SEM_INITIALIZER(0);
+static unsigned int g_pagecache_nwaiters;
+
+/* Incremented by each write to the drivers bypassing the cache, and the
+ * number of these writes in progress.  A page read while one is in
+ * progress may be older than the driver data, and is not kept.
+ */
+
+static uint32_t g_pagecache_gen;
+static unsigned int g_pagecache_nwriting;
+
+/* Incremented by each flush or eviction, so that a page whose writeback
+ * fails is not retried over and over within one of them.
+ */
+
+static uint32_t g_pagecache_pass;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pagecache_relock
+ *
+ * Description:
+ *   Take the lock back after a transfer.
+ *
+ ****************************************************************************/
+
+static void pagecache_relock(void)
+{
+  while (nxmutex_lock(&g_pagecache_lock) < 0)
+    {
+    }
+}
+
+/****************************************************************************
+ * Name: pagecache_wait
+ *
+ * Description:
+ *   Wait until a busy page may have become idle.  The lock is released
+ *   while waiting.
+ *
+ ****************************************************************************/
+
+static void pagecache_wait(void)
+{
+  g_pagecache_nwaiters++;
+  nxmutex_unlock(&g_pagecache_lock);
+  nxsem_wait_uninterruptible(&g_pagecache_waitsem);
+  pagecache_relock();
+}
+
+/****************************************************************************
+ * Name: pagecache_idle
+ *
+ * Description:
+ *   Mark a page idle once its transfer is done, and wake up the waiters.
+ *
+ ****************************************************************************/
+
+static void pagecache_idle(FAR struct pagecache_page_s *page)
+{
+  if (page != NULL)
+    {
+      page->busy = false;
+    }
+
+  while (g_pagecache_nwaiters > 0)
+    {
+      g_pagecache_nwaiters--;
+      nxsem_post(&g_pagecache_waitsem);
+    }
+}
+
+/****************************************************************************
+ * Name: pagecache_find
+ *
+ * Description:
+ *   Return the page of a sector, or NULL if it is not cached.
+ *
+ ****************************************************************************/
+
+static FAR struct pagecache_page_s *
+pagecache_find(FAR struct inode *inode, blkcnt_t sector)
+{
+  FAR struct pagecache_page_s *page;
+  FAR hash_node_t *p;
+
+  hashtable_for_every_possible(g_pagecache_hash, p,
+                               PAGECACHE_KEY(inode, sector))
+    {
+      page = container_of(p, struct pagecache_page_s, hnode);
+      if (page->inode == inode && page->sector == sector)
+        {
+          return page;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: pagecache_touch
+ *
+ * Description:
+ *   Make a page the most recently used one.
+ *
+ ****************************************************************************/
+
+static void pagecache_touch(FAR struct pagecache_page_s *page)
+{
+  dq_rem(&page->lnode, &g_pagecache_lru);
+  dq_addfirst(&page->lnode, &g_pagecache_lru);
+}
+
+/****************************************************************************
+ * Name: pagecache_dirty
+ *
+ * Description:
+ *   Mark a page written back, or not.
+ *
+ ****************************************************************************/
+
+static void pagecache_dirty(FAR struct pagecache_page_s *page, bool dirty)
+{
+  if (page->dirty != dirty)
+    {
+      page->dirty = dirty;
+      if (dirty)
+        {
+          g_pagecache_ndirty++;
+        }
+      else
+        {
+          g_pagecache_ndirty--;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: pagecache_devread / pagecache_devwrite
+ *
+ * Description:
+ *   Transfer sectors from or to the block driver.  The lock is released
+ *   during the transfer.
+ *
+ ****************************************************************************/
+
+static ssize_t pagecache_devread(FAR struct inode *inode,
+                                 FAR unsigned char *buffer, blkcnt_t start,
+                                 unsigned int nsectors)
+{
+  ssize_t ret;
+
+  if (inode->u.i_bops == NULL || inode->u.i_bops->read == NULL)
+    {
+      return -ENODEV;
+    }
+
+  nxmutex_unlock(&g_pagecache_lock);
+  ret = inode->u.i_bops->read(inode, buffer, start, nsectors);
+  pagecache_relock();
+
+  return ret;
+}
+
+static ssize_t pagecache_devwrite(FAR struct inode *inode,
+                                  FAR const unsigned char *buffer,
+                                  blkcnt_t start, unsigned int nsectors)
+{
+  ssize_t ret;
+
+  if (inode->u.i_bops == NULL || inode->u.i_bops->write == NULL)
+    {
+      return -EACCES;
+    }
+
+  nxmutex_unlock(&g_pagecache_lock);
+  ret = inode->u.i_bops->write(inode, buffer, start, nsectors);
+  pagecache_relock();
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pagecache_writethrough
+ *
+ * Description:
+ *   Write sectors to the driver, bypassing the cache.  The sectors must
+ *   not be cached.
+ *
+ ****************************************************************************/
+
+static ssize_t pagecache_writethrough(FAR struct inode *inode,
+                                      FAR const unsigned char *buffer,
+                                      blkcnt_t start, unsigned int nsectors)
+{
+  ssize_t ret;
+
+  g_pagecache_nwriting++;
+  ret = pagecache_devwrite(inode, buffer, start, nsectors);
+  g_pagecache_nwriting--;
+  g_pagecache_gen++;
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pagecache_writeback
+ *
+ * Description:
+ *   Write a page back to its driver, if it was modified.  The page must be
+ *   idle, it is busy during the write.  The attempt is recorded as part of
+ *   pass.
+ *
+ ****************************************************************************/
+
+static int pagecache_writeback(FAR struct pagecache_page_s *page,
+                               uint32_t pass)
+{
+  ssize_t ret;
+
+  DEBUGASSERT(!page->busy);
+
+  if (!page->dirty)
+    {
+      return OK;
+    }
+
+  page->busy = true;
+  page->pass = pass;
+
+  ret = pagecache_devwrite(page->inode, PAGECACHE_DATA(page),
+                           page->sector, 1);
+
+  pagecache_idle(page);
+  if (ret != 1)
+    {
+      ferr("ERROR: Failed to write back sector %" PRIuOFF ": %zd\n",
+           (off_t)page->sector, ret);
+      return ret < 0 ? ret : -EIO;
+    }
+
+  pagecache_dirty(page, false);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pagecache_free
+ *
+ * Description:
+ *   Remove an idle page from the cache and free it.
+ *
+ ****************************************************************************/
+
+static void pagecache_free(FAR struct pagecache_page_s *page)
+{
+  DEBUGASSERT(!page->busy);
+
+  pagecache_dirty(page, false);
+  hashtable_delete(g_pagecache_hash, &page->hnode,
+                   PAGECACHE_KEY(page->inode, page->sector));
+  dq_rem(&page->lnode, &g_pagecache_lru);
+  g_pagecache_used -= sizeof(struct pagecache_page_s) + page->size;
+  kmm_free(page);
+}
+
+/****************************************************************************
+ * Name: pagecache_makeroom
+ *
+ * Description:
+ *   Evict pages until need more bytes fit in the cache.  The least
+ *   recently used clean page goes first.  If there is none, the least
+ *   recently used modified page is written back; one that fails is kept
+ *   and skipped.
+ *
+ * Returned Value:
+ *   Zero on success, -ENOMEM if no page can be evicted.
+ *
+ ****************************************************************************/
+
+static int pagecache_makeroom(size_t need)
+{
+  FAR struct pagecache_page_s *page;
+  FAR dq_entry_t *p;
+  uint32_t pass = ++g_pagecache_pass;
+
+  while (g_pagecache_used + need > CONFIG_FS_PAGECACHE_SIZE)
+    {
+      for (p = dq_tail(&g_pagecache_lru); p != NULL; p = dq_prev(p))
+        {
+          page = container_of(p, struct pagecache_page_s, lnode);
+          if (!page->busy && !page->dirty)
+            {
+              break;
+            }
+        }
+
+      if (p != NULL)
+        {
+          pagecache_free(page);
+          continue;
+        }
+
+      for (p = dq_tail(&g_pagecache_lru); p != NULL; p = dq_prev(p))
+        {
+          page = container_of(p, struct pagecache_page_s, lnode);
+          if (!page->busy && page->pass != pass)
+            {
+              break;
+            }
+        }
+
+      if (p == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      /* Make it clean, it is evicted by the next iteration unless it is
+       * used in the meantime.
+       */
+
+      pagecache_writeback(page, pass);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pagecache_alloc
+ *
+ * Description:
+ *   Add a page for a sector, evicting the least recently used pages to
+ *   make room for it.  The lock may be released meanwhile.
+ *
+ * Returned Value:
+ *   The page, busy with undefined data, or NULL if the sector is cached
+ *   meanwhile or if no room could be made.
+ *
+ ****************************************************************************/
+
+static FAR struct pagecache_page_s *
+pagecache_alloc(FAR struct inode *inode, blkcnt_t sector, uint16_t size)
+{
+  FAR struct pagecache_page_s *page;
+  size_t need = sizeof(struct pagecache_page_s) + size;
+
+  if (need > CONFIG_FS_PAGECACHE_SIZE || pagecache_makeroom(need) < 0 ||
+      pagecache_find(inode, sector) != NULL)
+    {
+      return NULL;
+    }
+
+  page = kmm_malloc(need);
+  if (page == NULL)
+    {
+      return NULL;
+    }
+
+  page->inode  = inode;
+  page->sector = sector;
+  page->pass   = 0;
+  page->size   = size;
+  page->dirty  = false;
+  page->busy   = true;
+
+  hashtable_add(g_pagecache_hash, &page->hnode,
+                PAGECACHE_KEY(inode, sector));
+  dq_addfirst(&page->lnode, &g_pagecache_lru);
+  g_pagecache_used += need;
+
+  return page;
+}
+
+/****************************************************************************
+ * Name: pagecache_drop
+ *
+ * Description:
+ *   Drop the pages of nsectors sectors, waiting for their transfers.
+ *
+ ****************************************************************************/
+
+static void pagecache_drop(FAR struct inode *inode, blkcnt_t start,
+                           unsigned int nsectors)
+{
+  FAR struct pagecache_page_s *page;
+  unsigned int i = 0;
+
+  while (i < nsectors)
+    {
+      page = pagecache_find(inode, start + i);
+      if (page != NULL && page->busy)
+        {
+          pagecache_wait();
+          continue;
+        }
+
+      if (page != NULL)
+        {
+          pagecache_free(page);
+        }
+
+      i++;
+    }
+}
+
+/****************************************************************************
+ * Name: pagecache_overlay
+ *
+ * Description:
+ *   Copy the pages not written back over sectors just read from the
+ *   driver, they are newer.
+ *
+ ****************************************************************************/
+
+static void pagecache_overlay(FAR struct inode *inode,
+                              FAR unsigned char *buffer, blkcnt_t start,
+                              unsigned int nsectors, uint16_t sectorsize)
+{
+  FAR struct pagecache_page_s *page;
+  unsigned int i;
+
+  for (i = 0; g_pagecache_ndirty > 0 && i < nsectors; i++)
+    {
+      page = pagecache_find(inode, start + i);
+
+      /* A busy page being written back is stable.  One being read holds
+       * no data yet, and it is not dirty.
+       */
+
+      if (page != NULL && page->dirty)
+        {
+          memcpy(buffer + i * sectorsize, PAGECACHE_DATA(page),
+                 sectorsize);
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pagecache_read
+ *
+ * Description:
+ *   Read sectors of a block driver, from the page cache when they are
+ *   cached.  The runs of sectors not cached are read at once.
+ *
+ ****************************************************************************/
+
+ssize_t pagecache_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                       blkcnt_t start, unsigned int nsectors,
+                       uint16_t sectorsize)
+{
+  FAR struct pagecache_page_s *page;
+  unsigned int i = 0;
+  unsigned int n;
+  uint32_t gen;
+  ssize_t ret;
+  bool valid;
+
+  ret = nxmutex_lock(&g_pagecache_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (PAGECACHE_BYPASS(nsectors, sectorsize))
+    {
+      /* Read from the driver, the pages not written back are newer */
+
+      ret = pagecache_devread(inode, buffer, start, nsectors);
+      if (ret > 0)
+        {
+          pagecache_overlay(inode, buffer, start, ret, sectorsize);
+        }
+
+      nxmutex_unlock(&g_pagecache_lock);
+      return ret;
+    }
+
+  while (i < nsectors)
+    {
+      page = pagecache_find(inode, start + i);
+      if (page != NULL && page->busy)
+        {
+          pagecache_wait();
+          continue;
+        }
+
+      if (page != NULL)
+        {
+          memcpy(buffer + i * sectorsize, PAGECACHE_DATA(page), sectorsize);
+          pagecache_touch(page);
+          i++;
+          continue;
+        }
+
+      /* Add busy pages for the run of sectors not cached */
+
+      for (n = 0; i + n < nsectors; n++)
+        {
+          if (pagecache_alloc(inode, start + i + n, sectorsize) == NULL)
+            {
+              break;
+            }
+        }
+
+      if (n == 0)
+        {
+          if (pagecache_find(inode, start + i) != NULL)
+            {
+              /* Cached meanwhile */
+
+              continue;
+            }
+
+          /* No room, read the sector without caching it */
+
+          ret = pagecache_devread(inode, buffer + i * sectorsize,
+                                  start + i, 1);
+          if (ret <= 0)
+            {
+              break;
+            }
+
+          pagecache_overlay(inode, buffer + i * sectorsize, start + i, 1,
+                            sectorsize);
+          i++;
+          continue;
+        }
+
+      /* Read the run and fill its pages, unless the driver was written
+       * meanwhile.
+       */
+
+      gen = g_pagecache_gen;
+      ret = pagecache_devread(inode, buffer + i * sectorsize, start + i, n);
+      valid = gen == g_pagecache_gen && g_pagecache_nwriting == 0;
+
+      while (n-- > 0)
+        {
+          page = pagecache_find(inode, start + i + n);
+          DEBUGASSERT(page != NULL && page->busy);
+
+          if ((ssize_t)n < ret && valid)
+            {
+              memcpy(PAGECACHE_DATA(page), buffer + (i + n) * sectorsize,
+                     sectorsize);
+              page->busy = false;
+            }
+          else
+            {
+              page->busy = false;
+              pagecache_free(page);
+            }
+        }
+
+      pagecache_idle(NULL);
+      if (ret <= 0)
+        {
+          break;
+        }
+
+      i += ret;
+    }
+
+  nxmutex_unlock(&g_pagecache_lock);
+  return i > 0 ? i : ret;
+}
+
+/****************************************************************************
+ * Name: pagecache_write
+ *
+ * Description:
+ *   Write sectors of a block driver into the page cache.  A sector is
+ *   written to the driver at once if no room can be made for it.
+ *
+ ****************************************************************************/
+
+ssize_t pagecache_write(FAR struct inode *inode,
+                        FAR const unsigned char *buffer, blkcnt_t start,
+                        unsigned int nsectors, uint16_t sectorsize)
+{
+  FAR struct pagecache_page_s *page;
+  unsigned int i = 0;
+  ssize_t ret;
+
+  ret = nxmutex_lock(&g_pagecache_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (PAGECACHE_BYPASS(nsectors, sectorsize))
+    {
+      /* Write to the driver.  The pages of the sectors are superseded, and
+       * must not be written back over the new data.
+       */
+
+      pagecache_drop(inode, start, nsectors);
+      ret = pagecache_writethrough(inode, buffer, start, nsectors);
+
+      nxmutex_unlock(&g_pagecache_lock);
+      return ret;
+    }
+
+  while (i < nsectors)
+    {
+      page = pagecache_find(inode, start + i);
+      if (page != NULL && page->busy)
+        {
+          pagecache_wait();
+          continue;
+        }
+
+      if (page == NULL)
+        {
+          page = pagecache_alloc(inode, start + i, sectorsize);
+          if (page == NULL && pagecache_find(inode, start + i) != NULL)
+            {
+              /* Cached meanwhile */
+
+              continue;
+            }
+
+          if (page == NULL)
+            {
+              /* No room, write the sector to the driver */
+
+              ret = pagecache_writethrough(inode, buffer + i * sectorsize,
+                                           start + i, 1);
+              if (ret <= 0)
+                {
+                  break;
+                }
+
+              i++;
+              continue;
+            }
+
+          pagecache_idle(page);
+        }
+
+      memcpy(PAGECACHE_DATA(page), buffer + i * sectorsize, sectorsize);
+      pagecache_dirty(page, true);
+      pagecache_touch(page);
+      page->pass = 0;
+      i++;
+    }
+
+  nxmutex_unlock(&g_pagecache_lock);
+  return i > 0 ? i : ret;
+}
+
+/****************************************************************************
+ * Name: pagecache_flush
+ *
+ * Description:
+ *   Write back the modified pages of a block driver, or of all the drivers
+ *   if inode is NULL.
+ *
+ ****************************************************************************/
+
+int pagecache_flush(FAR struct inode *inode)
+{
+  FAR struct pagecache_page_s *page;
+  FAR dq_entry_t *p;
+  uint32_t pass;
+  int result = OK;
+  int ret;
+
+  ret = nxmutex_lock(&g_pagecache_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Write back the least recently used pages first.  The list may change
+   * during a write, so it is scanned again after each one.
+   */
+
+  pass = ++g_pagecache_pass;
+  while (g_pagecache_ndirty > 0)
+    {
+      for (p = dq_tail(&g_pagecache_lru); p != NULL; p = dq_prev(p))
+        {
+          page = container_of(p, struct pagecache_page_s, lnode);
+          if (page->dirty && page->pass != pass &&
+              (inode == NULL || page->inode == inode))
+            {
+              break;
+            }
+        }
+
+      if (p == NULL)
+        {
+          break;
+        }
+
+      if (page->busy)
+        {
+          pagecache_wait();
+          continue;
+        }
+
+      ret = pagecache_writeback(page, pass);
+      if (ret < 0 && result == OK)
+        {
+          result = ret;
+        }
+    }
+
+  nxmutex_unlock(&g_pagecache_lock);
+  return result;
+}
+
+/****************************************************************************
+ * Name: pagecache_invalidate
+ *
+ * Description:
+ *   Drop the pages of a block driver, written back first if writeback is
+ *   true.  The pages are dropped even if they can't be written back.
+ *
+ ****************************************************************************/
+
+int pagecache_invalidate(FAR struct inode *inode, bool writeback)
+{
+  FAR struct pagecache_page_s *page;
+  FAR dq_entry_t *p;
+  int result = OK;
+  int ret;
+
+  ret = nxmutex_lock(&g_pagecache_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (; ; )
+    {
+      for (p = dq_peek(&g_pagecache_lru); p != NULL; p = dq_next(p))
+        {
+          page = container_of(p, struct pagecache_page_s, lnode);
+          if (page->inode == inode)
+            {
+              break;
+            }
+        }
+
+      if (p == NULL)
+        {
+          break;
+        }
+
+      if (page->busy)
+        {
+          pagecache_wait();
+          continue;
+        }
+
+      /* The page stays busy during the write, it is not used meanwhile */
+
+      if (writeback)
+        {
+          ret = pagecache_writeback(page, ++g_pagecache_pass);
+          if (ret < 0 && result == OK)
+            {
+              result = ret;
+            }
+        }
+
+      pagecache_free(page);
+    }
+
+  nxmutex_unlock(&g_pagecache_lock);
+  return result;
+}
+
+#endif /* CONFIG_FS_PAGECACHE */
@@ -26,6 +26,8 @@
 
 #include <nuttx/config.h>
 
+#include <sys/epoll.h>
+
 #include <poll.h>
 #include <time.h>
 #include <assert.h>
@@ -257,6 +259,10 @@ void poll_default_cb(FAR struct pollfd *fds)
  *   Notify the poll, this function should be called by drivers to notify
  *   the caller the poll is ready.
  *
+ *   Of the waiters that asked for EPOLLEXCLUSIVE, only the first one that
+ *   has no event pending yet is notified of the events, the others already
+ *   have a wakeup on the way or are left asleep.
+ *
  * Input Parameters:
  *   afds     - The fds array
  *   nfds     - Number of fds array
@@ -270,8 +276,9 @@ void poll_default_cb(FAR struct pollfd *fds)
 noinstrument_function
 void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset)
 {
-  int i;
   FAR struct pollfd *fds;
+  bool exclusive = false;
+  int i;
 
   DEBUGASSERT(afds != NULL && nfds >= 1);
 
@@ -280,6 +287,19 @@ void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset)
       fds = afds[i];
       if (fds != NULL)
         {
+          /* Wake up a single idle exclusive waiter */
+
+          if ((fds->events & EPOLLEXCLUSIVE) != 0 && fds->revents == 0 &&
+              (eventset & (fds->events | POLLERR | POLLHUP)) != 0)
+            {
+              if (exclusive)
+                {
+                  continue;
+                }
+
+              exclusive = true;
+            }
+
           /* The error event must be set in fds->revents */
 
           fds->revents |= eventset & (fds->events | POLLERR | POLLHUP);
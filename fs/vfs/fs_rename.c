@@ -70,6 +70,7 @@ static int pseudorename(FAR const char *oldpath, FAR struct inode *oldinode,
 {
   struct inode_search_s newdesc;
   FAR struct inode *newinode;
+  FAR struct inode *child;
   FAR char *subdir = NULL;
 #ifdef CONFIG_FS_NOTIFY
   bool isdir = INODE_IS_PSEUDODIR(oldinode);
@@ -223,6 +224,18 @@ static int pseudorename(FAR const char *oldpath, FAR struct inode *oldinode,
 
   oldinode->i_child  = NULL;
   oldinode->i_parent = NULL;
+
+  /* The children now hang below the new inode */
+
+  for (child = newinode->i_child; child != NULL; child = child->i_peer)
+    {
+      child->i_parent = newinode;
+    }
+
+#ifdef CONFIG_PSEUDOFS_HASH
+  inode_hash_addtree(newinode->i_child);
+#endif
+
   ret = OK;
 
 errout_with_lock:
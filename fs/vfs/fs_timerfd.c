@@ -34,9 +34,14 @@
 #include <debug.h>
 
 #include <nuttx/irq.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/wdog.h>
 #include <nuttx/mutex.h>
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+#  include <nuttx/hrtimer.h>
+#endif
+
 #include <sys/ioctl.h>
 #include <sys/timerfd.h>
 
@@ -65,9 +70,15 @@ struct timerfd_priv_s
   mutex_t                   lock;    /* Enforces device exclusive access */
   FAR timerfd_waiter_sem_t *rdsems;  /* List of blocking readers */
   int                       clock;   /* Clock to use as the timing base */
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  uint64_t                  period;  /* If non-zero, used to reset repetitive
+                                      * timers (nsec) */
+  hrtimer_t                 hrtimer; /* The hrtimer that provides the timing */
+#else
   int                       delay;   /* If non-zero, used to reset repetitive
                                       * timers */
   struct wdog_s             wdog;    /* The watchdog that provides the timing */
+#endif
   timerfd_t                 counter; /* timerfd counter */
   uint8_t                   crefs;   /* References counts on timerfd (max: 255) */
 
@@ -101,7 +112,15 @@ static int timerfd_blocking_io(FAR struct timerfd_priv_s *dev,
 static FAR struct timerfd_priv_s *timerfd_allocdev(void);
 static void timerfd_destroy(FAR struct timerfd_priv_s *dev);
 
+static void timerfd_expire(FAR struct timerfd_priv_s *dev);
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+static uint64_t timerfd_timeout(FAR const hrtimer_t *hrtimer,
+                                uint64_t expired);
+#else
 static void timerfd_timeout(wdparm_t arg);
+#endif
+static void timerfd_gettimeleft(FAR struct timerfd_priv_s *dev,
+                                FAR struct itimerspec *value);
 
 /****************************************************************************
  * Private Data
@@ -158,7 +177,11 @@ static FAR struct timerfd_priv_s *timerfd_allocdev(void)
 
 static void timerfd_destroy(FAR struct timerfd_priv_s *dev)
 {
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  hrtimer_cancel_sync(&dev->hrtimer);
+#else
   wd_cancel(&dev->wdog);
+#endif
   nxmutex_unlock(&dev->lock);
   nxmutex_destroy(&dev->lock);
   fs_heap_free(dev);
@@ -386,29 +409,14 @@ out:
 }
 #endif
 
-static void timerfd_timeout(wdparm_t arg)
+static void timerfd_expire(FAR struct timerfd_priv_s *dev)
 {
-  FAR struct timerfd_priv_s *dev = (FAR struct timerfd_priv_s *)arg;
   FAR timerfd_waiter_sem_t *cur_sem;
-  irqstate_t intflags;
-
-  /* Disable interrupts to ensure that expiration counter is accessed
-   * atomically
-   */
-
-  intflags = enter_critical_section();
 
   /* Increment timer expiration counter */
 
   dev->counter++;
 
-  /* If this is a repetitive timer, then restart the watchdog */
-
-  if (dev->delay > 0)
-    {
-      wd_start(&dev->wdog, dev->delay, timerfd_timeout, arg);
-    }
-
 #ifdef CONFIG_TIMER_FD_POLL
   /* Notify all poll/select waiters */
 
@@ -425,9 +433,69 @@ static void timerfd_timeout(wdparm_t arg)
     }
 
   dev->rdsems = NULL;
+}
+
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+static uint64_t timerfd_timeout(FAR const hrtimer_t *hrtimer,
+                                uint64_t expired)
+{
+  FAR struct timerfd_priv_s *dev =
+    container_of(hrtimer, struct timerfd_priv_s, hrtimer);
+  irqstate_t intflags;
+
+  /* Disable interrupts to ensure that expiration counter is accessed
+   * atomically
+   */
+
+  intflags = enter_critical_section();
+  timerfd_expire(dev);
+  leave_critical_section(intflags);
+
+  /* If this is a repetitive timer, hrtimer_process() re-arms it with the
+   * returned period.
+   */
+
+  return dev->period;
+}
+#else
+static void timerfd_timeout(wdparm_t arg)
+{
+  FAR struct timerfd_priv_s *dev = (FAR struct timerfd_priv_s *)arg;
+  irqstate_t intflags;
+
+  /* Disable interrupts to ensure that expiration counter is accessed
+   * atomically
+   */
+
+  intflags = enter_critical_section();
+
+  /* If this is a repetitive timer, then restart the watchdog */
+
+  if (dev->delay > 0)
+    {
+      wd_start(&dev->wdog, dev->delay, timerfd_timeout, arg);
+    }
 
+  timerfd_expire(dev);
   leave_critical_section(intflags);
 }
+#endif
+
+static void timerfd_gettimeleft(FAR struct timerfd_priv_s *dev,
+                                FAR struct itimerspec *value)
+{
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  /* Get the time before the underlying hrtimer expires */
+
+  clock_nsec2time(&value->it_value, hrtimer_remaining(&dev->hrtimer));
+  clock_nsec2time(&value->it_interval, dev->period);
+#else
+  /* Get the number of ticks before the underlying watchdog expires */
+
+  clock_ticks2time(&value->it_value, wd_gettime(&dev->wdog));
+  clock_ticks2time(&value->it_interval, dev->delay);
+#endif
+}
 
 /****************************************************************************
  * Public Functions
@@ -492,7 +560,12 @@ int timerfd_settime(int fd, int flags,
   FAR struct timerfd_priv_s *dev;
   FAR struct file *filep;
   irqstate_t intflags;
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  struct timespec now;
+  uint64_t delay;
+#else
   sclock_t delay;
+#endif
   int ret;
 
   /* Some sanity checks */
@@ -524,6 +597,27 @@ int timerfd_settime(int fd, int flags,
 
   dev = (FAR struct timerfd_priv_s *)filep->f_priv;
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  if (old_value)
+    {
+      timerfd_gettimeleft(dev, old_value);
+    }
+
+  /* Disarm the timer (in case the timer was already armed when
+   * timerfd_settime() is called), and wait for an expiration running on
+   * another CPU, it would otherwise count an expiration or re-arm the timer
+   * after it is reset.  This is done before entering the critical section,
+   * which the expiration takes.
+   */
+
+  hrtimer_cancel_sync(&dev->hrtimer);
+
+  /* Disable interrupts here to ensure that expiration counter is accessed
+   * atomicaly.
+   */
+
+  intflags = enter_critical_section();
+#else
   /* Disable interrupts here to ensure that expiration counter is accessed
    * atomicaly.
    */
@@ -532,14 +626,7 @@ int timerfd_settime(int fd, int flags,
 
   if (old_value)
     {
-      /* Get the number of ticks before the underlying watchdog expires */
-
-      delay = wd_gettime(&dev->wdog);
-
-      /* Convert that to a struct timespec and return it */
-
-      clock_ticks2time(&old_value->it_value, delay);
-      clock_ticks2time(&old_value->it_interval, dev->delay);
+      timerfd_gettimeleft(dev, old_value);
     }
 
   /* Disarm the timer (in case the timer was already armed when
@@ -547,6 +634,7 @@ int timerfd_settime(int fd, int flags,
    */
 
   wd_cancel(&dev->wdog);
+#endif
 
   /* Clear expiration counter */
 
@@ -563,6 +651,37 @@ int timerfd_settime(int fd, int flags,
       return OK;
     }
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  /* Setup up any repetitive timer, the hrtimer keeps sub-tick
+   * resolution.
+   */
+
+  dev->period = clock_time2nsec(&new_value->it_interval);
+  delay = clock_time2nsec(&new_value->it_value);
+
+  if ((flags & TFD_TIMER_ABSTIME) != 0)
+    {
+      /* Calculate a delay corresponding to the absolute time in 'value' */
+
+      nxclock_gettime(dev->clock, &now);
+      delay = delay > clock_time2nsec(&now) ?
+              delay - clock_time2nsec(&now) : 0;
+    }
+
+  /* If the time is in the past or now, then set up the next interval
+   * instead (assuming a repetitive timer).
+   */
+
+  if (delay == 0)
+    {
+      delay = dev->period;
+    }
+
+  /* Then start the hrtimer */
+
+  ret = hrtimer_start(&dev->hrtimer, timerfd_timeout, delay,
+                      HRTIMER_MODE_REL);
+#else
   /* Setup up any repetitive timer */
 
   delay = clock_time2ticks(&new_value->it_interval);
@@ -602,6 +721,8 @@ int timerfd_settime(int fd, int flags,
   /* Then start the watchdog */
 
   ret = wd_start(&dev->wdog, delay, timerfd_timeout, (wdparm_t)dev);
+#endif
+
   if (ret < 0)
     {
       leave_critical_section(intflags);
@@ -623,7 +744,6 @@ int timerfd_gettime(int fd, FAR struct itimerspec *curr_value)
 {
   FAR struct timerfd_priv_s *dev;
   FAR struct file *filep;
-  sclock_t ticks;
   int ret;
 
   /* Some sanity checks */
@@ -650,14 +770,7 @@ int timerfd_gettime(int fd, FAR struct itimerspec *curr_value)
 
   dev = (FAR struct timerfd_priv_s *)filep->f_priv;
 
-  /* Get the number of ticks before the underlying watchdog expires */
-
-  ticks = wd_gettime(&dev->wdog);
-
-  /* Convert that to a struct timespec and return it */
-
-  clock_ticks2time(&curr_value->it_value, ticks);
-  clock_ticks2time(&curr_value->it_interval, dev->delay);
+  timerfd_gettimeleft(dev, curr_value);
   file_put(filep);
   return OK;
 
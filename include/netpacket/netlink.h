@@ -565,6 +565,16 @@
 #define CTA_PROTO_ICMPV6_CODE            9
 #define CTA_PROTO_MAX                    9
 
+/* NETLINK_NETFILTER: Conntrack counters attributes */
+
+#define CTA_COUNTERS_UNSPEC              0
+#define CTA_COUNTERS_PACKETS             1 /* 64bit counters */
+#define CTA_COUNTERS_BYTES               2 /* 64bit counters */
+#define CTA_COUNTERS32_PACKETS           3 /* Old 32bit counters, unused */
+#define CTA_COUNTERS32_BYTES             4 /* Old 32bit counters, unused */
+#define CTA_COUNTERS_PAD                 5
+#define CTA_COUNTERS_MAX                 5
+
 /* NFnetlink multicast groups (userspace) */
 
 #define NF_NETLINK_CONNTRACK_NEW         0x00000001
@@ -30,6 +30,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <nuttx/mutex.h>
@@ -55,6 +56,36 @@ typedef CODE ssize_t (*rwbreload_t)(FAR void *dev, FAR uint8_t *buffer,
 typedef CODE ssize_t (*rwbflush_t)(FAR void *dev, FAR const uint8_t *buffer,
                                    off_t startblock, size_t nblocks);
 
+/* One sequential reader followed by the read-ahead buffering.  Each stream
+ * has its own buffer, so that interleaved readers do not evict the data
+ * read ahead for each other.
+ */
+
+#ifdef CONFIG_DRVR_READAHEAD
+struct rwb_rhstream_s
+{
+  FAR uint8_t  *buffer;          /* Read-ahead buffer of the stream */
+  off_t         blockstart;      /* First block in the buffer */
+  off_t         next;            /* Block following the last one read */
+  uint32_t      stamp;           /* Time of the last read, for replacement */
+  uint16_t      nblocks;         /* Number of blocks in the buffer */
+  uint16_t      window;          /* Number of blocks to read ahead */
+  bool          sequential;      /* true: The stream is read sequentially */
+};
+#endif
+
+/* Buffering statistics, reported in /proc/rwbuffer */
+
+struct rwb_stats_s
+{
+  uint32_t      rhhits;          /* Blocks read from a read-ahead buffer */
+  uint32_t      rhmisses;        /* Blocks the reader waited for */
+  uint32_t      rhprefetched;    /* Blocks read ahead of the reader */
+  uint32_t      rhwasted;        /* Blocks read ahead but never read */
+  uint32_t      wrblocks;        /* Blocks written */
+  uint32_t      wrflushes;       /* Transfers to flush written blocks */
+};
+
 /* This structure holds the state of the buffers.  In typical usage,
  * an instance of this structure is declared within each block driver
  * status structure like:
@@ -140,10 +171,21 @@ struct rwbuffer_s
 
 #ifdef CONFIG_DRVR_READAHEAD
   mutex_t       rhlock;          /* Enforces exclusive access to the read-ahead buffer */
-  FAR uint8_t  *rhbuffer;        /* Allocated read-ahead buffer */
-  uint16_t      rhnblocks;       /* Number of blocks in read-ahead buffer */
-  off_t         rhblockstart;    /* First block in read-ahead buffer */
+  FAR uint8_t  *rhbuffer;        /* Allocated read-ahead buffers */
+  uint32_t      rhstamp;         /* Read counter, to replace the oldest stream */
+  uint32_t      rhgen;           /* Incremented when the buffered data changes */
+  struct rwb_rhstream_s rhstream[CONFIG_DRVR_READAHEAD_NSTREAMS];
+#ifdef CONFIG_DRVR_READAHEAD_PREFETCH
+  mutex_t       rhiolock;        /* Serializes the reads of the media */
+  struct work_s rhwork;          /* Work loading the next window of a stream */
+  FAR uint8_t  *rhspare;         /* Buffer loaded by the work */
+  int8_t        rhprefetch;      /* Stream being loaded, -1 if none */
+#endif
 #endif
+
+  struct rwb_stats_s stats;      /* Buffering statistics */
+  FAR struct rwbuffer_s *flink;  /* Next buffer listed in procfs */
+  unsigned int  id;              /* Index of the buffer in procfs */
 };
 
 /****************************************************************************
@@ -202,6 +244,13 @@ int rwb_flush(FAR struct rwbuffer_s *rwb);
 int rwb_discard(FAR struct rwbuffer_s *rwb);
 #endif
 
+/* Statistics */
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_RWBUFFER)
+void rwb_procfs_register(FAR struct rwbuffer_s *rwb);
+void rwb_procfs_unregister(FAR struct rwbuffer_s *rwb);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
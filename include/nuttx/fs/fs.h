@@ -417,6 +417,9 @@ struct inode
   struct timespec   i_ctime;    /* Time of last status change */
 #endif
   FAR void         *i_private;  /* Per inode driver private data */
+#ifdef CONFIG_PSEUDOFS_HASH
+  FAR struct inode *i_hash;     /* Link to next inode in hash bucket */
+#endif
   char              i_name[1];  /* Name of inode (variable) */
 };
 
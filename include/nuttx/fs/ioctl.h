@@ -366,6 +366,17 @@
                                            * IN:  None
                                            * OUT: None (ioctl return value provides
                                            *      success/failure indication). */
+#define BIOC_SETCACHE   _BIOC(0x0012)     /* Used only by BCH to set the number
+                                           * of sectors cached.
+                                           * IN:  Number of sectors (1-255)
+                                           * OUT: None (ioctl return value provides
+                                           *      success/failure indication). */
+#define BIOC_SETREADAHEAD _BIOC(0x0013)   /* Used only by BCH to set the maximum
+                                           * number of sectors read ahead of
+                                           * sequential accesses.
+                                           * IN:  Number of sectors (0-255)
+                                           * OUT: None (ioctl return value provides
+                                           *      success/failure indication). */
 
 /* NuttX MTD driver ioctl definitions ***************************************/
 
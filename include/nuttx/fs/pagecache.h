@@ -0,0 +1,149 @@
+/****************************************************************************
+ * include/nuttx/fs/pagecache.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FS_PAGECACHE_H
+#define __INCLUDE_NUTTX_FS_PAGECACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef CONFIG_FS_PAGECACHE
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct inode;
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* The page cache is shared by the block drivers accessed through it.  Its
+ * pages are the sectors of the drivers, identified by the driver inode and
+ * the sector number, kept in least recently used order within
+ * CONFIG_FS_PAGECACHE_SIZE bytes.  The writes are written back when their
+ * pages are evicted or flushed.
+ */
+
+/****************************************************************************
+ * Name: pagecache_read
+ *
+ * Description:
+ *   Read sectors of a block driver, from the page cache when they are
+ *   cached.  This is a replacement for inode->u.i_bops->read().
+ *
+ * Input Parameters:
+ *   inode      - The block driver inode
+ *   buffer     - The buffer receiving the data
+ *   start      - The first sector to read
+ *   nsectors   - The number of sectors to read
+ *   sectorsize - The sector size of the driver
+ *
+ * Returned Value:
+ *   The number of sectors read, or a negated errno value.
+ *
+ ****************************************************************************/
+
+ssize_t pagecache_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                       blkcnt_t start, unsigned int nsectors,
+                       uint16_t sectorsize);
+
+/****************************************************************************
+ * Name: pagecache_write
+ *
+ * Description:
+ *   Write sectors of a block driver into the page cache.  They are written
+ *   to the driver later, unless they are more than the cache would hold
+ *   comfortably.  This is a replacement for inode->u.i_bops->write().
+ *
+ * Input Parameters:
+ *   inode      - The block driver inode
+ *   buffer     - The data to write
+ *   start      - The first sector to write
+ *   nsectors   - The number of sectors to write
+ *   sectorsize - The sector size of the driver
+ *
+ * Returned Value:
+ *   The number of sectors written, or a negated errno value.
+ *
+ ****************************************************************************/
+
+ssize_t pagecache_write(FAR struct inode *inode,
+                        FAR const unsigned char *buffer, blkcnt_t start,
+                        unsigned int nsectors, uint16_t sectorsize);
+
+/****************************************************************************
+ * Name: pagecache_flush
+ *
+ * Description:
+ *   Write back the modified pages of a block driver, or of all the drivers
+ *   if inode is NULL.
+ *
+ * Returned Value:
+ *   Zero on success, or the first negated errno value of the writes.
+ *
+ ****************************************************************************/
+
+int pagecache_flush(FAR struct inode *inode);
+
+/****************************************************************************
+ * Name: pagecache_invalidate
+ *
+ * Description:
+ *   Drop the pages of a block driver, when it is released or its media is
+ *   changed.  The modified pages are written back first if writeback is
+ *   true, or lost.
+ *
+ * Returned Value:
+ *   Zero on success, or the first negated errno value of the writes.
+ *
+ ****************************************************************************/
+
+int pagecache_invalidate(FAR struct inode *inode, bool writeback);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_FS_PAGECACHE */
+#endif /* __INCLUDE_NUTTX_FS_PAGECACHE_H */
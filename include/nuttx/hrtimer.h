@@ -30,7 +30,6 @@
 #include <nuttx/config.h>
 #include <nuttx/clock.h>
 #include <nuttx/compiler.h>
-#include <nuttx/spinlock.h>
 
 #include <stdint.h>
 #include <sys/tree.h>
@@ -187,6 +186,23 @@ int hrtimer_start(FAR hrtimer_t *hrtimer, hrtimer_entry_t func,
                   uint64_t expired,
                   enum hrtimer_mode_e mode);
 
+/****************************************************************************
+ * Name: hrtimer_remaining
+ *
+ * Description:
+ *   Return the time remaining before the specified high-resolution timer
+ *   expires.
+ *
+ * Input Parameters:
+ *   hrtimer - Timer instance to query
+ *
+ * Returned Value:
+ *   The time in nanoseconds remaining until the timer expires.  Zero
+ *   means that the timer is not armed or has already expired.
+ ****************************************************************************/
+
+uint64_t hrtimer_remaining(FAR hrtimer_t *hrtimer);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -128,6 +128,7 @@ struct iob_s
 
 #ifdef CONFIG_IOB_ALLOC
   iob_free_cb_t io_free;  /* Custom free callback */
+  FAR void     *io_arg;   /* Argument of the free callback */
   FAR uint8_t  *io_data;
 #else
   uint8_t       io_data[CONFIG_IOB_BUFSIZE];
@@ -266,6 +267,24 @@ FAR struct iob_s *iob_alloc_dynamic(uint16_t size);
 FAR struct iob_s *iob_alloc_with_data(FAR void *data, uint16_t size,
                                       iob_free_cb_t free_cb);
 
+/****************************************************************************
+ * Name: iob_alloc_with_arg
+ *
+ * Description:
+ *   Allocate an I/O buffer from heap and attach the external payload, like
+ *   iob_alloc_with_data(), but free_cb is called with arg rather than data.
+ *
+ * Input Parameters:
+ *   data    - The external payload
+ *   size    - The size of the data parameter
+ *   free_cb - Called when the iob is freed
+ *   arg     - The argument of free_cb
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_with_arg(FAR void *data, uint16_t size,
+                                     iob_free_cb_t free_cb, FAR void *arg);
+
 /****************************************************************************
  * Name: iob_init_with_data
  *
@@ -41,6 +41,10 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* The size of the trailer of every expanded memory block of a pool */
+
+#define MEMPOOL_HEADER_SIZE (sizeof(sq_entry_t) + CONFIG_MM_NODE_GUARDSIZE)
+
 #if CONFIG_MM_BACKTRACE >= 0
 #  define MEMPOOL_REALBLOCKSIZE(pool) (ALIGN_UP((pool)->blocksize + \
                                        sizeof(struct mempool_backtrace_s), \
@@ -87,6 +91,21 @@ struct mempool_procfs_entry_s
 };
 #endif
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+/* This structure describes the free block cache of one CPU */
+
+struct mempool_cache_s
+{
+#ifdef CONFIG_SMP
+  spinlock_t      lock;   /* Taken by the CPUs draining the cache */
+#endif
+  FAR sq_entry_t *head;   /* The list of cached free blocks */
+  size_t          count;  /* The number of cached free blocks */
+  unsigned long   hits;   /* The number of allocations served by cache */
+  unsigned long   misses; /* The number of allocations missing cache */
+};
+#endif
+
 /* This structure describes memory buffer pool */
 
 struct mempool_s
@@ -110,6 +129,9 @@ struct mempool_s
   size_t     nalloc;  /* The number of used block in mempool */
   spinlock_t lock;    /* The protect lock to mempool */
   sem_t      waitsem; /* The semaphore of waiter get free block */
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+  struct mempool_cache_s cache[CONFIG_SMP_NCPUS]; /* The per-CPU caches */
+#endif
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
   struct mempool_procfs_entry_s procfs; /* The entry of procfs */
 #endif
@@ -139,6 +161,10 @@ struct mempoolinfo_s
   unsigned long aordblks; /* This is the number of used blocks */
   unsigned long sizeblks; /* This is the size of a mempool blocks */
   unsigned long nwaiter;  /* This is the number of waiter for mempool */
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+  unsigned long nhits;    /* This is the number of per-CPU cache hits */
+  unsigned long nmisses;  /* This is the number of per-CPU cache misses */
+#endif
 };
 
 /****************************************************************************
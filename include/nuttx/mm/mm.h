@@ -141,7 +141,7 @@
 #if CONFIG_MM_BACKTRACE >= 0
 #  define MM_DUMP_ALLOC(dump, node) \
     ((node) != NULL && (dump)->pid == PID_MM_ALLOC && \
-     (node)->pid != PID_MM_MEMPOOL)
+     (node)->pid != PID_MM_MEMPOOL && (node)->pid != PID_MM_CACHE)
 #  ifdef CONFIG_MM_BACKTRACE_SEQNO
 #    define MM_DUMP_SEQNO(dump, node) \
     ((node)->seqno >= (dump)->seqmin && (node)->seqno <= (dump)->seqmax)
@@ -182,6 +182,48 @@
 
 struct mm_heap_s; /* Forward reference */
 
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+/* Statistics of the per-CPU chunk caches of a heap */
+
+struct mm_cacheinfo_s
+{
+  size_t        cached;   /* Bytes held in the caches */
+  size_t        nchunks;  /* Chunks held in the caches */
+  unsigned long hits;     /* Allocations served by the caches */
+  unsigned long misses;   /* Allocations not served by the caches */
+  unsigned long refills;  /* Batches taken from the heap */
+  unsigned long flushes;  /* Batches returned to the heap */
+};
+#endif
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+/* Telemetry counters of a heap.  Size class n counts the blocks with a
+ * usable size of [2^n, 2^(n+1)) bytes and latency class n the allocations
+ * that took [2^n, 2^(n+1)) perf counter ticks.  The last class of both
+ * also holds everything larger.
+ */
+
+#  define MM_TELEMETRY_NCLASSES 24
+
+struct mm_telemetry_s
+{
+  unsigned long nalloc[MM_TELEMETRY_NCLASSES];  /* Allocations */
+  unsigned long nfree[MM_TELEMETRY_NCLASSES];   /* Frees */
+  unsigned long latency[MM_TELEMETRY_NCLASSES]; /* Allocation latency */
+  unsigned long nlocks;                         /* Heap mutex taken */
+  unsigned long ncontended;                     /* Heap mutex waited for */
+  clock_t       waittime;                       /* Ticks spent waiting */
+};
+
+/* Snapshot of the telemetry of a heap */
+
+struct mm_telemetryinfo_s
+{
+  struct mm_telemetry_s total;                  /* Counters of all CPUs */
+  unsigned long nchunks[MM_TELEMETRY_NCLASSES]; /* Free chunks */
+};
+#endif
+
 struct mempool_init_s
 {
   FAR const size_t *poolsize;
@@ -421,6 +463,29 @@ struct mallinfo_task mm_mallinfo_task(FAR struct mm_heap_s *heap,
 size_t mm_heapfree(FAR struct mm_heap_s *heap);
 size_t mm_heapfree_largest(FAR struct mm_heap_s *heap);
 
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+void mm_cacheinfo(FAR struct mm_heap_s *heap,
+                  FAR struct mm_cacheinfo_s *info);
+#endif
+
+/* Functions contained in mm_mallinfo.c or mm_tlsf.c ************************/
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+void mm_telemetry(FAR struct mm_heap_s *heap,
+                  FAR struct mm_telemetryinfo_s *info);
+#endif
+
+/* Functions contained in mm_telemetry.c ************************************/
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+void mm_telemetry_merge(FAR struct mm_telemetry_s *total,
+                        FAR const struct mm_telemetry_s *telemetry);
+clock_t mm_telemetry_latency(FAR const struct mm_telemetry_s *telemetry,
+                             int percent);
+#endif
+
 /* Functions contained in kmm_mallinfo.c ************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
@@ -0,0 +1,150 @@
+/****************************************************************************
+ * include/nuttx/mm/objcache.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_OBJCACHE_H
+#define __INCLUDE_NUTTX_MM_OBJCACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+
+#include <nuttx/mm/mempool.h>
+
+#ifdef CONFIG_MM_OBJCACHE
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The constructor of the objects of a cache, it is called on every object
+ * returned by objcache_alloc().
+ */
+
+typedef CODE void (*objcache_ctor_t)(FAR void *obj, size_t size);
+
+/* This structure describes a named cache of fixed size kernel objects.
+ * The objects are carved out of blocks of the kernel heap by a memory
+ * pool, so allocating and freeing an object is O(1) and objects of the
+ * same type are packed together.
+ */
+
+struct objcache_s
+{
+  struct mempool_s pool; /* The pool holding the objects */
+  objcache_ctor_t  ctor; /* The constructor of the objects */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: objcache_create
+ *
+ * Description:
+ *   Create a named object cache.  The cache is listed in /proc/mempool
+ *   with its name.
+ *
+ * Input Parameters:
+ *   name    - The name of the cache, it must stay valid while the cache
+ *             exists.
+ *   size    - The size of every object.
+ *   ninit   - The number of objects allocated at creation.
+ *   nexpand - The number of objects added each time the cache is empty.
+ *   ctor    - The constructor of the objects, may be NULL.
+ *
+ * Returned Value:
+ *   The new cache on success; NULL on any failure.
+ *
+ ****************************************************************************/
+
+FAR struct objcache_s *objcache_create(FAR const char *name, size_t size,
+                                       size_t ninit, size_t nexpand,
+                                       objcache_ctor_t ctor);
+
+/****************************************************************************
+ * Name: objcache_destroy
+ *
+ * Description:
+ *   Destroy an object cache.  All objects must have been freed.
+ *
+ * Input Parameters:
+ *   cache - The cache to be destroyed.
+ *
+ * Returned Value:
+ *   Zero on success; -EBUSY if objects are still in use.
+ *
+ ****************************************************************************/
+
+int objcache_destroy(FAR struct objcache_s *cache);
+
+/****************************************************************************
+ * Name: objcache_alloc
+ *
+ * Description:
+ *   Allocate an object from the cache and run the constructor on it.
+ *
+ * Input Parameters:
+ *   cache - The cache to be used.
+ *
+ * Returned Value:
+ *   The object on success; NULL if the cache can not be expanded.
+ *
+ ****************************************************************************/
+
+FAR void *objcache_alloc(FAR struct objcache_s *cache);
+
+/****************************************************************************
+ * Name: objcache_free
+ *
+ * Description:
+ *   Return an object to the cache.  This may be called from an interrupt
+ *   handler.
+ *
+ * Input Parameters:
+ *   cache - The cache the object was allocated from.
+ *   obj   - The object to be freed.
+ *
+ ****************************************************************************/
+
+void objcache_free(FAR struct objcache_s *cache, FAR void *obj);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_MM_OBJCACHE */
+#endif /* __INCLUDE_NUTTX_MM_OBJCACHE_H */
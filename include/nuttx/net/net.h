@@ -181,6 +181,19 @@ struct sock_intf_s
                     FAR struct file *infile, FAR off_t *offset,
                     size_t count);
 #endif
+
+  /* Optional batch operations of recvmmsg() and sendmmsg().  They transfer
+   * the first message as si_recvmsg()/si_sendmsg() would, then as many of
+   * the next ones as possible without blocking, and return the number of
+   * messages transferred.
+   */
+
+  CODE int        (*si_recvmmsg)(FAR struct socket *psock,
+                    FAR struct mmsghdr *msgvec, unsigned int vlen,
+                    int flags);
+  CODE int        (*si_sendmmsg)(FAR struct socket *psock,
+                    FAR struct mmsghdr *msgvec, unsigned int vlen,
+                    int flags);
 };
 
 /* Each socket refers to a connection structure of type FAR void *.  Each
@@ -193,6 +206,23 @@ struct sock_intf_s
 
 struct devif_callback_s;  /* Forward reference */
 
+/* Link of a connection in a hash table of connections, see net_hash_add() */
+
+struct net_hashnode_s
+{
+  FAR struct net_hashnode_s *next; /* Next node in the same bucket */
+  uint32_t hash;                   /* Hash of the key of the node */
+};
+
+/* Timer of an idle entry in a timer wheel, see net_wheel_add() */
+
+struct net_wheelnode_s
+{
+  dq_entry_t node;                 /* Entry of the slot */
+  int32_t expire;                  /* Expiration time, in seconds */
+  uint8_t slot;                    /* The slot holding the node */
+};
+
 struct socket_conn_s
 {
   /* Common prologue of all connection structures. */
@@ -227,6 +257,13 @@ struct socket_conn_s
   uint8_t       s_boundto;   /* Index of the interface we are bound to.
                               * Unbound: 0, Bound: 1-MAX_IFINDEX */
 #  endif
+#  ifdef CONFIG_NET_ZEROCOPY
+  uint32_t      s_zcnext;    /* ID of the next MSG_ZEROCOPY send */
+  dq_queue_t    s_zcpend;    /* MSG_ZEROCOPY sends still referenced */
+  dq_queue_t    s_zcdone;    /* Completion notifications to be read */
+  dq_entry_t    s_zcnode;    /* Entry of the sockets to notify */
+  bool          s_zcnotify;  /* Waiting for the notification work */
+#  endif
 #endif
 
   /* Definitions of 8-bit socket flags */
@@ -914,6 +951,68 @@ ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                       int flags);
 
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends a vector of messages to a socket.  This is an
+ *   internal OS interface.  It is functionally equivalent to sendmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    The messages to send
+ *   vlen      The number of messages in msgvec
+ *   flags     Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent, the msg_len field of
+ *   each of them is the number of characters sent.  Otherwise, if no
+ *   message could be sent, a negated errno value is returned (see comments
+ *   with sendmsg() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives a vector of messages from a socket.  This is
+ *   an internal OS interface.  It is functionally equivalent to recvmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    Buffers to receive the messages
+ *   vlen      The number of messages in msgvec
+ *   flags     Receive flags
+ *   timeout   The time to wait for the messages, or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received, the msg_len field
+ *   of each of them is the number of characters received.  Otherwise, if no
+ *   message could be received, a negated errno value is returned (see
+ *   comments with recvmsg() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout);
+
 /****************************************************************************
  * Name: psock_send
  *
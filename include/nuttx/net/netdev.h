@@ -440,6 +440,12 @@ struct net_driver_s
   struct iob_queue_s d_arpout;
 #endif
 
+  /* Remember the segments of a TCP large send waiting to be sent */
+
+#ifdef CONFIG_NET_TCP_TSO
+  struct iob_queue_s d_tsoout;
+#endif
+
   /* The d_buf array is used to hold incoming and outgoing packets. The
    * device driver should place incoming data into this buffer.  When sending
    * data, the device driver should read the link level headers and the
@@ -496,6 +502,22 @@ struct net_driver_s
 
   uint16_t d_sndlen;
 
+#ifdef CONFIG_NET_TCP_TSO
+  /* When d_buf contains a TCP large send, d_tsomss is the size of the data
+   * of the segments it is split into by tcp_segout(), zero otherwise.
+   */
+
+  uint16_t d_tsomss;
+#endif
+
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  /* d_looped is true while d_buf holds a packet looped back to ourself by
+   * devif_loopback(), which was already accounted on its way out.
+   */
+
+  bool d_looped;
+#endif
+
   /* Multicast group support */
 
 #ifdef CONFIG_NET_IGMP
@@ -28,13 +28,14 @@
  ****************************************************************************/
 
 #include <nuttx/mutex.h>
+#include <nuttx/spinlock.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
 #define RWSEM_NO_HOLDER     ((pid_t)-1)
-#define RWSEM_INITIALIZER   {NXMUTEX_INITIALIZER, SEM_INITIALIZER(0), \
+#define RWSEM_INITIALIZER   {SP_UNLOCKED, SEM_INITIALIZER(0), \
                              RWSEM_NO_HOLDER, 0, 0, 0}
 
 /****************************************************************************
@@ -43,7 +44,7 @@
 
 typedef struct
 {
-  mutex_t protected;    /* Protecting Locks for Read/Write Locked Tables */
+  spinlock_t protected; /* Protects the counts, never held while blocked */
   sem_t   waiting;      /* Reader/writer Waiting queue */
   pid_t   holder;       /* The write lock holder, this lock still can be
                          * locked when the holder is same as the current
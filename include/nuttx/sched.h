@@ -50,6 +50,10 @@
 #include <nuttx/tls.h>
 #include <nuttx/spinlock_type.h>
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+#  include <nuttx/hrtimer.h>
+#endif
+
 #include <arch/arch.h>
 
 /****************************************************************************
@@ -631,6 +635,9 @@ struct tcb_s
 #endif
 
   struct wdog_s waitdog;                 /* All timed waits use this timer  */
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  hrtimer_t waithrtimer;                 /* Sub-tick timer for nanosleep()  */
+#endif
 
   /* Stack-Related Fields ***************************************************/
 
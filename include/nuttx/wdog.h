@@ -35,6 +35,10 @@
 #include <errno.h>
 #include <stdint.h>
 
+#ifdef CONFIG_SCHED_WDOG_RBTREE
+#  include <sys/tree.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -79,11 +83,15 @@ typedef uint32_t  wdparm_t;
 
 typedef CODE void (*wdentry_t)(wdparm_t arg);
 
-/* Support a doubly linked list of watchdog timers */
+/* Support a doubly linked list (or a red-black tree) of watchdog timers */
 
 struct wdog_s
 {
+#ifdef CONFIG_SCHED_WDOG_RBTREE
+  RB_ENTRY(wdog_s)  entry;       /* Supports a tree sorted by expiration */
+#else
   struct list_node  node;        /* Supports a doubly linked list */
+#endif
   wdparm_t           arg;        /* Callback argument */
   wdentry_t          func;       /* Function to execute when delay expires */
 #ifdef CONFIG_PIC
@@ -136,6 +136,12 @@
 #define MSG_ERRQUEUE     0x002000 /* Fetch message from error queue.  */
 #define MSG_NOSIGNAL     0x004000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE         0x008000 /* Sender will send more.  */
+#define MSG_ZEROCOPY     0x010000 /* Send the user data without copying it,
+                                   * with SO_ZEROCOPY.
+                                   */
+#define MSG_WAITFORONE   0x020000 /* recvmmsg(): block until one message is
+                                   * received.
+                                   */
 #define MSG_CMSG_CLOEXEC 0x100000 /* Set close_on_exit for file
                                    * descriptor received through SCM_RIGHTS.
                                    */
@@ -223,6 +229,10 @@
 #define SO_TIMESTAMPNS  20 /* Generates a timestamp in ns for each incoming packet
                             * arg: integer value
                             */
+#define SO_ZEROCOPY     21 /* Allows MSG_ZEROCOPY sends (get/set).
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
 
 /* The options are unsupported but included for compatibility
  * and portability
@@ -377,6 +387,14 @@ struct msghdr
   unsigned int msg_flags;
 };
 
+/* A message of recvmmsg()/sendmmsg() and its length */
+
+struct mmsghdr
+{
+  struct msghdr msg_hdr;        /* Message header */
+  unsigned int msg_len;         /* Number of bytes transmitted */
+};
+
 struct cmsghdr
 {
   unsigned long cmsg_len;       /* Data byte count, including hdr */
@@ -391,6 +409,31 @@ struct ucred
   gid_t gid;
 };
 
+/* The error reported by recvmsg() with MSG_ERRQUEUE.  A MSG_ZEROCOPY
+ * completion has the origin SO_EE_ORIGIN_ZEROCOPY, it reports that the
+ * sends from ee_info to ee_data, counted from zero on the socket, no
+ * longer reference the user data.
+ */
+
+#define SO_EE_ORIGIN_NONE           0
+#define SO_EE_ORIGIN_LOCAL          1
+#define SO_EE_ORIGIN_ICMP           2
+#define SO_EE_ORIGIN_ICMP6          3
+#define SO_EE_ORIGIN_ZEROCOPY       5
+
+#define SO_EE_CODE_ZEROCOPY_COPIED  1 /* The data was copied after all */
+
+struct sock_extended_err
+{
+  uint32_t ee_errno;            /* Error number */
+  uint8_t  ee_origin;           /* Where the error originated */
+  uint8_t  ee_type;             /* Type */
+  uint8_t  ee_code;             /* Code */
+  uint8_t  ee_pad;              /* Padding */
+  uint32_t ee_info;             /* Additional information */
+  uint32_t ee_data;             /* Other data */
+};
+
 /****************************************************************************
  * Inline Functions
  ****************************************************************************/
@@ -464,6 +507,12 @@ int getpeername(int sockfd, FAR struct sockaddr *addr,
 ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
 
+struct timespec;
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout);
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags);
+
 #if CONFIG_FORTIFY_SOURCE > 0
 fortify_function(send) ssize_t send(int sockfd, FAR const void *buf,
                                     size_t len, int flags)
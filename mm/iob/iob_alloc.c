@@ -378,6 +378,28 @@ FAR struct iob_s *iob_alloc_dynamic(uint16_t size)
 
 FAR struct iob_s *iob_alloc_with_data(FAR void *data, uint16_t size,
                                       iob_free_cb_t free_cb)
+{
+  return iob_alloc_with_arg(data, size, free_cb, data);
+}
+
+/****************************************************************************
+ * Name: iob_alloc_with_arg
+ *
+ * Description:
+ *   Allocate an I/O buffer from heap and attach the external payload, like
+ *   iob_alloc_with_data(), but free_cb is called with arg rather than data.
+ *   This lets the caller track the payload references without a lookup.
+ *
+ * Input Parameters:
+ *   data    - The external payload
+ *   size    - The size of the data parameter
+ *   free_cb - Called when the iob is freed
+ *   arg     - The argument of free_cb
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_with_arg(FAR void *data, uint16_t size,
+                                     iob_free_cb_t free_cb, FAR void *arg)
 {
   FAR struct iob_s *iob;
 
@@ -392,6 +414,7 @@ FAR struct iob_s *iob_alloc_with_data(FAR void *data, uint16_t size,
       iob->io_bufsize = size;    /* Total length of the iob buffer */
       iob->io_pktlen  = 0;       /* Total length of the packet */
       iob->io_free    = free_cb; /* Customer free callback */
+      iob->io_arg     = arg;     /* Argument of the free callback */
       iob->io_data    = data;
     }
 
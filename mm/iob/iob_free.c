@@ -129,7 +129,7 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
         }
       else
         {
-          iob->io_free(iob->io_data);
+          iob->io_free(iob->io_arg);
           kmm_free(iob);
         }
 
@@ -26,10 +26,13 @@
 
 #include <assert.h>
 #include <execinfo.h>
+#include <string.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <syslog.h>
+#include <sys/param.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mm/kasan.h>
 #include <nuttx/mm/mempool.h>
@@ -40,7 +43,30 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define MEMPOOL_HEADER_SIZE (sizeof(sq_entry_t) + CONFIG_MM_NODE_GUARDSIZE)
+/* The per-CPU cache is protected by disabling the local interrupts, which
+ * is only possible in the kernel.  With SMP, its lock is also taken, only
+ * contended when another CPU drains the cache.  Pools waiting for free
+ * blocks must see every released block and so bypass the cache.
+ */
+
+#if defined(CONFIG_MM_MEMPOOL_PERCPU_CACHE) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define MEMPOOL_CACHE_ENABLED   1
+#  define MEMPOOL_CACHE_BATCH     MIN(CONFIG_MM_MEMPOOL_PERCPU_CACHE_BATCH, \
+                                      CONFIG_MM_MEMPOOL_PERCPU_CACHE_DEPTH)
+#  define MEMPOOL_CACHEABLE(pool) (!(pool)->wait || (pool)->expandsize != 0)
+#  define mempool_reclaim(pool)   (MEMPOOL_CACHEABLE(pool) && \
+                                   mempool_cache_drain(pool))
+#  ifdef CONFIG_SMP
+#    define mempool_cache_lock(cache)   spin_lock(&(cache)->lock)
+#    define mempool_cache_unlock(cache) spin_unlock(&(cache)->lock)
+#  else
+#    define mempool_cache_lock(cache)
+#    define mempool_cache_unlock(cache)
+#  endif
+#else
+#  define mempool_reclaim(pool)   false
+#endif
 
 #if CONFIG_MM_BACKTRACE >= 0
 #define MEMPOOL_MAGIC_FREE  0x55555555
@@ -100,6 +126,301 @@ static inline void mempool_add_queue(FAR struct mempool_s *pool,
     }
 }
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+/****************************************************************************
+ * Name: mempool_cache_count
+ *
+ * Description:
+ *   Return the number of free blocks held in the caches of all CPUs.  The
+ *   cached blocks are included in nalloc.
+ *
+ ****************************************************************************/
+
+static size_t mempool_cache_count(FAR struct mempool_s *pool)
+{
+  size_t count = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      count += pool->cache[cpu].count;
+    }
+
+  return count;
+}
+
+/****************************************************************************
+ * Name: mempool_cache_drain
+ *
+ * Description:
+ *   Return the blocks held in the caches of all CPUs to the pool.
+ *
+ * Returned Value:
+ *   true if any block was returned to the pool.
+ *
+ ****************************************************************************/
+
+static bool mempool_cache_drain(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_cache_s *cache;
+  FAR sq_entry_t *blk;
+  irqstate_t flags;
+  bool drained = false;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &pool->cache[cpu];
+      if (cache->head == NULL)
+        {
+          continue;
+        }
+
+      flags = up_irq_save();
+      mempool_cache_lock(cache);
+      spin_lock(&pool->lock);
+      while ((blk = cache->head) != NULL)
+        {
+          cache->head = blk->flink;
+          sq_addlast(blk, &pool->queue);
+          pool->nalloc--;
+          drained = true;
+        }
+
+      cache->count = 0;
+      spin_unlock(&pool->lock);
+      mempool_cache_unlock(cache);
+      up_irq_restore(flags);
+    }
+
+  return drained;
+}
+#endif
+
+#ifdef MEMPOOL_CACHE_ENABLED
+/****************************************************************************
+ * Name: mempool_cache_alloc
+ *
+ * Description:
+ *   Take a free block from the cache of this CPU.  An empty cache is
+ *   refilled with a batch of blocks taken from the pool with a single
+ *   acquisition of the pool spinlock.
+ *
+ * Returned Value:
+ *   The (poisoned) block, or NULL if the free queue of the pool is empty.
+ *
+ ****************************************************************************/
+
+static FAR sq_entry_t *mempool_cache_alloc(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_cache_s *cache;
+  FAR sq_entry_t *blk;
+  FAR sq_entry_t *tmp;
+  irqstate_t flags;
+  int n;
+
+  flags = up_irq_save();
+  cache = &pool->cache[this_cpu()];
+  mempool_cache_lock(cache);
+  blk   = cache->head;
+  if (blk != NULL)
+    {
+      cache->head = blk->flink;
+      cache->count--;
+      cache->hits++;
+      mempool_cache_unlock(cache);
+      up_irq_restore(flags);
+
+      blk->flink = NULL;
+      return blk;
+    }
+
+  /* Keep the first block and cache the rest of the batch */
+
+  cache->misses++;
+  spin_lock(&pool->lock);
+  blk = mempool_remove_queue(pool, &pool->queue);
+  if (blk != NULL)
+    {
+      pool->nalloc++;
+      for (n = 1; n < MEMPOOL_CACHE_BATCH; n++)
+        {
+          tmp = mempool_remove_queue(pool, &pool->queue);
+          if (tmp == NULL)
+            {
+              break;
+            }
+
+          tmp->flink  = cache->head;
+          cache->head = tmp;
+          cache->count++;
+          pool->nalloc++;
+        }
+    }
+
+  spin_unlock(&pool->lock);
+  mempool_cache_unlock(cache);
+  up_irq_restore(flags);
+  return blk;
+}
+
+/****************************************************************************
+ * Name: mempool_cache_release
+ *
+ * Description:
+ *   Put a released block into the cache of this CPU.  When the cache is
+ *   full, a batch of blocks is returned to the pool first.
+ *
+ * Returned Value:
+ *   true if the block was cached; false if it must go back to the pool.
+ *
+ ****************************************************************************/
+
+static bool mempool_cache_release(FAR struct mempool_s *pool, FAR void *blk)
+{
+  FAR struct mempool_cache_s *cache;
+  FAR sq_entry_t *tmp;
+  irqstate_t flags;
+  int n;
+#if CONFIG_MM_BACKTRACE >= 0
+  FAR struct mempool_backtrace_s *buf =
+    (FAR struct mempool_backtrace_s *)((FAR char *)blk + pool->blocksize);
+#endif
+
+  /* The blocks of the interrupt pool always return to the iqueue */
+
+  if (pool->ibase != NULL && (FAR char *)blk >= pool->ibase &&
+      (FAR char *)blk < pool->ibase + pool->interruptsize)
+    {
+      return false;
+    }
+
+  flags = up_irq_save();
+
+#if CONFIG_MM_BACKTRACE >= 0
+  /* Check double free or out of out of bounds */
+
+  DEBUGASSERT(buf->magic == MEMPOOL_MAGIC_ALLOC);
+  buf->magic = MEMPOOL_MAGIC_FREE;
+#endif
+
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+  memset(blk, MM_FREE_MAGIC, pool->blocksize);
+#endif
+
+  cache = &pool->cache[this_cpu()];
+  mempool_cache_lock(cache);
+  if (cache->count >= CONFIG_MM_MEMPOOL_PERCPU_CACHE_DEPTH)
+    {
+      spin_lock(&pool->lock);
+      for (n = 0; n < MEMPOOL_CACHE_BATCH; n++)
+        {
+          tmp         = cache->head;
+          cache->head = tmp->flink;
+          cache->count--;
+          sq_addlast(tmp, &pool->queue);
+          pool->nalloc--;
+        }
+
+      spin_unlock(&pool->lock);
+    }
+
+  ((FAR sq_entry_t *)blk)->flink = cache->head;
+  cache->head = blk;
+  cache->count++;
+  mempool_cache_unlock(cache);
+
+  kasan_poison(blk, pool->blocksize);
+  up_irq_restore(flags);
+  return true;
+}
+#endif
+
+/****************************************************************************
+ * Name: mempool_remove_block
+ *
+ * Description:
+ *   Take a free block from the pool with the pool spinlock held, expanding
+ *   the pool or waiting for a free block when the queue is empty.  The
+ *   blocks cached by the CPUs are returned to the pool before failing.
+ *
+ ****************************************************************************/
+
+static FAR sq_entry_t *mempool_remove_block(FAR struct mempool_s *pool)
+{
+  FAR sq_entry_t *blk;
+  irqstate_t flags;
+
+retry:
+  flags = spin_lock_irqsave(&pool->lock);
+  blk = mempool_remove_queue(pool, &pool->queue);
+  if (blk == NULL)
+    {
+      if (up_interrupt_context())
+        {
+          blk = mempool_remove_queue(pool, &pool->iqueue);
+          if (blk == NULL)
+            {
+              spin_unlock_irqrestore(&pool->lock, flags);
+              if (mempool_reclaim(pool))
+                {
+                  goto retry;
+                }
+
+              return blk;
+            }
+        }
+      else
+        {
+          size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+
+          spin_unlock_irqrestore(&pool->lock, flags);
+          if (pool->expandsize >= blocksize + MEMPOOL_HEADER_SIZE)
+            {
+              size_t nexpand = (pool->expandsize - MEMPOOL_HEADER_SIZE) /
+                               blocksize;
+              size_t size = nexpand * blocksize + MEMPOOL_HEADER_SIZE;
+              FAR char *base = pool->alloc(pool, size);
+
+              if (base == NULL)
+                {
+                  if (mempool_reclaim(pool))
+                    {
+                      goto retry;
+                    }
+
+                  return NULL;
+                }
+
+              kasan_poison(base, size);
+              flags = spin_lock_irqsave(&pool->lock);
+              mempool_add_queue(pool, &pool->queue,
+                                base, nexpand, blocksize);
+              sq_addlast((FAR sq_entry_t *)(base + nexpand * blocksize),
+                         &pool->equeue);
+              blk = mempool_remove_queue(pool, &pool->queue);
+            }
+          else if (mempool_reclaim(pool))
+            {
+              goto retry;
+            }
+          else if (!pool->wait ||
+                   nxsem_wait_uninterruptible(&pool->waitsem) < 0)
+            {
+              return NULL;
+            }
+          else
+            {
+              goto retry;
+            }
+        }
+    }
+
+  pool->nalloc++;
+  spin_unlock_irqrestore(&pool->lock, flags);
+  return blk;
+}
+
 #if CONFIG_MM_BACKTRACE >= 0
 static inline void mempool_add_backtrace(FAR struct mempool_s *pool,
                                          FAR struct mempool_backtrace_s *buf)
@@ -269,6 +590,10 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
   sq_init(&pool->iqueue);
   sq_init(&pool->equeue);
   pool->nalloc = 0;
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+  memset(pool->cache, 0, sizeof(pool->cache));
+#endif
+
   if (pool->interruptsize >= blocksize)
     {
       size_t ninterrupt = pool->interruptsize / blocksize;
@@ -351,63 +676,24 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
 
 FAR void *mempool_allocate(FAR struct mempool_s *pool)
 {
-  FAR sq_entry_t *blk;
-  irqstate_t flags;
+  FAR sq_entry_t *blk = NULL;
+
+#ifdef MEMPOOL_CACHE_ENABLED
+  if (MEMPOOL_CACHEABLE(pool))
+    {
+      blk = mempool_cache_alloc(pool);
+    }
+#endif
 
-retry:
-  flags = spin_lock_irqsave(&pool->lock);
-  blk = mempool_remove_queue(pool, &pool->queue);
   if (blk == NULL)
     {
-      if (up_interrupt_context())
+      blk = mempool_remove_block(pool);
+      if (blk == NULL)
         {
-          blk = mempool_remove_queue(pool, &pool->iqueue);
-          if (blk == NULL)
-            {
-              spin_unlock_irqrestore(&pool->lock, flags);
-              return blk;
-            }
-        }
-      else
-        {
-          size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
-
-          spin_unlock_irqrestore(&pool->lock, flags);
-          if (pool->expandsize >= blocksize + MEMPOOL_HEADER_SIZE)
-            {
-              size_t nexpand = (pool->expandsize - MEMPOOL_HEADER_SIZE) /
-                               blocksize;
-              size_t size = nexpand * blocksize + MEMPOOL_HEADER_SIZE;
-              FAR char *base = pool->alloc(pool, size);
-
-              if (base == NULL)
-                {
-                  return NULL;
-                }
-
-              kasan_poison(base, size);
-              flags = spin_lock_irqsave(&pool->lock);
-              mempool_add_queue(pool, &pool->queue,
-                                base, nexpand, blocksize);
-              sq_addlast((FAR sq_entry_t *)(base + nexpand * blocksize),
-                         &pool->equeue);
-              blk = mempool_remove_queue(pool, &pool->queue);
-            }
-          else if (!pool->wait ||
-                   nxsem_wait_uninterruptible(&pool->waitsem) < 0)
-            {
-              return NULL;
-            }
-          else
-            {
-              goto retry;
-            }
+          return NULL;
         }
     }
 
-  pool->nalloc++;
-  spin_unlock_irqrestore(&pool->lock, flags);
-
 #if CONFIG_MM_BACKTRACE >= 0
   mempool_add_backtrace(pool, (FAR struct mempool_backtrace_s *)
                               ((FAR char *)blk + pool->blocksize));
@@ -434,11 +720,21 @@ retry:
 
 void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 {
-  irqstate_t flags = spin_lock_irqsave(&pool->lock);
 #if CONFIG_MM_BACKTRACE >= 0
   FAR struct mempool_backtrace_s *buf =
     (FAR struct mempool_backtrace_s *)((FAR char *)blk + pool->blocksize);
+#endif
+  irqstate_t flags;
 
+#ifdef MEMPOOL_CACHE_ENABLED
+  if (MEMPOOL_CACHEABLE(pool) && mempool_cache_release(pool, blk))
+    {
+      return;
+    }
+#endif
+
+  flags = spin_lock_irqsave(&pool->lock);
+#if CONFIG_MM_BACKTRACE >= 0
   /* Check double free or out of out of bounds */
 
   DEBUGASSERT(buf->magic == MEMPOOL_MAGIC_ALLOC);
@@ -500,14 +796,29 @@ void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
 {
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+  size_t ncached = 0;
   irqstate_t flags;
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+  int cpu;
+#endif
 
   DEBUGASSERT(pool != NULL && info != NULL);
 
   flags = spin_lock_irqsave(&pool->lock);
-  info->ordblks = sq_count(&pool->queue);
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+  ncached = mempool_cache_count(pool);
+  info->nhits = 0;
+  info->nmisses = 0;
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      info->nhits += pool->cache[cpu].hits;
+      info->nmisses += pool->cache[cpu].misses;
+    }
+#endif
+
+  info->ordblks = sq_count(&pool->queue) + ncached;
   info->iordblks = sq_count(&pool->iqueue);
-  info->aordblks = pool->nalloc;
+  info->aordblks = pool->nalloc - ncached;
   info->arena = sq_count(&pool->equeue) * MEMPOOL_HEADER_SIZE +
     (info->aordblks + info->ordblks + info->iordblks) * blocksize;
   spin_unlock_irqrestore(&pool->lock, flags);
@@ -547,14 +858,22 @@ mempool_info_task(FAR struct mempool_s *pool,
       size_t count = sq_count(&pool->queue) +
                      sq_count(&pool->iqueue);
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+      count += mempool_cache_count(pool);
+#endif
       spin_unlock_irqrestore(&pool->lock, flags);
       info.aordblks += count;
       info.uordblks += count * blocksize;
     }
   else if (task->pid == PID_MM_ALLOC)
     {
-      info.aordblks += pool->nalloc;
-      info.uordblks += pool->nalloc * blocksize;
+      size_t count = pool->nalloc;
+
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+      count -= mempool_cache_count(pool);
+#endif
+      info.aordblks += count;
+      info.uordblks += count * blocksize;
     }
 #if CONFIG_MM_BACKTRACE >= 0
   else
@@ -624,6 +943,10 @@ int mempool_deinit(FAR struct mempool_s *pool)
   FAR sq_entry_t *blk;
   size_t count = 0;
 
+#ifdef CONFIG_MM_MEMPOOL_PERCPU_CACHE
+  mempool_cache_drain(pool);
+#endif
+
   if (pool->nalloc != 0)
     {
       return -EBUSY;
@@ -0,0 +1,191 @@
+/****************************************************************************
+ * mm/mempool/mempool_objcache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <sys/param.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/objcache.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static FAR void *objcache_pool_alloc(FAR struct mempool_s *pool,
+                                     size_t size)
+{
+  return kmm_malloc(size);
+}
+
+static void objcache_pool_free(FAR struct mempool_s *pool, FAR void *addr)
+{
+  kmm_free(addr);
+}
+
+static void objcache_pool_check(FAR struct mempool_s *pool, FAR void *blk)
+{
+  DEBUGASSERT(kmm_heapmember(blk));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: objcache_create
+ *
+ * Description:
+ *   Create a named object cache.  The cache is listed in /proc/mempool
+ *   with its name.
+ *
+ * Input Parameters:
+ *   name    - The name of the cache, it must stay valid while the cache
+ *             exists.
+ *   size    - The size of every object.
+ *   ninit   - The number of objects allocated at creation.
+ *   nexpand - The number of objects added each time the cache is empty.
+ *   ctor    - The constructor of the objects, may be NULL.
+ *
+ * Returned Value:
+ *   The new cache on success; NULL on any failure.
+ *
+ ****************************************************************************/
+
+FAR struct objcache_s *objcache_create(FAR const char *name, size_t size,
+                                       size_t ninit, size_t nexpand,
+                                       objcache_ctor_t ctor)
+{
+  FAR struct objcache_s *cache;
+  size_t blocksize;
+
+  cache = kmm_zalloc(sizeof(struct objcache_s));
+  if (cache == NULL)
+    {
+      return NULL;
+    }
+
+  /* Every free object holds the link of the free queue */
+
+  cache->pool.blocksize = ALIGN_UP(MAX(size, sizeof(sq_entry_t)), MM_ALIGN);
+  cache->pool.alloc     = objcache_pool_alloc;
+  cache->pool.free      = objcache_pool_free;
+  cache->pool.check     = objcache_pool_check;
+  cache->ctor           = ctor;
+
+  blocksize = MEMPOOL_REALBLOCKSIZE(&cache->pool);
+  if (ninit > 0)
+    {
+      cache->pool.initialsize = ninit * blocksize + MEMPOOL_HEADER_SIZE;
+    }
+
+  if (nexpand > 0)
+    {
+      cache->pool.expandsize = nexpand * blocksize + MEMPOOL_HEADER_SIZE;
+    }
+
+  if (mempool_init(&cache->pool, name) < 0)
+    {
+      kmm_free(cache);
+      return NULL;
+    }
+
+  return cache;
+}
+
+/****************************************************************************
+ * Name: objcache_destroy
+ *
+ * Description:
+ *   Destroy an object cache.  All objects must have been freed.
+ *
+ * Input Parameters:
+ *   cache - The cache to be destroyed.
+ *
+ * Returned Value:
+ *   Zero on success; -EBUSY if objects are still in use.
+ *
+ ****************************************************************************/
+
+int objcache_destroy(FAR struct objcache_s *cache)
+{
+  int ret;
+
+  ret = mempool_deinit(&cache->pool);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  kmm_free(cache);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: objcache_alloc
+ *
+ * Description:
+ *   Allocate an object from the cache and run the constructor on it.
+ *
+ * Input Parameters:
+ *   cache - The cache to be used.
+ *
+ * Returned Value:
+ *   The object on success; NULL if the cache can not be expanded.
+ *
+ ****************************************************************************/
+
+FAR void *objcache_alloc(FAR struct objcache_s *cache)
+{
+  FAR void *obj;
+
+  obj = mempool_allocate(&cache->pool);
+  if (obj != NULL && cache->ctor != NULL)
+    {
+      cache->ctor(obj, cache->pool.blocksize);
+    }
+
+  return obj;
+}
+
+/****************************************************************************
+ * Name: objcache_free
+ *
+ * Description:
+ *   Return an object to the cache.  This may be called from an interrupt
+ *   handler.
+ *
+ * Input Parameters:
+ *   cache - The cache the object was allocated from.
+ *   obj   - The object to be freed.
+ *
+ ****************************************************************************/
+
+void objcache_free(FAR struct objcache_s *cache, FAR void *obj)
+{
+  mempool_release(&cache->pool, obj);
+}
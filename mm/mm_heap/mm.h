@@ -36,12 +36,19 @@
 #include <nuttx/mm/mempool.h>
 #include <nuttx/mm/mm.h>
 
+#ifdef CONFIG_MM_HEAP_HUGE
+#  include <nuttx/mm/gran.h>
+#endif
+
 #include <assert.h>
+#include <sys/param.h>
 #include <sys/types.h>
 #include <stdbool.h>
 #include <string.h>
 #include <unistd.h>
 
+#include "telemetry/telemetry.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -158,6 +165,45 @@
 #define MM_PREVNODE_IS_ALLOC(node) (((node)->size & MM_PREVFREE_BIT) == 0)
 #define MM_PREVNODE_IS_FREE(node) (((node)->size & MM_PREVFREE_BIT) != 0)
 
+/* Per-CPU chunk cache.  Size class n holds chunks of at least
+ * (n + 1) * MM_MIN_CHUNK bytes.
+ */
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+#  define MM_CACHE_NCLASSES  (CONFIG_MM_HEAP_PERCPU_CACHE_MAXSIZE / \
+                              MM_MIN_CHUNK)
+#  define MM_CACHE_MAXCHUNK  (MM_CACHE_NCLASSES * MM_MIN_CHUNK)
+#  define MM_CACHE_BATCH     MIN(CONFIG_MM_HEAP_PERCPU_CACHE_BATCH, \
+                                 CONFIG_MM_HEAP_PERCPU_CACHE_DEPTH)
+#endif
+
+/* Check if a node is held by a chunk cache.  It is owned by PID_MM_CACHE
+ * rather than by a task.
+ */
+
+#if defined(CONFIG_MM_HEAP_PERCPU_CACHE) && CONFIG_MM_BACKTRACE >= 0
+#  define MM_NODE_IS_CACHED(node) ((node)->pid == PID_MM_CACHE)
+#else
+#  define MM_NODE_IS_CACHED(node) (false)
+#endif
+
+/* Huge allocation area.  Every huge allocation is preceded by a struct
+ * mm_hugenode_s describing the granules holding it.
+ */
+
+#ifdef CONFIG_MM_HEAP_HUGE
+#  define MM_HUGE_GRANSIZE      (1 << CONFIG_MM_HEAP_HUGE_LOG2GRAN)
+#  define MM_HUGE_ALIGN_UP(a)   (((a) + MM_HUGE_GRANSIZE - 1) & \
+                                 ~(MM_HUGE_GRANSIZE - 1))
+#  define MM_HUGE_ALIGN_DOWN(a) ((a) & ~(MM_HUGE_GRANSIZE - 1))
+#  define MM_SIZEOF_HUGENODE    MM_ALIGN_UP(sizeof(struct mm_hugenode_s))
+#  define MM_HUGE_NODE(mem)     ((FAR struct mm_hugenode_s *) \
+                                 ((FAR char *)(mem) - MM_SIZEOF_HUGENODE))
+#  define MM_HUGE_MEMBER(heap, mem) \
+     ((FAR char *)(mem) >= (heap)->mm_hugestart && \
+      (FAR char *)(mem) < (heap)->mm_hugestart + (heap)->mm_hugesize)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -216,6 +262,38 @@ struct mm_delaynode_s
   FAR struct mm_delaynode_s *flink;
 };
 
+/* This describes a huge allocation */
+
+#ifdef CONFIG_MM_HEAP_HUGE
+struct mm_hugenode_s
+{
+  FAR char *base;                           /* First granule */
+  size_t size;                              /* Size of the granules */
+};
+#endif
+
+/* This describes the chunk cache of one CPU.  The cached chunks stay
+ * allocated from the heap point of view and are linked through their
+ * payload, like the chunks in the delay list.  They are owned by
+ * PID_MM_CACHE.
+ */
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+struct mm_cache_s
+{
+#ifdef CONFIG_SMP
+  spinlock_t lock;                          /* Taken to flush other CPUs */
+#endif
+  FAR struct mm_delaynode_s *list[MM_CACHE_NCLASSES];
+  uint16_t count[MM_CACHE_NCLASSES];
+  size_t cached;                            /* Bytes held in the cache */
+  unsigned long hits;                       /* Allocations served */
+  unsigned long misses;                     /* Allocations not served */
+  unsigned long refills;                    /* Batches taken from heap */
+  unsigned long flushes;                    /* Batches returned to heap */
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -260,6 +338,27 @@ struct mm_heap_s
   size_t mm_delaycount[CONFIG_SMP_NCPUS];
 #endif
 
+  /* Per-CPU cache of small chunks */
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  struct mm_cache_s mm_cache[CONFIG_SMP_NCPUS];
+#endif
+
+  /* Huge allocation area, the granule allocator is created on first use */
+
+#ifdef CONFIG_MM_HEAP_HUGE
+  FAR char *mm_hugestart;
+  size_t mm_hugesize;
+  GRAN_HANDLE mm_huge;
+  FAR struct mm_delaynode_s *mm_hugedelay[CONFIG_SMP_NCPUS];
+#endif
+
+  /* Per-CPU telemetry counters */
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+  struct mm_telemetry_s mm_telemetry[CONFIG_SMP_NCPUS];
+#endif
+
   /* The is a multiple mempool of the heap */
 
 #ifdef CONFIG_MM_HEAP_MEMPOOL
@@ -298,9 +397,36 @@ void mm_shrinkchunk(FAR struct mm_heap_s *heap,
 void mm_foreach(FAR struct mm_heap_s *heap, mm_node_handler_t handler,
                 FAR void *arg);
 
+/* Functions contained in mm_malloc.c ***************************************/
+
+FAR void *mm_allocchunk(FAR struct mm_heap_s *heap, size_t alignsize);
+
 /* Functions contained in mm_free.c *****************************************/
 
 void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay);
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem);
+
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t alignsize);
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+bool mm_cache_flush(FAR struct mm_heap_s *heap);
+#endif
+
+/* Functions contained in mm_huge.c *****************************************/
+
+#ifdef CONFIG_MM_HEAP_HUGE
+FAR void *mm_huge_alloc(FAR struct mm_heap_s *heap, size_t alignment,
+                        size_t size);
+FAR void *mm_huge_align(FAR struct mm_heap_s *heap, FAR void *mem,
+                        size_t alignment, size_t size);
+FAR void *mm_huge_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
+                          size_t size);
+void mm_huge_free(FAR struct mm_heap_s *heap, FAR void *mem);
+size_t mm_huge_size(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_huge_info(FAR struct mm_heap_s *heap, FAR struct mallinfo *info);
+#endif
 
 /****************************************************************************
  * Inline Functions
@@ -0,0 +1,457 @@
+/****************************************************************************
+ * mm/mm_heap/mm_cache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/mm/kasan.h>
+
+#include "mm_heap/mm.h"
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The cache is protected by disabling the local interrupts, which is only
+ * possible in the kernel (same as the delay list).  With SMP, its lock is
+ * also taken, only contended when another CPU flushes the cache.
+ */
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#  define MM_CACHE_ENABLED 1
+#endif
+
+#ifdef CONFIG_SMP
+#  define mm_cache_lock(cache)   spin_lock(&(cache)->lock)
+#  define mm_cache_unlock(cache) spin_unlock(&(cache)->lock)
+#else
+#  define mm_cache_lock(cache)
+#  define mm_cache_unlock(cache)
+#endif
+
+/* Size class of a chunk being allocated (round up) or freed (round down) */
+
+#define MM_CACHE_ALLOCNDX(size) (div_round_up(size, MM_MIN_CHUNK) - 1)
+#define MM_CACHE_FREENDX(size)  ((size) / MM_MIN_CHUNK - 1)
+
+/* Size of the chunk holding the payload mem */
+
+#define MM_CACHE_NODESIZE(mem) \
+  MM_SIZEOF_NODE((FAR struct mm_allocnode_s *) \
+                 ((FAR char *)(mem) - MM_SIZEOF_ALLOCNODE))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cache_push
+ *
+ * Description:
+ *   Add a chunk to size class ndx of the cache of this CPU, and mark it as
+ *   cached.  Must be called with the cache locked.
+ *
+ ****************************************************************************/
+
+#ifdef MM_CACHE_ENABLED
+static void mm_cache_push(FAR struct mm_cache_s *cache, int ndx,
+                          FAR void *mem, size_t nodesize)
+{
+  FAR struct mm_delaynode_s *tmp = mem;
+#if CONFIG_MM_BACKTRACE >= 0
+  FAR struct mm_allocnode_s *node =
+    (FAR struct mm_allocnode_s *)((FAR char *)mem - MM_SIZEOF_ALLOCNODE);
+
+  node->pid = PID_MM_CACHE;
+#endif
+
+  tmp->flink        = cache->list[ndx];
+  cache->list[ndx]  = tmp;
+  cache->count[ndx]++;
+  cache->cached    += nodesize;
+}
+
+/****************************************************************************
+ * Name: mm_cache_release
+ *
+ * Description:
+ *   Return a list of cached chunks to the heap while holding the MM mutex
+ *   only once.
+ *
+ ****************************************************************************/
+
+static void mm_cache_release(FAR struct mm_heap_s *heap,
+                             FAR struct mm_delaynode_s *list)
+{
+  FAR struct mm_delaynode_s *tmp;
+
+  if (mm_lock(heap) < 0)
+    {
+      /* The heap can't be locked now (e.g. during a context switch), let
+       * mm_delayfree() put the chunks into the delay list.
+       */
+
+      while (list != NULL)
+        {
+          tmp  = list;
+          list = list->flink;
+          mm_delayfree(heap, tmp, false);
+        }
+
+      return;
+    }
+
+  while (list != NULL)
+    {
+      tmp  = list;
+      list = list->flink;
+      mm_freechunk(heap, tmp);
+    }
+
+  mm_unlock(heap);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cache_alloc
+ *
+ * Description:
+ *   Take a chunk of at least alignsize bytes from the cache of this CPU.
+ *   An empty size class is refilled with a batch of chunks taken from the
+ *   heap with a single acquisition of the MM mutex.
+ *
+ * Input Parameters:
+ *   heap      - The heap
+ *   alignsize - The chunk size including the chunk header
+ *
+ * Returned Value:
+ *   The (poisoned) chunk payload, or NULL if the size is not cached or the
+ *   heap is exhausted.
+ *
+ ****************************************************************************/
+
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t alignsize)
+{
+#ifdef MM_CACHE_ENABLED
+  FAR struct mm_delaynode_s *list = NULL;
+  FAR struct mm_delaynode_s *tmp;
+  FAR struct mm_cache_s *cache;
+  FAR void *ret;
+  irqstate_t flags;
+  size_t chunksize;
+  int ndx;
+  int n;
+
+  if (alignsize > MM_CACHE_MAXCHUNK)
+    {
+      return NULL;
+    }
+
+  ndx = MM_CACHE_ALLOCNDX(alignsize);
+
+  flags = mm_lock_irq(heap);
+  cache = &heap->mm_cache[this_cpu()];
+  mm_cache_lock(cache);
+  tmp   = cache->list[ndx];
+  if (tmp != NULL)
+    {
+      cache->list[ndx] = tmp->flink;
+      cache->count[ndx]--;
+      cache->cached -= MM_CACHE_NODESIZE(tmp);
+      cache->hits++;
+    }
+  else
+    {
+      cache->misses++;
+    }
+
+  mm_cache_unlock(cache);
+  mm_unlock_irq(heap, flags);
+
+  if (tmp != NULL)
+    {
+      return tmp;
+    }
+
+  /* Refill the size class with one batch of chunks */
+
+  chunksize = (ndx + 1) * MM_MIN_CHUNK;
+  if (mm_lock(heap) < 0)
+    {
+      return NULL;
+    }
+
+  for (n = 0; n < MM_CACHE_BATCH; n++)
+    {
+      ret = mm_allocchunk(heap, chunksize);
+      if (ret == NULL)
+        {
+          break;
+        }
+
+      kasan_poison(ret, MM_CACHE_NODESIZE(ret) - MM_ALLOCNODE_OVERHEAD);
+      tmp        = ret;
+      tmp->flink = list;
+      list       = tmp;
+    }
+
+  mm_unlock(heap);
+
+  if (list == NULL)
+    {
+      return NULL;
+    }
+
+  /* Keep the first chunk and cache the others */
+
+  ret  = list;
+  list = list->flink;
+
+  flags = mm_lock_irq(heap);
+  cache = &heap->mm_cache[this_cpu()];
+  mm_cache_lock(cache);
+  cache->refills++;
+
+  while (list != NULL)
+    {
+      tmp  = list;
+      list = list->flink;
+      chunksize = MM_CACHE_NODESIZE(tmp);
+      mm_cache_push(cache, MM_CACHE_FREENDX(chunksize), tmp, chunksize);
+    }
+
+  mm_cache_unlock(cache);
+  mm_unlock_irq(heap, flags);
+  return ret;
+#else
+  return NULL;
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_cache_free
+ *
+ * Description:
+ *   Put a freed chunk into the cache of this CPU.  When its size class is
+ *   full, a batch of chunks is returned to the heap first.
+ *
+ * Input Parameters:
+ *   heap - The heap
+ *   mem  - The memory being freed
+ *
+ * Returned Value:
+ *   true if the chunk was cached; false if it must be freed to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+#ifdef MM_CACHE_ENABLED
+  FAR struct mm_delaynode_s *list = NULL;
+  FAR struct mm_delaynode_s *tmp;
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_cache_s *cache;
+  irqstate_t flags;
+  size_t nodesize;
+  int ndx;
+  int n;
+
+  mem  = kasan_clear_tag(mem);
+  node = (FAR struct mm_allocnode_s *)((FAR char *)mem -
+                                       MM_SIZEOF_ALLOCNODE);
+
+  flags = mm_lock_irq(heap);
+
+  /* Sanity check against double-frees, the chunk may also be cached */
+
+  DEBUGASSERT(MM_NODE_IS_ALLOC(node) && !MM_NODE_IS_CACHED(node));
+
+  nodesize = MM_SIZEOF_NODE(node);
+  if (nodesize > MM_CACHE_MAXCHUNK)
+    {
+      mm_unlock_irq(heap, flags);
+      return false;
+    }
+
+  ndx   = MM_CACHE_FREENDX(nodesize);
+  cache = &heap->mm_cache[this_cpu()];
+  mm_cache_lock(cache);
+
+  if (cache->count[ndx] >= CONFIG_MM_HEAP_PERCPU_CACHE_DEPTH)
+    {
+      /* The heap mutex can't be taken from the interrupt handler */
+
+      if (up_interrupt_context())
+        {
+          mm_cache_unlock(cache);
+          mm_unlock_irq(heap, flags);
+          return false;
+        }
+
+      /* Detach one batch, it is returned to the heap below */
+
+      for (n = 0; n < MM_CACHE_BATCH; n++)
+        {
+          tmp               = cache->list[ndx];
+          cache->list[ndx]  = tmp->flink;
+          cache->count[ndx]--;
+          cache->cached    -= MM_CACHE_NODESIZE(tmp);
+          tmp->flink        = list;
+          list              = tmp;
+        }
+
+      cache->flushes++;
+    }
+
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+  memset(mem, MM_FREE_MAGIC, nodesize - MM_ALLOCNODE_OVERHEAD);
+#endif
+
+  kasan_poison(mem, nodesize - MM_ALLOCNODE_OVERHEAD);
+  mm_cache_push(cache, ndx, mem, nodesize);
+  mm_cache_unlock(cache);
+  mm_unlock_irq(heap, flags);
+
+  if (list != NULL)
+    {
+      mm_cache_release(heap, list);
+    }
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_cache_flush
+ *
+ * Description:
+ *   Return all the chunks cached by all the CPUs to the heap.
+ *
+ * Returned Value:
+ *   true if any chunk was returned to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_cache_flush(FAR struct mm_heap_s *heap)
+{
+#ifdef MM_CACHE_ENABLED
+  FAR struct mm_delaynode_s *list = NULL;
+  FAR struct mm_delaynode_s *tmp;
+  FAR struct mm_cache_s *cache;
+  irqstate_t flags;
+  int ndx;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &heap->mm_cache[cpu];
+      if (cache->cached == 0)
+        {
+          continue;
+        }
+
+      flags = mm_lock_irq(heap);
+      mm_cache_lock(cache);
+
+      for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+        {
+          while (cache->list[ndx] != NULL)
+            {
+              tmp              = cache->list[ndx];
+              cache->list[ndx] = tmp->flink;
+              tmp->flink       = list;
+              list             = tmp;
+            }
+
+          cache->count[ndx] = 0;
+        }
+
+      cache->flushes++;
+      cache->cached = 0;
+      mm_cache_unlock(cache);
+      mm_unlock_irq(heap, flags);
+    }
+
+  if (list == NULL)
+    {
+      return false;
+    }
+
+  mm_cache_release(heap, list);
+  return true;
+#else
+  return false;
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_cacheinfo
+ *
+ * Description:
+ *   Return the statistics of the chunk caches of all CPUs.
+ *
+ ****************************************************************************/
+
+void mm_cacheinfo(FAR struct mm_heap_s *heap,
+                  FAR struct mm_cacheinfo_s *info)
+{
+  FAR struct mm_cache_s *cache;
+  int ndx;
+  int cpu;
+
+  memset(info, 0, sizeof(*info));
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &heap->mm_cache[cpu];
+
+      info->cached  += cache->cached;
+      info->hits    += cache->hits;
+      info->misses  += cache->misses;
+      info->refills += cache->refills;
+      info->flushes += cache->flushes;
+
+      for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+        {
+          info->nchunks += cache->count[ndx];
+        }
+    }
+}
+
+#endif /* CONFIG_MM_HEAP_PERCPU_CACHE */
@@ -83,11 +83,7 @@ static void add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
 
 void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay)
 {
-  FAR struct mm_freenode_s *node;
-  FAR struct mm_freenode_s *prev;
-  FAR struct mm_freenode_s *next;
   size_t nodesize;
-  size_t prevsize;
 
   if (mm_lock(heap) < 0)
     {
@@ -125,6 +121,27 @@ void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay)
       return;
     }
 
+  mm_freechunk(heap, mem);
+  mm_unlock(heap);
+}
+
+/****************************************************************************
+ * Name: mm_freechunk
+ *
+ * Description:
+ *   Return an allocated chunk to the free lists, merging it with the
+ *   adjacent free chunks if possible.  The caller must hold the MM mutex.
+ *
+ ****************************************************************************/
+
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_freenode_s *node;
+  FAR struct mm_freenode_s *prev;
+  FAR struct mm_freenode_s *next;
+  size_t nodesize;
+  size_t prevsize;
+
   /* Map the memory chunk into a free node */
 
   node = (FAR struct mm_freenode_s *)
@@ -217,7 +234,6 @@ void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay)
   /* Add the merged node to the nodelist */
 
   mm_addfreechunk(heap, node);
-  mm_unlock(heap);
 }
 
 /****************************************************************************
@@ -231,6 +247,10 @@ void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay)
 
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+  FAR struct mm_allocnode_s *node;
+#endif
+
   minfo("Freeing %p\n", mem);
 
   /* Protect against attempts to free a NULL reference */
@@ -242,13 +262,51 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 
   DEBUGASSERT(mm_heapmember(heap, mem));
 
+#ifdef CONFIG_MM_HEAP_HUGE
+  if (MM_HUGE_MEMBER(heap, mem))
+    {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+      mm_telemetry_free(MM_TELEMETRY(heap), mm_huge_size(heap, mem));
+#endif
+      mm_huge_free(heap, mem);
+      return;
+    }
+#endif
+
 #ifdef CONFIG_MM_HEAP_MEMPOOL
   if (heap->mm_mpool)
     {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+      ssize_t size = mempool_multiple_alloc_size(heap->mm_mpool, mem);
+
+      if (size >= 0)
+        {
+          mm_telemetry_free(MM_TELEMETRY(heap), size);
+          mempool_multiple_free(heap->mm_mpool, mem);
+          return;
+        }
+#else
       if (mempool_multiple_free(heap->mm_mpool, mem) >= 0)
         {
           return;
         }
+#endif
+    }
+#endif
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+  /* Count the usable size of the chunk, as recorded in its header */
+
+  node = (FAR struct mm_allocnode_s *)((FAR char *)kasan_clear_tag(mem) -
+                                       MM_SIZEOF_ALLOCNODE);
+  mm_telemetry_free(MM_TELEMETRY(heap),
+                    MM_SIZEOF_NODE(node) - MM_ALLOCNODE_OVERHEAD);
+#endif
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  if (mm_cache_free(heap, mem))
+    {
+      return;
     }
 #endif
 
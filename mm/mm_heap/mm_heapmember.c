@@ -58,6 +58,14 @@
 bool mm_heapmember(FAR struct mm_heap_s *heap, FAR void *mem)
 {
   mem = kasan_clear_tag(mem);
+
+#ifdef CONFIG_MM_HEAP_HUGE
+  if (MM_HUGE_MEMBER(heap, mem))
+    {
+      return true;
+    }
+#endif
+
 #if CONFIG_MM_REGIONS > 1
   int i;
 
@@ -0,0 +1,420 @@
+/****************************************************************************
+ * mm/mm_heap/mm_huge.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <malloc.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/gran.h>
+#include <nuttx/mm/mm.h>
+
+#include "mm_heap/mm.h"
+
+#ifdef CONFIG_MM_HEAP_HUGE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_huge_handle
+ *
+ * Description:
+ *   Return the granule allocator of the huge allocation area, creating it
+ *   on first use.  It can't be created by mm_addregion() because its state
+ *   is allocated from the kernel heap, which may be the heap being set up.
+ *
+ ****************************************************************************/
+
+static GRAN_HANDLE mm_huge_handle(FAR struct mm_heap_s *heap)
+{
+  GRAN_HANDLE handle;
+
+  if (heap->mm_huge != NULL || heap->mm_hugesize == 0)
+    {
+      return heap->mm_huge;
+    }
+
+  handle = gran_initialize(heap->mm_hugestart, heap->mm_hugesize,
+                           CONFIG_MM_HEAP_HUGE_LOG2GRAN,
+                           CONFIG_MM_HEAP_HUGE_LOG2GRAN);
+  if (handle == NULL)
+    {
+      return NULL;
+    }
+
+  /* Another thread may have won the race */
+
+  if (mm_lock(heap) < 0)
+    {
+      gran_release(handle);
+      return NULL;
+    }
+
+  if (heap->mm_huge == NULL)
+    {
+      heap->mm_huge = handle;
+      handle = NULL;
+    }
+
+  mm_unlock(heap);
+
+  if (handle != NULL)
+    {
+      gran_release(handle);
+    }
+
+  return heap->mm_huge;
+}
+
+/****************************************************************************
+ * Name: mm_huge_release
+ *
+ * Description:
+ *   Return the granules of a huge allocation to the area.
+ *
+ ****************************************************************************/
+
+static void mm_huge_release(FAR struct mm_heap_s *heap,
+                            FAR struct mm_hugenode_s *node)
+{
+  minfo("Freeing huge %p, size %zu\n", node->base, node->size);
+  gran_free(heap->mm_huge, node->base, node->size);
+}
+
+/****************************************************************************
+ * Name: mm_huge_drain
+ *
+ * Description:
+ *   Release the huge allocations freed by the interrupt handlers of this
+ *   CPU.
+ *
+ ****************************************************************************/
+
+static void mm_huge_drain(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_delaynode_s *list;
+  FAR struct mm_delaynode_s *tmp;
+  irqstate_t flags;
+
+  if (heap->mm_hugedelay[this_cpu()] == NULL)
+    {
+      return;
+    }
+
+  flags = up_irq_save();
+  list  = heap->mm_hugedelay[this_cpu()];
+  heap->mm_hugedelay[this_cpu()] = NULL;
+  up_irq_restore(flags);
+
+  while (list != NULL)
+    {
+      tmp  = list;
+      list = list->flink;
+      mm_huge_release(heap, MM_HUGE_NODE(tmp));
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_huge_alloc
+ *
+ * Description:
+ *   Allocate size bytes aligned to alignment from the huge allocation
+ *   area.
+ *
+ * Returned Value:
+ *   The allocated memory, or NULL if the request is below the threshold,
+ *   made from an interrupt handler or the area is exhausted.  The caller
+ *   then falls back to the free lists of the heap.
+ *
+ ****************************************************************************/
+
+FAR void *mm_huge_alloc(FAR struct mm_heap_s *heap, size_t alignment,
+                        size_t size)
+{
+  FAR struct mm_hugenode_s *node;
+  FAR char *base;
+  FAR char *mem;
+  size_t hugesize;
+  size_t offset;
+
+  if (size < CONFIG_MM_HEAP_HUGE_THRESHOLD || up_interrupt_context() ||
+      mm_huge_handle(heap) == NULL)
+    {
+      return NULL;
+    }
+
+  /* The granules are aligned to alignment, the header fits before the
+   * first aligned address after the first granule.
+   */
+
+  offset   = MAX(alignment, MM_SIZEOF_HUGENODE);
+  hugesize = MM_HUGE_ALIGN_UP(size + offset);
+  if (hugesize < size)
+    {
+      /* There must have been an integer overflow */
+
+      return NULL;
+    }
+
+  mm_huge_drain(heap);
+
+  if (alignment > MM_HUGE_GRANSIZE)
+    {
+      base = gran_alloc_align(heap->mm_huge, hugesize, alignment);
+    }
+  else
+    {
+      base = gran_alloc(heap->mm_huge, hugesize);
+    }
+
+  if (base == NULL)
+    {
+      return NULL;
+    }
+
+  mem        = base + offset;
+  node       = MM_HUGE_NODE(mem);
+  node->base = base;
+  node->size = hugesize;
+
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+  memset(mem, MM_ALLOC_MAGIC, hugesize - offset);
+#endif
+
+  minfo("Allocated huge %p, size %zu\n", mem, hugesize);
+  return mem;
+}
+
+/****************************************************************************
+ * Name: mm_huge_align
+ *
+ * Description:
+ *   Align a huge allocation in place.  mem must have at least
+ *   size + alignment - 1 usable bytes.  The granules before the header of
+ *   the aligned block and after its end go back to the area.
+ *
+ * Returned Value:
+ *   The aligned memory, inside the original allocation.
+ *
+ ****************************************************************************/
+
+FAR void *mm_huge_align(FAR struct mm_heap_s *heap, FAR void *mem,
+                        size_t alignment, size_t size)
+{
+  FAR struct mm_hugenode_s *node = MM_HUGE_NODE(mem);
+  FAR char *base = node->base;
+  size_t oldsize = node->size;
+  FAR char *aligned;
+  size_t hugesize;
+  size_t lead;
+
+  aligned = (FAR char *)(((uintptr_t)mem + alignment - 1) &
+                         ~(uintptr_t)(alignment - 1));
+  DEBUGASSERT(aligned + size <= base + oldsize);
+
+  /* The header of the aligned block is always past the old one, so it is
+   * still in the allocation.
+   */
+
+  lead     = MM_HUGE_ALIGN_DOWN(aligned - MM_SIZEOF_HUGENODE - base);
+  hugesize = MM_HUGE_ALIGN_UP(aligned + size - base) - lead;
+
+  if (lead > 0)
+    {
+      gran_free(heap->mm_huge, base, lead);
+    }
+
+  if (lead + hugesize < oldsize)
+    {
+      gran_free(heap->mm_huge, base + lead + hugesize,
+                oldsize - lead - hugesize);
+    }
+
+  node       = MM_HUGE_NODE(aligned);
+  node->base = base + lead;
+  node->size = hugesize;
+
+  minfo("Aligned huge %p to %p, size %zu\n", mem, aligned, hugesize);
+  return aligned;
+}
+
+/****************************************************************************
+ * Name: mm_huge_realloc
+ *
+ * Description:
+ *   Resize a huge allocation.  The allocation shrinks in place, and grows
+ *   in place when the granules following it are free.  Otherwise the data
+ *   are moved to a new allocation.
+ *
+ * Returned Value:
+ *   The resized allocation, or NULL (oldmem is still valid) on failure.
+ *
+ ****************************************************************************/
+
+FAR void *mm_huge_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
+                          size_t size)
+{
+  FAR struct mm_hugenode_s *node = MM_HUGE_NODE(oldmem);
+  size_t offset = (FAR char *)oldmem - node->base;
+  size_t oldsize = node->size;
+  size_t newsize;
+  FAR void *newmem;
+
+  newsize = MM_HUGE_ALIGN_UP(size + offset);
+  if (newsize < size)
+    {
+      /* There must have been an integer overflow */
+
+      return NULL;
+    }
+
+  if (newsize <= oldsize)
+    {
+      /* Shrink in place, the tail granules go back to the area */
+
+      if (newsize < oldsize && !up_interrupt_context())
+        {
+          gran_free(heap->mm_huge, node->base + newsize, oldsize - newsize);
+          node->size = newsize;
+        }
+
+      return oldmem;
+    }
+
+  /* Grow in place if the granules following the allocation are free */
+
+  if (!up_interrupt_context() &&
+      gran_reserve(heap->mm_huge, (uintptr_t)node->base + oldsize,
+                   newsize - oldsize) != NULL)
+    {
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+      memset(node->base + oldsize, MM_ALLOC_MAGIC, newsize - oldsize);
+#endif
+
+      node->size = newsize;
+      return oldmem;
+    }
+
+  newmem = mm_malloc(heap, size);
+  if (newmem != NULL)
+    {
+      memcpy(newmem, oldmem, oldsize - offset);
+      mm_huge_free(heap, oldmem);
+    }
+
+  return newmem;
+}
+
+/****************************************************************************
+ * Name: mm_huge_free
+ *
+ * Description:
+ *   Free a huge allocation.  The granule allocator can't be used from an
+ *   interrupt handler or during a context switch, the allocation is then
+ *   queued and released by the next huge allocation of this CPU.
+ *
+ ****************************************************************************/
+
+void mm_huge_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_delaynode_s *tmp = mem;
+  irqstate_t flags;
+
+  DEBUGASSERT(heap->mm_huge != NULL);
+
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+  memset(mem, MM_FREE_MAGIC, mm_huge_size(heap, mem));
+#endif
+
+  if (up_interrupt_context() || _SCHED_GETTID() < 0)
+    {
+      flags = up_irq_save();
+      tmp->flink = heap->mm_hugedelay[this_cpu()];
+      heap->mm_hugedelay[this_cpu()] = tmp;
+      up_irq_restore(flags);
+      return;
+    }
+
+  mm_huge_release(heap, MM_HUGE_NODE(mem));
+  mm_huge_drain(heap);
+}
+
+/****************************************************************************
+ * Name: mm_huge_size
+ *
+ * Description:
+ *   Return the usable size of a huge allocation.
+ *
+ ****************************************************************************/
+
+size_t mm_huge_size(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_hugenode_s *node = MM_HUGE_NODE(mem);
+
+  return node->base + node->size - (FAR char *)mem;
+}
+
+/****************************************************************************
+ * Name: mm_huge_info
+ *
+ * Description:
+ *   Add the usage of the huge allocation area to info.
+ *
+ ****************************************************************************/
+
+void mm_huge_info(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
+{
+  struct graninfo_s graninfo;
+  size_t nfree = heap->mm_hugesize;
+  size_t mxfree = heap->mm_hugesize;
+
+  if (heap->mm_huge != NULL)
+    {
+      gran_info(heap->mm_huge, &graninfo);
+      nfree  = (size_t)graninfo.nfree << graninfo.log2gran;
+      mxfree = (size_t)graninfo.mxfree << graninfo.log2gran;
+    }
+
+  info->arena    += heap->mm_hugesize;
+  info->fordblks += nfree;
+  info->uordblks += heap->mm_hugesize - nfree;
+  if ((size_t)info->mxordblk < mxfree)
+    {
+      info->mxordblk = mxfree;
+    }
+}
+
+#endif /* CONFIG_MM_HEAP_HUGE */
@@ -141,6 +141,19 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
   memset(heapstart, MM_INIT_MAGIC, heapsize);
 #endif
 
+#ifdef CONFIG_MM_HEAP_HUGE
+  /* Give the end of the first large enough region to the huge allocation
+   * area.
+   */
+
+  if (heap->mm_hugesize == 0 && heapsize >= 2 * CONFIG_MM_HEAP_HUGE_SIZE)
+    {
+      heapsize          -= CONFIG_MM_HEAP_HUGE_SIZE;
+      heap->mm_hugestart = (FAR char *)heapstart + heapsize;
+      heap->mm_hugesize  = CONFIG_MM_HEAP_HUGE_SIZE;
+    }
+#endif
+
   /* Adjust the provided heap start and size.
    *
    * Note: (uintptr_t)node + MM_SIZEOF_ALLOCNODE is what's actually
@@ -104,10 +104,30 @@ int mm_lock(FAR struct mm_heap_s *heap)
     }
   else
     {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+      bool contended = false;
+      clock_t start = 0;
+      int ret;
+
+      /* The mutex is contended only if it cannot be taken at once */
+
+      ret = nxmutex_trylock(&heap->mm_lock);
+      if (ret < 0)
+        {
+          contended = true;
+          start = mm_telemetry_start();
+          ret = nxmutex_lock(&heap->mm_lock);
+        }
+#else
       int ret = nxmutex_lock(&heap->mm_lock);
+#endif
+
       if (ret >= 0)
         {
           kasan_bypass(true);
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+          mm_telemetry_lock(MM_TELEMETRY(heap), contended, start);
+#endif
         }
 
       return 0;
@@ -131,6 +131,9 @@ struct mallinfo mm_mallinfo(FAR struct mm_heap_s *heap)
 #ifdef CONFIG_MM_HEAP_MEMPOOL
   struct mallinfo poolinfo;
 #endif
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  struct mm_cacheinfo_s cacheinfo;
+#endif
 
   memset(&info, 0, sizeof(info));
   mm_foreach(heap, mallinfo_handler, &info);
@@ -146,6 +149,19 @@ struct mallinfo mm_mallinfo(FAR struct mm_heap_s *heap)
   info.fordblks += poolinfo.fordblks;
 #endif
 
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  /* The cached chunks are free from the user point of view */
+
+  mm_cacheinfo(heap, &cacheinfo);
+
+  info.uordblks -= cacheinfo.cached;
+  info.fordblks += cacheinfo.cached;
+#endif
+
+#ifdef CONFIG_MM_HEAP_HUGE
+  mm_huge_info(heap, &info);
+#endif
+
   DEBUGASSERT(info.uordblks + info.fordblks == info.arena);
 
   return info;
@@ -216,3 +232,52 @@ size_t mm_heapfree_largest(FAR struct mm_heap_s *heap)
 
   return 0;
 }
+
+/****************************************************************************
+ * Name: mm_telemetry
+ *
+ * Description:
+ *   Return the telemetry counters of all CPUs and the number of free
+ *   chunks per size class of the free lists.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+void mm_telemetry(FAR struct mm_heap_s *heap,
+                  FAR struct mm_telemetryinfo_s *info)
+{
+  FAR struct mm_freenode_s *node;
+  size_t nodesize;
+  int ndx;
+  int cpu;
+
+  memset(info, 0, sizeof(*info));
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      mm_telemetry_merge(&info->total, &heap->mm_telemetry[cpu]);
+    }
+
+  /* Retake the mutex for each free list to reduce latencies */
+
+  for (ndx = 0; ndx < MM_NNODES; ndx++)
+    {
+      if (mm_lock(heap) < 0)
+        {
+          break;
+        }
+
+      for (node = heap->mm_nodelist[ndx].flink; node; node = node->flink)
+        {
+          nodesize = MM_SIZEOF_NODE(node);
+          if (nodesize != 0)
+            {
+              nodesize -= MM_ALLOCNODE_OVERHEAD;
+              info->nchunks[mm_telemetry_class(nodesize)]++;
+            }
+        }
+
+      mm_unlock(heap);
+    }
+}
+#endif
@@ -157,63 +157,26 @@ void mm_free_delaylist(FAR struct mm_heap_s *heap)
 }
 
 /****************************************************************************
- * Name: mm_malloc
+ * Name: mm_allocchunk
  *
  * Description:
- *  Find the smallest chunk that satisfies the request. Take the memory from
- *  that chunk, save the remaining, smaller chunk (if any).
+ *  Take the best fitting chunk of alignsize bytes from the free lists and
+ *  return the remainder (if any) to the free lists.  The caller must hold
+ *  the MM mutex.
  *
- *  8-byte alignment of the allocated data is assured.
+ * Returned Value:
+ *  The address of the chunk payload, or NULL if there is no free chunk
+ *  large enough.
  *
  ****************************************************************************/
 
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+FAR void *mm_allocchunk(FAR struct mm_heap_s *heap, size_t alignsize)
 {
   FAR struct mm_freenode_s *node;
-  size_t alignsize;
   size_t nodesize;
   FAR void *ret = NULL;
   int ndx;
 
-  /* Free the delay list first */
-
-  free_delaylist(heap, false);
-
-#ifdef CONFIG_MM_HEAP_MEMPOOL
-  if (heap->mm_mpool)
-    {
-      ret = mempool_multiple_alloc(heap->mm_mpool, size);
-      if (ret != NULL)
-        {
-          return ret;
-        }
-    }
-#endif
-
-  /* Adjust the size to account for (1) the size of the allocated node and
-   * (2) to make sure that it is aligned with MM_ALIGN and its size is at
-   * least MM_MIN_CHUNK.
-   */
-
-  if (size < MM_MIN_CHUNK - MM_ALLOCNODE_OVERHEAD)
-    {
-      size = MM_MIN_CHUNK - MM_ALLOCNODE_OVERHEAD;
-    }
-
-  alignsize = MM_ALIGN_UP(size + MM_ALLOCNODE_OVERHEAD);
-  if (alignsize < size)
-    {
-      /* There must have been an integer overflow */
-
-      return NULL;
-    }
-
-  DEBUGASSERT(alignsize >= MM_ALIGN);
-
-  /* We need to hold the MM mutex while we muck with the nodelist. */
-
-  DEBUGVERIFY(mm_lock(heap));
-
   /* Convert the request size into a nodelist index */
 
   ndx = mm_size2ndx(alignsize);
@@ -328,10 +291,110 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
                       heap->mm_curused);
     }
 
-  mm_unlock(heap);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_malloc
+ *
+ * Description:
+ *  Find the smallest chunk that satisfies the request. Take the memory from
+ *  that chunk, save the remaining, smaller chunk (if any).
+ *
+ *  8-byte alignment of the allocated data is assured.
+ *
+ ****************************************************************************/
+
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  size_t alignsize;
+  size_t nodesize;
+  FAR void *ret = NULL;
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+  clock_t start = mm_telemetry_start();
+#endif
+
+  /* Free the delay list first */
+
+  free_delaylist(heap, false);
+
+#ifdef CONFIG_MM_HEAP_HUGE
+  /* Serve the large requests from the huge allocation area */
+
+  ret = mm_huge_alloc(heap, MM_ALIGN, size);
+  if (ret != NULL)
+    {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+      mm_telemetry_alloc(MM_TELEMETRY(heap), mm_huge_size(heap, ret),
+                         start);
+#endif
+      return ret;
+    }
+#endif
+
+#ifdef CONFIG_MM_HEAP_MEMPOOL
+  if (heap->mm_mpool)
+    {
+      ret = mempool_multiple_alloc(heap->mm_mpool, size);
+      if (ret != NULL)
+        {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+          mm_telemetry_alloc(MM_TELEMETRY(heap),
+                             mempool_multiple_alloc_size(heap->mm_mpool,
+                                                         ret),
+                             start);
+#endif
+          return ret;
+        }
+    }
+#endif
+
+  /* Adjust the size to account for (1) the size of the allocated node and
+   * (2) to make sure that it is aligned with MM_ALIGN and its size is at
+   * least MM_MIN_CHUNK.
+   */
+
+  if (size < MM_MIN_CHUNK - MM_ALLOCNODE_OVERHEAD)
+    {
+      size = MM_MIN_CHUNK - MM_ALLOCNODE_OVERHEAD;
+    }
+
+  alignsize = MM_ALIGN_UP(size + MM_ALLOCNODE_OVERHEAD);
+  if (alignsize < size)
+    {
+      /* There must have been an integer overflow */
+
+      return NULL;
+    }
+
+  DEBUGASSERT(alignsize >= MM_ALIGN);
+
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  /* Try the chunk cache of this CPU first */
+
+  ret = mm_cache_alloc(heap, alignsize);
+  if (ret == NULL)
+#endif
+    {
+      /* We need to hold the MM mutex while we muck with the nodelist. */
+
+      DEBUGVERIFY(mm_lock(heap));
+      ret = mm_allocchunk(heap, alignsize);
+      mm_unlock(heap);
+    }
 
   if (ret)
     {
+      node = (FAR struct mm_freenode_s *)
+        ((FAR char *)ret - MM_SIZEOF_ALLOCNODE);
+      nodesize = MM_SIZEOF_NODE(node);
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+      mm_telemetry_alloc(MM_TELEMETRY(heap),
+                         nodesize - MM_ALLOCNODE_OVERHEAD, start);
+#endif
+
       MM_ADD_BACKTRACE(heap, node);
       ret = kasan_unpoison(ret, nodesize - MM_ALLOCNODE_OVERHEAD);
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
@@ -351,6 +414,15 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     }
 #endif
 
+#ifdef CONFIG_MM_HEAP_PERCPU_CACHE
+  /* Try again after returning the cached chunks to the heap */
+
+  else if (mm_cache_flush(heap))
+    {
+      return mm_malloc(heap, size);
+    }
+#endif
+
 #ifdef CONFIG_DEBUG_MM
   else if (MM_INTERNAL_HEAP(heap))
     {
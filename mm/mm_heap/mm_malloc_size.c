@@ -44,6 +44,13 @@ size_t mm_malloc_size(FAR struct mm_heap_s *heap, FAR void *mem)
   ssize_t size;
   bool flag;
 
+#ifdef CONFIG_MM_HEAP_HUGE
+  if (MM_HUGE_MEMBER(heap, mem))
+    {
+      return mm_huge_size(heap, mem);
+    }
+#endif
+
   flag = kasan_bypass(true);
 #ifdef CONFIG_MM_HEAP_MEMPOOL
   if (heap->mm_mpool)
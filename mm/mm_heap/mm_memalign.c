@@ -61,6 +61,10 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
   size_t mask;
   size_t allocsize;
   size_t newsize;
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+  clock_t start = mm_telemetry_start();
+  size_t rawsize;
+#endif
 
   /* Make sure that alignment is less than half max size_t */
 
@@ -82,11 +86,29 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       node = mempool_multiple_memalign(heap->mm_mpool, alignment, size);
       if (node != NULL)
         {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+          mm_telemetry_alloc(MM_TELEMETRY(heap),
+                             mempool_multiple_alloc_size(heap->mm_mpool,
+                                                         node),
+                             start);
+#endif
           return node;
         }
     }
 #endif
 
+#ifdef CONFIG_MM_HEAP_HUGE
+  node = mm_huge_alloc(heap, alignment, size);
+  if (node != NULL)
+    {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+      mm_telemetry_alloc(MM_TELEMETRY(heap), mm_huge_size(heap, node),
+                         start);
+#endif
+      return node;
+    }
+#endif
+
   /* If this requested alinement's less than or equal to the natural
    * alignment of malloc, then just let malloc do the work.
    */
@@ -139,6 +161,26 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       return NULL;
     }
 
+#ifdef CONFIG_MM_HEAP_HUGE
+  /* The larger request may be served by the huge allocation area when the
+   * aligned one above was not, because it reached the threshold or needed
+   * no aligned granules.  The aligned block is trimmed out of it.
+   */
+
+  if (MM_HUGE_MEMBER(heap, (FAR void *)rawchunk))
+    {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+      rawsize = mm_huge_size(heap, (FAR void *)rawchunk);
+#endif
+      node = mm_huge_align(heap, (FAR void *)rawchunk, alignment, size);
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+      mm_telemetry_resize(MM_TELEMETRY(heap), rawsize,
+                          mm_huge_size(heap, node));
+#endif
+      return node;
+    }
+#endif
+
   kasan_poison((FAR void *)rawchunk,
                mm_malloc_size(heap, (FAR void *)rawchunk));
 
@@ -156,6 +198,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
 
   node = (FAR struct mm_allocnode_s *)(rawchunk - MM_SIZEOF_ALLOCNODE);
   heap->mm_curused -= MM_SIZEOF_NODE(node);
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+  rawsize = MM_SIZEOF_NODE(node) - MM_ALLOCNODE_OVERHEAD;
+#endif
 
   /* Find the aligned subregion */
 
@@ -278,6 +323,15 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       heap->mm_maxused = heap->mm_curused;
     }
 
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+  /* mm_malloc() counted the whole raw chunk, count the usable size of the
+   * aligned chunk instead, as for any other allocation.
+   */
+
+  mm_telemetry_resize(MM_TELEMETRY(heap), rawsize,
+                      size - MM_ALLOCNODE_OVERHEAD);
+#endif
+
   sched_note_heap(NOTE_HEAP_ALLOC, heap, (FAR void *)alignedchunk, size,
                   heap->mm_curused);
 
@@ -184,6 +184,10 @@ static void memdump_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
           priv->info.uordblks += nodesize;
           memdump_allocnode(node);
         }
+      else if (MM_NODE_IS_CACHED(node))
+        {
+          /* A cached chunk is free, though not in the free lists */
+        }
       else if(dump->pid == PID_MM_ORPHAN && MM_DUMP_SEQNO(dump, node))
         {
           FAR struct mm_allocnode_s *next = (FAR struct mm_allocnode_s *)
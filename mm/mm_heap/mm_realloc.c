@@ -86,6 +86,13 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
 
   DEBUGASSERT(mm_heapmember(heap, oldmem));
 
+#ifdef CONFIG_MM_HEAP_HUGE
+  if (MM_HUGE_MEMBER(heap, oldmem))
+    {
+      return mm_huge_realloc(heap, oldmem, size);
+    }
+#endif
+
 #ifdef CONFIG_MM_HEAP_MEMPOOL
   if (heap->mm_mpool)
     {
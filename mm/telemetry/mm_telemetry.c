@@ -0,0 +1,114 @@
+/****************************************************************************
+ * mm/telemetry/mm_telemetry.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_telemetry_merge
+ *
+ * Description:
+ *   Add the counters of one CPU to total.
+ *
+ ****************************************************************************/
+
+void mm_telemetry_merge(FAR struct mm_telemetry_s *total,
+                        FAR const struct mm_telemetry_s *telemetry)
+{
+  int ndx;
+
+  for (ndx = 0; ndx < MM_TELEMETRY_NCLASSES; ndx++)
+    {
+      total->nalloc[ndx]  += telemetry->nalloc[ndx];
+      total->nfree[ndx]   += telemetry->nfree[ndx];
+      total->latency[ndx] += telemetry->latency[ndx];
+    }
+
+  total->nlocks     += telemetry->nlocks;
+  total->ncontended += telemetry->ncontended;
+  total->waittime   += telemetry->waittime;
+}
+
+/****************************************************************************
+ * Name: mm_telemetry_latency
+ *
+ * Description:
+ *   Return the given percentile of the allocation latency.
+ *
+ * Input Parameters:
+ *   telemetry - The counters
+ *   percent   - The percentile, 1 to 100
+ *
+ * Returned Value:
+ *   The upper bound in perf counter ticks of the latency class holding the
+ *   percentile, zero if no allocation was measured.
+ *
+ ****************************************************************************/
+
+clock_t mm_telemetry_latency(FAR const struct mm_telemetry_s *telemetry,
+                             int percent)
+{
+  uint64_t total = 0;
+  uint64_t count = 0;
+  uint64_t rank;
+  int ndx;
+
+  for (ndx = 0; ndx < MM_TELEMETRY_NCLASSES; ndx++)
+    {
+      total += telemetry->latency[ndx];
+    }
+
+  if (total == 0)
+    {
+      return 0;
+    }
+
+  /* The rank of the percentile, rounded up */
+
+  rank = (total * percent + 99) / 100;
+
+  for (ndx = 0; ndx < MM_TELEMETRY_NCLASSES - 1; ndx++)
+    {
+      count += telemetry->latency[ndx];
+      if (count >= rank)
+        {
+          break;
+        }
+    }
+
+  return ((clock_t)2 << ndx) - 1;
+}
+
+#endif /* CONFIG_MM_HEAP_TELEMETRY */
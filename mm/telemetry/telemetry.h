@@ -0,0 +1,165 @@
+/****************************************************************************
+ * mm/telemetry/telemetry.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __MM_TELEMETRY_TELEMETRY_H
+#define __MM_TELEMETRY_TELEMETRY_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <limits.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <sys/param.h>
+#include <sys/types.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/sched.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The perf counter and the CPU index are only accessible in the kernel.
+ *
+ * The counters of this CPU are updated without any lock, a task migrated
+ * to another CPU in between may rarely lose a count.  The user space heap
+ * of the protected and kernel builds always updates the counters of CPU 0.
+ */
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#  define MM_TELEMETRY_LATENCY 1
+#  define mm_telemetry_start() perf_gettime()
+#  define MM_TELEMETRY(heap)   (&(heap)->mm_telemetry[this_cpu()])
+#else
+#  define mm_telemetry_start() 0
+#  define MM_TELEMETRY(heap)   (&(heap)->mm_telemetry[0])
+#endif
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_telemetry_class
+ *
+ * Description:
+ *   Return the power of two class of value.
+ *
+ ****************************************************************************/
+
+static inline_function int mm_telemetry_class(unsigned long value)
+{
+  int ndx;
+
+  if (value == 0)
+    {
+      return 0;
+    }
+
+  ndx = flsl(value) - 1;
+  return ndx < MM_TELEMETRY_NCLASSES ? ndx : MM_TELEMETRY_NCLASSES - 1;
+}
+
+/****************************************************************************
+ * Name: mm_telemetry_alloc
+ *
+ * Description:
+ *   Count an allocation of size usable bytes started at start.
+ *
+ ****************************************************************************/
+
+static inline_function void
+mm_telemetry_alloc(FAR struct mm_telemetry_s *telemetry, size_t size,
+                   clock_t start)
+{
+#ifdef MM_TELEMETRY_LATENCY
+  clock_t elapsed = perf_gettime() - start;
+
+  telemetry->latency[mm_telemetry_class(MIN(elapsed, ULONG_MAX))]++;
+#endif
+
+  telemetry->nalloc[mm_telemetry_class(size)]++;
+}
+
+/****************************************************************************
+ * Name: mm_telemetry_resize
+ *
+ * Description:
+ *   Move a counted allocation from the class of oldsize to the class of
+ *   newsize, when a chunk is trimmed before it is returned.
+ *
+ ****************************************************************************/
+
+static inline_function void
+mm_telemetry_resize(FAR struct mm_telemetry_s *telemetry, size_t oldsize,
+                    size_t newsize)
+{
+  telemetry->nalloc[mm_telemetry_class(oldsize)]--;
+  telemetry->nalloc[mm_telemetry_class(newsize)]++;
+}
+
+/****************************************************************************
+ * Name: mm_telemetry_free
+ *
+ * Description:
+ *   Count a free of size usable bytes.
+ *
+ ****************************************************************************/
+
+static inline_function void
+mm_telemetry_free(FAR struct mm_telemetry_s *telemetry, size_t size)
+{
+  telemetry->nfree[mm_telemetry_class(size)]++;
+}
+
+/****************************************************************************
+ * Name: mm_telemetry_lock
+ *
+ * Description:
+ *   Count an acquisition of the heap mutex started at start, contended is
+ *   true if the mutex was held by another thread.
+ *
+ ****************************************************************************/
+
+static inline_function void
+mm_telemetry_lock(FAR struct mm_telemetry_s *telemetry, bool contended,
+                  clock_t start)
+{
+  telemetry->nlocks++;
+  if (contended)
+    {
+      telemetry->ncontended++;
+#ifdef MM_TELEMETRY_LATENCY
+      telemetry->waittime += perf_gettime() - start;
+#endif
+    }
+}
+
+#endif /* CONFIG_MM_HEAP_TELEMETRY */
+#endif /* __MM_TELEMETRY_TELEMETRY_H */
@@ -45,6 +45,7 @@
 #include <nuttx/sched_note.h>
 
 #include "tlsf/tlsf.h"
+#include "telemetry/telemetry.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -109,6 +110,12 @@ struct mm_heap_s
   size_t mm_delaycount[CONFIG_SMP_NCPUS];
 #endif
 
+  /* Per-CPU telemetry counters */
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+  struct mm_telemetry_s mm_telemetry[CONFIG_SMP_NCPUS];
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMINFO)
   struct procfs_meminfo_entry_s mm_procfs;
 #endif
@@ -468,6 +475,23 @@ static void mallinfo_handler(FAR void *ptr, size_t size, int used,
     }
 }
 
+/****************************************************************************
+ * Name: telemetry_handler
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+static void telemetry_handler(FAR void *ptr, size_t size, int used,
+                              FAR void *user)
+{
+  FAR struct mm_telemetryinfo_s *info = user;
+
+  if (!used)
+    {
+      info->nchunks[mm_telemetry_class(size)]++;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: mallinfo_task_handler
  ****************************************************************************/
@@ -558,7 +582,30 @@ static int mm_lock(FAR struct mm_heap_s *heap)
     }
   else
     {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+      bool contended = false;
+      clock_t start = 0;
+      int ret;
+
+      /* The mutex is contended only if it cannot be taken at once */
+
+      ret = nxmutex_trylock(&heap->mm_lock);
+      if (ret < 0)
+        {
+          contended = true;
+          start = mm_telemetry_start();
+          ret = nxmutex_lock(&heap->mm_lock);
+        }
+
+      if (ret >= 0)
+        {
+          mm_telemetry_lock(MM_TELEMETRY(heap), contended, start);
+        }
+
+      return ret;
+#else
       return nxmutex_lock(&heap->mm_lock);
+#endif
     }
 }
 
@@ -923,13 +970,35 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 #ifdef CONFIG_MM_HEAP_MEMPOOL
   if (heap->mm_mpool)
     {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+      ssize_t size = mempool_multiple_alloc_size(heap->mm_mpool, mem);
+
+      if (size >= 0)
+        {
+          mm_telemetry_free(MM_TELEMETRY(heap), size);
+          mempool_multiple_free(heap->mm_mpool, mem);
+          return;
+        }
+#else
       if (mempool_multiple_free(heap->mm_mpool, mem) >= 0)
         {
           return;
         }
+#endif
     }
 #endif
 
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+  /* Count the usable size of the block, as recorded in its header */
+
+#  if CONFIG_MM_BACKTRACE >= 0
+  mm_telemetry_free(MM_TELEMETRY(heap), tlsf_block_size(mem) -
+                    sizeof(struct memdump_backtrace_s));
+#  else
+  mm_telemetry_free(MM_TELEMETRY(heap), tlsf_block_size(mem));
+#  endif
+#endif
+
   mm_delayfree(heap, mem, CONFIG_MM_FREE_DELAYCOUNT_MAX > 0);
 }
 
@@ -1201,6 +1270,50 @@ struct mallinfo_task mm_mallinfo_task(FAR struct mm_heap_s *heap,
   return info;
 }
 
+/****************************************************************************
+ * Name: mm_telemetry
+ *
+ * Description:
+ *   Return the telemetry counters of all CPUs and the number of free
+ *   blocks per size class of the pools.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+void mm_telemetry(FAR struct mm_heap_s *heap,
+                  FAR struct mm_telemetryinfo_s *info)
+{
+#if CONFIG_MM_REGIONS > 1
+  int region;
+#else
+#  define region 0
+#endif
+  int cpu;
+
+  memset(info, 0, sizeof(*info));
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      mm_telemetry_merge(&info->total, &heap->mm_telemetry[cpu]);
+    }
+
+  /* Visit each region */
+
+#if CONFIG_MM_REGIONS > 1
+  for (region = 0; region < heap->mm_nregions; region++)
+#endif
+    {
+      /* Retake the mutex for each region to reduce latencies */
+
+      DEBUGVERIFY(mm_lock(heap));
+      tlsf_walk_pool(heap->mm_heapstart[region],
+                     telemetry_handler, info);
+      mm_unlock(heap);
+    }
+#undef region
+}
+#endif
+
 /****************************************************************************
  * Name: mm_memdump
  *
@@ -1347,6 +1460,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 {
   size_t nodesize;
   FAR void *ret;
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+  clock_t start = mm_telemetry_start();
+#endif
 
   /* In case of zero-length allocations allocate the minimum size object */
 
@@ -1361,6 +1477,10 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       ret = mempool_multiple_alloc(heap->mm_mpool, size);
       if (ret != NULL)
         {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+          mm_telemetry_alloc(MM_TELEMETRY(heap),
+                             mm_malloc_size(heap, ret), start);
+#endif
           return ret;
         }
     }
@@ -1389,6 +1509,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
   if (ret)
     {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+      mm_telemetry_alloc(MM_TELEMETRY(heap), nodesize, start);
+#endif
       sched_note_heap(NOTE_HEAP_ALLOC, heap, ret, nodesize,
                       heap->mm_curused);
     }
@@ -1440,6 +1563,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
 {
   size_t nodesize;
   FAR void *ret;
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+  clock_t start = mm_telemetry_start();
+#endif
 
 #ifdef CONFIG_MM_HEAP_MEMPOOL
   if (heap->mm_mpool)
@@ -1447,6 +1573,10 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       ret = mempool_multiple_memalign(heap->mm_mpool, alignment, size);
       if (ret != NULL)
         {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+          mm_telemetry_alloc(MM_TELEMETRY(heap),
+                             mm_malloc_size(heap, ret), start);
+#endif
           return ret;
         }
     }
@@ -1475,6 +1605,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
 
   if (ret)
     {
+#ifdef CONFIG_MM_HEAP_TELEMETRY
+      mm_telemetry_alloc(MM_TELEMETRY(heap), nodesize, start);
+#endif
       sched_note_heap(NOTE_HEAP_ALLOC, heap, ret, nodesize,
                       heap->mm_curused);
     }
@@ -56,6 +56,13 @@
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+#  include <nuttx/atomic.h>
+#  include <nuttx/semaphore.h>
+#  include <nuttx/wqueue.h>
+#  include <nuttx/mm/map.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -185,6 +192,14 @@
  *                        out pending IP fragments.  This is a device
  *                        oriented event, not associated with a socket.
  *                   OUT: Not used
+ *   TCPSEG_POLL      IN: Used for polling the send queue of the segments
+ *                        of TCP large sends.  This is a device oriented
+ *                        event, not associated with a socket.
+ *                   OUT: Not used
+ *   ZCOPY_DONE       IN: A MSG_ZEROCOPY completion notification has been
+ *                        queued on the error queue of the socket.  This is
+ *                        raised from a work queue, not by a device.
+ *                   OUT: Not used
  */
 
 /* Bits 0-10: Connection specific event bits */
@@ -220,7 +235,7 @@
 
 #define NETDEV_DOWN        (1 << 17)
 
-/* Bits 18-24: device specific poll events.  Unlike connection
+/* Bits 18-25: device specific poll events.  Unlike connection
  * oriented poll events, device related poll events must distinguish
  * between what is being polled for since the callbacks all reside in
  * the same list in the network device structure.
@@ -233,6 +248,11 @@
 #define ICMP_POLL          (1 << 22)
 #define ICMPv6_POLL        (1 << 23)
 #define IPFWD_POLL         (1 << 24)
+#define TCPSEG_POLL        (1 << 25)
+
+/* Bit 26: Socket error queue event bits */
+
+#define ZCOPY_DONE         (1 << 26)
 
 /* The set of events that and implications to the TCP connection state */
 
@@ -299,6 +319,28 @@ struct devif_callback_s
   uint8_t free_flags;
 };
 
+/* The references of the I/O buffers to the data of a file that is sent
+ * without copying it.  The data is mapped, so that it stays in place until
+ * it is unmapped.  The mapping does not belong to the task group of the
+ * sender, so that it can outlive it.  The count starts at one for the
+ * sender, which waits in devif_fileref_wait() until the I/O buffers have
+ * all been released, or leaves the last of them to unmap the data.
+ */
+
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+struct devif_fileref_s
+{
+  atomic_t refs;                /* Number of references to the file data */
+  atomic_t detach;              /* Set by the sender giving up or the last
+                                 * reference, whichever comes first */
+  sem_t    sem;                 /* Posted when the last one is released */
+  struct work_s work;           /* Unmaps the data once detached */
+  struct mm_map_entry_s entry;  /* The mapping of the file data */
+};
+#else
+struct devif_fileref_s;      /* Forward reference */
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -495,6 +537,10 @@ int devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *buf,
  *   This is identical to calling devif_file_send() except that the data is
  *   in a available file handle.
  *
+ *   If ref is not NULL and the file data was mapped by
+ *   devif_fileref_alloc(), the I/O buffers reference the file data rather
+ *   than a copy of it.
+ *
  * Assumptions:
  *   Called with the network locked.
  *
@@ -503,7 +549,48 @@ int devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *buf,
 #ifdef CONFIG_MM_IOB
 int devif_file_send(FAR struct net_driver_s *dev, FAR struct file *file,
                     unsigned int len, unsigned int offset,
-                    unsigned int target_offset);
+                    unsigned int target_offset,
+                    FAR struct devif_fileref_s *ref);
+#endif
+
+/****************************************************************************
+ * Name: devif_fileref_alloc
+ *
+ * Description:
+ *   Map length bytes of the file data at offset to send them without
+ *   copying them, if they are directly addressable.
+ *
+ * Returned Value:
+ *   The references to the mapped file data, or NULL if it is not mapped
+ *   and must be copied.
+ *
+ * Assumptions:
+ *   Called without the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+FAR struct devif_fileref_s *devif_fileref_alloc(FAR struct file *file,
+                                                off_t offset,
+                                                size_t length);
+#endif
+
+/****************************************************************************
+ * Name: devif_fileref_wait
+ *
+ * Description:
+ *   Drop the reference of the sender and wait until the I/O buffers that
+ *   reference the file data have all been released, then unmap it.  If
+ *   they are not released within timeout ticks or the wait is interrupted,
+ *   the last of them unmaps the data instead.
+ *
+ * Assumptions:
+ *   Called without the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+void devif_fileref_wait(FAR struct devif_fileref_s *ref, uint32_t timeout);
 #endif
 
 /****************************************************************************
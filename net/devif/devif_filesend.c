@@ -26,17 +26,157 @@
 
 #include <nuttx/config.h>
 
+#include <sys/mman.h>
+#include <sys/param.h>
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
 #include <debug.h>
 #include <errno.h>
 
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/mm/iob.h>
+#include <nuttx/mm/map.h>
 #include <nuttx/net/netdev.h>
 
+#include "devif/devif.h"
+
 #ifdef CONFIG_MM_IOB
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_fileref_free
+ *
+ * Description:
+ *   Unmap the file data and free the references.  The mapping was taken
+ *   out of the task group, it is removed like a mapping of an exiting task.
+ *
+ ****************************************************************************/
+
+static void devif_fileref_free(FAR void *arg)
+{
+  FAR struct devif_fileref_s *ref = arg;
+
+  if (ref->entry.munmap != NULL)
+    {
+      ref->entry.munmap(NULL, &ref->entry, ref->entry.vaddr,
+                        ref->entry.length);
+    }
+
+  nxsem_destroy(&ref->sem);
+  kmm_free(ref);
+}
+
+/****************************************************************************
+ * Name: devif_fileref_release
+ *
+ * Description:
+ *   Called when an I/O buffer that references the file data is freed.
+ *   The last one wakes up the sender or, if it is no longer waiting,
+ *   unmaps the data from the work queue.
+ *
+ ****************************************************************************/
+
+static void devif_fileref_release(FAR void *arg)
+{
+  FAR struct devif_fileref_s *ref = arg;
+
+  if (atomic_fetch_sub(&ref->refs, 1) != 1)
+    {
+      return;
+    }
+
+  if (atomic_xchg(&ref->detach, 1) == 0)
+    {
+      nxsem_post(&ref->sem);
+    }
+  else
+    {
+      work_queue(LPWORK, &ref->work, devif_fileref_free, ref, 0);
+    }
+}
+
+/****************************************************************************
+ * Name: devif_file_map
+ *
+ * Description:
+ *   Return the address of len bytes of the file data at offset, or NULL if
+ *   they are not mapped.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *devif_file_map(FAR struct devif_fileref_s *ref,
+                                   unsigned int len, unsigned int offset)
+{
+  if ((off_t)offset < ref->entry.offset ||
+      (off_t)offset + len > ref->entry.offset + (off_t)ref->entry.length)
+    {
+      return NULL;
+    }
+
+  return (FAR uint8_t *)ref->entry.vaddr +
+         ((off_t)offset - ref->entry.offset);
+}
+
+/****************************************************************************
+ * Name: devif_file_attach
+ *
+ * Description:
+ *   Attach len bytes of file data at data to d_iob, after the target_offset
+ *   bytes of headers, with I/O buffers that reference the file data.
+ *
+ ****************************************************************************/
+
+static int devif_file_attach(FAR struct net_driver_s *dev,
+                             FAR uint8_t *data, unsigned int len,
+                             unsigned int target_offset,
+                             FAR struct devif_fileref_s *ref)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct iob_s *next;
+  unsigned int chunk;
+
+  /* The headers end at the end of the first I/O buffer, so that its length
+   * is kept when the packet length is updated by the upper layers.
+   */
+
+  iob_update_pktlen(iob, 0, false);
+  iob_reserve(iob, CONFIG_IOB_BUFSIZE - target_offset);
+  iob_update_pktlen(iob, target_offset, false);
+  dev->d_buf = NETLLBUF;
+
+  while (len > 0)
+    {
+      chunk = MIN(len, UINT16_MAX);
+      next  = iob_alloc_with_arg(data, chunk, devif_fileref_release, ref);
+      if (next == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      atomic_fetch_add(&ref->refs, 1);
+
+      next->io_len  = chunk;
+      iob->io_flink = next;
+      iob           = next;
+      data         += chunk;
+      len          -= chunk;
+
+      dev->d_iob->io_pktlen += chunk;
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_NET_SENDFILE_ZEROCOPY */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -58,8 +198,12 @@
 
 int devif_file_send(FAR struct net_driver_s *dev, FAR struct file *file,
                     unsigned int len, unsigned int offset,
-                    unsigned int target_offset)
+                    unsigned int target_offset,
+                    FAR struct devif_fileref_s *ref)
 {
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  FAR uint8_t *data;
+#endif
   FAR struct iob_s *iob;
   unsigned int copying;
   unsigned int remain;
@@ -94,6 +238,32 @@ int devif_file_send(FAR struct net_driver_s *dev, FAR struct file *file,
       goto errout;
     }
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  /* Reference the file data if it is directly addressable */
+
+  data = ref != NULL && target_offset <= CONFIG_IOB_BUFSIZE -
+         CONFIG_NET_LL_GUARDSIZE ? devif_file_map(ref, len, offset) : NULL;
+  if (data != NULL)
+    {
+      ret = devif_file_attach(dev, data, len, target_offset, ref);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+
+      /* Leave the file position after the data, as file_read() does */
+
+      ret = file_seek(file, offset + len, SEEK_SET);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+
+      dev->d_sndlen = len;
+      return len;
+    }
+#endif
+
   iob_update_pktlen(dev->d_iob, target_offset, false);
 
   ret = file_seek(file, offset, SEEK_SET);
@@ -163,4 +333,105 @@ errout:
   return ret;
 }
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+
+/****************************************************************************
+ * Name: devif_fileref_alloc
+ *
+ * Description:
+ *   Map length bytes of the file data at offset to send them without
+ *   copying them, if they are directly addressable.
+ *
+ ****************************************************************************/
+
+FAR struct devif_fileref_s *devif_fileref_alloc(FAR struct file *file,
+                                                off_t offset,
+                                                size_t length)
+{
+  FAR struct inode *inode = file->f_inode;
+  FAR struct mm_map_s *mm = get_current_mm();
+  FAR struct mm_map_entry_s *entry;
+  FAR struct devif_fileref_s *ref;
+  int ret;
+
+  if (length == 0 || inode == NULL || inode->u.i_ops->mmap == NULL)
+    {
+      return NULL;
+    }
+
+  ref = kmm_zalloc(sizeof(struct devif_fileref_s));
+  if (ref == NULL)
+    {
+      return NULL;
+    }
+
+  atomic_set(&ref->refs, 1);
+  nxsem_init(&ref->sem, 0, 0);
+
+  ref->entry.length = length;
+  ref->entry.offset = offset;
+  ref->entry.prot   = PROT_READ;
+  ref->entry.flags  = MAP_SHARED;
+
+  /* The mapping keeps the data in place while it is referenced, e.g. a
+   * TMPFS file does not free or move it.  The file system is called
+   * directly, file_mmap() would copy the data of the files that can't be
+   * mapped.  The file system adds the mapping to the task group, take it
+   * back so that an exiting task does not unmap the data still referenced.
+   */
+
+  ret = mm_map_lock();
+  if (ret >= 0)
+    {
+      ret = inode->u.i_ops->mmap(file, &ref->entry);
+      entry = mm_map_next(mm, NULL);
+      if (ret >= 0 && ref->entry.munmap != NULL && entry != NULL &&
+          entry->vaddr == ref->entry.vaddr &&
+          entry->munmap == ref->entry.munmap)
+        {
+          mm_map_remove(mm, entry);
+        }
+
+      mm_map_unlock();
+    }
+
+  if (ret < 0)
+    {
+      nxsem_destroy(&ref->sem);
+      kmm_free(ref);
+      return NULL;
+    }
+
+  return ref;
+}
+
+/****************************************************************************
+ * Name: devif_fileref_wait
+ *
+ * Description:
+ *   Drop the reference of the sender and wait until the I/O buffers that
+ *   reference the file data have all been released, then unmap it.  If
+ *   they are not released within timeout ticks or the wait is interrupted,
+ *   the last of them unmaps the data instead.
+ *
+ ****************************************************************************/
+
+void devif_fileref_wait(FAR struct devif_fileref_s *ref, uint32_t timeout)
+{
+  if (atomic_fetch_sub(&ref->refs, 1) != 1 &&
+      nxsem_tickwait(&ref->sem, timeout) < 0 &&
+      atomic_xchg(&ref->detach, 1) == 0)
+    {
+      /* Detached: the data stays mapped until the I/O buffers that are
+       * still held, e.g. by a stalled driver, are released.
+       */
+
+      nwarn("WARNING: File data still referenced\n");
+      return;
+    }
+
+  devif_fileref_free(ref);
+}
+
+#endif /* CONFIG_NET_SENDFILE_ZEROCOPY */
 #endif /* CONFIG_MM_IOB */
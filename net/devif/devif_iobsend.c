@@ -76,8 +76,15 @@ int devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
 #ifndef CONFIG_NET_IPFRAG
   if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset)
     {
-      ret = -EMSGSIZE;
-      goto errout;
+#  ifdef CONFIG_NET_TCP_TSO
+      /* Unless it is a TCP large send, split later by tcp_segout() */
+
+      if (dev->d_tsomss == 0)
+#  endif
+        {
+          ret = -EMSGSIZE;
+          goto errout;
+        }
     }
 #endif
 
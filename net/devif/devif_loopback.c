@@ -100,6 +100,10 @@ int devif_loopback(FAR struct net_driver_s *dev)
    * Sending, of course, just means relaying back through the network.
    */
 
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  dev->d_looped = true;
+#endif
+
   do
     {
        NETDEV_TXPACKETS(dev);
@@ -143,5 +147,9 @@ int devif_loopback(FAR struct net_driver_s *dev)
     }
   while (dev->d_len > 0);
 
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  dev->d_looped = false;
+#endif
+
   return 1;
 }
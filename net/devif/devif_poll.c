@@ -707,7 +707,8 @@ devif_poll_tcp_connections(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-#if defined(CONFIG_NET_ARP_SEND_QUEUE) || defined(CONFIG_NET_IPFRAG)
+#if defined(CONFIG_NET_ARP_SEND_QUEUE) || defined(CONFIG_NET_IPFRAG) || \
+    defined(CONFIG_NET_TCP_TSO)
 static int devif_poll_queue(FAR struct iob_queue_s *iobq,
                             FAR struct net_driver_s *dev,
                             devif_poll_callback_t callback)
@@ -785,6 +786,33 @@ static inline_function int devif_poll_ipfrag(FAR struct net_driver_s *dev,
 }
 #endif
 
+/****************************************************************************
+ * Name: devif_poll_tcpseg
+ *
+ * Description:
+ *   Poll all segments of TCP large sends for available packets to send.
+ *
+ * Input Parameters:
+ *   dev - NIC Device instance.
+ *   callback - the actual sending API provided by each NIC driver.
+ *
+ * Returned Value:
+ *   Zero indicated the polling will continue, else stop the polling.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver with the network
+ *   locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TSO
+static inline_function int devif_poll_tcpseg(FAR struct net_driver_s *dev,
+                                             devif_poll_callback_t callback)
+{
+  return devif_poll_queue(&dev->d_tsoout, dev, callback);
+}
+#endif
+
 /****************************************************************************
  * Name: devif_poll_arp
  *
@@ -893,6 +921,16 @@ static int devif_poll_connections(FAR struct net_driver_s *dev,
             bstop = devif_poll_ipfrag(dev, callback);
             break;
 #endif
+#ifdef CONFIG_NET_TCP_TSO
+          case TCPSEG_POLL:
+
+            /* Traverse all of the segments of TCP large sends for available
+             * packets to transfer
+             */
+
+            bstop = devif_poll_tcpseg(dev, callback);
+            break;
+#endif
 #ifdef CONFIG_NET_PKT
           case PKT_POLL:
 
@@ -1271,6 +1309,19 @@ int devif_poll_out(FAR struct net_driver_s *dev,
       return 0;
     }
 
+#ifdef CONFIG_NET_TCP_TSO
+  /* Split a TCP large send, the L2 header is built for each segment */
+
+  if (tcp_segout(dev) != OK)
+    {
+      return 1;
+    }
+  else if (dev->d_len == 0)
+    {
+      return callback ? devif_poll_tcpseg(dev, callback) : 0;
+    }
+#endif
+
   devif_out(dev);
 
   bstop = devif_loopback(dev);
@@ -466,6 +466,10 @@ static int ipv4_in(FAR struct net_driver_s *dev)
 done:
 #endif
 
+#ifdef CONFIG_NET_TCP_TSO
+  tcp_segout(dev);
+#endif
+
 #ifdef CONFIG_NET_IPFRAG
   ip_fragout(dev);
 #endif
@@ -583,6 +583,10 @@ static int ipv6_in(FAR struct net_driver_s *dev)
 done:
 #endif
 
+#ifdef CONFIG_NET_TCP_TSO
+  tcp_segout(dev);
+#endif
+
 #ifdef CONFIG_NET_IPFRAG
   ip_fragout(dev);
 #endif
@@ -297,6 +297,25 @@ uint16_t ipv4_build_header(FAR struct ipv4_hdr_s *ipv4, uint16_t total_len,
                            uint8_t tos, FAR struct ipv4_opt_s *opt);
 #endif
 
+/****************************************************************************
+ * Name: ipv4_reserve_ipid
+ *
+ * Description:
+ *   Reserve IP IDs for packets whose header is not built by
+ *   ipv4_build_header(), like the segments of a TCP large send.
+ *
+ * Input Parameters:
+ *   count      The number of consecutive IP IDs
+ *
+ * Returned Value:
+ *   The first of the IP IDs
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+uint16_t ipv4_reserve_ipid(uint16_t count);
+#endif
+
 /****************************************************************************
  * Name: ipv6_build_header
  *
@@ -98,6 +98,12 @@ static ssize_t    inet_sendmsg(FAR struct socket *psock,
                                FAR struct msghdr *msg, int flags);
 static ssize_t    inet_recvmsg(FAR struct socket *psock,
                                FAR struct msghdr *msg, int flags);
+static int        inet_sendmmsg(FAR struct socket *psock,
+                                FAR struct mmsghdr *msgvec,
+                                unsigned int vlen, int flags);
+static int        inet_recvmmsg(FAR struct socket *psock,
+                                FAR struct mmsghdr *msgvec,
+                                unsigned int vlen, int flags);
 static int        inet_ioctl(FAR struct socket *psock,
                              int cmd, unsigned long arg);
 static int        inet_socketpair(FAR struct socket *psocks[2]);
@@ -145,6 +151,8 @@ static const struct sock_intf_s g_inet_sockif =
 #ifdef CONFIG_NET_SENDFILE
   , inet_sendfile   /* si_sendfile */
 #endif
+  , inet_recvmmsg   /* si_recvmmsg */
+  , inet_sendmmsg   /* si_sendmmsg */
 };
 
 /****************************************************************************
@@ -1875,6 +1883,9 @@ static ssize_t inet_sendmsg(FAR struct socket *psock,
   socklen_t tolen = msg->msg_namelen;
   FAR const struct iovec *iov;
   FAR const struct iovec *end;
+#ifdef CONFIG_NET_ZEROCOPY
+  FAR struct socket_conn_s *conn = psock->s_conn;
+#endif
   int ret;
 
   if (msg->msg_iovlen == 1)
@@ -1906,8 +1917,23 @@ static ssize_t inet_sendmsg(FAR struct socket *psock,
       len += iov->iov_len;
     }
 
+#ifdef CONFIG_NET_ZEROCOPY
+  /* The gathered data is sent from a copy, that the MSG_ZEROCOPY send
+   * does not reference.
+   */
+
+  ret = to ? inet_sendto(psock, buf, len, flags & ~MSG_ZEROCOPY, to,
+                         tolen) :
+             inet_send(psock, buf, len, flags & ~MSG_ZEROCOPY);
+  if (ret > 0 && (flags & MSG_ZEROCOPY) != 0 &&
+      _SO_GETOPT(conn->s_options, SO_ZEROCOPY))
+    {
+      net_zcopy_copied(conn);
+    }
+#else
   ret = to ? inet_sendto(psock, buf, len, flags, to, tolen) :
              inet_send(psock, buf, len, flags);
+#endif
 
   kmm_free(buf);
 
@@ -2195,6 +2221,15 @@ static ssize_t inet_recvmsg(FAR struct socket *psock,
 {
   ssize_t ret;
 
+#ifdef CONFIG_NET_ZEROCOPY
+  /* The error queue only holds the completions of MSG_ZEROCOPY sends */
+
+  if ((flags & MSG_ERRQUEUE) != 0)
+    {
+      return net_zcopy_recverr(psock->s_conn, msg, psock->s_domain);
+    }
+#endif
+
   /* If a 'from' address has been provided, verify that it is large
    * enough to hold this address family.
    */
@@ -2275,6 +2310,162 @@ static ssize_t inet_recvmsg(FAR struct socket *psock,
   return ret;
 }
 
+/****************************************************************************
+ * Name: inet_addrlen
+ *
+ * Description:
+ *   Return the size of the socket address of an address family, or zero if
+ *   the address family is not supported.
+ *
+ ****************************************************************************/
+
+#ifdef NET_UDP_HAVE_STACK
+static socklen_t inet_addrlen(sa_family_t family)
+{
+  switch (family)
+    {
+#ifdef CONFIG_NET_IPv4
+      case AF_INET:
+        return sizeof(struct sockaddr_in);
+#endif
+
+#ifdef CONFIG_NET_IPv6
+      case AF_INET6:
+        return sizeof(struct sockaddr_in6);
+#endif
+
+      default:
+        return 0;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: inet_sendmmsg
+ *
+ * Description:
+ *   Implements the sendmmsg() batch operation for the case of the AF_INET
+ *   and AF_INET6 address families.  The leading datagrams that are sent as
+ *   a single buffer are queued at once, otherwise the first message is sent
+ *   as inet_sendmsg() does.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The messages to send
+ *   vlen    - The number of messages in msgvec
+ *   flags   - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  On  error, a negated
+ *   errno value is returned (see sendmsg()).
+ *
+ ****************************************************************************/
+
+static int inet_sendmmsg(FAR struct socket *psock,
+                         FAR struct mmsghdr *msgvec, unsigned int vlen,
+                         int flags)
+{
+  ssize_t ret;
+
+#if defined(NET_UDP_HAVE_STACK) && defined(CONFIG_NET_UDP_WRITE_BUFFERS) && \
+    !defined(CONFIG_NET_6LOWPAN)
+  if (psock->s_type == SOCK_DGRAM)
+    {
+      FAR const struct sockaddr *to;
+      FAR struct msghdr *msg;
+      unsigned int n;
+
+      for (n = 0; n < vlen; n++)
+        {
+          msg = &msgvec[n].msg_hdr;
+          to  = msg->msg_name;
+          if (msg->msg_iovlen != 1 ||
+              (to != NULL && (inet_addrlen(to->sa_family) == 0 ||
+                              msg->msg_namelen <
+                              inet_addrlen(to->sa_family))))
+            {
+              break;
+            }
+        }
+
+      if (n > 0)
+        {
+          return psock_udp_sendmmsg(psock, msgvec, n, flags);
+        }
+    }
+#endif
+
+  ret = inet_sendmsg(psock, &msgvec[0].msg_hdr, flags);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  msgvec[0].msg_len = ret;
+  return 1;
+}
+
+/****************************************************************************
+ * Name: inet_recvmmsg
+ *
+ * Description:
+ *   Implements the recvmmsg() batch operation for the case of the AF_INET
+ *   and AF_INET6 address families.  The leading datagrams that are received
+ *   into a single buffer are received at once, otherwise the first message
+ *   is received as inet_recvmsg() does.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - Buffers to receive the messages
+ *   vlen    - The number of messages in msgvec
+ *   flags   - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  On errors, a
+ *   negated errno value is returned (see recvmsg()).
+ *
+ ****************************************************************************/
+
+static int inet_recvmmsg(FAR struct socket *psock,
+                         FAR struct mmsghdr *msgvec, unsigned int vlen,
+                         int flags)
+{
+  ssize_t ret;
+
+#ifdef NET_UDP_HAVE_STACK
+  if (psock->s_type == SOCK_DGRAM && (flags & MSG_ERRQUEUE) == 0)
+    {
+      FAR struct msghdr *msg;
+      unsigned int n;
+
+      for (n = 0; n < vlen; n++)
+        {
+          msg = &msgvec[n].msg_hdr;
+          if (msg->msg_iovlen != 1 ||
+              (msg->msg_name != NULL &&
+               msg->msg_namelen < inet_addrlen(psock->s_domain)))
+            {
+              break;
+            }
+        }
+
+      if (n > 0)
+        {
+          return psock_udp_recvmmsg(psock, msgvec, n, flags);
+        }
+    }
+#endif
+
+  ret = inet_recvmsg(psock, &msgvec[0].msg_hdr, flags);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  msgvec[0].msg_len = ret;
+  return 1;
+}
+
 #endif /* NET_UDP_HAVE_STACK || NET_TCP_HAVE_STACK */
 
 /****************************************************************************
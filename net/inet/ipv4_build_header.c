@@ -111,4 +111,27 @@ uint16_t ipv4_build_header(FAR struct ipv4_hdr_s *ipv4, uint16_t total_len,
   return (ipv4->vhl & IPv4_HLMASK) << 2;
 }
 
+/****************************************************************************
+ * Name: ipv4_reserve_ipid
+ *
+ * Description:
+ *   Reserve IP IDs for packets whose header is not built by
+ *   ipv4_build_header(), like the segments of a TCP large send.
+ *
+ * Input Parameters:
+ *   count      The number of consecutive IP IDs
+ *
+ * Returned Value:
+ *   The first of the IP IDs
+ *
+ ****************************************************************************/
+
+uint16_t ipv4_reserve_ipid(uint16_t count)
+{
+  uint16_t ipid = g_ipid + 1;
+
+  g_ipid += count;
+  return ipid;
+}
+
 #endif /* CONFIG_NET_IPv4 */
@@ -76,10 +76,37 @@ static sq_queue_t g_ipv4_filters[IPFILTER_CHAIN_MAX];
 static sq_queue_t g_ipv6_filters[IPFILTER_CHAIN_MAX];
 #endif
 
+/* The generation of the rules, changed by each update of the rules so
+ * that the verdicts saved in the tracked flows are no longer used.
+ */
+
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+static uint32_t g_ipfilter_gen = 1;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: ipfilter_newgen
+ *
+ * Description:
+ *   Start a new generation of the rules.  Zero is skipped when the
+ *   generation wraps, it is the generation of a flow with no verdict.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+static void ipfilter_newgen(void)
+{
+  if (++g_ipfilter_gen == 0)
+    {
+      g_ipfilter_gen = 1;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: ipfilter_match_device
  *
@@ -189,7 +216,7 @@ static bool ipfilter_match_proto(FAR const struct ipfilter_entry_s *entry,
 }
 
 /****************************************************************************
- * Name: ipv4_filter_match / ipv6_filter_match
+ * Name: ipv4_filter_rules / ipv6_filter_rules
  *
  * Description:
  *   Match the input packet with the filter entries in the specified chain.
@@ -208,7 +235,7 @@ static bool ipfilter_match_proto(FAR const struct ipfilter_entry_s *entry,
  ****************************************************************************/
 
 #ifdef CONFIG_NET_IPv4
-static int ipv4_filter_match(FAR const struct net_driver_s *indev,
+static int ipv4_filter_rules(FAR const struct net_driver_s *indev,
                              FAR const struct net_driver_s *outdev,
                              FAR const struct ipv4_hdr_s *ipv4,
                              enum ipfilter_chain_e chain)
@@ -278,7 +305,7 @@ static int ipv4_filter_match(FAR const struct net_driver_s *indev,
 #endif
 
 #ifdef CONFIG_NET_IPv6
-static int ipv6_filter_match(FAR const struct net_driver_s *indev,
+static int ipv6_filter_rules(FAR const struct net_driver_s *indev,
                              FAR const struct net_driver_s *outdev,
                              FAR const struct ipv6_hdr_s *ipv6,
                              enum ipfilter_chain_e chain)
@@ -347,6 +374,118 @@ static int ipv6_filter_match(FAR const struct net_driver_s *indev,
 }
 #endif
 
+/****************************************************************************
+ * Name: ipv4_filter_match / ipv6_filter_match
+ *
+ * Description:
+ *   Match the input packet with the specified chain.  The verdict is taken
+ *   from the flow of the packet if the chain already matched it with the
+ *   current rules, the rules are only matched for the first packet.
+ *
+ *   A packet is accounted to its flow in the first chain it meets: INPUT,
+ *   OUTPUT or FORWARD.  A packet sent to this host itself meets the INPUT
+ *   chain after the OUTPUT chain, with its source address on the input
+ *   device, and is not accounted twice.
+ *
+ * Input Parameters:
+ *   indev     - The network device that the packet comes from
+ *   outdev    - The network device that the packet goes to
+ *   ipv4/ipv6 - The IPv4/IPv6 header
+ *   chain     - The chain to match the filter entries
+ *
+ * Returned Value:
+ *   The same as ipv4_filter_rules / ipv6_filter_rules
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+#ifdef CONFIG_NET_IPv4
+static int ipv4_filter_match(FAR const struct net_driver_s *indev,
+                             FAR const struct net_driver_s *outdev,
+                             FAR const struct ipv4_hdr_s *ipv4,
+                             enum ipfilter_chain_e chain)
+{
+  FAR struct ipfilter_ct_s *ct = NULL;
+  uint32_t gen = g_ipfilter_gen;
+  int target;
+
+  if ((indev != NULL || outdev != NULL) && ipv4 != NULL)
+    {
+      uint16_t len = (ipv4->len[0] << 8) + ipv4->len[1];
+
+      /* A looped back packet was accounted by the OUTPUT chain */
+
+      if (chain == IPFILTER_CHAIN_INPUT && indev->d_looped)
+        {
+          len = 0;
+        }
+
+      ct = ipfilter_ct_find(PF_INET, ipv4->srcipaddr, ipv4->destipaddr,
+                            ipv4->proto, IPv4_L4HDR(ipv4), len);
+      if (ct != NULL &&
+          ipfilter_ct_cached(ct, indev, outdev, chain, gen, &target))
+        {
+          return target;
+        }
+    }
+
+  target = ipv4_filter_rules(indev, outdev, ipv4, chain);
+  if (ct != NULL)
+    {
+      ipfilter_ct_cache(ct, indev, outdev, chain, gen, target);
+    }
+
+  return target;
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static int ipv6_filter_match(FAR const struct net_driver_s *indev,
+                             FAR const struct net_driver_s *outdev,
+                             FAR const struct ipv6_hdr_s *ipv6,
+                             enum ipfilter_chain_e chain)
+{
+  FAR struct ipfilter_ct_s *ct = NULL;
+  FAR const void *l4hdr;
+  uint32_t gen = g_ipfilter_gen;
+  uint8_t proto;
+  int target;
+
+  if ((indev != NULL || outdev != NULL) && ipv6 != NULL)
+    {
+      uint16_t len = IPv6_HDRLEN + (ipv6->len[0] << 8) + ipv6->len[1];
+
+      /* A looped back packet was accounted by the OUTPUT chain */
+
+      if (chain == IPFILTER_CHAIN_INPUT && indev->d_looped)
+        {
+          len = 0;
+        }
+
+      l4hdr = IPv6_L4HDR(ipv6, proto);
+      ct    = ipfilter_ct_find(PF_INET6, ipv6->srcipaddr, ipv6->destipaddr,
+                               proto, l4hdr, len);
+      if (ct != NULL &&
+          ipfilter_ct_cached(ct, indev, outdev, chain, gen, &target))
+        {
+          return target;
+        }
+    }
+
+  target = ipv6_filter_rules(indev, outdev, ipv6, chain);
+  if (ct != NULL)
+    {
+      ipfilter_ct_cache(ct, indev, outdev, chain, gen, target);
+    }
+
+  return target;
+}
+#endif
+#else
+#  define ipv4_filter_match ipv4_filter_rules
+#  define ipv6_filter_match ipv6_filter_rules
+#endif /* CONFIG_NET_IPFILTER_CONNTRACK */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -420,6 +559,10 @@ void ipfilter_cfg_add(FAR struct ipfilter_entry_s *entry,
       sq_addlast((FAR sq_entry_t *)entry, &g_ipv6_filters[chain]);
     }
 #endif
+
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  ipfilter_newgen();
+#endif
 }
 
 /****************************************************************************
@@ -461,6 +604,10 @@ void ipfilter_cfg_clear(sa_family_t family, enum ipfilter_chain_e chain)
         }
     }
 #endif
+
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  ipfilter_newgen();
+#endif
 }
 
 /****************************************************************************
@@ -29,6 +29,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <nuttx/compiler.h>
@@ -56,6 +57,37 @@ enum ipfilter_chain_e
   IPFILTER_CHAIN_MAX
 };
 
+/* The NAT entries cached in a flow, for the packets of the flow sent out
+ * of and received on a NAT device.
+ */
+
+enum ipfilter_ct_nat_e
+{
+  IPFILTER_CT_NAT_OUTBOUND = 0,
+  IPFILTER_CT_NAT_INBOUND  = 1,
+  IPFILTER_CT_NAT_MAX
+};
+
+/* A flow tracked by the filter, see ipfilter_ct_find() */
+
+struct ipfilter_ct_s;
+
+/* A flow as reported by ipfilter_ct_foreach() */
+
+struct ipfilter_ct_info_s
+{
+  FAR const void *srcip;  /* Source address */
+  FAR const void *destip; /* Destination address */
+  uint16_t srcport;       /* TCP/UDP ports, or ICMP identifier in both */
+  uint16_t destport;
+  uint8_t proto;          /* L4 protocol */
+  uint32_t packets;       /* Number of packets of the flow */
+  uint64_t bytes;         /* Number of bytes of the flow */
+};
+
+typedef CODE void (*ipfilter_ct_cb_t)(
+  FAR const struct ipfilter_ct_info_s *info, FAR void *arg);
+
 /* The filter configuration entry */
 
 struct ipfilter_entry_s
@@ -264,5 +296,143 @@ int ipv6_filter_fwd(FAR struct net_driver_s *indev,
                     FAR struct ipv6_hdr_s *ipv6);
 #endif
 
+/****************************************************************************
+ * Name: ipfilter_ct_find
+ *
+ * Description:
+ *   Find the flow of a packet, or start tracking it, and account the
+ *   packet unless len is zero.
+ *
+ * Input Parameters:
+ *   domain        - PF_INET or PF_INET6
+ *   srcip/destip  - The addresses of the packet
+ *   proto         - The L4 protocol of the packet
+ *   l4hdr         - The L4 header of the packet
+ *   len           - The length of the packet, zero if it was already
+ *                   accounted in another chain
+ *
+ * Returned Value:
+ *   The flow, or NULL if it can't be tracked.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+FAR struct ipfilter_ct_s *ipfilter_ct_find(uint8_t domain,
+                                           FAR const void *srcip,
+                                           FAR const void *destip,
+                                           uint8_t proto,
+                                           FAR const void *l4hdr,
+                                           uint16_t len);
+
+/****************************************************************************
+ * Name: ipfilter_ct_cached / ipfilter_ct_cache
+ *
+ * Description:
+ *   Get or save the verdict of a chain on a flow.  A verdict is only
+ *   returned for the same devices and the same generation gen of the
+ *   rules.
+ *
+ * Input Parameters:
+ *   ct     - The flow
+ *   indev  - The network device that the packet comes from
+ *   outdev - The network device that the packet goes to
+ *   chain  - The chain
+ *   gen    - The generation of the rules
+ *   target - The verdict of the chain
+ *
+ * Returned Value:
+ *   ipfilter_ct_cached() returns true if the verdict is returned in target.
+ *
+ ****************************************************************************/
+
+bool ipfilter_ct_cached(FAR const struct ipfilter_ct_s *ct,
+                        FAR const struct net_driver_s *indev,
+                        FAR const struct net_driver_s *outdev,
+                        enum ipfilter_chain_e chain, uint32_t gen,
+                        FAR int *target);
+void ipfilter_ct_cache(FAR struct ipfilter_ct_s *ct,
+                       FAR const struct net_driver_s *indev,
+                       FAR const struct net_driver_s *outdev,
+                       enum ipfilter_chain_e chain, uint32_t gen,
+                       int target);
+
+/****************************************************************************
+ * Name: ipfilter_ct_lookup
+ *
+ * Description:
+ *   Find the TCP or UDP flow of a tuple, or start tracking it, without
+ *   accounting a packet.  This lets NAT find its entries in the flow table
+ *   before its own tables.
+ *
+ * Input Parameters:
+ *   domain            - PF_INET or PF_INET6
+ *   srcip/destip      - The addresses of the tuple
+ *   proto             - The L4 protocol of the tuple
+ *   srcport/destport  - The ports of the tuple, in network order
+ *
+ * Returned Value:
+ *   The flow, or NULL if it isn't TCP or UDP, or can't be tracked.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct ipfilter_ct_s *ipfilter_ct_lookup(uint8_t domain,
+                                             FAR const void *srcip,
+                                             FAR const void *destip,
+                                             uint8_t proto,
+                                             uint16_t srcport,
+                                             uint16_t destport);
+
+/****************************************************************************
+ * Name: ipfilter_ct_nat / ipfilter_ct_setnat
+ *
+ * Description:
+ *   Get or save the NAT entry of a flow in a direction.  An entry is only
+ *   returned for the same generation gen of the NAT entries, which changes
+ *   whenever one of them is freed.
+ *
+ * Input Parameters:
+ *   ct    - The flow, may be NULL for ipfilter_ct_nat()
+ *   dir   - The direction of the packets
+ *   gen   - The generation of the NAT entries, not zero
+ *   entry - The NAT entry
+ *
+ * Returned Value:
+ *   ipfilter_ct_nat() returns the NAT entry, or NULL if none is cached.
+ *
+ ****************************************************************************/
+
+FAR void *ipfilter_ct_nat(FAR const struct ipfilter_ct_s *ct,
+                          enum ipfilter_ct_nat_e dir, uint32_t gen);
+void ipfilter_ct_setnat(FAR struct ipfilter_ct_s *ct,
+                        enum ipfilter_ct_nat_e dir, FAR void *entry,
+                        uint32_t gen);
+
+/****************************************************************************
+ * Name: ipfilter_ct_foreach
+ *
+ * Description:
+ *   Call the callback function for each flow of a domain, which must not
+ *   add or remove flows.
+ *
+ * Input Parameters:
+ *   domain - PF_INET or PF_INET6
+ *   cb     - The callback function
+ *   arg    - The argument to pass to the callback function
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipfilter_ct_foreach(uint8_t domain, ipfilter_ct_cb_t cb,
+                         FAR void *arg);
+#endif
+
 #endif /* CONFIG_NET_IPFILTER */
 #endif /* __NET_IPFILTER_IPFILTER_H */
@@ -0,0 +1,467 @@
+/****************************************************************************
+ * net/ipfilter/ipfilter_conntrack.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/netdev.h>
+
+#include "ipfilter/ipfilter.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The initial number of buckets of the flow table, which grows with the
+ * number of flows.
+ */
+
+#define IPFILTER_CT_HASHSIZE 16
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The key of a flow.  The rules only look at the addresses, the protocol,
+ * the ports of TCP and UDP and the type of ICMP, so all the packets of a
+ * flow get the same verdict from a chain.
+ */
+
+struct ipfilter_ct_key_s
+{
+  net_ipv6addr_t srcip;   /* Source address, IPv4 in the first words */
+  net_ipv6addr_t destip;  /* Destination address */
+  uint16_t l4[2];         /* TCP/UDP ports, or ICMP type and identifier */
+  uint8_t domain;         /* PF_INET or PF_INET6 */
+  uint8_t proto;          /* L4 protocol */
+};
+
+/* The last verdict of a chain on a flow, valid until the rules change */
+
+struct ipfilter_ct_verdict_s
+{
+  FAR const struct net_driver_s *indev;
+  FAR const struct net_driver_s *outdev;
+  uint32_t gen;           /* Generation of the rules, zero if none */
+  int8_t target;          /* IPFILTER_TARGET_* */
+};
+
+/* The NAT entry of a flow, valid until a NAT entry is freed */
+
+struct ipfilter_ct_nat_s
+{
+  FAR void *entry;        /* ipv4_nat_entry_t or ipv6_nat_entry_t */
+  uint32_t gen;           /* Generation of the NAT entries, zero if none */
+};
+
+/* A tracked flow */
+
+struct ipfilter_ct_s
+{
+  struct net_hashnode_s hnode;  /* Entry of g_ipfilter_cthash */
+  struct net_wheelnode_s timer; /* Idle timeout */
+  struct ipfilter_ct_key_s key;
+  uint32_t packets;             /* Number of packets of the flow */
+  uint64_t bytes;               /* Number of bytes of the flow */
+  struct ipfilter_ct_verdict_s verdict[IPFILTER_CHAIN_MAX];
+  struct ipfilter_ct_nat_s nat[IPFILTER_CT_NAT_MAX];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+NET_HASHTAB_DECLARE(g_ipfilter_cthash, IPFILTER_CT_HASHSIZE);
+static struct net_wheel_s g_ipfilter_ctwheel;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipfilter_ct_expire
+ *
+ * Description:
+ *   Free an idle flow, called by the timer wheel.
+ *
+ ****************************************************************************/
+
+static void ipfilter_ct_expire(FAR struct net_wheelnode_s *node,
+                               FAR void *arg)
+{
+  FAR struct ipfilter_ct_s *ct =
+    container_of(node, struct ipfilter_ct_s, timer);
+
+  ninfo("INFO: Flow proto=%" PRIu8 " expired, %" PRIu32 " packets, "
+        "%" PRIu64 " bytes\n", ct->key.proto, ct->packets, ct->bytes);
+
+  net_wheel_remove(&g_ipfilter_ctwheel, &ct->timer);
+  net_hash_remove(&g_ipfilter_cthash, &ct->hnode);
+  kmm_free(ct);
+}
+
+/****************************************************************************
+ * Name: ipfilter_ct_key
+ *
+ * Description:
+ *   Fill the key of the flow of a packet.
+ *
+ ****************************************************************************/
+
+static void ipfilter_ct_key(FAR struct ipfilter_ct_key_s *key,
+                            uint8_t domain, FAR const void *srcip,
+                            FAR const void *destip, uint8_t proto,
+                            FAR const void *l4hdr)
+{
+  FAR const uint16_t *l4 = l4hdr;
+  size_t addrlen = sizeof(net_ipv6addr_t);
+
+  memset(key, 0, sizeof(*key));
+
+  if (domain == PF_INET)
+    {
+      addrlen = sizeof(in_addr_t);
+    }
+
+  memcpy(key->srcip, srcip, addrlen);
+  memcpy(key->destip, destip, addrlen);
+  key->domain = domain;
+  key->proto  = proto;
+
+  switch (proto)
+    {
+      case IP_PROTO_TCP:
+      case IP_PROTO_UDP:
+        key->l4[0] = l4[0];
+        key->l4[1] = l4[1];
+        break;
+
+      case IP_PROTO_ICMP:
+      case IP_PROTO_ICMP6:
+        key->l4[0] = *(FAR const uint8_t *)l4hdr;
+        key->l4[1] = l4[2];
+        break;
+
+      default:
+        break;
+    }
+}
+
+/****************************************************************************
+ * Name: ipfilter_ct_get
+ *
+ * Description:
+ *   Find the flow of a key, or start tracking it.  The flows idle for
+ *   CONFIG_NET_IPFILTER_CONNTRACK_TIMEOUT seconds are freed.
+ *
+ * Returned Value:
+ *   The flow, or NULL if the table is full or it can't be allocated.
+ *
+ ****************************************************************************/
+
+static FAR struct ipfilter_ct_s *
+ipfilter_ct_get(FAR const struct ipfilter_ct_key_s *key)
+{
+  FAR struct net_hashnode_s *node;
+  FAR struct ipfilter_ct_s *ct = NULL;
+  int32_t now = TICK2SEC(clock_systime_ticks());
+  uint32_t hash;
+
+  net_wheel_run(&g_ipfilter_ctwheel, now, ipfilter_ct_expire, NULL);
+
+  hash = net_hash_mix(net_hash_seed(&g_ipfilter_cthash), key, sizeof(*key));
+
+  for (node = net_hash_first(&g_ipfilter_cthash, hash); node != NULL;
+       node = net_hash_next(node))
+    {
+      ct = container_of(node, struct ipfilter_ct_s, hnode);
+      if (memcmp(&ct->key, key, sizeof(*key)) == 0)
+        {
+          break;
+        }
+    }
+
+  if (node == NULL)
+    {
+      if (g_ipfilter_cthash.count >= CONFIG_NET_IPFILTER_CONNTRACK_MAX)
+        {
+          return NULL;
+        }
+
+      ct = kmm_zalloc(sizeof(struct ipfilter_ct_s));
+      if (ct == NULL)
+        {
+          return NULL;
+        }
+
+      memcpy(&ct->key, key, sizeof(*key));
+      net_hash_add(&g_ipfilter_cthash, &ct->hnode, hash);
+      net_wheel_add(&g_ipfilter_ctwheel, &ct->timer,
+                    now + CONFIG_NET_IPFILTER_CONNTRACK_TIMEOUT);
+    }
+  else
+    {
+      ct->timer.expire = now + CONFIG_NET_IPFILTER_CONNTRACK_TIMEOUT;
+    }
+
+  return ct;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipfilter_ct_find
+ *
+ * Description:
+ *   Find the flow of a packet, or start tracking it, and account the
+ *   packet unless len is zero.
+ *
+ * Returned Value:
+ *   The flow, or NULL if the table is full or it can't be allocated.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct ipfilter_ct_s *ipfilter_ct_find(uint8_t domain,
+                                           FAR const void *srcip,
+                                           FAR const void *destip,
+                                           uint8_t proto,
+                                           FAR const void *l4hdr,
+                                           uint16_t len)
+{
+  FAR struct ipfilter_ct_s *ct;
+  struct ipfilter_ct_key_s key;
+
+  ipfilter_ct_key(&key, domain, srcip, destip, proto, l4hdr);
+
+  ct = ipfilter_ct_get(&key);
+  if (ct != NULL && len > 0)
+    {
+      ct->packets++;
+      ct->bytes += len;
+    }
+
+  return ct;
+}
+
+/****************************************************************************
+ * Name: ipfilter_ct_lookup
+ *
+ * Description:
+ *   Find the TCP or UDP flow of a tuple, or start tracking it, without
+ *   accounting a packet.
+ *
+ * Returned Value:
+ *   The flow, or NULL if it isn't TCP or UDP, or can't be tracked.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct ipfilter_ct_s *ipfilter_ct_lookup(uint8_t domain,
+                                             FAR const void *srcip,
+                                             FAR const void *destip,
+                                             uint8_t proto,
+                                             uint16_t srcport,
+                                             uint16_t destport)
+{
+  struct ipfilter_ct_key_s key;
+  uint16_t ports[2];
+
+  /* The ports are the start of the TCP and UDP headers, the key of the
+   * other protocols needs more of the header.
+   */
+
+  if (proto != IP_PROTO_TCP && proto != IP_PROTO_UDP)
+    {
+      return NULL;
+    }
+
+  ports[0] = srcport;
+  ports[1] = destport;
+  ipfilter_ct_key(&key, domain, srcip, destip, proto, ports);
+
+  return ipfilter_ct_get(&key);
+}
+
+/****************************************************************************
+ * Name: ipfilter_ct_cached
+ *
+ * Description:
+ *   Get the verdict of a chain on the flow, if it was made by the rules of
+ *   generation gen for the same devices.
+ *
+ * Returned Value:
+ *   true if the verdict is returned in target.
+ *
+ ****************************************************************************/
+
+bool ipfilter_ct_cached(FAR const struct ipfilter_ct_s *ct,
+                        FAR const struct net_driver_s *indev,
+                        FAR const struct net_driver_s *outdev,
+                        enum ipfilter_chain_e chain, uint32_t gen,
+                        FAR int *target)
+{
+  FAR const struct ipfilter_ct_verdict_s *verdict = &ct->verdict[chain];
+
+  if (verdict->gen != gen || verdict->indev != indev ||
+      verdict->outdev != outdev)
+    {
+      return false;
+    }
+
+  *target = verdict->target;
+  return true;
+}
+
+/****************************************************************************
+ * Name: ipfilter_ct_cache
+ *
+ * Description:
+ *   Save the verdict of a chain on the flow, made by the rules of
+ *   generation gen.
+ *
+ ****************************************************************************/
+
+void ipfilter_ct_cache(FAR struct ipfilter_ct_s *ct,
+                       FAR const struct net_driver_s *indev,
+                       FAR const struct net_driver_s *outdev,
+                       enum ipfilter_chain_e chain, uint32_t gen,
+                       int target)
+{
+  FAR struct ipfilter_ct_verdict_s *verdict = &ct->verdict[chain];
+
+  verdict->indev  = indev;
+  verdict->outdev = outdev;
+  verdict->gen    = gen;
+  verdict->target = target;
+}
+
+/****************************************************************************
+ * Name: ipfilter_ct_nat
+ *
+ * Description:
+ *   Get the NAT entry of the flow in a direction, if it was saved in
+ *   generation gen of the NAT entries.
+ *
+ * Returned Value:
+ *   The NAT entry, or NULL if none is cached or ct is NULL.
+ *
+ ****************************************************************************/
+
+FAR void *ipfilter_ct_nat(FAR const struct ipfilter_ct_s *ct,
+                          enum ipfilter_ct_nat_e dir, uint32_t gen)
+{
+  if (ct == NULL || ct->nat[dir].gen != gen)
+    {
+      return NULL;
+    }
+
+  return ct->nat[dir].entry;
+}
+
+/****************************************************************************
+ * Name: ipfilter_ct_setnat
+ *
+ * Description:
+ *   Save the NAT entry of the flow in a direction, found in generation gen
+ *   of the NAT entries.
+ *
+ ****************************************************************************/
+
+void ipfilter_ct_setnat(FAR struct ipfilter_ct_s *ct,
+                        enum ipfilter_ct_nat_e dir, FAR void *entry,
+                        uint32_t gen)
+{
+  ct->nat[dir].entry = entry;
+  ct->nat[dir].gen   = gen;
+}
+
+/****************************************************************************
+ * Name: ipfilter_ct_foreach
+ *
+ * Description:
+ *   Call the callback function for each flow of a domain.
+ *
+ ****************************************************************************/
+
+void ipfilter_ct_foreach(uint8_t domain, ipfilter_ct_cb_t cb,
+                         FAR void *arg)
+{
+  FAR struct net_hashnode_s *node;
+  FAR struct ipfilter_ct_s *ct;
+  struct ipfilter_ct_info_s info;
+  uint32_t i;
+
+  for (i = 0; i < g_ipfilter_cthash.nbuckets; i++)
+    {
+      for (node = g_ipfilter_cthash.buckets[i]; node != NULL;
+           node = node->next)
+        {
+          ct = container_of(node, struct ipfilter_ct_s, hnode);
+          if (ct->key.domain != domain)
+            {
+              continue;
+            }
+
+          info.srcip   = ct->key.srcip;
+          info.destip  = ct->key.destip;
+          info.proto   = ct->key.proto;
+          info.packets = ct->packets;
+          info.bytes   = ct->bytes;
+
+          if (ct->key.proto == IP_PROTO_ICMP ||
+              ct->key.proto == IP_PROTO_ICMP6)
+            {
+              info.srcport  = ct->key.l4[1];
+              info.destport = ct->key.l4[1];
+            }
+          else
+            {
+              info.srcport  = ct->key.l4[0];
+              info.destport = ct->key.l4[1];
+            }
+
+          cb(&info, arg);
+        }
+    }
+}
+
+#endif /* CONFIG_NET_IPFILTER_CONNTRACK */
@@ -476,6 +476,31 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
 ssize_t local_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                       int flags);
 
+/****************************************************************************
+ * Name: local_sendmmsg
+ *
+ * Description:
+ *   Implements the sendmmsg() batch operation for the case of the local
+ *   Unix socket.  The leading messages to the same address and without
+ *   control data are sent with the FIFO opened and the send lock taken
+ *   once, otherwise the first message is sent as local_sendmsg() does.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   The messages to send
+ *   vlen     The number of messages in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  On  error, a negated
+ *   errno value is returned (see sendmsg() for the list of appropriate
+ *   error values.
+ *
+ ****************************************************************************/
+
+int local_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
 /****************************************************************************
  * Name: local_send_preamble
  *
@@ -548,6 +573,30 @@ int local_send_packet(FAR struct file *filep, FAR const struct iovec *buf,
 ssize_t local_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                       int flags);
 
+/****************************************************************************
+ * Name: local_recvmmsg
+ *
+ * Description:
+ *   Implements the recvmmsg() batch operation for local sockets.  The
+ *   datagrams available are received with the receiving FIFO opened once,
+ *   otherwise the first message is received as local_recvmsg() does.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   Buffers to receive the messages
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  Otherwise, on
+ *   errors, a negated errno value is returned (see recvmsg() for the list
+ *   of appropriate error values).
+ *
+ ****************************************************************************/
+
+int local_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
 /****************************************************************************
  * Name: local_fifo_read
  *
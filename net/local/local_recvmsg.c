@@ -341,10 +341,11 @@ static int psock_fifo_discard(FAR struct socket *psock, size_t len,
 }
 
 /****************************************************************************
- * Name: psock_dgram_recvfrom
+ * Name: psock_dgram_recvpkt
  *
  * Description:
- *   psock_dgram_recvfrom() receives messages from a local datagram socket.
+ *   psock_dgram_recvpkt() receives the next packet from the receiving FIFO
+ *   of a local datagram socket, which must be open.
  *
  * Input Parameters:
  *   psock    A pointer to a NuttX-specific, internal socket structure
@@ -356,62 +357,22 @@ static int psock_fifo_discard(FAR struct socket *psock, size_t len,
  *
  * Returned Value:
  *   On success, returns the number of characters received.  Otherwise, on
- *   errors, -1 is returned, and errno is set appropriately (see receive
- *   from for the complete list).
+ *   errors, a negated errno value is returned.
  *
  ****************************************************************************/
 
-static inline ssize_t
-psock_dgram_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
-                     int flags, FAR struct sockaddr *from,
-                     FAR socklen_t *fromlen)
+static ssize_t psock_dgram_recvpkt(FAR struct socket *psock, FAR void *buf,
+                                   size_t len, int flags,
+                                   FAR struct sockaddr *from,
+                                   FAR socklen_t *fromlen)
 {
-  FAR struct local_conn_s *conn = psock->s_conn;
   size_t readlen;
   size_t pathlen;
-  bool bclose = false;
   lc_size_t addrlen;
   lc_size_t pktlen;
   int offset = 0;
   int ret;
 
-  /* Verify that this is a bound, un-connected peer socket */
-
-  if (conn->lc_state != LOCAL_STATE_BOUND &&
-      conn->lc_state != LOCAL_STATE_CONNECTED)
-    {
-      /* Either not bound to address or it is connected */
-
-      nerr("ERROR: Connected or not bound\n");
-      return -EISCONN;
-    }
-
-  if (conn->lc_infile.f_inode == NULL)
-    {
-      bclose = true;
-
-      /* Make sure that half duplex FIFO has been created */
-
-      ret = local_create_halfduplex(conn, conn->lc_path, conn->lc_rcvsize);
-      if (ret < 0)
-        {
-          nerr("ERROR: Failed to create FIFO for %s: %d\n",
-               conn->lc_path, ret);
-          return ret;
-        }
-
-      /* Open the receiving side of the transfer */
-
-      ret = local_open_receiver(conn, (flags & MSG_DONTWAIT) != 0 ||
-                                _SS_ISNONBLOCK(conn->lc_conn.s_flags));
-      if (ret < 0)
-        {
-          nerr("ERROR: Failed to open FIFO for %s: %d\n",
-               conn->lc_path, ret);
-          goto errout_with_halfduplex;
-        }
-    }
-
   readlen = sizeof(addrlen);
   ret = psock_fifo_read(psock, &addrlen, offset, &readlen, flags, false);
   if (ret < 0)
@@ -430,7 +391,7 @@ psock_dgram_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
   if (ret < 0)
     {
       nerr("ERROR: Failed to get packet length: ret %d\n", ret);
-      goto errout_with_infd;
+      return ret;
     }
 
   readlen = addrlen;
@@ -444,7 +405,7 @@ psock_dgram_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
       if (ret < 0)
         {
           nerr("ERROR: Failed to get path : ret %d\n", ret);
-          goto errout_with_infd;
+          return ret;
         }
 
       from->sa_family = AF_LOCAL;
@@ -459,7 +420,7 @@ psock_dgram_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
       if (ret < 0)
         {
           nerr("ERROR: Failed to discard redunance address: ret %d\n", ret);
-          goto errout_with_infd;
+          return ret;
         }
     }
 
@@ -471,7 +432,7 @@ psock_dgram_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
   if (ret < 0)
     {
       nerr("ERROR: Failed to get packet : ret %d\n", ret);
-      goto errout_with_infd;
+      return ret;
     }
 
   /* If there are unread bytes remaining in the packet, flush the remainder
@@ -484,25 +445,233 @@ psock_dgram_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
       ret = psock_fifo_discard(psock, pktlen - readlen, flags);
     }
 
-errout_with_infd:
+  return ret < 0 ? ret : readlen;
+}
 
-  /* Close the read-only file descriptor */
+/****************************************************************************
+ * Name: psock_dgram_open
+ *
+ * Description:
+ *   Make sure that the receiving FIFO of a local datagram socket is open.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   flags    Receive flags
+ *   bclose   Location to return true if the FIFO was opened, it must then
+ *            be closed with psock_dgram_close()
+ *
+ * Returned Value:
+ *   OK on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
 
-  if (bclose)
+static int psock_dgram_open(FAR struct socket *psock, int flags,
+                            FAR bool *bclose)
+{
+  FAR struct local_conn_s *conn = psock->s_conn;
+  int ret;
+
+  *bclose = false;
+
+  /* Verify that this is a bound, un-connected peer socket */
+
+  if (conn->lc_state != LOCAL_STATE_BOUND &&
+      conn->lc_state != LOCAL_STATE_CONNECTED)
     {
-      /* Now we can close the read-only file descriptor */
+      /* Either not bound to address or it is connected */
 
-      file_close(&conn->lc_infile);
-      conn->lc_infile.f_inode = NULL;
+      nerr("ERROR: Connected or not bound\n");
+      return -EISCONN;
+    }
 
-errout_with_halfduplex:
+  if (conn->lc_infile.f_inode != NULL)
+    {
+      return OK;
+    }
+
+  /* Make sure that half duplex FIFO has been created */
+
+  ret = local_create_halfduplex(conn, conn->lc_path, conn->lc_rcvsize);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to create FIFO for %s: %d\n",
+           conn->lc_path, ret);
+      return ret;
+    }
 
-      /* Release our reference to the half duplex FIFO */
+  /* Open the receiving side of the transfer */
 
+  ret = local_open_receiver(conn, (flags & MSG_DONTWAIT) != 0 ||
+                            _SS_ISNONBLOCK(conn->lc_conn.s_flags));
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to open FIFO for %s: %d\n",
+           conn->lc_path, ret);
       local_release_halfduplex(conn);
+      return ret;
     }
 
-  return ret < 0 ? ret : readlen;
+  *bclose = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: psock_dgram_close
+ *
+ * Description:
+ *   Close the receiving FIFO opened by psock_dgram_open().
+ *
+ ****************************************************************************/
+
+static void psock_dgram_close(FAR struct socket *psock)
+{
+  FAR struct local_conn_s *conn = psock->s_conn;
+
+  /* Now we can close the read-only file descriptor */
+
+  file_close(&conn->lc_infile);
+  conn->lc_infile.f_inode = NULL;
+
+  /* Release our reference to the half duplex FIFO */
+
+  local_release_halfduplex(conn);
+}
+
+/****************************************************************************
+ * Name: psock_dgram_recvfrom
+ *
+ * Description:
+ *   psock_dgram_recvfrom() receives messages from a local datagram socket.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   buf      Buffer to receive data
+ *   len      Length of buffer
+ *   flags    Receive flags
+ *   from     Address of source (may be NULL)
+ *   fromlen  The length of the address structure
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  Otherwise, on
+ *   errors, -1 is returned, and errno is set appropriately (see receive
+ *   from for the complete list).
+ *
+ ****************************************************************************/
+
+static inline ssize_t
+psock_dgram_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
+                     int flags, FAR struct sockaddr *from,
+                     FAR socklen_t *fromlen)
+{
+  bool bclose;
+  ssize_t ret;
+
+  ret = psock_dgram_open(psock, flags, &bclose);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = psock_dgram_recvpkt(psock, buf, len, flags, from, fromlen);
+
+  if (bclose)
+    {
+      psock_dgram_close(psock);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: psock_dgram_recvmmsg
+ *
+ * Description:
+ *   psock_dgram_recvmmsg() receives the first packet from a local datagram
+ *   socket as psock_dgram_recvfrom() does, then the packets already in the
+ *   FIFO, that is opened once.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   Buffers to receive the packets
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of packets received.  Otherwise, on
+ *   errors, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+static int psock_dgram_recvmmsg(FAR struct socket *psock,
+                                FAR struct mmsghdr *msgvec,
+                                unsigned int vlen, int flags)
+{
+  FAR struct local_conn_s *conn = psock->s_conn;
+  FAR struct msghdr *msg;
+  unsigned int count;
+  ssize_t ret;
+  bool bclose;
+  int avail;
+
+  ret = psock_dgram_open(psock, flags, &bclose);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (count = 0; count < vlen; count++)
+    {
+      msg = &msgvec[count].msg_hdr;
+      if (msg->msg_iovlen != 1)
+        {
+          ret = -ENOTSUP;
+          break;
+        }
+
+      /* Only the first packet may be waited for, or peeked */
+
+      if (count > 0)
+        {
+          if ((flags & MSG_PEEK) != 0)
+            {
+              break;
+            }
+
+          avail = 0;
+          ret = file_ioctl(&conn->lc_infile, FIONREAD, &avail);
+          if (ret < 0 || avail == 0)
+            {
+              break;
+            }
+        }
+
+      ret = psock_dgram_recvpkt(psock, msg->msg_iov->iov_base,
+                                msg->msg_iov->iov_len, flags,
+                                msg->msg_name, &msg->msg_namelen);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[count].msg_len = ret;
+
+#ifdef CONFIG_NET_LOCAL_SCM
+      /* Receive the control message */
+
+      if (msg->msg_control &&
+          msg->msg_controllen > sizeof(struct cmsghdr))
+        {
+          local_recvctl(conn, msg, flags);
+        }
+#endif /* CONFIG_NET_LOCAL_SCM */
+    }
+
+  if (bclose)
+    {
+      psock_dgram_close(psock);
+    }
+
+  return count > 0 ? count : ret;
 }
 #endif /* CONFIG_NET_LOCAL_DGRAM */
 
@@ -585,3 +754,46 @@ ssize_t local_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 
   return len;
 }
+
+/****************************************************************************
+ * Name: local_recvmmsg
+ *
+ * Description:
+ *   Implements the recvmmsg() batch operation for local sockets.  The
+ *   datagrams available are received with the receiving FIFO opened once,
+ *   otherwise the first message is received as local_recvmsg() does.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   Buffers to receive the messages
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  Otherwise, on
+ *   errors, a negated errno value is returned (see recvmsg() for the list
+ *   of appropriate error values).
+ *
+ ****************************************************************************/
+
+int local_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags)
+{
+  ssize_t ret;
+
+#ifdef CONFIG_NET_LOCAL_DGRAM
+  if (psock->s_type == SOCK_DGRAM)
+    {
+      return psock_dgram_recvmmsg(psock, msgvec, vlen, flags);
+    }
+#endif
+
+  ret = local_recvmsg(psock, &msgvec[0].msg_hdr, flags);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  msgvec[0].msg_len = ret;
+  return 1;
+}
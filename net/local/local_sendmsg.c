@@ -28,6 +28,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <string.h>
 #include <unistd.h>
 #include <errno.h>
 #include <assert.h>
@@ -133,25 +134,27 @@ fail:
  * Name: local_send
  *
  * Description:
- *   Send a local packet as a stream.
+ *   Send local packets as a stream, with the send lock taken once.
  *
  * Input Parameters:
  *   psock    An instance of the internal socket structure.
- *   buf      Data to send
- *   len      Length of data to send
+ *   msgvec   The messages to send
+ *   vlen     The number of messages in msgvec
  *   flags    Send flags (ignored for now)
  *
  * Returned Value:
- *   On success, returns the number of characters sent.  On  error,
- *   -1 is returned, and errno is set appropriately (see send() for the
- *   list of errno numbers).
+ *   On success, returns the number of messages sent, the msg_len field of
+ *   each of them is the number of characters sent.  On  error, a negated
+ *   errno value is returned (see send() for the list of errno numbers).
  *
  ****************************************************************************/
 
-static ssize_t local_send(FAR struct socket *psock,
-                          FAR const struct iovec *buf,
-                          size_t len, int flags)
+static int local_send(FAR struct socket *psock,
+                      FAR struct mmsghdr *msgvec,
+                      unsigned int vlen, int flags)
 {
+  FAR struct msghdr *msg;
+  unsigned int count = 0;
   ssize_t ret;
 
   switch (psock->s_type)
@@ -165,10 +168,6 @@ static ssize_t local_send(FAR struct socket *psock,
         {
           FAR struct local_conn_s *conn = psock->s_conn;
 
-          /* Local TCP packet send */
-
-          DEBUGASSERT(buf);
-
           /* Verify that this is a connected peer socket and that it has
            * opened the outgoing FIFO for write-only access.
            */
@@ -186,7 +185,7 @@ static ssize_t local_send(FAR struct socket *psock,
               return -EPIPE;
             }
 
-          /* Send the packet */
+          /* Send the packets */
 
           ret = nxmutex_lock(&conn->lc_sendlock);
           if (ret < 0)
@@ -196,7 +195,23 @@ static ssize_t local_send(FAR struct socket *psock,
               return ret;
             }
 
-          ret = local_send_packet(&conn->lc_outfile, buf, len);
+          for (; count < vlen; count++)
+            {
+              /* Local TCP packet send */
+
+              msg = &msgvec[count].msg_hdr;
+              DEBUGASSERT(msg->msg_iov);
+
+              ret = local_send_packet(&conn->lc_outfile, msg->msg_iov,
+                                      msg->msg_iovlen);
+              if (ret < 0)
+                {
+                  break;
+                }
+
+              msgvec[count].msg_len = ret;
+            }
+
           nxmutex_unlock(&conn->lc_sendlock);
         }
         break;
@@ -211,7 +226,7 @@ static ssize_t local_send(FAR struct socket *psock,
         break;
     }
 
-  return ret;
+  return count > 0 ? count : ret;
 }
 
 /****************************************************************************
@@ -219,36 +234,38 @@ static ssize_t local_send(FAR struct socket *psock,
  *
  * Description:
  *   This function implements the Unix domain-specific logic of the
- *   standard sendto() socket operation.
+ *   standard sendto() socket operation.  The messages, all to the address
+ *   of the first one, are sent with the FIFO of the recipient opened once.
  *
  * Input Parameters:
  *   psock    A pointer to a NuttX-specific, internal socket structure
- *   buf      Data to send
- *   len      Length of data to send
+ *   msgvec   The messages to send
+ *   vlen     The number of messages in msgvec
  *   flags    Send flags
- *   to       Address of recipient
- *   tolen    The length of the address structure
  *
  *   NOTE: All input parameters were verified by sendto() before this
  *   function was called.
  *
  * Returned Value:
- *   On success, returns the number of characters sent.  On  error,
- *   a negated errno value is returned.  See the description in
- *   net/socket/sendto.c for the list of appropriate return value.
+ *   On success, returns the number of messages sent, the msg_len field of
+ *   each of them is the number of characters sent.  On  error, a negated
+ *   errno value is returned.  See the description in net/socket/sendto.c
+ *   for the list of appropriate return value.
  *
  ****************************************************************************/
 
-static ssize_t local_sendto(FAR struct socket *psock,
-                            FAR const struct iovec *buf,
-                            size_t len, int flags,
-                            FAR const struct sockaddr *to,
-                            socklen_t tolen)
+static int local_sendto(FAR struct socket *psock,
+                        FAR struct mmsghdr *msgvec,
+                        unsigned int vlen, int flags)
 {
 #ifdef CONFIG_NET_LOCAL_DGRAM
   FAR struct local_conn_s *conn = psock->s_conn;
-  FAR struct local_conn_s *server;
+  FAR const struct sockaddr *to = msgvec[0].msg_hdr.msg_name;
   FAR const struct sockaddr_un *unaddr = (FAR const struct sockaddr_un *)to;
+  socklen_t tolen = msgvec[0].msg_hdr.msg_namelen;
+  FAR struct local_conn_s *server;
+  FAR struct msghdr *msg;
+  unsigned int count = 0;
   ssize_t ret;
 
   /* Verify that a valid address has been provided */
@@ -345,26 +362,32 @@ static ssize_t local_sendto(FAR struct socket *psock,
       goto errout_with_halfduplex;
     }
 
-  /* Send the preamble */
-
-  ret = local_send_preamble(conn, &conn->lc_outfile, buf, len,
-                            server->lc_rcvsize);
-  if (ret < 0)
+  for (; count < vlen; count++)
     {
-      nerr("ERROR: Failed to send the preamble: %zd\n", ret);
-      goto errout_with_sender;
-    }
+      msg = &msgvec[count].msg_hdr;
 
-  /* Send the packet */
+      /* Send the preamble */
 
-  ret = local_send_packet(&conn->lc_outfile, buf, len);
-  if (ret < 0)
-    {
-      nerr("ERROR: Failed to send the packet: %zd\n", ret);
-      goto errout_with_sender;
-    }
+      ret = local_send_preamble(conn, &conn->lc_outfile, msg->msg_iov,
+                                msg->msg_iovlen, server->lc_rcvsize);
+      if (ret < 0)
+        {
+          nerr("ERROR: Failed to send the preamble: %zd\n", ret);
+          break;
+        }
+
+      /* Send the packet */
 
-errout_with_sender:
+      ret = local_send_packet(&conn->lc_outfile, msg->msg_iov,
+                              msg->msg_iovlen);
+      if (ret < 0)
+        {
+          nerr("ERROR: Failed to send the packet: %zd\n", ret);
+          break;
+        }
+
+      msgvec[count].msg_len = ret;
+    }
 
   /* Now we can close the write-only socket descriptor */
 
@@ -382,7 +405,7 @@ errout_with_lock:
   /* Release localsocket sendlock */
 
   nxmutex_unlock(&conn->lc_sendlock);
-  return ret;
+  return count > 0 ? count : ret;
 #else
   return -EISCONN;
 #endif /* CONFIG_NET_LOCAL_DGRAM */
@@ -413,10 +436,8 @@ errout_with_lock:
 ssize_t local_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                       int flags)
 {
-  FAR const struct sockaddr *to = msg->msg_name;
-  FAR const struct iovec *buf = msg->msg_iov;
-  socklen_t tolen = msg->msg_namelen;
-  size_t len = msg->msg_iovlen;
+  struct mmsghdr mmsg;
+  ssize_t ret;
 
 #ifdef CONFIG_NET_LOCAL_SCM
   FAR struct local_conn_s *conn = psock->s_conn;
@@ -431,20 +452,87 @@ ssize_t local_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
           return count;
         }
     }
+#endif
 
-  len = to ? local_sendto(psock, buf, len, flags, to, tolen) :
-             local_send(psock, buf, len, flags);
+  mmsg.msg_hdr = *msg;
+  ret = msg->msg_name ? local_sendto(psock, &mmsg, 1, flags) :
+                        local_send(psock, &mmsg, 1, flags);
 
-  if (len < 0 && count > 0)
+#ifdef CONFIG_NET_LOCAL_SCM
+  if (ret < 0 && count > 0)
     {
       local_lock();
       local_freectl(conn, count);
       local_unlock();
     }
-#else
-  len = to ? local_sendto(psock, buf, len, flags, to, tolen) :
-             local_send(psock, buf, len, flags);
 #endif
 
-  return len;
+  return ret < 0 ? ret : mmsg.msg_len;
+}
+
+/****************************************************************************
+ * Name: local_sendmmsg
+ *
+ * Description:
+ *   Implements the sendmmsg() batch operation for the case of the local
+ *   Unix socket.  The leading messages to the same address and without
+ *   control data are sent with the FIFO opened and the send lock taken
+ *   once, otherwise the first message is sent as local_sendmsg() does.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   The messages to send
+ *   vlen     The number of messages in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  On  error, a negated
+ *   errno value is returned (see sendmsg() for the list of appropriate
+ *   error values.
+ *
+ ****************************************************************************/
+
+int local_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags)
+{
+  FAR const struct msghdr *first = &msgvec[0].msg_hdr;
+  FAR const struct msghdr *msg;
+  unsigned int n;
+  ssize_t ret;
+
+  for (n = 0; n < vlen; n++)
+    {
+      msg = &msgvec[n].msg_hdr;
+
+#ifdef CONFIG_NET_LOCAL_SCM
+      if (msg->msg_control &&
+          msg->msg_controllen > sizeof(struct cmsghdr))
+        {
+          break;
+        }
+#endif
+
+      if ((msg->msg_name == NULL) != (first->msg_name == NULL) ||
+          (msg->msg_name != NULL &&
+           (msg->msg_namelen != first->msg_namelen ||
+            memcmp(msg->msg_name, first->msg_name, msg->msg_namelen))))
+        {
+          break;
+        }
+    }
+
+  if (n == 0)
+    {
+      ret = local_sendmsg(psock, &msgvec[0].msg_hdr, flags);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      msgvec[0].msg_len = ret;
+      return 1;
+    }
+
+  return first->msg_name ? local_sendto(psock, msgvec, n, flags) :
+                           local_send(psock, msgvec, n, flags);
 }
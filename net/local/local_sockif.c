@@ -113,6 +113,11 @@ const struct sock_intf_s g_local_sockif =
   , local_getsockopt /* si_getsockopt */
   , local_setsockopt /* si_setsockopt */
 #endif
+#ifdef CONFIG_NET_SENDFILE
+  , NULL             /* si_sendfile */
+#endif
+  , local_recvmmsg   /* si_recvmmsg */
+  , local_sendmmsg   /* si_sendmmsg */
 };
 
 /****************************************************************************
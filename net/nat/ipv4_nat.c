@@ -748,7 +748,13 @@ void ipv4_nat_inbound(FAR struct net_driver_s *dev,
   if (IFF_IS_NAT(dev->d_flags) &&
       net_ipv4addr_hdrcmp(ipv4->destipaddr, &dev->d_ipaddr))
     {
-      ipv4_nat_inbound_internal(ipv4, NAT_MANIP_DST);
+      FAR ipv4_nat_entry_t *entry =
+          ipv4_nat_inbound_internal(ipv4, NAT_MANIP_DST);
+      if (entry)
+        {
+          entry->reply.packets++;
+          entry->reply.bytes += (ipv4->len[0] << 8) + ipv4->len[1];
+        }
     }
 
   nat_unlock();
@@ -797,6 +803,16 @@ int ipv4_nat_outbound(FAR struct net_driver_s *dev,
 
           return -ENOENT;
         }
+
+      /* Only the packets sent by the local hosts are counted, not the
+       * ICMP errors about the packets they received.
+       */
+
+      if (manip_type == NAT_MANIP_SRC)
+        {
+          entry->orig.packets++;
+          entry->orig.bytes += (ipv4->len[0] << 8) + ipv4->len[1];
+        }
     }
 
   nat_unlock();
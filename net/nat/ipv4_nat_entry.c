@@ -34,8 +34,10 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/nuttx.h>
 
+#include "ipfilter/ipfilter.h"
 #include "nat/nat.h"
 #include "netlink/netlink.h"
+#include "utils/utils.h"
 
 #ifdef CONFIG_NET_NAT44
 
@@ -46,6 +48,21 @@
 static DECLARE_HASHTABLE(g_nat44_inbound, CONFIG_NET_NAT_HASH_BITS);
 static DECLARE_HASHTABLE(g_nat44_outbound, CONFIG_NET_NAT_HASH_BITS);
 
+/* The expiration of the entries, so that they are reclaimed as soon as
+ * they expire without scanning the whole table.
+ */
+
+static struct net_wheel_s g_nat44_wheel;
+
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+/* The generation of the entries cached in the flows of the packet filter,
+ * bumped when an entry is freed.  The wheel frees the expired entries in
+ * batches, so the flows look their entry up again about once a second.
+ */
+
+static uint32_t g_nat44_gen = 1;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -95,7 +112,7 @@ static inline uint32_t ipv4_nat_outbound_key(in_addr_t local_ip,
 
 static void ipv4_nat_entry_refresh(FAR ipv4_nat_entry_t *entry)
 {
-  entry->expire_time = nat_expire_time(entry->protocol);
+  entry->timer.expire = nat_expire_time(entry->protocol);
 }
 
 /****************************************************************************
@@ -124,7 +141,7 @@ ipv4_nat_entry_create(uint8_t protocol,
                       in_addr_t local_ip, uint16_t local_port,
                       in_addr_t peer_ip, uint16_t peer_port)
 {
-  FAR ipv4_nat_entry_t *entry = kmm_malloc(sizeof(ipv4_nat_entry_t));
+  FAR ipv4_nat_entry_t *entry = kmm_zalloc(sizeof(ipv4_nat_entry_t));
   if (entry == NULL)
     {
       nwarn("WARNING: Failed to allocate IPv4 NAT entry\n");
@@ -141,7 +158,7 @@ ipv4_nat_entry_create(uint8_t protocol,
   entry->peer_port     = peer_port;
 #endif
 
-  ipv4_nat_entry_refresh(entry);
+  net_wheel_add(&g_nat44_wheel, &entry->timer, nat_expire_time(protocol));
 
   hashtable_add(g_nat44_inbound, &entry->hash_inbound,
                 ipv4_nat_inbound_key(external_ip, external_port, protocol));
@@ -173,6 +190,7 @@ static void ipv4_nat_entry_delete(FAR ipv4_nat_entry_t *entry)
         entry->protocol, entry->local_ip, entry->local_port,
         entry->external_port);
 
+  net_wheel_remove(&g_nat44_wheel, &entry->timer);
   hashtable_delete(g_nat44_inbound, &entry->hash_inbound,
                    ipv4_nat_inbound_key(entry->external_ip,
                                         entry->external_port,
@@ -186,51 +204,46 @@ static void ipv4_nat_entry_delete(FAR ipv4_nat_entry_t *entry)
   netlink_conntrack_notify(IPCTNL_MSG_CT_DELETE, PF_INET, entry);
 #endif
 
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  if (++g_nat44_gen == 0)
+    {
+      g_nat44_gen = 1;
+    }
+#endif
+
   kmm_free(entry);
 }
 
 /****************************************************************************
- * Name: ipv4_nat_reclaim_entry
+ * Name: ipv4_nat_expire_cb
  *
  * Description:
- *   Try reclaim all expired NAT entries.
- *   Only works after every CONFIG_NET_NAT_ENTRY_RECLAIM_SEC (low frequency).
+ *   Reclaim an expired NAT entry, called by the timer wheel.
  *
- *   Although expired entries will be automatically reclaimed when matching
- *   inbound/outbound entries, there might be some situations that entries
- *   will be kept in memory, e.g. big hashtable with only a few connections.
+ ****************************************************************************/
+
+static void ipv4_nat_expire_cb(FAR struct net_wheelnode_s *node,
+                               FAR void *arg)
+{
+  ipv4_nat_entry_delete(container_of(node, ipv4_nat_entry_t, timer));
+}
+
+/****************************************************************************
+ * Name: ipv4_nat_reclaim_entry
+ *
+ * Description:
+ *   Reclaim the NAT entries expired since the last call.  Only the entries
+ *   due in the elapsed seconds are visited.
  *
  * Assumptions:
  *   NAT is initialized.
  *
  ****************************************************************************/
 
-#if CONFIG_NET_NAT_ENTRY_RECLAIM_SEC > 0
-static void ipv4_nat_reclaim_entry_cb(FAR ipv4_nat_entry_t *entry,
-                                      FAR void *arg)
-{
-  int32_t current_time = *(FAR int32_t *)arg;
-
-  if (entry->expire_time - current_time <= 0)
-    {
-      ipv4_nat_entry_delete(entry);
-    }
-}
-
 static void ipv4_nat_reclaim_entry(int32_t current_time)
 {
-  static int32_t next_reclaim_time = CONFIG_NET_NAT_ENTRY_RECLAIM_SEC;
-
-  if (next_reclaim_time - current_time <= 0)
-    {
-      ninfo("INFO: Reclaiming all expired NAT44 entries.\n");
-      ipv4_nat_entry_foreach(ipv4_nat_reclaim_entry_cb, &current_time);
-      next_reclaim_time = current_time + CONFIG_NET_NAT_ENTRY_RECLAIM_SEC;
-    }
+  net_wheel_run(&g_nat44_wheel, current_time, ipv4_nat_expire_cb, NULL);
 }
-#else
-#  define ipv4_nat_reclaim_entry(t)
-#endif
 
 /****************************************************************************
  * Name: ipv4_nat_entry_clear_cb
@@ -328,8 +341,12 @@ ipv4_nat_inbound_entry_find(uint8_t protocol, in_addr_t external_ip,
                             uint16_t external_port, in_addr_t peer_ip,
                             uint16_t peer_port, bool refresh)
 {
+  FAR ipv4_nat_entry_t *entry;
   FAR hash_node_t *p;
   FAR hash_node_t *tmp;
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  FAR struct ipfilter_ct_s *ct = NULL;
+#endif
   bool skip_ip = net_ipv4addr_cmp(external_ip, INADDR_ANY);
 #ifdef CONFIG_NET_NAT44_SYMMETRIC
   bool skip_peer = net_ipv4addr_cmp(peer_ip, INADDR_ANY);
@@ -338,19 +355,28 @@ ipv4_nat_inbound_entry_find(uint8_t protocol, in_addr_t external_ip,
 
   ipv4_nat_reclaim_entry(current_time);
 
-  hashtable_for_every_possible_safe(g_nat44_inbound, p, tmp,
-                  ipv4_nat_inbound_key(external_ip, external_port, protocol))
-    {
-      FAR ipv4_nat_entry_t *entry =
-        container_of(p, ipv4_nat_entry_t, hash_inbound);
-
-      /* Remove expired entries. */
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  /* A packet looks its entry up in the flow table first, where it is
+   * cached once found.
+   */
 
-      if (entry->expire_time - current_time <= 0)
+  if (refresh)
+    {
+      ct = ipfilter_ct_lookup(PF_INET, &peer_ip, &external_ip, protocol,
+                              peer_port, external_port);
+      entry = ipfilter_ct_nat(ct, IPFILTER_CT_NAT_INBOUND, g_nat44_gen);
+      if (entry != NULL)
         {
-          ipv4_nat_entry_delete(entry);
-          continue;
+          ipv4_nat_entry_refresh(entry);
+          return entry;
         }
+    }
+#endif
+
+  hashtable_for_every_possible_safe(g_nat44_inbound, p, tmp,
+                  ipv4_nat_inbound_key(external_ip, external_port, protocol))
+    {
+      entry = container_of(p, ipv4_nat_entry_t, hash_inbound);
 
       if (entry->protocol == protocol &&
           (skip_ip || net_ipv4addr_cmp(entry->external_ip, external_ip)) &&
@@ -366,6 +392,14 @@ ipv4_nat_inbound_entry_find(uint8_t protocol, in_addr_t external_ip,
               ipv4_nat_entry_refresh(entry);
             }
 
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+          if (ct != NULL)
+            {
+              ipfilter_ct_setnat(ct, IPFILTER_CT_NAT_INBOUND, entry,
+                                 g_nat44_gen);
+            }
+#endif
+
           return entry;
         }
     }
@@ -407,26 +441,36 @@ ipv4_nat_outbound_entry_find(FAR struct net_driver_s *dev, uint8_t protocol,
                              in_addr_t peer_ip, uint16_t peer_port,
                              bool try_create)
 {
+  FAR ipv4_nat_entry_t *entry;
   FAR hash_node_t *p;
   FAR hash_node_t *tmp;
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  FAR struct ipfilter_ct_s *ct;
+#endif
   uint16_t external_port;
   int32_t current_time = TICK2SEC(clock_systime_ticks());
 
   ipv4_nat_reclaim_entry(current_time);
 
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  /* A packet looks its entry up in the flow table first, where it is
+   * cached once found or created.
+   */
+
+  ct = ipfilter_ct_lookup(PF_INET, &local_ip, &peer_ip, protocol,
+                          local_port, peer_port);
+  entry = ipfilter_ct_nat(ct, IPFILTER_CT_NAT_OUTBOUND, g_nat44_gen);
+  if (entry != NULL && net_ipv4addr_cmp(entry->external_ip, dev->d_ipaddr))
+    {
+      ipv4_nat_entry_refresh(entry);
+      return entry;
+    }
+#endif
+
   hashtable_for_every_possible_safe(g_nat44_outbound, p, tmp,
                       ipv4_nat_outbound_key(local_ip, local_port, protocol))
     {
-      FAR ipv4_nat_entry_t *entry =
-        container_of(p, ipv4_nat_entry_t, hash_outbound);
-
-      /* Remove expired entries. */
-
-      if (entry->expire_time - current_time <= 0)
-        {
-          ipv4_nat_entry_delete(entry);
-          continue;
-        }
+      entry = container_of(p, ipv4_nat_entry_t, hash_outbound);
 
       if (entry->protocol == protocol &&
           net_ipv4addr_cmp(entry->external_ip, dev->d_ipaddr) &&
@@ -439,6 +483,14 @@ ipv4_nat_outbound_entry_find(FAR struct net_driver_s *dev, uint8_t protocol,
           )
         {
           ipv4_nat_entry_refresh(entry);
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+          if (ct != NULL)
+            {
+              ipfilter_ct_setnat(ct, IPFILTER_CT_NAT_OUTBOUND, entry,
+                                 g_nat44_gen);
+            }
+#endif
+
           return entry;
         }
     }
@@ -462,8 +514,16 @@ ipv4_nat_outbound_entry_find(FAR struct net_driver_s *dev, uint8_t protocol,
       return NULL;
     }
 
-  return ipv4_nat_entry_create(protocol, dev->d_ipaddr, external_port,
-                               local_ip, local_port, peer_ip, peer_port);
+  entry = ipv4_nat_entry_create(protocol, dev->d_ipaddr, external_port,
+                                local_ip, local_port, peer_ip, peer_port);
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  if (entry != NULL && ct != NULL)
+    {
+      ipfilter_ct_setnat(ct, IPFILTER_CT_NAT_OUTBOUND, entry, g_nat44_gen);
+    }
+#endif
+
+  return entry;
 }
 
 #endif /* CONFIG_NET_NAT44 */
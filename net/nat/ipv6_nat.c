@@ -638,7 +638,14 @@ void ipv6_nat_inbound(FAR struct net_driver_s *dev,
   if (IFF_IS_NAT(dev->d_flags) &&
       NETDEV_IS_MY_V6ADDR(dev, ipv6->destipaddr))
     {
-      ipv6_nat_inbound_internal(ipv6, NAT_MANIP_DST);
+      FAR ipv6_nat_entry_t *entry =
+          ipv6_nat_inbound_internal(ipv6, NAT_MANIP_DST);
+      if (entry)
+        {
+          entry->reply.packets++;
+          entry->reply.bytes += IPv6_HDRLEN +
+                                ((ipv6->len[0] << 8) + ipv6->len[1]);
+        }
     }
 
   nat_unlock();
@@ -685,6 +692,17 @@ int ipv6_nat_outbound(FAR struct net_driver_s *dev,
 
           return -ENOENT;
         }
+
+      /* Only the packets sent by the local hosts are counted, not the
+       * ICMPv6 errors about the packets they received.
+       */
+
+      if (manip_type == NAT_MANIP_SRC)
+        {
+          entry->orig.packets++;
+          entry->orig.bytes += IPv6_HDRLEN +
+                               ((ipv6->len[0] << 8) + ipv6->len[1]);
+        }
     }
 
   nat_unlock();
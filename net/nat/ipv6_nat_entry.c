@@ -35,8 +35,10 @@
 #include <nuttx/nuttx.h>
 
 #include "inet/inet.h"
+#include "ipfilter/ipfilter.h"
 #include "nat/nat.h"
 #include "netlink/netlink.h"
+#include "utils/utils.h"
 
 #ifdef CONFIG_NET_NAT66
 
@@ -47,6 +49,21 @@
 static DECLARE_HASHTABLE(g_nat66_inbound, CONFIG_NET_NAT_HASH_BITS);
 static DECLARE_HASHTABLE(g_nat66_outbound, CONFIG_NET_NAT_HASH_BITS);
 
+/* The expiration of the entries, so that they are reclaimed as soon as
+ * they expire without scanning the whole table.
+ */
+
+static struct net_wheel_s g_nat66_wheel;
+
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+/* The generation of the entries cached in the flows of the packet filter,
+ * bumped when an entry is freed.  The wheel frees the expired entries in
+ * batches, so the flows look their entry up again about once a second.
+ */
+
+static uint32_t g_nat66_gen = 1;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -83,7 +100,7 @@ static inline uint32_t ipv6_nat_hash_key(const net_ipv6addr_t ip,
 
 static void ipv6_nat_entry_refresh(FAR ipv6_nat_entry_t *entry)
 {
-  entry->expire_time = nat_expire_time(entry->protocol);
+  entry->timer.expire = nat_expire_time(entry->protocol);
 }
 
 /****************************************************************************
@@ -112,7 +129,7 @@ ipv6_nat_entry_create(uint8_t protocol, const net_ipv6addr_t external_ip,
                       uint16_t local_port, const net_ipv6addr_t peer_ip,
                       uint16_t peer_port)
 {
-  FAR ipv6_nat_entry_t *entry = kmm_malloc(sizeof(ipv6_nat_entry_t));
+  FAR ipv6_nat_entry_t *entry = kmm_zalloc(sizeof(ipv6_nat_entry_t));
   if (entry == NULL)
     {
       nwarn("WARNING: Failed to allocate IPv6 NAT entry\n");
@@ -131,7 +148,7 @@ ipv6_nat_entry_create(uint8_t protocol, const net_ipv6addr_t external_ip,
   net_ipv6addr_copy(entry->peer_ip, peer_ip);
 #endif
 
-  ipv6_nat_entry_refresh(entry);
+  net_wheel_add(&g_nat66_wheel, &entry->timer, nat_expire_time(protocol));
 
   hashtable_add(g_nat66_inbound, &entry->hash_inbound,
                 ipv6_nat_hash_key(external_ip, external_port, protocol));
@@ -166,6 +183,7 @@ static void ipv6_nat_entry_delete(FAR ipv6_nat_entry_t *entry)
         entry->local_ip[5], entry->local_ip[6], entry->local_ip[7],
         entry->local_port, entry->external_port);
 
+  net_wheel_remove(&g_nat66_wheel, &entry->timer);
   hashtable_delete(g_nat66_inbound, &entry->hash_inbound,
                    ipv6_nat_hash_key(entry->external_ip,
                                      entry->external_port,
@@ -179,51 +197,46 @@ static void ipv6_nat_entry_delete(FAR ipv6_nat_entry_t *entry)
   netlink_conntrack_notify(IPCTNL_MSG_CT_DELETE, PF_INET6, entry);
 #endif
 
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  if (++g_nat66_gen == 0)
+    {
+      g_nat66_gen = 1;
+    }
+#endif
+
   kmm_free(entry);
 }
 
 /****************************************************************************
- * Name: ipv6_nat_reclaim_entry
+ * Name: ipv6_nat_expire_cb
  *
  * Description:
- *   Try reclaim all expired NAT entries.
- *   Only works after every CONFIG_NET_NAT_ENTRY_RECLAIM_SEC (low frequency).
+ *   Reclaim an expired NAT entry, called by the timer wheel.
  *
- *   Although expired entries will be automatically reclaimed when matching
- *   inbound/outbound entries, there might be some situations that entries
- *   will be kept in memory, e.g. big hashtable with only a few connections.
+ ****************************************************************************/
+
+static void ipv6_nat_expire_cb(FAR struct net_wheelnode_s *node,
+                               FAR void *arg)
+{
+  ipv6_nat_entry_delete(container_of(node, ipv6_nat_entry_t, timer));
+}
+
+/****************************************************************************
+ * Name: ipv6_nat_reclaim_entry
+ *
+ * Description:
+ *   Reclaim the NAT entries expired since the last call.  Only the entries
+ *   due in the elapsed seconds are visited.
  *
  * Assumptions:
  *   NAT is initialized.
  *
  ****************************************************************************/
 
-#if CONFIG_NET_NAT_ENTRY_RECLAIM_SEC > 0
-static void ipv6_nat_reclaim_entry_cb(FAR ipv6_nat_entry_t *entry,
-                                      FAR void *arg)
-{
-  int32_t current_time = *(FAR int32_t *)arg;
-
-  if (entry->expire_time - current_time <= 0)
-    {
-      ipv6_nat_entry_delete(entry);
-    }
-}
-
 static void ipv6_nat_reclaim_entry(int32_t current_time)
 {
-  static int32_t next_reclaim_time = CONFIG_NET_NAT_ENTRY_RECLAIM_SEC;
-
-  if (next_reclaim_time - current_time <= 0)
-    {
-      ninfo("INFO: Reclaiming all expired NAT66 entries.\n");
-      ipv6_nat_entry_foreach(ipv6_nat_reclaim_entry_cb, &current_time);
-      next_reclaim_time = current_time + CONFIG_NET_NAT_ENTRY_RECLAIM_SEC;
-    }
+  net_wheel_run(&g_nat66_wheel, current_time, ipv6_nat_expire_cb, NULL);
 }
-#else
-#  define ipv6_nat_reclaim_entry(t)
-#endif
 
 /****************************************************************************
  * Name: ipv6_nat_entry_clear_cb
@@ -323,8 +336,12 @@ ipv6_nat_inbound_entry_find(uint8_t protocol,
                             const net_ipv6addr_t peer_ip,
                             uint16_t peer_port, bool refresh)
 {
+  FAR ipv6_nat_entry_t *entry;
   FAR hash_node_t *p;
   FAR hash_node_t *tmp;
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  FAR struct ipfilter_ct_s *ct = NULL;
+#endif
   bool skip_ip = net_ipv6addr_cmp(external_ip, g_ipv6_unspecaddr);
 #ifdef CONFIG_NET_NAT66_SYMMETRIC
   bool skip_peer = net_ipv6addr_cmp(peer_ip, g_ipv6_unspecaddr);
@@ -333,19 +350,28 @@ ipv6_nat_inbound_entry_find(uint8_t protocol,
 
   ipv6_nat_reclaim_entry(current_time);
 
-  hashtable_for_every_possible_safe(g_nat66_inbound, p, tmp,
-                    ipv6_nat_hash_key(external_ip, external_port, protocol))
-    {
-      FAR ipv6_nat_entry_t *entry =
-        container_of(p, ipv6_nat_entry_t, hash_inbound);
-
-      /* Remove expired entries. */
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  /* A packet looks its entry up in the flow table first, where it is
+   * cached once found.
+   */
 
-      if (entry->expire_time - current_time <= 0)
+  if (refresh)
+    {
+      ct = ipfilter_ct_lookup(PF_INET6, peer_ip, external_ip, protocol,
+                              peer_port, external_port);
+      entry = ipfilter_ct_nat(ct, IPFILTER_CT_NAT_INBOUND, g_nat66_gen);
+      if (entry != NULL)
         {
-          ipv6_nat_entry_delete(entry);
-          continue;
+          ipv6_nat_entry_refresh(entry);
+          return entry;
         }
+    }
+#endif
+
+  hashtable_for_every_possible_safe(g_nat66_inbound, p, tmp,
+                    ipv6_nat_hash_key(external_ip, external_port, protocol))
+    {
+      entry = container_of(p, ipv6_nat_entry_t, hash_inbound);
 
       if (entry->protocol == protocol &&
           (skip_ip || net_ipv6addr_cmp(entry->external_ip, external_ip)) &&
@@ -361,6 +387,14 @@ ipv6_nat_inbound_entry_find(uint8_t protocol,
               ipv6_nat_entry_refresh(entry);
             }
 
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+          if (ct != NULL)
+            {
+              ipfilter_ct_setnat(ct, IPFILTER_CT_NAT_INBOUND, entry,
+                                 g_nat66_gen);
+            }
+#endif
+
           return entry;
         }
     }
@@ -406,27 +440,37 @@ ipv6_nat_outbound_entry_find(FAR struct net_driver_s *dev, uint8_t protocol,
                              const net_ipv6addr_t peer_ip,
                              uint16_t peer_port, bool try_create)
 {
+  FAR ipv6_nat_entry_t *entry;
   FAR hash_node_t *p;
   FAR hash_node_t *tmp;
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  FAR struct ipfilter_ct_s *ct;
+#endif
   FAR union ip_addr_u *external_ip;
   uint16_t external_port;
   int32_t current_time = TICK2SEC(clock_systime_ticks());
 
   ipv6_nat_reclaim_entry(current_time);
 
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  /* A packet looks its entry up in the flow table first, where it is
+   * cached once found or created.
+   */
+
+  ct = ipfilter_ct_lookup(PF_INET6, local_ip, peer_ip, protocol,
+                          local_port, peer_port);
+  entry = ipfilter_ct_nat(ct, IPFILTER_CT_NAT_OUTBOUND, g_nat66_gen);
+  if (entry != NULL && NETDEV_IS_MY_V6ADDR(dev, entry->external_ip))
+    {
+      ipv6_nat_entry_refresh(entry);
+      return entry;
+    }
+#endif
+
   hashtable_for_every_possible_safe(g_nat66_outbound, p, tmp,
                           ipv6_nat_hash_key(local_ip, local_port, protocol))
     {
-      FAR ipv6_nat_entry_t *entry =
-        container_of(p, ipv6_nat_entry_t, hash_outbound);
-
-      /* Remove expired entries. */
-
-      if (entry->expire_time - current_time <= 0)
-        {
-          ipv6_nat_entry_delete(entry);
-          continue;
-        }
+      entry = container_of(p, ipv6_nat_entry_t, hash_outbound);
 
       if (entry->protocol == protocol &&
           NETDEV_IS_MY_V6ADDR(dev, entry->external_ip) &&
@@ -439,6 +483,14 @@ ipv6_nat_outbound_entry_find(FAR struct net_driver_s *dev, uint8_t protocol,
           )
         {
           ipv6_nat_entry_refresh(entry);
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+          if (ct != NULL)
+            {
+              ipfilter_ct_setnat(ct, IPFILTER_CT_NAT_OUTBOUND, entry,
+                                 g_nat66_gen);
+            }
+#endif
+
           return entry;
         }
     }
@@ -466,8 +518,16 @@ ipv6_nat_outbound_entry_find(FAR struct net_driver_s *dev, uint8_t protocol,
       return NULL;
     }
 
-  return ipv6_nat_entry_create(protocol, external_ip->ipv6, external_port,
-                               local_ip, local_port, peer_ip, peer_port);
+  entry = ipv6_nat_entry_create(protocol, external_ip->ipv6, external_port,
+                                local_ip, local_port, peer_ip, peer_port);
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  if (entry != NULL && ct != NULL)
+    {
+      ipfilter_ct_setnat(ct, IPFILTER_CT_NAT_OUTBOUND, entry, g_nat66_gen);
+    }
+#endif
+
+  return entry;
 }
 
 #endif /* CONFIG_NET_NAT66 */
@@ -70,6 +70,14 @@
  * Public Types
  ****************************************************************************/
 
+/* The packets translated with a NAT entry in one direction */
+
+struct nat_counter_s
+{
+  uint64_t packets;          /* Number of packets */
+  uint64_t bytes;            /* Number of bytes of the IP packets */
+};
+
 struct ipv4_nat_entry_s
 {
   hash_node_t hash_inbound;
@@ -99,7 +107,9 @@ struct ipv4_nat_entry_s
 #endif
   uint8_t    protocol;       /* L4 protocol (TCP, UDP etc). */
 
-  int32_t    expire_time;    /* The expiration time of this entry. */
+  struct nat_counter_s orig;    /* Sent to the external network. */
+  struct nat_counter_s reply;   /* Received from the external network. */
+  struct net_wheelnode_s timer; /* The expiration time of this entry. */
 };
 
 struct ipv6_nat_entry_s
@@ -119,7 +129,9 @@ struct ipv6_nat_entry_s
 #endif
   uint8_t        protocol;      /* L4 protocol (TCP, UDP etc). */
 
-  int32_t        expire_time;   /* The expiration time of this entry. */
+  struct nat_counter_s orig;    /* Sent to the external network. */
+  struct nat_counter_s reply;   /* Received from the external network. */
+  struct net_wheelnode_s timer; /* The expiration time of this entry. */
 };
 
 typedef struct ipv4_nat_entry_s ipv4_nat_entry_t;
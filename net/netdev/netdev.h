@@ -559,6 +559,26 @@ void netdev_list_lock(void);
 
 void netdev_list_unlock(void);
 
+/****************************************************************************
+ * Name: netdev_list_rlock
+ *
+ * Description:
+ *   Lock the network device list for reading.
+ *
+ ****************************************************************************/
+
+void netdev_list_rlock(void);
+
+/****************************************************************************
+ * Name: netdev_list_runlock
+ *
+ * Description:
+ *   Unlock the network device list locked for reading.
+ *
+ ****************************************************************************/
+
+void netdev_list_runlock(void);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -92,6 +92,12 @@ void netdev_carrier_off(FAR struct net_driver_s *dev)
       ip_frag_stop(dev);
 #endif
 
+#ifdef CONFIG_NET_TCP_TSO
+      /* Drop the unsent segments of TCP large sends */
+
+      iob_free_queue(&dev->d_tsoout);
+#endif
+
       /* Notify clients that the network has been taken down */
 
       devif_dev_event(dev, NETDEV_DOWN);
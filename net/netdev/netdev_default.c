@@ -63,7 +63,7 @@ FAR struct net_driver_s *netdev_default(void)
 
   /* Examine each registered network device */
 
-  netdev_list_lock();
+  netdev_list_rlock();
   for (dev = g_netdevices; dev; dev = dev->flink)
     {
       /* Is the interface in the "running" state? */
@@ -84,6 +84,6 @@ FAR struct net_driver_s *netdev_default(void)
         }
     }
 
-  netdev_list_unlock();
+  netdev_list_runlock();
   return ret;
 }
@@ -80,7 +80,7 @@ netdev_prefixlen_findby_lipv4addr(in_addr_t lipaddr, FAR int8_t *prefixlen)
 
   /* Examine each registered network device */
 
-  netdev_list_lock();
+  netdev_list_rlock();
   for (dev = g_netdevices; dev; dev = dev->flink)
     {
       /* Is the interface in the "running" state? */
@@ -140,7 +140,7 @@ netdev_prefixlen_findby_lipv4addr(in_addr_t lipaddr, FAR int8_t *prefixlen)
         }
     }
 
-  netdev_list_unlock();
+  netdev_list_runlock();
   *prefixlen = bestpref;
   return bestdev;
 }
@@ -179,7 +179,7 @@ netdev_prefixlen_findby_lipv6addr(const net_ipv6addr_t lipaddr,
   int16_t len;
 #endif
 
-  netdev_list_lock();
+  netdev_list_rlock();
 
 #ifdef CONFIG_ROUTE_LONGEST_MATCH
   /* Find a hint from neighbor table in case same prefix length exists on
@@ -244,7 +244,7 @@ netdev_prefixlen_findby_lipv6addr(const net_ipv6addr_t lipaddr,
         }
     }
 
-  netdev_list_unlock();
+  netdev_list_runlock();
   *prefixlen = bestpref;
   return bestdev;
 }
@@ -72,7 +72,7 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
 
 #endif
 
-  netdev_list_lock();
+  netdev_list_rlock();
 
 #ifdef CONFIG_NETDEV_IFINDEX
   /* Check if this index has been assigned */
@@ -81,7 +81,7 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
     {
       /* This index has not been assigned */
 
-      netdev_list_unlock();
+      netdev_list_runlock();
       return NULL;
     }
 #endif
@@ -104,12 +104,12 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
       if (++i == ifindex)
 #endif
         {
-          netdev_list_unlock();
+          netdev_list_runlock();
           return dev;
         }
     }
 
-  netdev_list_unlock();
+  netdev_list_runlock();
   return NULL;
 }
 
@@ -141,7 +141,7 @@ int netdev_nextindex(int ifindex)
 
   if (ifindex >= 0 && ifindex < MAX_IFINDEX)
     {
-      netdev_list_lock();
+      netdev_list_rlock();
       for (; ifindex < MAX_IFINDEX; ifindex++)
         {
           if ((g_devset & (1UL << ifindex)) != 0)
@@ -150,12 +150,12 @@ int netdev_nextindex(int ifindex)
                * mean no-index in the POSIX standards.
                */
 
-              netdev_list_unlock();
+              netdev_list_runlock();
               return ifindex + 1;
             }
         }
 
-      netdev_list_unlock();
+      netdev_list_runlock();
     }
 
   return -ENODEV;
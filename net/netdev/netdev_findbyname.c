@@ -59,17 +59,17 @@ FAR struct net_driver_s *netdev_findbyname(FAR const char *ifname)
 
   if (ifname)
     {
-      netdev_list_lock();
+      netdev_list_rlock();
       for (dev = g_netdevices; dev; dev = dev->flink)
         {
           if (strcmp(ifname, dev->d_ifname) == 0)
             {
-              netdev_list_unlock();
+              netdev_list_runlock();
               return dev;
             }
         }
 
-      netdev_list_unlock();
+      netdev_list_runlock();
     }
 
   return NULL;
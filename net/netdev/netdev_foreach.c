@@ -71,7 +71,7 @@ int netdev_foreach(netdev_callback_t callback, FAR void *arg)
 
   if (callback != NULL)
     {
-      netdev_list_lock();
+      netdev_list_rlock();
       for (dev = g_netdevices; dev; dev = dev->flink)
         {
           if (callback(dev, arg) != 0)
@@ -81,7 +81,7 @@ int netdev_foreach(netdev_callback_t callback, FAR void *arg)
             }
         }
 
-      netdev_list_unlock();
+      netdev_list_runlock();
     }
 
   return ret;
@@ -40,6 +40,7 @@
 #include <nuttx/net/ethernet.h>
 #include <nuttx/net/bluetooth.h>
 #include <nuttx/net/can.h>
+#include <nuttx/rwsem.h>
 
 #include "utils/utils.h"
 #include "icmpv6/icmpv6.h"
@@ -110,7 +111,11 @@ uint32_t g_devfreed;
  * Private Data
  ****************************************************************************/
 
+#ifdef CONFIG_NET_RWLOCK
+static rw_semaphore_t g_netdevices_lock = RWSEM_INITIALIZER;
+#else
 static mutex_t g_netdevices_lock = NXMUTEX_INITIALIZER;
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -233,7 +238,11 @@ static int get_ifindex(void)
 
 void netdev_list_lock(void)
 {
+#ifdef CONFIG_NET_RWLOCK
+  down_write(&g_netdevices_lock);
+#else
   nxmutex_lock(&g_netdevices_lock);
+#endif
 }
 
 /****************************************************************************
@@ -246,7 +255,46 @@ void netdev_list_lock(void)
 
 void netdev_list_unlock(void)
 {
+#ifdef CONFIG_NET_RWLOCK
+  up_write(&g_netdevices_lock);
+#else
+  nxmutex_unlock(&g_netdevices_lock);
+#endif
+}
+
+/****************************************************************************
+ * Name: netdev_list_rlock
+ *
+ * Description:
+ *   Lock the network device list for reading.  The readers run in parallel
+ *   if CONFIG_NET_RWLOCK is enabled.
+ *
+ ****************************************************************************/
+
+void netdev_list_rlock(void)
+{
+#ifdef CONFIG_NET_RWLOCK
+  down_read(&g_netdevices_lock);
+#else
+  nxmutex_lock(&g_netdevices_lock);
+#endif
+}
+
+/****************************************************************************
+ * Name: netdev_list_runlock
+ *
+ * Description:
+ *   Unlock the network device list locked for reading.
+ *
+ ****************************************************************************/
+
+void netdev_list_runlock(void)
+{
+#ifdef CONFIG_NET_RWLOCK
+  up_read(&g_netdevices_lock);
+#else
   nxmutex_unlock(&g_netdevices_lock);
+#endif
 }
 
 /****************************************************************************
@@ -55,7 +55,7 @@ bool netdev_verify(FAR struct net_driver_s *dev)
 
   /* Search the list of registered devices */
 
-  netdev_list_lock();
+  netdev_list_rlock();
   for (chkdev = g_netdevices; chkdev != NULL; chkdev = chkdev->flink)
     {
       /* Is the network device that we are looking for? */
@@ -69,6 +69,6 @@ bool netdev_verify(FAR struct net_driver_s *dev)
         }
     }
 
-  netdev_list_unlock();
+  netdev_list_runlock();
   return valid;
 }
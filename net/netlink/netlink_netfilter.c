@@ -41,6 +41,7 @@
 #include <nuttx/net/netlink.h>
 
 #include "inet/inet.h"
+#include "ipfilter/ipfilter.h"
 #include "nat/nat.h"
 #include "netlink/netlink.h"
 #include "utils/utils.h"
@@ -89,6 +90,12 @@ struct nfnl_attr_u16_s
   uint16_t      pad[1];
 };
 
+struct nfnl_attr_u64_s
+{
+  struct nfattr attr;
+  uint32_t      value[2]; /* Big endian, the attributes are 4 bytes aligned */
+};
+
 /* Struct of a conntrack tuple
  * +------+--------------+-----------------+
  * | attr | CTA_TUPLE_IP | CTA_TUPLE_PROTO |
@@ -130,10 +137,22 @@ struct conntrack_tuple_icmp_s
   struct nfnl_attr_u8_s  code;
 };
 
+/* CTA_COUNTERS_ORIG and CTA_COUNTERS_REPLY definitions */
+
+struct conntrack_counters_s
+{
+  struct nfattr attr;
+  struct nfnl_attr_u64_s packets;
+  struct nfnl_attr_u64_s bytes;
+};
+
 /* Struct of a conntrack response
  * +-----+-----+-----------------+----------------+
  * | hdr | msg | tuple of origin | tuple of reply |
  * +-----+-----+-----------------+----------------+
+ * +--------------------+-------------------+
+ * | counters of origin | counters of reply |
+ * +--------------------+-------------------+
  */
 
 struct conntrack_recvfrom_response_s
@@ -387,6 +406,44 @@ static size_t netlink_conntrack_fill_proto(FAR void *buf, uint8_t proto,
   return 0;
 }
 
+/****************************************************************************
+ * Name: netlink_conntrack_fill_counters
+ *
+ * Description:
+ *   Fill the data of a CTA_COUNTERS_ORIG or CTA_COUNTERS_REPLY.
+ *
+ * Input Parameters:
+ *   buf     - The buffer to fill
+ *   type    - CTA_COUNTERS_ORIG or CTA_COUNTERS_REPLY
+ *   counter - The packets and bytes in this direction
+ *
+ * Returned Value:
+ *   The size of the filled data.
+ *
+ ****************************************************************************/
+
+static size_t
+netlink_conntrack_fill_counters(FAR void *buf, uint16_t type,
+                                FAR const struct nat_counter_s *counter)
+{
+  FAR struct conntrack_counters_s *counters = buf;
+
+  counters->attr.nfa_len  = sizeof(struct conntrack_counters_s);
+  counters->attr.nfa_type = type | NFNL_NFA_NEST;
+
+  counters->packets.attr.nfa_len  = NFA_LENGTH(sizeof(uint64_t));
+  counters->packets.attr.nfa_type = CTA_COUNTERS_PACKETS;
+  counters->packets.value[0] = HTONL((uint32_t)(counter->packets >> 32));
+  counters->packets.value[1] = HTONL((uint32_t)counter->packets);
+
+  counters->bytes.attr.nfa_len    = NFA_LENGTH(sizeof(uint64_t));
+  counters->bytes.attr.nfa_type   = CTA_COUNTERS_BYTES;
+  counters->bytes.value[0]   = HTONL((uint32_t)(counter->bytes >> 32));
+  counters->bytes.value[1]   = HTONL((uint32_t)counter->bytes);
+
+  return counters->attr.nfa_len;
+}
+
 /****************************************************************************
  * Name: netlink_get_ipv4/ipv6_conntrack
  *
@@ -400,12 +457,15 @@ netlink_get_conntrack(FAR const struct nlmsghdr *req, uint16_t flags,
                       uint8_t type, uint8_t domain, uint8_t proto,
                       FAR const void *lipaddr, uint16_t lport,
                       FAR const void *eipaddr, uint16_t eport,
-                      FAR const void *ripaddr, uint16_t rport)
+                      FAR const void *ripaddr, uint16_t rport,
+                      FAR const struct nat_counter_s *orig,
+                      FAR const struct nat_counter_s *reply)
 {
   FAR struct conntrack_recvfrom_rsplist_s *entry;
   FAR struct nfattr *tuple;
   ssize_t tuple_size = netlink_conntrack_tuple_size(domain, proto);
   size_t  offset     = 0;
+  size_t  datasize;
   size_t  allocsize;
   size_t  rspsize;
 
@@ -415,8 +475,9 @@ netlink_get_conntrack(FAR const struct nlmsghdr *req, uint16_t flags,
       return NULL;
     }
 
-  rspsize   = SIZEOF_CTNL_RECVFROM_RESPONSE_S(tuple_size * 2);
-  allocsize = SIZEOF_CTNL_RECVFROM_RSPLIST_S(tuple_size * 2);
+  datasize  = tuple_size * 2 + sizeof(struct conntrack_counters_s) * 2;
+  rspsize   = SIZEOF_CTNL_RECVFROM_RESPONSE_S(datasize);
+  allocsize = SIZEOF_CTNL_RECVFROM_RSPLIST_S(datasize);
 
   entry = kmm_malloc(allocsize);
   if (entry == NULL)
@@ -463,6 +524,15 @@ netlink_get_conntrack(FAR const struct nlmsghdr *req, uint16_t flags,
 
   DEBUGASSERT(offset == tuple_size * 2);
 
+  /* CTA_COUNTERS_ORIG and CTA_COUNTERS_REPLY */
+
+  offset += netlink_conntrack_fill_counters(&entry->payload.data[offset],
+                                            CTA_COUNTERS_ORIG, orig);
+  offset += netlink_conntrack_fill_counters(&entry->payload.data[offset],
+                                            CTA_COUNTERS_REPLY, reply);
+
+  DEBUGASSERT(offset == datasize);
+
   return (FAR struct netlink_response_s *)entry;
 }
 
@@ -479,11 +549,11 @@ netlink_get_ipv4_conntrack(FAR const struct nlmsghdr *req,
                                &entry->local_ip, entry->local_port,
                                &entry->external_ip, entry->external_port,
 #ifdef CONFIG_NET_NAT44_SYMMETRIC
-                               &entry->peer_ip, entry->peer_port
+                               &entry->peer_ip, entry->peer_port,
 #else
-                               &any, 0 /* Zero-address */
+                               &any, 0, /* Zero-address */
 #endif
-                              );
+                               &entry->orig, &entry->reply);
 }
 #endif
 
@@ -497,11 +567,11 @@ netlink_get_ipv6_conntrack(FAR const struct nlmsghdr *req,
                                entry->local_ip, entry->local_port,
                                entry->external_ip, entry->external_port,
 #ifdef CONFIG_NET_NAT66_SYMMETRIC
-                               entry->peer_ip, entry->peer_port
+                               entry->peer_ip, entry->peer_port,
 #else
-                               g_ipv6_unspecaddr, 0 /* Zero-address */
+                               g_ipv6_unspecaddr, 0, /* Zero-address */
 #endif
-      );
+                               &entry->orig, &entry->reply);
 }
 #endif
 
@@ -548,11 +618,49 @@ static void netlink_add_ipv6_conntrack(FAR ipv6_nat_entry_t *entry,
 }
 #endif
 
+/****************************************************************************
+ * Name: netlink_add_flow_conntrack
+ *
+ * Description:
+ *   Add the conntrack response of a flow of the packet filter, which is
+ *   reported as its own reply, with the packets of the flow as origin.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+static void netlink_add_flow_conntrack(
+  FAR const struct ipfilter_ct_info_s *flow, FAR void *arg)
+{
+  FAR struct nfnl_info_s *info = arg;
+  FAR struct netlink_response_s *resp;
+  uint16_t flags = NLM_F_MULTI | NLM_F_DUMP_FILTERED;
+  struct nat_counter_s orig;
+  struct nat_counter_s reply;
+
+  orig.packets  = flow->packets;
+  orig.bytes    = flow->bytes;
+  reply.packets = 0;
+  reply.bytes   = 0;
+
+  resp = netlink_get_conntrack(&info->req->hdr, flags, IPCTNL_MSG_CT_NEW,
+                               info->req->msg.nfgen_family, flow->proto,
+                               flow->srcip, flow->srcport,
+                               flow->srcip, flow->srcport,
+                               flow->destip, flow->destport,
+                               &orig, &reply);
+  if (resp != NULL)
+    {
+      netlink_add_response(info->handle, resp);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: netlink_list_conntrack
  *
  * Description:
- *   Return the entire NAT table.
+ *   Return the entire NAT table, followed by the flows of the packet
+ *   filter.
  *
  ****************************************************************************/
 
@@ -587,6 +695,13 @@ static int netlink_list_conntrack(NETLINK_HANDLE handle,
         return -ENOSYS;
     }
 
+#ifdef CONFIG_NET_IPFILTER_CONNTRACK
+  net_lock();
+  ipfilter_ct_foreach(req->msg.nfgen_family, netlink_add_flow_conntrack,
+                      &info);
+  net_unlock();
+#endif
+
   return netlink_add_terminator(handle, &req->hdr, 0);
 }
 
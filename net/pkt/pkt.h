@@ -305,6 +305,30 @@ uint32_t pkt_callback(FAR struct net_driver_s *dev,
 ssize_t pkt_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                     int flags);
 
+/****************************************************************************
+ * Name: pkt_recvmmsg
+ *
+ * Description:
+ *   Implements the recvmmsg() batch operation for packet sockets: receive
+ *   the first packet as pkt_recvmsg() does, then the packets already queued
+ *   in the read-ahead buffers, with the connection locked once.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   Buffers to receive the packets
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of packets received.  Otherwise, on
+ *   errors, a negated errno value is returned (see recvmsg() for the list
+ *   of appropriate error values).
+ *
+ ****************************************************************************/
+
+int pkt_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                 unsigned int vlen, int flags);
+
 /****************************************************************************
  * Name: pkt_find_device
  *
@@ -400,6 +424,32 @@ int pkt_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds);
 ssize_t pkt_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                     int flags);
 
+/****************************************************************************
+ * Name: pkt_sendmmsg
+ *
+ * Description:
+ *   Implements the sendmmsg() batch operation for packet sockets: the
+ *   packets to the same device are queued with the connection locked once,
+ *   and the device driver is notified once.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   msgvec   The messages to send
+ *   vlen     The number of messages in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of packets sent. On error, a negated
+ *   errno value is returned (see sendmsg() for the complete list of return
+ *   values.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_WRITE_BUFFERS
+int pkt_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                 unsigned int vlen, int flags);
+#endif
+
 #ifdef CONFIG_NET_PKTPROTO_OPTIONS
 /****************************************************************************
  * Name: pkt_getsockopt
@@ -441,75 +441,32 @@ static inline void pkt_readahead(FAR struct pkt_recvfrom_s *pstate)
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: pkt_recvmsg
+ * Name: pkt_recvfrom_locked
  *
  * Description:
- *   Implements the socket recvmsg interface for the case of the AF_INET
- *   and AF_INET6 address families.  pkt_recvmsg() receives messages from
- *   a socket, and may be used to receive data on a socket whether or not it
- *   is connection-oriented.
- *
- *   If 'msg_name' is not NULL, and the underlying protocol provides the
- *   source address, this source address is filled in.  The argument
- *   'msg_namelen' is initialized to the size of the buffer associated with
- *   msg_name, and modified on return to indicate the actual size of the
- *   address stored there.
+ *   Receive a packet into msg, the connection and the device being locked
+ *   by the caller.
  *
  * Input Parameters:
  *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   dev      The device of the packet socket
  *   msg      Buffer to receive the message
  *   flags    Receive flags
  *
  * Returned Value:
- *   On success, returns the number of characters received. If no data is
- *   available to be received and the peer has performed an orderly shutdown,
- *   recvmsg() will return 0.  Otherwise, on errors, a negated errno value is
- *   returned (see recvmsg() for the list of appropriate error values).
+ *   On success, returns the number of characters received.  Otherwise, on
+ *   errors, a negated errno value is returned.
  *
  ****************************************************************************/
 
-ssize_t pkt_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
-                    int flags)
+static ssize_t pkt_recvfrom_locked(FAR struct socket *psock,
+                                   FAR struct net_driver_s *dev,
+                                   FAR struct msghdr *msg, int flags)
 {
-  FAR struct sockaddr *from = msg->msg_name;
-  FAR socklen_t *fromlen = &msg->msg_namelen;
   FAR struct pkt_conn_s *conn = psock->s_conn;
-  FAR struct net_driver_s *dev;
   struct pkt_recvfrom_s state;
   ssize_t ret = 0;
 
-  /* If a 'from' address has been provided, verify that it is large
-   * enough to hold this address family.
-   */
-
-  if (from != NULL && *fromlen < sizeof(sa_family_t))
-    {
-      return -EINVAL;
-    }
-
-  if (msg->msg_iovlen != 1)
-    {
-      return -ENOTSUP;
-    }
-
-  if (psock->s_type != SOCK_DGRAM && psock->s_type != SOCK_RAW)
-    {
-      nerr("ERROR: Unsupported socket type: %d\n", psock->s_type);
-      ret = -ENOSYS;
-    }
-
-  /* Get the device driver that will service this transfer */
-
-  dev  = pkt_find_device(conn);
-  if (dev == NULL)
-    {
-      return -ENODEV;
-    }
-
   /* Perform the packet recvfrom() operation */
 
   /* Initialize the state structure.  This is done with the network
@@ -518,8 +475,6 @@ ssize_t pkt_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 
   pkt_recvfrom_initialize(conn, msg, &state, psock->s_type);
 
-  conn_dev_lock(&conn->sconn, dev);
-
   /* Check if there is buffered read-ahead data for this socket.  We may have
    * already received the response to previous command.
    */
@@ -580,11 +535,170 @@ ssize_t pkt_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
         }
     }
 
-  conn_dev_unlock(&conn->sconn, dev);
-
   pkt_recvfrom_uninitialize(&state);
 
   return ret;
 }
 
+/****************************************************************************
+ * Name: pkt_recvmsg_is_valid
+ *
+ * Description:
+ *   Validate the recvmsg() parameters for a packet socket.
+ *
+ ****************************************************************************/
+
+static int pkt_recvmsg_is_valid(FAR const struct msghdr *msg)
+{
+  /* If a 'from' address has been provided, verify that it is large
+   * enough to hold this address family.
+   */
+
+  if (msg->msg_name != NULL && msg->msg_namelen < sizeof(sa_family_t))
+    {
+      return -EINVAL;
+    }
+
+  if (msg->msg_iovlen != 1)
+    {
+      return -ENOTSUP;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_recvmsg
+ *
+ * Description:
+ *   Implements the socket recvmsg interface for the case of the AF_INET
+ *   and AF_INET6 address families.  pkt_recvmsg() receives messages from
+ *   a socket, and may be used to receive data on a socket whether or not it
+ *   is connection-oriented.
+ *
+ *   If 'msg_name' is not NULL, and the underlying protocol provides the
+ *   source address, this source address is filled in.  The argument
+ *   'msg_namelen' is initialized to the size of the buffer associated with
+ *   msg_name, and modified on return to indicate the actual size of the
+ *   address stored there.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msg      Buffer to receive the message
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received. If no data is
+ *   available to be received and the peer has performed an orderly shutdown,
+ *   recvmsg() will return 0.  Otherwise, on errors, a negated errno value is
+ *   returned (see recvmsg() for the list of appropriate error values).
+ *
+ ****************************************************************************/
+
+ssize_t pkt_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                    int flags)
+{
+  FAR struct pkt_conn_s *conn = psock->s_conn;
+  FAR struct net_driver_s *dev;
+  ssize_t ret;
+
+  ret = pkt_recvmsg_is_valid(msg);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (psock->s_type != SOCK_DGRAM && psock->s_type != SOCK_RAW)
+    {
+      nerr("ERROR: Unsupported socket type: %d\n", psock->s_type);
+      ret = -ENOSYS;
+    }
+
+  /* Get the device driver that will service this transfer */
+
+  dev  = pkt_find_device(conn);
+  if (dev == NULL)
+    {
+      return -ENODEV;
+    }
+
+  conn_dev_lock(&conn->sconn, dev);
+  ret = pkt_recvfrom_locked(psock, dev, msg, flags);
+  conn_dev_unlock(&conn->sconn, dev);
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pkt_recvmmsg
+ *
+ * Description:
+ *   Implements the recvmmsg() batch operation for packet sockets: receive
+ *   the first packet as pkt_recvmsg() does, then the packets already queued
+ *   in the read-ahead buffers, with the connection locked once.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   Buffers to receive the packets
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of packets received.  Otherwise, on
+ *   errors, a negated errno value is returned (see recvmsg() for the list
+ *   of appropriate error values).
+ *
+ ****************************************************************************/
+
+int pkt_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                 unsigned int vlen, int flags)
+{
+  FAR struct pkt_conn_s *conn = psock->s_conn;
+  FAR struct net_driver_s *dev;
+  unsigned int count = 0;
+  ssize_t ret;
+
+  ret = pkt_recvmsg_is_valid(&msgvec[0].msg_hdr);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (psock->s_type != SOCK_DGRAM && psock->s_type != SOCK_RAW)
+    {
+      nerr("ERROR: Unsupported socket type: %d\n", psock->s_type);
+      return -ENOSYS;
+    }
+
+  dev = pkt_find_device(conn);
+  if (dev == NULL)
+    {
+      return -ENODEV;
+    }
+
+  conn_dev_lock(&conn->sconn, dev);
+
+  do
+    {
+      ret = pkt_recvfrom_locked(psock, dev, &msgvec[count].msg_hdr, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[count].msg_len = ret;
+      flags |= MSG_DONTWAIT;
+    }
+  while (++count < vlen &&
+         pkt_recvmsg_is_valid(&msgvec[count].msg_hdr) == OK);
+
+  conn_dev_unlock(&conn->sconn, dev);
+
+  return count > 0 ? count : ret;
+}
+
 #endif /* CONFIG_NET */
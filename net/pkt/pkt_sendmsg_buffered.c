@@ -182,55 +182,42 @@ static uint32_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: pkt_sendmsg
+ * Name: pkt_sendmsg_locked
  *
  * Description:
- *   The pkt_sendmsg() call may be used only when the packet socket is in
- *   a connected state (so that the intended recipient is known).
+ *   Queue the packet of msg to the write queue, the connection and the
+ *   device being locked by the caller.
  *
  * Input Parameters:
  *   psock    An instance of the internal socket structure.
+ *   dev      The device to send the packet
  *   msg      Message to send
  *   flags    Send flags
  *
  * Returned Value:
- *   On success, returns the number of characters sent. On error, a negated
- *   errno value is returned (see sendmsg() for the complete list of return
- *   values.
+ *   On success, returns the number of characters queued. On error, a
+ *   negated errno value is returned.
  *
  ****************************************************************************/
 
-ssize_t pkt_sendmsg(FAR struct socket *psock, FAR const struct msghdr *msg,
-                    int flags)
+static ssize_t pkt_sendmsg_locked(FAR struct socket *psock,
+                                  FAR struct net_driver_s *dev,
+                                  FAR const struct msghdr *msg, int flags)
 {
   FAR const void *buf = msg->msg_iov->iov_base;
   size_t len = msg->msg_iov->iov_len;
   FAR struct sockaddr_ll *addr = msg->msg_name;
-  FAR struct net_driver_s *dev;
-  FAR struct pkt_conn_s *conn;
+  FAR struct pkt_conn_s *conn = psock->s_conn;
   FAR struct iob_s *iob;
   bool nonblock;
   int offset = 0;
   int ret = OK;
 
-  /* Validity check */
-
-  ret = pkt_sendmsg_is_valid(psock, msg, &dev);
-  if (ret != OK)
-    {
-      return ret;
-    }
-
   if (len <= 0)
     {
       return 0;
     }
 
-  conn = psock->s_conn;
   if (psock->s_type == SOCK_DGRAM)
     {
       /* Set the interface index for devif_poll can match the conn */
@@ -238,7 +225,6 @@ ssize_t pkt_sendmsg(FAR struct socket *psock, FAR const struct msghdr *msg,
       conn->ifindex = addr->sll_ifindex;
     }
 
-  conn_dev_lock(&conn->sconn, dev);
   nonblock = _SS_ISNONBLOCK(conn->sconn.s_flags) ||
              (flags & MSG_DONTWAIT) != 0;
 
@@ -250,8 +236,7 @@ ssize_t pkt_sendmsg(FAR struct socket *psock, FAR const struct msghdr *msg,
       if (nonblock)
         {
           nerr("ERROR: Buffer overflow\n");
-          ret = -EAGAIN;
-          goto errout_with_lock;
+          return -EAGAIN;
         }
 
       ret = conn_dev_sem_timedwait(&conn->sndsem, false,
@@ -259,7 +244,7 @@ ssize_t pkt_sendmsg(FAR struct socket *psock, FAR const struct msghdr *msg,
                                    &conn->sconn, dev);
       if (ret < 0)
         {
-          goto errout_with_lock;
+          return ret;
         }
     }
 #endif
@@ -279,16 +264,7 @@ ssize_t pkt_sendmsg(FAR struct socket *psock, FAR const struct msghdr *msg,
 
       nerr("ERROR: Failed to allocate write buffer\n");
 
-      if (nonblock)
-        {
-          ret = -EAGAIN;
-        }
-      else
-        {
-          ret = -ENOMEM;
-        }
-
-      goto errout_with_lock;
+      return nonblock ? -EAGAIN : -ENOMEM;
     }
 
   iob_reserve(iob, CONFIG_NET_LL_GUARDSIZE);
@@ -349,6 +325,28 @@ ssize_t pkt_sendmsg(FAR struct socket *psock, FAR const struct msghdr *msg,
       goto errout_with_iob;
     }
 
+  return len;
+
+errout_with_iob:
+  iob_free_chain(iob);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pkt_sendmsg_notify
+ *
+ * Description:
+ *   Set up the send callback and notify the device driver of the packets
+ *   queued by pkt_sendmsg_locked().
+ *
+ * Returned Value:
+ *   OK on success, -ENOMEM if the callback could not be allocated.
+ *
+ ****************************************************************************/
+
+static int pkt_sendmsg_notify(FAR struct pkt_conn_s *conn,
+                              FAR struct net_driver_s *dev)
+{
   /* Allocate resource to receive a callback */
 
   if (conn->sndcb == NULL)
@@ -363,30 +361,145 @@ ssize_t pkt_sendmsg(FAR struct socket *psock, FAR const struct msghdr *msg,
       /* A buffer allocation error occurred */
 
       nerr("ERROR: Failed to allocate callback\n");
-      ret = -ENOMEM;
-      goto errout_with_iob;
+      return -ENOMEM;
     }
-  else
+
+  /* Set up the callback in the connection */
+
+  conn->sndcb->flags = PKT_POLL;
+  conn->sndcb->priv  = conn;
+  conn->sndcb->event = psock_send_eventhandler;
+
+  /* Notify the device driver that new TX data is available. */
+
+  netdev_txnotify_dev(dev, PKT_POLL);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_sendmsg
+ *
+ * Description:
+ *   The pkt_sendmsg() call may be used only when the packet socket is in
+ *   a connected state (so that the intended recipient is known).
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   msg      Message to send
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent. On error, a negated
+ *   errno value is returned (see sendmsg() for the complete list of return
+ *   values.
+ *
+ ****************************************************************************/
+
+ssize_t pkt_sendmsg(FAR struct socket *psock, FAR const struct msghdr *msg,
+                    int flags)
+{
+  FAR struct net_driver_s *dev;
+  FAR struct pkt_conn_s *conn;
+  ssize_t len;
+  int ret;
+
+  /* Validity check */
+
+  ret = pkt_sendmsg_is_valid(psock, msg, &dev);
+  if (ret != OK)
+    {
+      return ret;
+    }
+
+  if (msg->msg_iov->iov_len <= 0)
     {
-      /* Set up the callback in the connection */
+      return 0;
+    }
 
-      conn->sndcb->flags = PKT_POLL;
-      conn->sndcb->priv  = conn;
-      conn->sndcb->event = psock_send_eventhandler;
+  conn = psock->s_conn;
+  conn_dev_lock(&conn->sconn, dev);
 
-      /* Notify the device driver that new TX data is available. */
+  /* The packet is left queued if the callback cannot be allocated, it is
+   * released with the connection.
+   */
 
-      netdev_txnotify_dev(dev, PKT_POLL);
-      conn_dev_unlock(&conn->sconn, dev);
+  len = pkt_sendmsg_locked(psock, dev, msg, flags);
+  if (len > 0)
+    {
+      ret = pkt_sendmsg_notify(conn, dev);
+      if (ret < 0)
+        {
+          len = ret;
+        }
     }
 
+  conn_dev_unlock(&conn->sconn, dev);
   return len;
+}
 
-errout_with_iob:
-  iob_free_chain(iob);
+/****************************************************************************
+ * Name: pkt_sendmmsg
+ *
+ * Description:
+ *   Implements the sendmmsg() batch operation for packet sockets: the
+ *   packets to the same device are queued with the connection locked once,
+ *   and the device driver is notified once.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   msgvec   The messages to send
+ *   vlen     The number of messages in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of packets sent. On error, a negated
+ *   errno value is returned (see sendmsg() for the complete list of return
+ *   values.
+ *
+ ****************************************************************************/
 
-errout_with_lock:
-  conn_dev_unlock(&conn->sconn, dev);
+int pkt_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                 unsigned int vlen, int flags)
+{
+  FAR struct net_driver_s *next;
+  FAR struct net_driver_s *dev;
+  FAR struct pkt_conn_s *conn;
+  unsigned int count = 0;
+  ssize_t ret;
 
-  return ret;
+  ret = pkt_sendmsg_is_valid(psock, &msgvec[0].msg_hdr, &dev);
+  if (ret != OK)
+    {
+      return ret;
+    }
+
+  conn = psock->s_conn;
+  conn_dev_lock(&conn->sconn, dev);
+
+  do
+    {
+      ret = pkt_sendmsg_locked(psock, dev, &msgvec[count].msg_hdr, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[count].msg_len = ret;
+      flags |= MSG_DONTWAIT;
+    }
+  while (++count < vlen &&
+         pkt_sendmsg_is_valid(psock, &msgvec[count].msg_hdr, &next) == OK &&
+         next == dev);
+
+  if (count > 0)
+    {
+      ret = pkt_sendmsg_notify(conn, dev);
+    }
+
+  conn_dev_unlock(&conn->sconn, dev);
+  return ret < 0 ? ret : count;
 }
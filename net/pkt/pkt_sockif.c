@@ -83,9 +83,23 @@ const struct sock_intf_s g_pkt_sockif =
   NULL,            /* si_ioctl */
   NULL,            /* si_socketpair */
   NULL             /* si_shutdown */
-#if defined(CONFIG_NET_SOCKOPTS) && defined(CONFIG_NET_PKTPROTO_OPTIONS)
+#ifdef CONFIG_NET_SOCKOPTS
+#ifdef CONFIG_NET_PKTPROTO_OPTIONS
   , pkt_getsockopt /* si_getsockopt */
   , pkt_setsockopt /* si_setsockopt */
+#else
+  , NULL           /* si_getsockopt */
+  , NULL           /* si_setsockopt */
+#endif
+#endif
+#ifdef CONFIG_NET_SENDFILE
+  , NULL           /* si_sendfile */
+#endif
+  , pkt_recvmmsg   /* si_recvmmsg */
+#ifdef CONFIG_NET_PKT_WRITE_BUFFERS
+  , pkt_sendmmsg   /* si_sendmmsg */
+#else
+  , NULL           /* si_sendmmsg */
 #endif
 };
 
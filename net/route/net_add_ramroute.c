@@ -63,6 +63,9 @@
 int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 {
   FAR struct net_route_ipv4_s *route;
+#ifdef CONFIG_ROUTE_TRIE
+  int ret;
+#endif
 
   /* Allocate a route entry */
 
@@ -82,13 +85,26 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 
   /* Get exclusive address to the networking data structures */
 
-  net_lock();
+  ramroute_lock();
+
+#ifdef CONFIG_ROUTE_TRIE
+  /* Index the new entry by its prefix */
+
+  ret = net_addtrie_ipv4((FAR struct net_route_ipv4_entry_s *)route);
+  if (ret < 0)
+    {
+      ramroute_unlock();
+      nerr("ERROR:  Failed to index the route: %d\n", ret);
+      net_freeroute_ipv4(route);
+      return ret;
+    }
+#endif
 
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_ipv4_routes);
-  net_unlock();
+  ramroute_unlock();
 
   netlink_route_notify(route, RTM_NEWROUTE, AF_INET);
   return OK;
@@ -100,6 +116,9 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
                       net_ipv6addr_t router)
 {
   FAR struct net_route_ipv6_s *route;
+#ifdef CONFIG_ROUTE_TRIE
+  int ret;
+#endif
 
   /* Allocate a route entry */
 
@@ -119,13 +138,26 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
 
   /* Get exclusive address to the networking data structures */
 
-  net_lock();
+  ramroute_lock();
+
+#ifdef CONFIG_ROUTE_TRIE
+  /* Index the new entry by its prefix */
+
+  ret = net_addtrie_ipv6((FAR struct net_route_ipv6_entry_s *)route);
+  if (ret < 0)
+    {
+      ramroute_unlock();
+      nerr("ERROR:  Failed to index the route: %d\n", ret);
+      net_freeroute_ipv6(route);
+      return ret;
+    }
+#endif
 
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_ipv6_routes);
-  net_unlock();
+  ramroute_unlock();
 
   netlink_route_notify(route, RTM_NEWROUTE, AF_INET6);
   return OK;
@@ -54,6 +54,10 @@ FAR struct net_route_ipv4_queue_s g_ipv4_routes;
 FAR struct net_route_ipv6_queue_s g_ipv6_routes;
 #endif
 
+#ifdef CONFIG_NET_RWLOCK
+rw_semaphore_t g_ramroute_lock = RWSEM_INITIALIZER;
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -154,13 +158,13 @@ FAR struct net_route_ipv4_s *net_allocroute_ipv4(void)
 
   /* Get exclusive address to the networking data structures */
 
-  net_lock();
+  ramroute_lock();
 
   /* Then add the remove the first entry from the table */
 
   route = ramroute_ipv4_remfirst(&g_free_ipv4routes);
 
-  net_unlock();
+  ramroute_unlock();
   if (!route)
     {
       return NULL;
@@ -177,13 +181,13 @@ FAR struct net_route_ipv6_s *net_allocroute_ipv6(void)
 
   /* Get exclusive address to the networking data structures */
 
-  net_lock();
+  ramroute_lock();
 
   /* Then add the remove the first entry from the table */
 
   route = ramroute_ipv6_remfirst(&g_free_ipv6routes);
 
-  net_unlock();
+  ramroute_unlock();
   if (!route)
     {
       return NULL;
@@ -214,13 +218,13 @@ void net_freeroute_ipv4(FAR struct net_route_ipv4_s *route)
 
   /* Get exclusive address to the networking data structures */
 
-  net_lock();
+  ramroute_lock();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_free_ipv4routes);
-  net_unlock();
+  ramroute_unlock();
 }
 #endif
 
@@ -231,13 +235,13 @@ void net_freeroute_ipv6(FAR struct net_route_ipv6_s *route)
 
   /* Get exclusive address to the networking data structures */
 
-  net_lock();
+  ramroute_lock();
 
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_free_ipv6routes);
-  net_unlock();
+  ramroute_unlock();
 }
 #endif
 
@@ -68,7 +68,7 @@ int net_foreachroute_ipv4(route_handler_ipv4_t handler, FAR void *arg)
 
   /* Prevent concurrent access to the routing table */
 
-  net_lock();
+  ramroute_rlock();
 
   /* Visit each entry in the routing table */
 
@@ -82,9 +82,9 @@ int net_foreachroute_ipv4(route_handler_ipv4_t handler, FAR void *arg)
       ret  = handler(&route->entry, arg);
     }
 
-  /* Unlock the network */
+  /* Unlock the routing table */
 
-  net_unlock();
+  ramroute_runlock();
   return ret;
 }
 #endif
@@ -98,7 +98,7 @@ int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg)
 
   /* Prevent concurrent access to the routing table */
 
-  net_lock();
+  ramroute_rlock();
 
   /* Visit each entry in the routing table */
 
@@ -112,9 +112,9 @@ int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg)
       ret  = handler(&route->entry, arg);
     }
 
-  /* Unlock the network */
+  /* Unlock the routing table */
 
-  net_unlock();
+  ramroute_runlock();
   return ret;
 }
 #endif
@@ -0,0 +1,473 @@
+/****************************************************************************
+ * net/route/net_trieroute.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/queue.h>
+#include <nuttx/net/ip.h>
+
+#include "route/ramroute.h"
+#include "route/route.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_ROUTE_TRIE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A node of the path-compressed binary trie of the route prefixes.  The
+ * prefixes of the children extend the prefix of the node, the child is
+ * selected by the first bit after the prefix.  A node without route has
+ * two children, it only exists to branch.
+ */
+
+struct route_trie_node_s
+{
+  FAR struct route_trie_node_s *child[2]; /* Longer prefixes */
+  sq_queue_t routes;                      /* Routes of exactly this prefix */
+  uint8_t plen;                           /* Prefix length in bits */
+  uint8_t key[1];                         /* Prefix, in network order */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The prefix tries of the in-memory routing tables */
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+static FAR struct route_trie_node_s *g_ipv4_trie;
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+static FAR struct route_trie_node_s *g_ipv6_trie;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: route_trie_bit
+ *
+ * Description:
+ *   Return the bit of the key at the position, 0 being the MSB.
+ *
+ ****************************************************************************/
+
+static inline int route_trie_bit(FAR const uint8_t *key, unsigned int bit)
+{
+  return (key[bit >> 3] >> (7 - (bit & 7))) & 1;
+}
+
+/****************************************************************************
+ * Name: route_trie_common
+ *
+ * Description:
+ *   Return the number of leading bits the keys have in common, up to
+ *   maxlen.
+ *
+ ****************************************************************************/
+
+static unsigned int route_trie_common(FAR const uint8_t *key1,
+                                      FAR const uint8_t *key2,
+                                      unsigned int maxlen)
+{
+  unsigned int len;
+  uint8_t diff;
+
+  for (len = 0; len < maxlen; len += 8)
+    {
+      diff = key1[len >> 3] ^ key2[len >> 3];
+      if (diff != 0)
+        {
+          while ((diff & 0x80) == 0)
+            {
+              diff <<= 1;
+              len++;
+            }
+
+          break;
+        }
+    }
+
+  return MIN(len, maxlen);
+}
+
+/****************************************************************************
+ * Name: route_trie_contains
+ *
+ * Description:
+ *   Return true if the prefix of the node contains the address.
+ *
+ ****************************************************************************/
+
+static inline bool route_trie_contains(FAR struct route_trie_node_s *node,
+                                       FAR const uint8_t *addr)
+{
+  return route_trie_common(node->key, addr, node->plen) == node->plen;
+}
+
+/****************************************************************************
+ * Name: route_trie_alloc
+ *
+ * Description:
+ *   Allocate a node for the first plen bits of the key.
+ *
+ ****************************************************************************/
+
+static FAR struct route_trie_node_s *
+route_trie_alloc(FAR const uint8_t *key, uint8_t plen, size_t keylen)
+{
+  FAR struct route_trie_node_s *node;
+  size_t nbytes = (plen + 7) >> 3;
+
+  node = kmm_zalloc(sizeof(struct route_trie_node_s) + keylen - 1);
+  if (node == NULL)
+    {
+      return NULL;
+    }
+
+  memcpy(node->key, key, nbytes);
+  if ((plen & 7) != 0)
+    {
+      node->key[nbytes - 1] &= 0xff << (8 - (plen & 7));
+    }
+
+  node->plen = plen;
+  return node;
+}
+
+/****************************************************************************
+ * Name: route_trie_insert
+ *
+ * Description:
+ *   Add the route to the node of the prefix, created if needed.  The routes
+ *   of a prefix are kept in the order they were added.
+ *
+ ****************************************************************************/
+
+static int route_trie_insert(FAR struct route_trie_node_s **link,
+                             FAR const uint8_t *key, uint8_t plen,
+                             size_t keylen, FAR sq_entry_t *route)
+{
+  FAR struct route_trie_node_s *branch;
+  FAR struct route_trie_node_s *node;
+  FAR struct route_trie_node_s *leaf;
+  unsigned int common = 0;
+
+  /* Walk down while the prefix of the node contains the new prefix */
+
+  while ((node = *link) != NULL)
+    {
+      common = route_trie_common(node->key, key, MIN(node->plen, plen));
+      if (common < node->plen)
+        {
+          break;
+        }
+
+      if (node->plen == plen)
+        {
+          sq_addlast(route, &node->routes);
+          return OK;
+        }
+
+      link = &node->child[route_trie_bit(key, node->plen)];
+    }
+
+  leaf = route_trie_alloc(key, plen, keylen);
+  if (leaf == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  sq_addlast(route, &leaf->routes);
+
+  if (node == NULL)
+    {
+      /* Append a new leaf */
+
+      *link = leaf;
+    }
+  else if (common == plen)
+    {
+      /* The new prefix contains the one of the node, insert it above */
+
+      leaf->child[route_trie_bit(node->key, plen)] = node;
+      *link = leaf;
+    }
+  else
+    {
+      /* The prefixes diverge, branch where they do */
+
+      branch = route_trie_alloc(key, common, keylen);
+      if (branch == NULL)
+        {
+          kmm_free(leaf);
+          return -ENOMEM;
+        }
+
+      branch->child[route_trie_bit(key, common)]       = leaf;
+      branch->child[route_trie_bit(node->key, common)] = node;
+      *link = branch;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: route_trie_remove
+ *
+ * Description:
+ *   Remove the route from the node of the prefix.  The node is freed once
+ *   it has no route, and its parent too if it was only left to branch.
+ *
+ ****************************************************************************/
+
+static void route_trie_remove(FAR struct route_trie_node_s **link,
+                              FAR const uint8_t *key, uint8_t plen,
+                              FAR sq_entry_t *route)
+{
+  FAR struct route_trie_node_s **plink = NULL;
+  FAR struct route_trie_node_s *parent;
+  FAR struct route_trie_node_s *node;
+
+  while ((node = *link) != NULL && node->plen < plen)
+    {
+      if (!route_trie_contains(node, key))
+        {
+          return;
+        }
+
+      plink = link;
+      link  = &node->child[route_trie_bit(key, node->plen)];
+    }
+
+  if (node == NULL || node->plen != plen || !route_trie_contains(node, key))
+    {
+      return;
+    }
+
+  sq_rem(route, &node->routes);
+  if (!sq_empty(&node->routes) ||
+      (node->child[0] != NULL && node->child[1] != NULL))
+    {
+      return;
+    }
+
+  *link = node->child[0] != NULL ? node->child[0] : node->child[1];
+  kmm_free(node);
+
+  if (plink != NULL && *link == NULL)
+    {
+      parent = *plink;
+      if (sq_empty(&parent->routes))
+        {
+          *plink = parent->child[0] != NULL ? parent->child[0] :
+                                              parent->child[1];
+          kmm_free(parent);
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_addtrie_ipv4 and net_addtrie_ipv6
+ *
+ * Description:
+ *   Add an entry of the in-memory routing table to its prefix trie.
+ *
+ * Input Parameters:
+ *   route - The entry added to the routing table
+ *
+ * Returned Value:
+ *   OK on success, -ENOMEM if the trie nodes could not be allocated.
+ *
+ * Assumptions:
+ *   The caller holds the write lock of the routing table.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_addtrie_ipv4(FAR struct net_route_ipv4_entry_s *route)
+{
+  return route_trie_insert(&g_ipv4_trie,
+                           (FAR const uint8_t *)&route->entry.target,
+                           net_ipv4_mask2pref(route->entry.netmask),
+                           sizeof(in_addr_t), &route->tlink);
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_addtrie_ipv6(FAR struct net_route_ipv6_entry_s *route)
+{
+  return route_trie_insert(&g_ipv6_trie,
+                           (FAR const uint8_t *)route->entry.target,
+                           net_ipv6_mask2pref(route->entry.netmask),
+                           sizeof(net_ipv6addr_t), &route->tlink);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_deltrie_ipv4 and net_deltrie_ipv6
+ *
+ * Description:
+ *   Remove an entry of the in-memory routing table from its prefix trie.
+ *
+ * Input Parameters:
+ *   route - The entry removed from the routing table
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller holds the write lock of the routing table.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+void net_deltrie_ipv4(FAR struct net_route_ipv4_entry_s *route)
+{
+  route_trie_remove(&g_ipv4_trie, (FAR const uint8_t *)&route->entry.target,
+                    net_ipv4_mask2pref(route->entry.netmask), &route->tlink);
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+void net_deltrie_ipv6(FAR struct net_route_ipv6_entry_s *route)
+{
+  route_trie_remove(&g_ipv6_trie, (FAR const uint8_t *)route->entry.target,
+                    net_ipv6_mask2pref(route->entry.netmask), &route->tlink);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_matchroute_ipv4 and net_matchroute_ipv6
+ *
+ * Description:
+ *   Traverse the routes of the in-memory routing table whose prefix
+ *   contains the target address, from the shortest prefix to the longest
+ *   one.  Only the nodes on the path of the address in the prefix trie are
+ *   visited, the cost depends on the prefix length and not on the size of
+ *   the table.
+ *
+ * Input Parameters:
+ *   target  - The address to look up
+ *   handler - Will be called for each matching route
+ *   arg     - An arbitrary value that will be passed to the handler
+ *
+ * Returned Value:
+ *   Zero (OK) returned if all the matching routes were visited.  Handlers
+ *   may also terminate the search early with any non-zero value.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_matchroute_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                        FAR void *arg)
+{
+  FAR const uint8_t *addr = (FAR const uint8_t *)&target;
+  FAR struct route_trie_node_s *node;
+  FAR sq_entry_t *entry;
+  int ret = 0;
+
+  ramroute_rlock();
+
+  node = g_ipv4_trie;
+  while (ret == 0 && node != NULL && route_trie_contains(node, addr))
+    {
+      sq_for_every(&node->routes, entry)
+        {
+          ret = handler(&container_of(entry, struct net_route_ipv4_entry_s,
+                                      tlink)->entry, arg);
+          if (ret != 0)
+            {
+              break;
+            }
+        }
+
+      if (node->plen >= 32)
+        {
+          break;
+        }
+
+      node = node->child[route_trie_bit(addr, node->plen)];
+    }
+
+  ramroute_runlock();
+  return ret;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_matchroute_ipv6(FAR const uint16_t *target,
+                        route_handler_ipv6_t handler, FAR void *arg)
+{
+  FAR const uint8_t *addr = (FAR const uint8_t *)target;
+  FAR struct route_trie_node_s *node;
+  FAR sq_entry_t *entry;
+  int ret = 0;
+
+  ramroute_rlock();
+
+  node = g_ipv6_trie;
+  while (ret == 0 && node != NULL && route_trie_contains(node, addr))
+    {
+      sq_for_every(&node->routes, entry)
+        {
+          ret = handler(&container_of(entry, struct net_route_ipv6_entry_s,
+                                      tlink)->entry, arg);
+          if (ret != 0)
+            {
+              break;
+            }
+        }
+
+      if (node->plen >= 128)
+        {
+          break;
+        }
+
+      node = node->child[route_trie_bit(addr, node->plen)];
+    }
+
+  ramroute_runlock();
+  return ret;
+}
+#endif
+
+#endif /* CONFIG_ROUTE_TRIE */
@@ -29,6 +29,10 @@
 
 #include <nuttx/config.h>
 
+#include <nuttx/net/net.h>
+#include <nuttx/queue.h>
+#include <nuttx/rwsem.h>
+
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
@@ -47,6 +51,23 @@
 #  define CONFIG_ROUTE_MAX_IPv6_RAMROUTES 4
 #endif
 
+/* Protection of the routing tables and of the lists of free entries.  The
+ * write lock is recursive and a thread holding it may also take the read
+ * lock.
+ */
+
+#ifdef CONFIG_NET_RWLOCK
+#  define ramroute_lock()    down_write(&g_ramroute_lock)
+#  define ramroute_unlock()  up_write(&g_ramroute_lock)
+#  define ramroute_rlock()   down_read(&g_ramroute_lock)
+#  define ramroute_runlock() up_read(&g_ramroute_lock)
+#else
+#  define ramroute_lock()    net_lock()
+#  define ramroute_unlock()  net_unlock()
+#  define ramroute_rlock()   net_lock()
+#  define ramroute_runlock() net_unlock()
+#endif
+
 /* Routing table initializer */
 
 #define ramroute_init(rr) \
@@ -68,6 +89,9 @@ struct net_route_ipv4_entry_s
 {
   struct net_route_ipv4_s entry;
   FAR struct net_route_ipv4_entry_s *flink;
+#ifdef CONFIG_ROUTE_TRIE
+  sq_entry_t tlink;                  /* Link of the routes of the prefix */
+#endif
 };
 
 /* This structure describes the head of a routing table list */
@@ -86,6 +110,9 @@ struct net_route_ipv6_entry_s
 {
   struct net_route_ipv6_s entry;
   FAR struct net_route_ipv6_entry_s *flink;
+#ifdef CONFIG_ROUTE_TRIE
+  sq_entry_t tlink;                  /* Link of the routes of the prefix */
+#endif
 };
 
 /* This structure describes the head of a routing table list */
@@ -115,6 +142,12 @@ extern struct net_route_ipv4_queue_s g_ipv4_routes;
 extern struct net_route_ipv6_queue_s g_ipv6_routes;
 #endif
 
+#ifdef CONFIG_NET_RWLOCK
+/* The lock of the routing tables */
+
+extern rw_semaphore_t g_ramroute_lock;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -218,5 +251,55 @@ ramroute_ipv6_remafter(FAR struct net_route_ipv6_entry_s *entry,
                        FAR struct net_route_ipv6_queue_s *list);
 #endif
 
+/****************************************************************************
+ * Name: net_addtrie_ipv4 and net_addtrie_ipv6
+ *
+ * Description:
+ *   Add an entry of the in-memory routing table to its prefix trie.
+ *
+ * Input Parameters:
+ *   route - The entry added to the routing table
+ *
+ * Returned Value:
+ *   OK on success, -ENOMEM if the trie nodes could not be allocated.
+ *
+ * Assumptions:
+ *   The caller holds the write lock of the routing table.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_ROUTE_TRIE) && defined(CONFIG_ROUTE_IPv4_RAMROUTE)
+int net_addtrie_ipv4(FAR struct net_route_ipv4_entry_s *route);
+#endif
+
+#if defined(CONFIG_ROUTE_TRIE) && defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+int net_addtrie_ipv6(FAR struct net_route_ipv6_entry_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_deltrie_ipv4 and net_deltrie_ipv6
+ *
+ * Description:
+ *   Remove an entry of the in-memory routing table from its prefix trie.
+ *
+ * Input Parameters:
+ *   route - The entry removed from the routing table
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller holds the write lock of the routing table.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_ROUTE_TRIE) && defined(CONFIG_ROUTE_IPv4_RAMROUTE)
+void net_deltrie_ipv4(FAR struct net_route_ipv4_entry_s *route);
+#endif
+
+#if defined(CONFIG_ROUTE_TRIE) && defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+void net_deltrie_ipv6(FAR struct net_route_ipv6_entry_s *route);
+#endif
+
 #endif /* CONFIG_ROUTE_IPv4_RAMROUTE || CONFIG_ROUTE_IPv6_RAMROUTE */
 #endif /* __NET_ROUTE_RAMROUTE_H */
@@ -283,6 +283,47 @@ int net_foreachroute_ipv4(route_handler_ipv4_t handler, FAR void *arg);
 int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg);
 #endif
 
+/****************************************************************************
+ * Name: net_matchroute_ipv4/net_matchroute_ipv6
+ *
+ * Description:
+ *   Traverse the routes of the routing table that may contain the target
+ *   address.  With CONFIG_ROUTE_TRIE, only the routes of the in-memory
+ *   table whose prefix contains the target are visited, shortest prefix
+ *   first.  Otherwise the whole table is traversed.
+ *
+ * Input Parameters:
+ *   target  - The address to look up
+ *   handler - Will be called for each route that may match
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   Zero (OK) returned if all the routes were visited.  A negated errno
+ *   value will be returned in the event of a failure.  Handlers may also
+ *   terminate the search early with any non-zero value.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+#  if defined(CONFIG_ROUTE_TRIE) && defined(CONFIG_ROUTE_IPv4_RAMROUTE)
+int net_matchroute_ipv4(in_addr_t target, route_handler_ipv4_t handler,
+                        FAR void *arg);
+#  else
+#    define net_matchroute_ipv4(target, handler, arg) \
+       net_foreachroute_ipv4(handler, arg)
+#  endif
+#endif
+
+#ifdef CONFIG_NET_IPv6
+#  if defined(CONFIG_ROUTE_TRIE) && defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+int net_matchroute_ipv6(FAR const uint16_t *target,
+                        route_handler_ipv6_t handler, FAR void *arg);
+#  else
+#    define net_matchroute_ipv6(target, handler, arg) \
+       net_foreachroute_ipv6(handler, arg)
+#  endif
+#endif
+
 /****************************************************************************
  * Name: net_ipv4_dumproute and net_ipv6_dumproute
  *
@@ -150,6 +150,9 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
 #ifdef CONFIG_NET_TIMESTAMP
       case SO_TIMESTAMP:   /* Generates a timestamp in us for each incoming packet */
       case SO_TIMESTAMPNS: /* Generates a timestamp in ns for each incoming packet */
+#endif
+#ifdef CONFIG_NET_ZEROCOPY
+      case SO_ZEROCOPY:    /* Allows MSG_ZEROCOPY sends */
 #endif
         {
           sockopt_t optionset;
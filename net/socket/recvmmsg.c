@@ -0,0 +1,306 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <assert.h>
+#include <errno.h>
+#include <time.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/clock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The maximum number of messages passed to the socket at once, the control
+ * buffers of which are saved on the stack.
+ */
+
+#define RECVMMSG_BATCH 16
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: recvmmsg_batch
+ *
+ * Description:
+ *   Receive the first message of msgvec, then as many of the next ones as
+ *   possible without blocking.
+ *
+ * Returned Value:
+ *   The number of messages received, or a negated errno value if none was.
+ *
+ ****************************************************************************/
+
+static int recvmmsg_batch(FAR struct socket *psock,
+                          FAR struct mmsghdr *msgvec, unsigned int vlen,
+                          int flags)
+{
+  FAR void *control[RECVMMSG_BATCH];
+  FAR struct msghdr *msg;
+  unsigned long used;
+  unsigned int i;
+  int ret;
+
+  /* Only pass the messages that psock_recvmsg() would accept */
+
+  vlen = MIN(vlen, RECVMMSG_BATCH);
+  for (i = 0; i < vlen; i++)
+    {
+      msg = &msgvec[i].msg_hdr;
+      if (msg->msg_iov == NULL || msg->msg_iov->iov_base == NULL ||
+          (msg->msg_name != NULL && msg->msg_namelen <= 0))
+        {
+          break;
+        }
+
+      control[i] = msg->msg_control;
+    }
+
+  if (i == 0)
+    {
+      return -EINVAL;
+    }
+
+  vlen = i;
+
+  if (psock->s_sockif->si_recvmmsg != NULL)
+    {
+      ret = psock->s_sockif->si_recvmmsg(psock, msgvec, vlen, flags);
+    }
+  else
+    {
+      ret = psock->s_sockif->si_recvmsg(psock, &msgvec[0].msg_hdr, flags);
+      if (ret >= 0)
+        {
+          msgvec[0].msg_len = ret;
+          ret = 1;
+        }
+    }
+
+  /* Recover the pointers and calculate the cmsg's true data lengths, as
+   * psock_recvmsg() does.
+   */
+
+  for (i = 0; i < vlen; i++)
+    {
+      msg  = &msgvec[i].msg_hdr;
+      used = (FAR char *)msg->msg_control - (FAR char *)control[i];
+
+      msg->msg_control = control[i];
+      if ((int)i < ret)
+        {
+          msg->msg_controllen = used;
+        }
+      else
+        {
+          msg->msg_controllen += used;
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives a vector of messages from a socket.  This is
+ *   an internal OS interface.  It is functionally equivalent to recvmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    Buffers to receive the messages
+ *   vlen      The number of messages in msgvec
+ *   flags     Receive flags
+ *   timeout   The time to wait for the messages, or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received, the msg_len field
+ *   of each of them is the number of characters received.  Otherwise, if no
+ *   message could be received, a negated errno value is returned (see
+ *   comments with recvmsg() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  unsigned int count = 0;
+  clock_t expire = 0;
+  clock_t now;
+  int ret = OK;
+
+  /* Verify that non-NULL pointers were passed */
+
+  if (msgvec == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (timeout != NULL &&
+      (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+       timeout->tv_nsec >= NSEC_PER_SEC))
+    {
+      return -EINVAL;
+    }
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      return -EBADF;
+    }
+
+  DEBUGASSERT(psock->s_sockif != NULL &&
+              psock->s_sockif->si_recvmsg != NULL);
+
+  if (timeout != NULL)
+    {
+      expire = clock_systime_ticks() + clock_time2ticks(timeout);
+    }
+
+  /* Each batch waits for its first message only.  As with Linux, the
+   * timeout is checked once a batch is received, it does not interrupt a
+   * blocked receive.
+   */
+
+  while (count < vlen)
+    {
+      ret = recvmmsg_batch(psock, &msgvec[count], vlen - count, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      count += ret;
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      if (timeout != NULL &&
+          (sclock_t)(clock_systime_ticks() - expire) >= 0)
+        {
+          break;
+        }
+    }
+
+  if (timeout != NULL)
+    {
+      now = clock_systime_ticks();
+      clock_ticks2time(timeout, (sclock_t)(expire - now) > 0 ?
+                                expire - now : 0);
+    }
+
+  /* An error after some messages were received is not reported, the next
+   * receive will see it again.
+   */
+
+  return count > 0 ? count : ret;
+}
+
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *   recvmmsg() receives multiple messages from a socket in a single call.
+ *   Each message is received as recvmsg() would, its length is stored in
+ *   the msg_len field of its mmsghdr.  The call blocks, unless the socket
+ *   is non-blocking or MSG_DONTWAIT is specified, until vlen messages are
+ *   received, or only until the first one with MSG_WAITFORONE.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   Buffers to receive the messages
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *   timeout  The time to wait for the messages, or NULL to wait forever.
+ *            It is updated with the time left.
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  On error, -1 is
+ *   returned, and errno is set appropriately (see recvmsg()).
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  ret = sockfd_socket(sockfd, &filep, &psock);
+
+  /* Let psock_recvmmsg() do all of the work */
+
+  if (ret == OK)
+    {
+      ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+      file_put(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -0,0 +1,206 @@
+/****************************************************************************
+ * net/socket/sendmmsg.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends a vector of messages to a socket.  This is an
+ *   internal OS interface.  It is functionally equivalent to sendmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    The messages to send
+ *   vlen      The number of messages in msgvec
+ *   flags     Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent, the msg_len field of
+ *   each of them is the number of characters sent.  Otherwise, if no
+ *   message could be sent, a negated errno value is returned (see comments
+ *   with sendmsg() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags)
+{
+  FAR struct msghdr *msg;
+  unsigned int count = 0;
+  unsigned int n;
+  int ret = OK;
+
+  /* Verify that non-NULL pointers were passed */
+
+  if (msgvec == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      return -EBADF;
+    }
+
+  DEBUGASSERT(psock->s_sockif != NULL &&
+              psock->s_sockif->si_sendmsg != NULL);
+
+  while (count < vlen)
+    {
+      /* Only pass the messages that psock_sendmsg() would accept */
+
+      for (n = count; n < vlen; n++)
+        {
+          msg = &msgvec[n].msg_hdr;
+          if (msg->msg_iov == NULL ||
+              (psock->s_type != SOCK_DGRAM &&
+               msg->msg_iov->iov_base == NULL))
+            {
+              break;
+            }
+        }
+
+      if (n == count)
+        {
+          ret = -EINVAL;
+          break;
+        }
+
+      /* Let the socket send as many messages as it can at once, or send
+       * them one by one.
+       */
+
+      if (psock->s_sockif->si_sendmmsg != NULL)
+        {
+          ret = psock->s_sockif->si_sendmmsg(psock, &msgvec[count],
+                                             n - count, flags);
+        }
+      else
+        {
+          ret = psock->s_sockif->si_sendmsg(psock, &msgvec[count].msg_hdr,
+                                            flags);
+          if (ret >= 0)
+            {
+              msgvec[count].msg_len = ret;
+              ret = 1;
+            }
+        }
+
+      if (ret < 0)
+        {
+          break;
+        }
+
+      count += ret;
+    }
+
+  /* An error after some messages were sent is not reported, the next send
+   * will see it again.
+   */
+
+  return count > 0 ? count : ret;
+}
+
+/****************************************************************************
+ * Function: sendmmsg
+ *
+ * Description:
+ *   sendmmsg() sends multiple messages on a socket in a single call.  Each
+ *   message is sent as sendmsg() would, the number of bytes sent is stored
+ *   in the msg_len field of its mmsghdr.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   The messages to send
+ *   vlen     The number of messages in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent, that may be less than
+ *   vlen.  On error, -1 is returned, and errno is set appropriately (see
+ *   sendmsg()).
+ *
+ ****************************************************************************/
+
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  int ret;
+
+  /* sendmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  ret = sockfd_socket(sockfd, &filep, &psock);
+
+  /* Let psock_sendmmsg() do all of the work */
+
+  if (ret == OK)
+    {
+      ret = psock_sendmmsg(psock, msgvec, vlen, flags);
+      file_put(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -67,6 +67,7 @@
 #define _SO_TIMESTAMP    _SO_BIT(SO_TIMESTAMP)
 #define _SO_TIMESTAMPNS  _SO_BIT(SO_TIMESTAMPNS)
 #define _SO_BINDTODEVICE _SO_BIT(SO_BINDTODEVICE)
+#define _SO_ZEROCOPY     _SO_BIT(SO_ZEROCOPY)
 
 /* This is the largest option value.  REVISIT: belongs in sys/socket.h */
 
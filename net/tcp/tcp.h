@@ -208,6 +208,10 @@ struct tcp_conn_s
 
   /* TCP-specific content follows */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  struct net_hashnode_s hnode; /* Link in the hash table of the 4-tuples */
+  struct net_hashnode_s pnode; /* Link in the hash table of local ports */
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
@@ -1960,6 +1964,30 @@ void tcp_wrbuffer_dump(FAR const char *msg, FAR struct tcp_wrbuffer_s *wrb,
 #endif
 #endif /* CONFIG_NET_TCP_WRITE_BUFFERS */
 
+/****************************************************************************
+ * Name: tcp_segout
+ *
+ * Description:
+ *   Complete the TCP large send in d_iob, if any.  A large send that
+ *   exceeds the MTU of the device is split into MSS sized segments queued
+ *   to d_tsoout, otherwise its TCP checksum is filled in.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure holding the outgoing packet
+ *
+ * Returned Value:
+ *   OK on success, d_len is zero if the segments were queued.  -ENOMEM if
+ *   the segments could not be allocated, the packet is then dropped.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TSO
+int tcp_segout(FAR struct net_driver_s *dev);
+#endif
+
 /****************************************************************************
  * Name: tcp_pollsetup
  *
@@ -63,6 +63,7 @@
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/tcp.h>
+#include <nuttx/nuttx.h>
 
 #include "devif/devif.h"
 #include "inet/inet.h"
@@ -95,10 +96,109 @@ NET_BUFPOOL_DECLARE(g_tcp_connections, sizeof(struct tcp_conn_s),
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+/* The active connections indexed by their 4-tuple and by their local port,
+ * protected by the lock of the list of active connections.
+ */
+
+NET_HASHTAB_DECLARE(g_tcp_tuplehash, CONFIG_NET_TCP_CONN_HASHSIZE);
+NET_HASHTAB_DECLARE(g_tcp_porthash, CONFIG_NET_TCP_CONN_HASHSIZE);
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+/****************************************************************************
+ * Name: tcp_tuplehash, tcp_porthash
+ *
+ * Description:
+ *   Return the hash of the 4-tuple or of the local port of a connection.
+ *   The local address is not part of the key because the connections
+ *   bound to INADDR_ANY match any local address.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_tuplehash(uint16_t lport, uint16_t rport,
+                              FAR const void *raddr, size_t len)
+{
+  uint32_t hash = net_hash_seed(&g_tcp_tuplehash);
+
+  hash = net_hash_mix(hash, &lport, sizeof(lport));
+  hash = net_hash_mix(hash, &rport, sizeof(rport));
+  return net_hash_mix(hash, raddr, len);
+}
+
+static uint32_t tcp_porthash(uint16_t lport)
+{
+  return net_hash_mix(net_hash_seed(&g_tcp_porthash), &lport,
+                      sizeof(lport));
+}
+
+/****************************************************************************
+ * Name: tcp_tupleconn, tcp_portconn
+ *
+ * Description:
+ *   Return the connection of a node of the 4-tuple or local port table.
+ *
+ ****************************************************************************/
+
+static inline FAR struct tcp_conn_s *
+tcp_tupleconn(FAR struct net_hashnode_s *node)
+{
+  return node != NULL ? container_of(node, struct tcp_conn_s, hnode) : NULL;
+}
+
+static inline FAR struct tcp_conn_s *
+tcp_portconn(FAR struct net_hashnode_s *node)
+{
+  return node != NULL ? container_of(node, struct tcp_conn_s, pnode) : NULL;
+}
+
+/****************************************************************************
+ * Name: tcp_hash_add
+ *
+ * Description:
+ *   Index a connection entering the list of active connections.  Its ports
+ *   and remote address don't change while it is in the list.
+ *
+ * Assumptions:
+ *   The list of active connections is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_hash_add(FAR struct tcp_conn_s *conn)
+{
+  FAR const void *raddr;
+  size_t len;
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      raddr = &conn->u.ipv4.raddr;
+      len   = sizeof(conn->u.ipv4.raddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      raddr = conn->u.ipv6.raddr;
+      len   = sizeof(conn->u.ipv6.raddr);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+  net_hash_add(&g_tcp_tuplehash, &conn->hnode,
+               tcp_tuplehash(conn->lport, conn->rport, raddr, len));
+  net_hash_add(&g_tcp_porthash, &conn->pnode, tcp_porthash(conn->lport));
+}
+#endif /* CONFIG_NET_TCP_CONN_HASH */
+
 /****************************************************************************
  * Name: tcp_listener
  *
@@ -115,11 +215,17 @@ static FAR struct tcp_conn_s *
   tcp_listener(uint8_t domain, FAR const union ip_addr_u *ipaddr,
                uint16_t portno)
 {
-  FAR struct tcp_conn_s *conn = NULL;
+  FAR struct tcp_conn_s *conn;
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
-  while ((conn = tcp_nextconn(conn)) != NULL)
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  conn = tcp_portconn(net_hash_first(&g_tcp_porthash, tcp_porthash(portno)));
+#else
+  conn = tcp_nextconn(NULL);
+#endif
+
+  while (conn != NULL)
     {
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -135,6 +241,12 @@ static FAR struct tcp_conn_s *
         {
           return conn;
         }
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      conn = tcp_portconn(net_hash_next(&conn->pnode));
+#else
+      conn = tcp_nextconn(conn);
+#endif
     }
 
 /* Check if this port number is in use by any listen TCP connection.
@@ -171,10 +283,17 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  conn = tcp_tupleconn(net_hash_first(&g_tcp_tuplehash,
+                       tcp_tuplehash(tcp->destport, tcp->srcport,
+                                     &srcipaddr, sizeof(srcipaddr))));
+#else
+  conn = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -210,7 +329,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      conn = tcp_tupleconn(net_hash_next(&conn->hnode));
+#else
       conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+#endif
     }
 
   return conn;
@@ -238,10 +361,17 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  conn = tcp_tupleconn(net_hash_first(&g_tcp_tuplehash,
+                       tcp_tuplehash(tcp->destport, tcp->srcport,
+                                     *srcipaddr, sizeof(*srcipaddr))));
+#else
+  conn = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -277,7 +407,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      conn = tcp_tupleconn(net_hash_next(&conn->hnode));
+#else
       conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
+#endif
     }
 
   return conn;
@@ -321,7 +455,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
     {
       ret = -EADDRNOTAVAIL;
 
-      netdev_list_lock();
+      netdev_list_rlock();
       for (dev = g_netdevices; dev; dev = dev->flink)
         {
           if (net_ipv4addr_cmp(addr->sin_addr.s_addr, dev->d_ipaddr))
@@ -331,7 +465,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
             }
         }
 
-      netdev_list_unlock();
+      netdev_list_runlock();
 
       if (ret == -EADDRNOTAVAIL)
         {
@@ -416,7 +550,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
     {
       ret = -EADDRNOTAVAIL;
 
-      netdev_list_lock();
+      netdev_list_rlock();
       for (dev = g_netdevices; dev; dev = dev->flink)
         {
           if (NETDEV_IS_MY_V6ADDR(dev, addr->sin6_addr.in6_u.u6_addr16))
@@ -426,7 +560,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
             }
         }
 
-      netdev_list_unlock();
+      netdev_list_runlock();
       if (ret == -EADDRNOTAVAIL)
         {
           return ret;
@@ -813,6 +947,10 @@ void tcp_free(FAR struct tcp_conn_s *conn)
 
       tcp_conn_list_lock();
       dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      net_hash_remove(&g_tcp_tuplehash, &conn->hnode);
+      net_hash_remove(&g_tcp_porthash, &conn->pnode);
+#endif
       tcp_conn_list_unlock();
     }
 
@@ -820,6 +958,12 @@ void tcp_free(FAR struct tcp_conn_s *conn)
 
   tcp_stop_timer(conn);
 
+#ifdef CONFIG_NET_ZEROCOPY
+  /* Discard the MSG_ZEROCOPY completions nobody will read */
+
+  net_zcopy_free(&conn->sconn);
+#endif
+
   nxrmutex_destroy(&conn->sconn.s_lock);
   tcp_free_rx_buffers(conn);
 
@@ -1182,6 +1326,9 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
 
       tcp_conn_list_lock();
       dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONN_HASH
+      tcp_hash_add(conn);
+#endif
       tcp_conn_list_unlock();
 
       tcp_update_retrantimer(conn, TCP_RTO);
@@ -1491,6 +1638,9 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
   tcp_conn_list_lock();
   dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  tcp_hash_add(conn);
+#endif
   tcp_conn_list_unlock();
 
   return OK;
@@ -0,0 +1,422 @@
+/****************************************************************************
+ * net/tcp/tcp_segout.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <net/if.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "devif/devif.h"
+#include "inet/inet.h"
+#include "netdev/netdev.h"
+#include "utils/utils.h"
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_TSO
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The largest IP and TCP headers, both with options */
+
+#define TCP_SEGOUT_MAXHDRLEN  (60 + 60)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_segout_iphdrlen
+ *
+ * Description:
+ *   Return the size of the IP header of the TCP segment in d_iob, or zero
+ *   if d_iob does not hold a TCP segment.
+ *
+ ****************************************************************************/
+
+static uint16_t tcp_segout_iphdrlen(FAR struct net_driver_s *dev)
+{
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      return IPv6BUF->proto == IP_PROTO_TCP ? IPv6_HDRLEN : 0;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+      return ipv4->proto == IP_PROTO_TCP ?
+             (ipv4->vhl & IPv4_HLMASK) << 2 : 0;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_segout_chksum
+ *
+ * Description:
+ *   Fill in the TCP checksum of the segment in d_iob, its IP header must
+ *   be complete.
+ *
+ ****************************************************************************/
+
+static void tcp_segout_chksum(FAR struct net_driver_s *dev,
+                              FAR struct tcp_hdr_s *tcp)
+{
+  tcp->tcpchksum = 0;
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+  tcp->tcpchksum = ~tcp_chksum(dev);
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_segout_enqueue
+ *
+ * Description:
+ *   Queue the TCP segment in d_iob behind the segments of earlier large
+ *   sends still in d_tsoout, so that it does not overtake them.
+ *
+ ****************************************************************************/
+
+static void tcp_segout_enqueue(FAR struct net_driver_s *dev)
+{
+  if (IOB_QEMPTY(&dev->d_tsoout) || devif_is_loopback(dev))
+    {
+      return;
+    }
+
+  /* The segment is sent right away if it can't be queued */
+
+  if (iob_tryadd_queue(dev->d_iob, &dev->d_tsoout) < 0)
+    {
+      return;
+    }
+
+  netdev_iob_clear(dev);
+  netdev_txnotify_dev(dev, TCPSEG_POLL);
+}
+
+/****************************************************************************
+ * Name: tcp_segout_data
+ *
+ * Description:
+ *   Move len bytes from the head of the data chain to the end of the
+ *   segment.  The I/O buffers are moved, only the part of a buffer shared
+ *   with the next segment is copied.
+ *
+ ****************************************************************************/
+
+static int tcp_segout_data(FAR struct iob_s **data, FAR struct iob_s *seg,
+                           uint16_t len)
+{
+  FAR struct iob_s *tail = seg;
+  FAR struct iob_s *iob;
+
+  while (tail->io_flink != NULL)
+    {
+      tail = tail->io_flink;
+    }
+
+  while (len > 0)
+    {
+      iob = *data;
+      DEBUGASSERT(iob != NULL);
+
+      if (iob->io_len <= len)
+        {
+          *data = iob->io_flink;
+          if (*data != NULL)
+            {
+              (*data)->io_pktlen = iob->io_pktlen - iob->io_len;
+            }
+
+          len            -= iob->io_len;
+          seg->io_pktlen += iob->io_len;
+          iob->io_flink   = NULL;
+          tail->io_flink  = iob;
+          tail            = iob;
+        }
+      else
+        {
+          if (iob_trycopyin(seg, IOB_DATA(iob), len, seg->io_pktlen,
+                            false) < 0)
+            {
+              return -ENOMEM;
+            }
+
+          iob->io_offset += len;
+          iob->io_len    -= len;
+          iob->io_pktlen -= len;
+          len             = 0;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tcp_segout_fixup
+ *
+ * Description:
+ *   Adjust the headers copied from the large send to the segment in d_iob:
+ *   the length, the identification and the checksum of the IP header and
+ *   the sequence number, the flags and the checksum of the TCP header.
+ *   The first segment keeps the identification of the large send, the
+ *   others take consecutive ones from ipid.
+ *
+ ****************************************************************************/
+
+static void tcp_segout_fixup(FAR struct net_driver_s *dev,
+                             uint16_t iphdrlen, uint16_t segno,
+                             uint16_t ipid, uint32_t seqno, bool last)
+{
+  FAR struct tcp_hdr_s *tcp = IPBUF(iphdrlen);
+  uint16_t len = dev->d_iob->io_pktlen;
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+
+      ipv6->len[0] = (len - IPv6_HDRLEN) >> 8;
+      ipv6->len[1] = (len - IPv6_HDRLEN) & 0xff;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+      if (segno > 0)
+        {
+          ipid          += segno - 1;
+          ipv4->ipid[0]  = ipid >> 8;
+          ipv4->ipid[1]  = ipid & 0xff;
+        }
+
+      ipv4->len[0]   = len >> 8;
+      ipv4->len[1]   = len & 0xff;
+      ipv4->ipchksum = 0;
+      ipv4->ipchksum = ~ipv4_chksum(ipv4);
+    }
+#endif
+
+  /* FIN and PSH belong to the last segment only */
+
+  tcp_setsequence(tcp->seqno, seqno);
+  if (!last)
+    {
+      tcp->flags &= ~(TCP_FIN | TCP_PSH);
+    }
+
+  tcp_segout_chksum(dev, tcp);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_segout
+ *
+ * Description:
+ *   Complete the TCP large send in d_iob, if any.  A large send that
+ *   exceeds the MTU of the device is split into segments of d_tsomss bytes
+ *   of data, queued to d_tsoout.  Otherwise its TCP checksum, which is not
+ *   computed by tcp_send(), is filled in.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure holding the outgoing packet
+ *
+ * Returned Value:
+ *   OK on success, d_len is zero if the segments were queued.  -ENOMEM if
+ *   the segments could not be allocated, the packet is then dropped.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int tcp_segout(FAR struct net_driver_s *dev)
+{
+  FAR struct iob_s *orig = dev->d_iob;
+  FAR struct iob_s *seg = NULL;
+  FAR struct tcp_hdr_s *tcp;
+  uint8_t hdr[TCP_SEGOUT_MAXHDRLEN];
+  uint16_t mss = dev->d_tsomss;
+  uint16_t iphdrlen;
+  uint16_t hdrlen;
+  uint16_t datalen;
+  uint16_t segno;
+  uint16_t ipid = 0;
+  uint16_t mtu;
+  uint32_t offset;
+  uint32_t seqno;
+  struct iob_queue_s segq =
+    {
+      NULL, NULL
+    };
+
+  dev->d_tsomss = 0;
+  if (orig == NULL || dev->d_len == 0)
+    {
+      return OK;
+    }
+
+  iphdrlen = tcp_segout_iphdrlen(dev);
+  if (iphdrlen == 0)
+    {
+      return OK;
+    }
+
+  /* Any other TCP segment, a small send or a retransmission, follows the
+   * segments still queued.
+   */
+
+  if (mss == 0)
+    {
+      tcp_segout_enqueue(dev);
+      return OK;
+    }
+
+  mtu = devif_get_mtu(dev);
+  if (orig->io_pktlen <= mtu || devif_is_loopback(dev))
+    {
+      tcp_segout_chksum(dev, IPBUF(iphdrlen));
+      tcp_segout_enqueue(dev);
+      return OK;
+    }
+
+  tcp     = IPBUF(iphdrlen);
+  hdrlen  = iphdrlen + ((tcp->tcpoffset >> 4) << 2);
+  datalen = orig->io_pktlen - hdrlen;
+  seqno   = tcp_getsequence(tcp->seqno);
+
+  if (hdrlen + mss > mtu)
+    {
+      mss = mtu - hdrlen;
+    }
+
+  ninfo("Large send: %u bytes, mss %u\n", datalen, mss);
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (!IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      /* The identifications of the segments after the first one */
+
+      ipid = ipv4_reserve_ipid((datalen - 1) / mss);
+    }
+#endif
+
+  /* Each segment is a copy of the headers followed by its slice of the
+   * data, moved from the large send.  It is built in d_iob so that the
+   * checksum helpers apply.
+   */
+
+  DEBUGASSERT(hdrlen <= TCP_SEGOUT_MAXHDRLEN);
+  iob_copyout(hdr, orig, hdrlen, 0);
+  orig = iob_trimhead(orig, hdrlen);
+  netdev_iob_clear(dev);
+
+  for (offset = 0, segno = 0; offset < datalen; offset += mss, segno++)
+    {
+      uint16_t len = MIN(mss, datalen - offset);
+
+      seg = iob_tryalloc(false);
+      if (seg == NULL)
+        {
+          goto errout;
+        }
+
+      iob_reserve(seg, CONFIG_NET_LL_GUARDSIZE);
+
+      if (iob_trycopyin(seg, hdr, hdrlen, 0, false) < 0 ||
+          tcp_segout_data(&orig, seg, len) < 0)
+        {
+          goto errout;
+        }
+
+      dev->d_iob = seg;
+      tcp_segout_fixup(dev, iphdrlen, segno, ipid, seqno + offset,
+                       offset + len >= datalen);
+      netdev_iob_clear(dev);
+
+      if (iob_tryadd_queue(seg, &segq) < 0)
+        {
+          goto errout;
+        }
+    }
+
+  iob_free_chain(orig);
+  iob_concat_queue(&dev->d_tsoout, &segq);
+
+#ifdef CONFIG_NET_STATISTICS
+  g_netstats.tcp.sent += segno - 1;
+#endif
+
+  dev->d_len = 0;
+  netdev_txnotify_dev(dev, TCPSEG_POLL);
+  return OK;
+
+errout:
+  nerr("ERROR: No I/O buffer for the TCP segments\n");
+  netdev_iob_clear(dev);
+  iob_free_chain(seg);
+  iob_free_chain(orig);
+  iob_free_queue(&segq);
+  dev->d_len = 0;
+  return -ENOMEM;
+}
+
+#endif /* CONFIG_NET_TCP_TSO */
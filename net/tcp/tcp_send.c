@@ -200,7 +200,14 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
       tcp->tcpchksum = 0;
 
 #ifdef CONFIG_NET_TCP_CHECKSUMS
-      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+#  ifdef CONFIG_NET_TCP_TSO
+      /* The checksum of a large send is computed by tcp_segout() */
+
+      if (dev->d_tsomss == 0)
+#  endif
+        {
+          tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+        }
 #endif
 
 #ifdef CONFIG_NET_STATISTICS
@@ -224,7 +231,14 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
       tcp->tcpchksum = 0;
 
 #ifdef CONFIG_NET_TCP_CHECKSUMS
-      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+#  ifdef CONFIG_NET_TCP_TSO
+      /* The checksum of a large send is computed by tcp_segout() */
+
+      if (dev->d_tsomss == 0)
+#  endif
+        {
+          tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+        }
 #endif
 
 #ifdef CONFIG_NET_STATISTICS
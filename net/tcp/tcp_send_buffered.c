@@ -36,6 +36,7 @@
 #  define CONFIG_DEBUG_NET 1
 #endif
 
+#include <sys/param.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 
@@ -411,6 +412,30 @@ static int parse_sack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp,
 }
 #endif /* CONFIG_NET_TCP_SELECTIVE_ACK */
 
+/****************************************************************************
+ * Name: tcp_send_segsize
+ *
+ * Description:
+ *   Return the largest amount of data sent in one packet: the MSS, or a
+ *   multiple of it if the packet can be segmented by tcp_segout().
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_send_segsize(FAR struct net_driver_s *dev,
+                                 FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_TCP_TSO
+  if (dev->d_lltype == NET_LL_ETHERNET ||
+      dev->d_lltype == NET_LL_IEEE80211)
+    {
+      return MAX(conn->mss,
+                 CONFIG_NET_TCP_TSO_MAXSIZE / conn->mss * conn->mss);
+    }
+#endif
+
+  return conn->mss;
+}
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -1062,9 +1087,9 @@ static uint32_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           int ret;
 
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-          if (sndlen > conn->mss)
+          if (sndlen > tcp_send_segsize(dev, conn))
             {
-              sndlen = conn->mss;
+              sndlen = tcp_send_segsize(dev, conn);
             }
 
           remaining_snd_wnd = TCP_SEQ_SUB(snd_wnd_edge, seq);
@@ -1089,6 +1114,21 @@ static uint32_t psock_send_eventhandler(FAR struct net_driver_s *dev,
               sndlen = CONFIG_IOB_BUFSIZE;
             }
 
+#ifdef CONFIG_NET_TCP_TSO
+          /* The data of a large send is moved to its segments, but each
+           * segment takes an I/O buffer for its headers and may take one
+           * more for the data it shares with the next segment.
+           */
+
+          if (sndlen > conn->mss &&
+              (sndlen + CONFIG_IOB_BUFSIZE - 1) / CONFIG_IOB_BUFSIZE +
+              2 * ((sndlen + conn->mss - 1) / conn->mss) >
+              iob_navail(false))
+            {
+              sndlen = conn->mss;
+            }
+#endif
+
           ninfo("SEND: wrb=%p seq=%" PRIu32 " pktlen=%u sent=%u sndlen=%zu "
                 "mss=%u snd_wnd=%" PRIu32 " seq=%" PRIu32
                 " remaining_snd_wnd=%" PRIu32 "\n",
@@ -1128,10 +1168,17 @@ static uint32_t psock_send_eventhandler(FAR struct net_driver_s *dev,
             }
 #endif
 
+#ifdef CONFIG_NET_TCP_TSO
+          dev->d_tsomss = sndlen > conn->mss ? conn->mss : 0;
+#endif
+
           ret = devif_iob_send(dev, TCP_WBIOB(wrb), sndlen,
                                TCP_WBSENT(wrb), tcpip_hdrsize(conn));
           if (ret <= 0)
             {
+#ifdef CONFIG_NET_TCP_TSO
+              dev->d_tsomss = 0;
+#endif
               return flags;
             }
 
@@ -1223,6 +1270,15 @@ static uint32_t tcp_max_wrb_size(FAR struct tcp_conn_s *conn)
 
   size = 4 * mss;
 
+#ifdef CONFIG_NET_TCP_TSO
+  /* or a whole large send */
+
+  if (size < CONFIG_NET_TCP_TSO_MAXSIZE)
+    {
+      size = CONFIG_NET_TCP_TSO_MAXSIZE;
+    }
+#endif
+
   /* but it should not hog too many IOB buffers */
 
   if (size > CONFIG_IOB_NBUFFERS * CONFIG_IOB_BUFSIZE / 2)
@@ -1336,6 +1392,9 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 {
   FAR struct tcp_conn_s *conn;
   FAR struct tcp_wrbuffer_s *wrb;
+#ifdef CONFIG_NET_ZEROCOPY
+  FAR struct net_zcopy_s *zcopy = NULL;
+#endif
   FAR const uint8_t *cp;
   unsigned int timeout;
   ssize_t    result = 0;
@@ -1403,6 +1462,21 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
   start    = clock_systime_ticks();
   timeout  = _SO_TIMEOUT(conn->sconn.s_sndtimeo);
 
+#ifdef CONFIG_NET_ZEROCOPY
+  /* The write buffers reference the user data until it is acknowledged */
+
+  if ((flags & MSG_ZEROCOPY) != 0 &&
+      _SO_GETOPT(conn->sconn.s_options, SO_ZEROCOPY))
+    {
+      zcopy = net_zcopy_alloc(&conn->sconn);
+      if (zcopy == NULL)
+        {
+          ret = -ENOBUFS;
+          goto errout;
+        }
+    }
+#endif
+
   /* Dump the incoming buffer */
 
   BUF_DUMP("psock_tcp_send", buf, len);
@@ -1566,8 +1640,8 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
               chunk_len = max_wrb_size - off;
             }
 
-          /* Copy the user data into the write buffer.  We cannot wait for
-           * buffer space.
+          /* Copy the user data into the write buffer, or reference it with
+           * MSG_ZEROCOPY.  We cannot wait for buffer space.
            */
 
           /* The return value from TCP_WBTRYCOPYIN is either OK or
@@ -1578,7 +1652,18 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
            * remaining data.
            */
 
-          chunk_result = TCP_WBTRYCOPYIN(wrb, cp, chunk_len, off);
+#ifdef CONFIG_NET_ZEROCOPY
+          if (zcopy != NULL)
+            {
+              chunk_result = net_zcopy_copyin(zcopy, TCP_WBIOB(wrb), cp,
+                                              chunk_len);
+            }
+          else
+#endif
+            {
+              chunk_result = TCP_WBTRYCOPYIN(wrb, cp, chunk_len, off);
+            }
+
           if (chunk_result == -ENOMEM)
             {
               if (TCP_WBPKTLEN(wrb) > 0)
@@ -1705,6 +1790,13 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
       goto errout;
     }
 
+#ifdef CONFIG_NET_ZEROCOPY
+  if (zcopy != NULL)
+    {
+      net_zcopy_done(zcopy, true);
+    }
+#endif
+
   /* Return the number of bytes actually sent */
 
   return result;
@@ -1713,6 +1805,13 @@ errout_with_lock:
   conn_dev_unlock(&conn->sconn, conn->dev);
 
 errout:
+#ifdef CONFIG_NET_ZEROCOPY
+  if (zcopy != NULL)
+    {
+      net_zcopy_done(zcopy, result > 0);
+    }
+#endif
+
   if (result > 0)
     {
       return result;
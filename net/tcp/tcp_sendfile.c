@@ -61,6 +61,24 @@
 #if defined(CONFIG_NET_SENDFILE) && defined(CONFIG_NET_TCP) && \
     defined(NET_TCP_HAVE_STACK)
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+#  define SENDFILE_REF(d,p)  (sendfile_loopback(d, (p)->snd_conn) ? \
+                              NULL : (p)->snd_ref)
+
+/* Once sendfile() is done, the I/O buffers still referencing the file data
+ * are only held by the lower layers, e.g. queued to a driver.  They are not
+ * waited for longer than this before being left to unmap the data.
+ */
+
+#  define SENDFILE_REF_TIMEOUT  MSEC2TICK(1000)
+#else
+#  define SENDFILE_REF(d,p)  NULL
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -91,12 +109,49 @@ struct sendfile_s
 #endif
   int                snd_dup_acks;         /* Duplicate ACK counter */
 #endif
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  FAR struct devif_fileref_s *snd_ref;     /* References to the file data */
+#endif
 };
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: sendfile_loopback
+ *
+ * Description:
+ *   Return true if the packets of a connection are looped back to ourself.
+ *   They stay queued in the receiving socket until it is read, so they
+ *   must not reference the file data: sendfile() would wait for them.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+static bool sendfile_loopback(FAR struct net_driver_s *dev,
+                              FAR struct tcp_conn_s *conn)
+{
+  if (dev->d_lltype == NET_LL_LOOPBACK)
+    {
+      return true;
+    }
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (conn->domain == PF_INET6)
+#endif
+    {
+      return NETDEV_IS_MY_V6ADDR(dev, conn->u.ipv6.raddr);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+  return net_ipv4addr_cmp(conn->u.ipv4.raddr, dev->d_ipaddr);
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: sendfile_eventhandler
  *
@@ -272,7 +327,7 @@ static uint32_t sendfile_eventhandler(FAR struct net_driver_s *dev,
 
       ret = devif_file_send(dev, pstate->snd_file, sndlen,
                             pstate->snd_foffset + pstate->snd_acked,
-                            tcpip_hdrsize(conn));
+                            tcpip_hdrsize(conn), SENDFILE_REF(dev, pstate));
       if (ret < 0)
         {
           nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
@@ -343,7 +398,8 @@ static uint32_t sendfile_eventhandler(FAR struct net_driver_s *dev,
 
           ret = devif_file_send(dev, pstate->snd_file, sndlen,
                                 pstate->snd_foffset + pstate->snd_sent,
-                                tcpip_hdrsize(conn));
+                                tcpip_hdrsize(conn),
+                                SENDFILE_REF(dev, pstate));
           if (ret < 0)
             {
               nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
@@ -476,11 +532,20 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
    * ready.
    */
 
+  memset(&state, 0, sizeof(struct sendfile_s));
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  /* Map the file data, if it can be sent without copying it, before the
+   * network is locked.
+   */
+
+  state.snd_ref = devif_fileref_alloc(infile, offset ? *offset : startpos,
+                                      count);
+#endif
+
   conn_dev_lock(&conn->sconn, conn->dev);
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   conn->sendfile = true;
 #endif
-  memset(&state, 0, sizeof(struct sendfile_s));
   nxsem_init(&state.snd_sem, 0, 0);                /* Doesn't really fail */
 
   state.snd_conn    = conn;                        /* Tcp conn to use */
@@ -549,6 +614,17 @@ errout_locked:
 #endif
   conn_dev_unlock(&conn->sconn, conn->dev);
 
+#ifdef CONFIG_NET_SENDFILE_ZEROCOPY
+  /* The file data may still be referenced by I/O buffers queued for
+   * transmission.
+   */
+
+  if (state.snd_ref != NULL)
+    {
+      devif_fileref_wait(state.snd_ref, SENDFILE_REF_TIMEOUT);
+    }
+#endif
+
   /* Return the current file position */
 
   if (offset)
@@ -110,6 +110,9 @@ struct udp_conn_s
 
   /* UDP-specific content follows */
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  struct net_hashnode_s pnode; /* Link in the hash table of local ports */
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
@@ -175,6 +178,9 @@ struct udp_wrbuffer_s
   sq_entry_t wb_node;              /* Supports a singly linked list */
   struct sockaddr_storage wb_dest; /* Destination address */
   FAR struct iob_s *wb_iob;        /* Head of the I/O buffer chain */
+#ifdef CONFIG_NET_ZEROCOPY
+  FAR struct net_zcopy_s *wb_zcopy; /* MSG_ZEROCOPY send, until queued */
+#endif
 };
 #endif
 
@@ -253,6 +259,21 @@ FAR struct udp_conn_s *udp_active(FAR struct net_driver_s *dev,
 
 FAR struct udp_conn_s *udp_nextconn(FAR struct udp_conn_s *conn);
 
+/****************************************************************************
+ * Name: udp_rehash
+ *
+ * Description:
+ *   Move the connection to the hash bucket of its local port.  Must be
+ *   called when lport has been changed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_CONN_HASH
+void udp_rehash(FAR struct udp_conn_s *conn);
+#else
+#  define udp_rehash(conn)
+#endif
+
 /****************************************************************************
  * Name: udp_conn_list_lock
  *
@@ -767,6 +788,30 @@ void udp_callback_cleanup(FAR void *arg);
 ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
                            int flags);
 
+/****************************************************************************
+ * Name: psock_udp_recvmmsg
+ *
+ * Description:
+ *   Perform the recvmmsg operation for a UDP SOCK_DGRAM: receive the first
+ *   datagram as psock_udp_recvfrom() does, then the datagrams already
+ *   queued in the read-ahead buffers, with the connection locked once.
+ *
+ * Input Parameters:
+ *   psock    Pointer to the socket structure for the SOCK_DRAM socket
+ *   msgvec   Receive info and buffers for the datagrams, each one with a
+ *            single I/O vector
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of datagrams received.  On  error,
+ *   -errno is returned (see recvfrom for list of errnos).
+ *
+ ****************************************************************************/
+
+int psock_udp_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                       unsigned int vlen, int flags);
+
 /****************************************************************************
  * Name: psock_udp_sendto
  *
@@ -796,6 +841,32 @@ ssize_t psock_udp_sendto(FAR struct socket *psock,
                          FAR const void *buf, size_t len, int flags,
                          FAR const struct sockaddr *to, socklen_t tolen);
 
+/****************************************************************************
+ * Name: psock_udp_sendmmsg
+ *
+ * Description:
+ *   Send a vector of datagrams: they are queued to the write buffers with
+ *   the connection locked once, and the device is notified once.  Only the
+ *   first datagram may wait for a write buffer.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   The datagrams to send, each one with a single I/O vector and
+ *            a valid destination address, if any
+ *   vlen     The number of messages in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of datagrams sent.  On  error, a
+ *   negated errno value is returned (see sendto()).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_WRITE_BUFFERS
+int psock_udp_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                       unsigned int vlen, int flags);
+#endif
+
 /****************************************************************************
  * Name: udp_pollsetup
  *
@@ -64,6 +64,7 @@
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/udp.h>
+#include <nuttx/nuttx.h>
 
 #include "devif/devif.h"
 #include "inet/inet.h"
@@ -96,10 +97,68 @@ NET_BUFPOOL_DECLARE(g_udp_connections, sizeof(struct udp_conn_s),
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+/* The bound connections indexed by their local port, protected by the lock
+ * of the list of connections.
+ */
+
+NET_HASHTAB_DECLARE(g_udp_porthash, CONFIG_NET_UDP_CONN_HASHSIZE);
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: udp_porthash
+ *
+ * Description:
+ *   Return the hash of a local port.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_CONN_HASH
+static uint32_t udp_porthash(uint16_t lport)
+{
+  return net_hash_mix(net_hash_seed(&g_udp_porthash), &lport,
+                      sizeof(lport));
+}
+#endif
+
+/****************************************************************************
+ * Name: udp_nextport
+ *
+ * Description:
+ *   Traverse the connections that may be bound to the local port portno
+ *   (network byte order).  This is all the connections unless they are
+ *   hashed.
+ *
+ * Assumptions:
+ *   The list of connections is locked.
+ *
+ ****************************************************************************/
+
+static FAR struct udp_conn_s *udp_nextport(FAR struct udp_conn_s *conn,
+                                           uint16_t portno)
+{
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  FAR struct net_hashnode_s *node;
+
+  if (conn == NULL)
+    {
+      node = net_hash_first(&g_udp_porthash, udp_porthash(portno));
+    }
+  else
+    {
+      node = net_hash_next(&conn->pnode);
+    }
+
+  return node != NULL ? container_of(node, struct udp_conn_s, pnode) : NULL;
+#else
+  return udp_nextconn(conn);
+#endif
+}
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
@@ -130,7 +189,7 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
   /* Now search each connection structure. */
 
   udp_conn_list_lock();
-  while ((conn = udp_nextconn(conn)) != NULL)
+  while ((conn = udp_nextport(conn, portno)) != NULL)
     {
       /* With SO_REUSEADDR set for both sockets, we do not need to check its
        * address and port.
@@ -204,7 +263,7 @@ udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 #endif
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
 
-  conn = udp_nextconn(conn);
+  conn = udp_nextport(conn, udp->destport);
 
   while (conn)
     {
@@ -318,7 +377,7 @@ udp_ipv4_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 
       /* Look at the next active connection */
 
-      conn = udp_nextconn(conn);
+      conn = udp_nextport(conn, udp->destport);
     }
 
   return conn;
@@ -344,7 +403,7 @@ udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 {
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
 
-  conn = udp_nextconn(conn);
+  conn = udp_nextport(conn, udp->destport);
 
   while (conn != NULL)
     {
@@ -458,7 +517,7 @@ udp_ipv6_active(FAR struct net_driver_s *dev, FAR struct udp_conn_s *conn,
 
       /* Look at the next active connection */
 
-      conn = udp_nextconn(conn);
+      conn = udp_nextport(conn, udp->destport);
     }
 
   return conn;
@@ -611,6 +670,16 @@ void udp_free(FAR struct udp_conn_s *conn)
   /* Remove the connection from the active list */
 
   dq_rem(&conn->sconn.node, &g_active_udp_connections);
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  net_hash_remove(&g_udp_porthash, &conn->pnode);
+#endif
+
+#ifdef CONFIG_NET_ZEROCOPY
+  /* Discard the MSG_ZEROCOPY completions nobody will read */
+
+  net_zcopy_free(&conn->sconn);
+#endif
+
   nxrmutex_destroy(&conn->sconn.s_lock);
 
   /* Release any read-ahead buffers attached to the connection, NULL is ok */
@@ -712,6 +781,29 @@ void udp_conn_list_unlock(void)
   NET_BUFPOOL_UNLOCK(g_udp_connections);
 }
 
+/****************************************************************************
+ * Name: udp_rehash
+ *
+ * Description:
+ *   Move the connection to the hash bucket of its local port after lport
+ *   has been changed.  The connection is only hashed while it is bound.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_CONN_HASH
+void udp_rehash(FAR struct udp_conn_s *conn)
+{
+  udp_conn_list_lock();
+  net_hash_remove(&g_udp_porthash, &conn->pnode);
+  if (conn->lport != 0)
+    {
+      net_hash_add(&g_udp_porthash, &conn->pnode, udp_porthash(conn->lport));
+    }
+
+  udp_conn_list_unlock();
+}
+#endif
+
 /****************************************************************************
  * Name: udp_nextconn
  *
@@ -781,7 +873,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           ret = -EADDRNOTAVAIL;
 
-          netdev_list_lock();
+          netdev_list_rlock();
           for (dev = g_netdevices; dev; dev = dev->flink)
             {
               if (net_ipv4addr_cmp(inaddr->sin_addr.s_addr, dev->d_ipaddr))
@@ -791,7 +883,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
                 }
             }
 
-          netdev_list_unlock();
+          netdev_list_runlock();
           if (ret == -EADDRNOTAVAIL)
             {
               conn_unlock(&conn->sconn);
@@ -830,7 +922,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           ret = -EADDRNOTAVAIL;
 
-          netdev_list_lock();
+          netdev_list_rlock();
           for (dev = g_netdevices; dev; dev = dev->flink)
             {
               if (NETDEV_IS_MY_V6ADDR(dev,
@@ -841,7 +933,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
                 }
             }
 
-          netdev_list_unlock();
+          netdev_list_runlock();
           if (ret == -EADDRNOTAVAIL)
             {
               conn_unlock(&conn->sconn);
@@ -910,6 +1002,11 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         }
     }
 
+  if (ret == OK)
+    {
+      udp_rehash(conn);
+    }
+
   conn_unlock(&conn->sconn);
   return ret;
 }
@@ -959,6 +1056,8 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
           nerr("ERROR: Failed to get a local port!\n");
           return -EADDRINUSE;
         }
+
+      udp_rehash(conn);
     }
 
   /* Is there a remote port (rport)? */
@@ -100,6 +100,13 @@ static uint32_t udp_poll_eventhandler(FAR struct net_driver_s *dev,
           eventset |= POLLOUT;
         }
 
+#ifdef CONFIG_NET_ZEROCOPY
+      if (net_zcopy_pending(&info->conn->sconn))
+        {
+          eventset |= POLLERR;
+        }
+#endif
+
       /* Awaken the caller of poll() is requested event occurred. */
 
       poll_notify(&info->fds, 1, eventset);
@@ -195,6 +202,10 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
   cb->priv  = info;
   cb->event = udp_poll_eventhandler;
 
+#ifdef CONFIG_NET_ZEROCOPY
+  cb->flags |= ZCOPY_DONE;
+#endif
+
   if ((fds->events & POLLOUT) != 0)
     {
       cb->flags |= UDP_POLL;
@@ -227,6 +238,15 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       eventset |= POLLWRNORM;
     }
 
+#ifdef CONFIG_NET_ZEROCOPY
+  /* MSG_ZEROCOPY completions are read from the error queue */
+
+  if (net_zcopy_pending(&conn->sconn))
+    {
+      eventset |= POLLERR;
+    }
+#endif
+
   /* Check if any requested events are already in effect */
 
   poll_notify(&fds, 1, eventset);
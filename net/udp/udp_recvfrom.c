@@ -653,58 +653,38 @@ static void udp_notify_recvcpu(FAR struct udp_conn_s *conn)
 #endif /* CONFIG_NETDEV_RSS */
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: psock_udp_recvfrom
+ * Name: udp_recvfrom_locked
  *
  * Description:
- *   Perform the recvfrom operation for a UDP SOCK_DGRAM
+ *   Receive a datagram into msg, the connection and the device being
+ *   locked by the caller.
  *
  * Input Parameters:
- *   psock  Pointer to the socket structure for the SOCK_DRAM socket
+ *   conn   The UDP connection
+ *   dev    The device of the bound address of conn, or NULL
  *   msg    Receive info and buffer for receive data
+ *   flags  Receive flags
  *
  * Returned Value:
  *   On success, returns the number of characters received.  On  error,
  *   -errno is returned (see recvfrom for list of errnos).
  *
- * Assumptions:
- *
  ****************************************************************************/
 
-ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
-                           int flags)
+static ssize_t udp_recvfrom_locked(FAR struct udp_conn_s *conn,
+                                   FAR struct net_driver_s *dev,
+                                   FAR struct msghdr *msg, int flags)
 {
-  FAR struct udp_conn_s *conn = psock->s_conn;
-  FAR struct net_driver_s *dev;
   struct udp_callback_s info;
   struct udp_recvfrom_s state;
   ssize_t ret;
 
-  /* Perform the UDP recvfrom() operation */
-
-  if (msg->msg_iovlen != 1)
-    {
-      return -ENOTSUP;
-    }
-
   /* Initialize the state structure.  This is done with the network locked
    * because we don't want anything to happen until we are ready.
    */
 
   udp_recvfrom_initialize(conn, msg, &state, flags);
 
-  /* Get the device that will handle the packet transfers.  This may be
-   * NULL if the UDP socket is bound to INADDR_ANY.  In that case, no
-   * NETDEV_DOWN notifications will be received.
-   */
-
-  dev = udp_find_laddr_device(conn);
-
-  conn_dev_lock(&conn->sconn, dev);
-
   /* Copy the read-ahead data from the packet */
 
   udp_readahead(&state);
@@ -789,11 +769,111 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
         }
     }
 
+  udp_recvfrom_uninitialize(&state);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_udp_recvfrom
+ *
+ * Description:
+ *   Perform the recvfrom operation for a UDP SOCK_DGRAM
+ *
+ * Input Parameters:
+ *   psock  Pointer to the socket structure for the SOCK_DRAM socket
+ *   msg    Receive info and buffer for receive data
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On  error,
+ *   -errno is returned (see recvfrom for list of errnos).
+ *
+ * Assumptions:
+ *
+ ****************************************************************************/
+
+ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
+                           int flags)
+{
+  FAR struct udp_conn_s *conn = psock->s_conn;
+  FAR struct net_driver_s *dev;
+  ssize_t ret;
+
+  /* Perform the UDP recvfrom() operation */
+
+  if (msg->msg_iovlen != 1)
+    {
+      return -ENOTSUP;
+    }
+
+  /* Get the device that will handle the packet transfers.  This may be
+   * NULL if the UDP socket is bound to INADDR_ANY.  In that case, no
+   * NETDEV_DOWN notifications will be received.
+   */
+
+  dev = udp_find_laddr_device(conn);
+
+  conn_dev_lock(&conn->sconn, dev);
+  ret = udp_recvfrom_locked(conn, dev, msg, flags);
   conn_dev_unlock(&conn->sconn, dev);
-  udp_notify_recvcpu(conn);
 
-  udp_recvfrom_uninitialize(&state);
+  udp_notify_recvcpu(conn);
   return ret;
 }
 
+/****************************************************************************
+ * Name: psock_udp_recvmmsg
+ *
+ * Description:
+ *   Perform the recvmmsg operation for a UDP SOCK_DGRAM: receive the first
+ *   datagram as psock_udp_recvfrom() does, then the datagrams already
+ *   queued in the read-ahead buffers, with the connection locked once.
+ *
+ * Input Parameters:
+ *   psock   Pointer to the socket structure for the SOCK_DRAM socket
+ *   msgvec  Receive info and buffers for the datagrams, each one with a
+ *           single I/O vector
+ *   vlen    The number of messages in msgvec
+ *   flags   Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of datagrams received.  On  error,
+ *   -errno is returned (see recvfrom for list of errnos).
+ *
+ ****************************************************************************/
+
+int psock_udp_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                       unsigned int vlen, int flags)
+{
+  FAR struct udp_conn_s *conn = psock->s_conn;
+  FAR struct net_driver_s *dev;
+  unsigned int count = 0;
+  ssize_t ret;
+
+  dev = udp_find_laddr_device(conn);
+
+  conn_dev_lock(&conn->sconn, dev);
+
+  do
+    {
+      ret = udp_recvfrom_locked(conn, dev, &msgvec[count].msg_hdr, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[count].msg_len = ret;
+      flags |= MSG_DONTWAIT;
+    }
+  while (++count < vlen);
+
+  conn_dev_unlock(&conn->sconn, dev);
+
+  udp_notify_recvcpu(conn);
+  return count > 0 ? count : ret;
+}
+
 #endif /* CONFIG_NET && CONFIG_NET_UDP */
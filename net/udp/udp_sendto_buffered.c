@@ -275,6 +275,8 @@ static int sendto_next_transfer(FAR struct udp_conn_s *conn)
           nerr("ERROR: Failed to get a local port!\n");
           return -EADDRINUSE;
         }
+
+      udp_rehash(conn);
     }
 
   /* Get the device that will handle the remote packet transfers.  This
@@ -536,15 +538,11 @@ static unsigned int udp_send_gettimeout(clock_t start, unsigned int timeout)
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: psock_udp_sendto
+ * Name: sendto_prepare
  *
  * Description:
- *   This function implements the UDP-specific logic of the standard
- *   sendto() socket operation.
+ *   Allocate a write buffer holding the datagram to send, ready to be
+ *   queued with sendto_queue().
  *
  * Input Parameters:
  *   psock    A pointer to a NuttX-specific, internal socket structure
@@ -553,27 +551,28 @@ static unsigned int udp_send_gettimeout(clock_t start, unsigned int timeout)
  *   flags    Send flags
  *   to       Address of recipient
  *   tolen    The length of the address structure
- *
- *   NOTE: All input parameters were verified by sendto() before this
- *   function was called.
+ *   wrbp     Location to return the write buffer
  *
  * Returned Value:
- *   On success, returns the number of characters sent.  On  error,
- *   a negated errno value is returned.  See the description in
- *   net/socket/sendto.c for the list of appropriate return value.
+ *   On success, returns the number of characters to send.  On  error,
+ *   a negated errno value is returned.
  *
  ****************************************************************************/
 
-ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
-                         size_t len, int flags,
-                         FAR const struct sockaddr *to, socklen_t tolen)
+static ssize_t sendto_prepare(FAR struct socket *psock, FAR const void *buf,
+                              size_t len, int flags,
+                              FAR const struct sockaddr *to,
+                              socklen_t tolen,
+                              FAR struct udp_wrbuffer_s **wrbp)
 {
   FAR struct udp_wrbuffer_s *wrb;
   FAR struct udp_conn_s *conn;
+#ifdef CONFIG_NET_ZEROCOPY
+  FAR struct net_zcopy_s *zcopy = NULL;
+#endif
   unsigned int timeout;
   uint16_t udpiplen;
   bool nonblock;
-  bool empty;
   int ret = OK;
   clock_t start;
 
@@ -831,7 +830,31 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 
   udpiplen = udpip_hdrsize(conn);
 
-  iob_reserve(wrb->wb_iob, CONFIG_NET_LL_GUARDSIZE);
+#ifdef CONFIG_NET_ZEROCOPY
+  /* With MSG_ZEROCOPY, the I/O buffers reference the user data until the
+   * datagram is sent.  The headers then end at the end of the first I/O
+   * buffer, so that its length is kept when the packet length is updated
+   * by the lower layers.
+   */
+
+  if (len > 0 && (flags & MSG_ZEROCOPY) != 0 &&
+      _SO_GETOPT(conn->sconn.s_options, SO_ZEROCOPY))
+    {
+      zcopy = net_zcopy_alloc(&conn->sconn);
+      if (zcopy == NULL)
+        {
+          ret = -ENOBUFS;
+          goto errout_with_wrb;
+        }
+
+      iob_reserve(wrb->wb_iob, IOB_BUFSIZE(wrb->wb_iob) - udpiplen);
+    }
+  else
+#endif
+    {
+      iob_reserve(wrb->wb_iob, CONFIG_NET_LL_GUARDSIZE);
+    }
+
   iob_update_pktlen(wrb->wb_iob, udpiplen, false);
 
   /* Copy the user data into the write buffer.  We cannot wait for
@@ -840,6 +863,13 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 
   if (len > 0)
     {
+#ifdef CONFIG_NET_ZEROCOPY
+      if (zcopy != NULL)
+        {
+          ret = net_zcopy_copyin(zcopy, wrb->wb_iob, buf, len);
+        }
+      else
+#endif
       if (nonblock)
         {
           ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf,
@@ -861,6 +891,54 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 
   UDP_WBDUMP("I/O buffer chain", wrb, wrb->wb_iob->io_pktlen, 0);
 
+#ifdef CONFIG_NET_ZEROCOPY
+  /* The send is ended by sendto_queue(), once the datagram is queued */
+
+  wrb->wb_zcopy = zcopy;
+#endif
+
+  *wrbp = wrb;
+  return len;
+
+errout_with_wrb:
+  udp_wrbuffer_release(wrb);
+
+#ifdef CONFIG_NET_ZEROCOPY
+  if (zcopy != NULL)
+    {
+      net_zcopy_done(zcopy, false);
+    }
+#endif
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: sendto_queue
+ *
+ * Description:
+ *   Queue the write buffers prepared by sendto_prepare() and start their
+ *   transfer if the write queue was empty.
+ *
+ * Input Parameters:
+ *   conn     The UDP connection
+ *   queue    The write buffers, released if they could not be queued
+ *
+ * Returned Value:
+ *   OK on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static int sendto_queue(FAR struct udp_conn_s *conn,
+                        FAR sq_queue_t *queue)
+{
+  FAR struct udp_wrbuffer_s *wrb;
+#ifdef CONFIG_NET_ZEROCOPY
+  FAR sq_entry_t *node;
+#endif
+  bool empty;
+  int ret = OK;
+
   /* sendto_eventhandler() will send data in FIFO order from the
    * conn->write_q.
    *
@@ -875,14 +953,16 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
   conn_lock(&conn->sconn);
   empty = sq_empty(&conn->write_q);
 
-  sq_addlast(&wrb->wb_node, &conn->write_q);
-  ninfo("Queued WRB=%p pktlen=%u write_q(%p,%p)\n",
-        wrb, wrb->wb_iob->io_pktlen,
-        conn->write_q.head, conn->write_q.tail);
+#ifdef CONFIG_NET_ZEROCOPY
+  node = sq_peek(queue);
+#endif
+
+  sq_cat(queue, &conn->write_q);
+  ninfo("Queued write_q(%p,%p)\n", conn->write_q.head, conn->write_q.tail);
 
   if (empty)
     {
-      /* The new write buffer lies at the head of the write queue.  Set
+      /* The new write buffers lie at the head of the write queue.  Set
        * up for the next packet transfer by setting the connection
        * address to the address of the next packet now at the header of
        * the write buffer queue.
@@ -891,22 +971,162 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
       ret = sendto_next_transfer(conn);
       if (ret < 0)
         {
-          sq_remlast(&conn->write_q);
-          conn_unlock(&conn->sconn);
-          goto errout_with_wrb;
+          sq_move(&conn->write_q, queue);
         }
+    }
+
+#ifdef CONFIG_NET_ZEROCOPY
+  /* End the MSG_ZEROCOPY sends in the order they are queued, only the
+   * datagrams actually queued are reported.  The write buffers cannot be
+   * sent and released before the connection is unlocked.
+   */
+
+  for (; node != NULL; node = sq_next(node))
+    {
+      wrb = (FAR struct udp_wrbuffer_s *)node;
+      if (wrb->wb_zcopy != NULL)
+        {
+          net_zcopy_done(wrb->wb_zcopy, ret >= 0);
+          wrb->wb_zcopy = NULL;
+        }
+    }
+#endif
+
+  conn_unlock(&conn->sconn);
+
+  while ((wrb = (FAR struct udp_wrbuffer_s *)sq_remfirst(queue)) != NULL)
+    {
+      udp_wrbuffer_release(wrb);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_udp_sendto
+ *
+ * Description:
+ *   This function implements the UDP-specific logic of the standard
+ *   sendto() socket operation.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   buf      Data to send
+ *   len      Length of data to send
+ *   flags    Send flags
+ *   to       Address of recipient
+ *   tolen    The length of the address structure
+ *
+ *   NOTE: All input parameters were verified by sendto() before this
+ *   function was called.
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error,
+ *   a negated errno value is returned.  See the description in
+ *   net/socket/sendto.c for the list of appropriate return value.
+ *
+ ****************************************************************************/
+
+ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
+                         size_t len, int flags,
+                         FAR const struct sockaddr *to, socklen_t tolen)
+{
+  FAR struct udp_wrbuffer_s *wrb;
+  sq_queue_t queue;
+  ssize_t ret;
 
-      conn_unlock(&conn->sconn);
+  ret = sendto_prepare(psock, buf, len, flags, to, tolen, &wrb);
+  if (ret < 0)
+    {
+      return ret;
     }
 
+  sq_init(&queue);
+  sq_addlast(&wrb->wb_node, &queue);
+
+  ret = sendto_queue(psock->s_conn, &queue);
+
   /* Return the number of bytes that will be sent */
 
-  return len;
+  return ret < 0 ? ret : len;
+}
 
-errout_with_wrb:
-  udp_wrbuffer_release(wrb);
+/****************************************************************************
+ * Name: psock_udp_sendmmsg
+ *
+ * Description:
+ *   Send a vector of datagrams: they are queued to the write buffers with
+ *   the connection locked once, and the device is notified once.  Only the
+ *   first datagram may wait for a write buffer.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   The datagrams to send, each one with a single I/O vector and
+ *            a valid destination address, if any
+ *   vlen     The number of messages in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of datagrams sent.  On  error, a
+ *   negated errno value is returned (see sendto()).
+ *
+ ****************************************************************************/
 
-  return ret;
+int psock_udp_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                       unsigned int vlen, int flags)
+{
+  FAR struct udp_wrbuffer_s *wrb;
+  FAR struct msghdr *msg;
+#if CONFIG_NET_SEND_BUFSIZE > 0
+  FAR struct udp_conn_s *conn = psock->s_conn;
+  uint32_t queued = 0;
+#endif
+  unsigned int count;
+  sq_queue_t queue;
+  ssize_t ret = OK;
+
+  sq_init(&queue);
+
+  for (count = 0; count < vlen; count++)
+    {
+      msg = &msgvec[count].msg_hdr;
+
+#if CONFIG_NET_SEND_BUFSIZE > 0
+      /* The datagrams of the batch are not yet accounted in the write
+       * queue, stop before they exceed the send buffer.
+       */
+
+      queued += msg->msg_iov->iov_len;
+      if (count > 0 &&
+          udp_wrbuffer_inqueue_size(conn) + queued > conn->sndbufs)
+        {
+          break;
+        }
+#endif
+
+      ret = sendto_prepare(psock, msg->msg_iov->iov_base,
+                           msg->msg_iov->iov_len, flags, msg->msg_name,
+                           msg->msg_namelen, &wrb);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      sq_addlast(&wrb->wb_node, &queue);
+      msgvec[count].msg_len = ret;
+      flags |= MSG_DONTWAIT;
+    }
+
+  if (count > 0)
+    {
+      ret = sendto_queue(psock->s_conn, &queue);
+    }
+
+  return ret < 0 ? ret : count;
 }
 
 /****************************************************************************
@@ -0,0 +1,186 @@
+/****************************************************************************
+ * net/utils/net_hash.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdlib.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_HASH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The table is doubled when it holds more nodes per bucket */
+
+#define NET_HASH_LOADFACTOR 2
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_hash_grow
+ *
+ * Description:
+ *   Move the nodes to a table twice as large.
+ *
+ ****************************************************************************/
+
+static void net_hash_grow(FAR struct net_hashtab_s *tab)
+{
+  FAR struct net_hashnode_s **buckets;
+  FAR struct net_hashnode_s *node;
+  uint32_t nbuckets = tab->nbuckets << 1;
+  uint32_t i;
+
+  buckets = kmm_zalloc(nbuckets * sizeof(FAR struct net_hashnode_s *));
+  if (buckets == NULL)
+    {
+      /* The longer chains are still correct */
+
+      return;
+    }
+
+  for (i = 0; i < tab->nbuckets; i++)
+    {
+      while ((node = tab->buckets[i]) != NULL)
+        {
+          tab->buckets[i] = node->next;
+          node->next = buckets[node->hash & (nbuckets - 1)];
+          buckets[node->hash & (nbuckets - 1)] = node;
+        }
+    }
+
+  if (tab->buckets != tab->initial)
+    {
+      kmm_free(tab->buckets);
+    }
+
+  tab->buckets  = buckets;
+  tab->nbuckets = nbuckets;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_hash_seed
+ *
+ * Description:
+ *   Return the initial value of the hashes of a table, which is chosen at
+ *   random so that the peers can't flood one bucket.
+ *
+ ****************************************************************************/
+
+uint32_t net_hash_seed(FAR struct net_hashtab_s *tab)
+{
+  while (tab->seed == 0)
+    {
+      arc4random_buf(&tab->seed, sizeof(tab->seed));
+    }
+
+  return tab->seed;
+}
+
+/****************************************************************************
+ * Name: net_hash_mix
+ *
+ * Description:
+ *   Add len bytes of data to the hash (FNV-1a).
+ *
+ ****************************************************************************/
+
+uint32_t net_hash_mix(uint32_t hash, FAR const void *data, size_t len)
+{
+  FAR const uint8_t *ptr = data;
+
+  while (len-- > 0)
+    {
+      hash = (hash ^ *ptr++) * 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: net_hash_add
+ *
+ * Description:
+ *   Add a node with this hash to the table, growing the table if needed.
+ *
+ ****************************************************************************/
+
+void net_hash_add(FAR struct net_hashtab_s *tab,
+                  FAR struct net_hashnode_s *node, uint32_t hash)
+{
+  FAR struct net_hashnode_s **bucket;
+
+  if (tab->count >= tab->nbuckets * NET_HASH_LOADFACTOR)
+    {
+      net_hash_grow(tab);
+    }
+
+  bucket     = &tab->buckets[hash & (tab->nbuckets - 1)];
+  node->hash = hash;
+  node->next = *bucket;
+  *bucket    = node;
+  tab->count++;
+}
+
+/****************************************************************************
+ * Name: net_hash_remove
+ *
+ * Description:
+ *   Remove a node from the table, if it is in the table.
+ *
+ ****************************************************************************/
+
+void net_hash_remove(FAR struct net_hashtab_s *tab,
+                     FAR struct net_hashnode_s *node)
+{
+  FAR struct net_hashnode_s **link;
+
+  for (link = &tab->buckets[node->hash & (tab->nbuckets - 1)];
+       *link != NULL; link = &(*link)->next)
+    {
+      if (*link == node)
+        {
+          *link      = node->next;
+          node->next = NULL;
+          tab->count--;
+          break;
+        }
+    }
+}
+
+#endif /* CONFIG_NET_HASH */
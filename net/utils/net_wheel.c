@@ -0,0 +1,131 @@
+/****************************************************************************
+ * net/utils/net_wheel.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <nuttx/nuttx.h>
+#include <nuttx/net/net.h>
+
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_WHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NET_WHEEL_SLOT(t) ((uint8_t)((t) & (NET_WHEEL_SLOTS - 1)))
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_wheel_add
+ *
+ * Description:
+ *   Add a timer expiring at the second expire to the wheel.
+ *
+ ****************************************************************************/
+
+void net_wheel_add(FAR struct net_wheel_s *wheel,
+                   FAR struct net_wheelnode_s *node, int32_t expire)
+{
+  node->expire = expire;
+  node->slot   = NET_WHEEL_SLOT(expire);
+  dq_addlast(&node->node, &wheel->slots[node->slot]);
+}
+
+/****************************************************************************
+ * Name: net_wheel_remove
+ *
+ * Description:
+ *   Remove a timer from the wheel.
+ *
+ ****************************************************************************/
+
+void net_wheel_remove(FAR struct net_wheel_s *wheel,
+                      FAR struct net_wheelnode_s *node)
+{
+  dq_rem(&node->node, &wheel->slots[node->slot]);
+}
+
+/****************************************************************************
+ * Name: net_wheel_run
+ *
+ * Description:
+ *   Call cb for each timer expired at the second now.  A timer is in the
+ *   slot of the second it was due when added or last moved, which is never
+ *   later than its expiration, so it is visited when it expires or sooner.
+ *   The timers pushed back meanwhile are moved to their new slot.
+ *
+ ****************************************************************************/
+
+void net_wheel_run(FAR struct net_wheel_s *wheel, int32_t now,
+                   net_wheel_cb_t cb, FAR void *arg)
+{
+  FAR struct net_wheelnode_s *node;
+  FAR dq_queue_t *slot;
+  FAR dq_entry_t *p;
+  FAR dq_entry_t *tmp;
+  int32_t elapsed = now - wheel->last;
+  int32_t t;
+
+  if (elapsed <= 0)
+    {
+      return;
+    }
+
+  /* After a full turn, each slot is visited once */
+
+  if (elapsed > NET_WHEEL_SLOTS)
+    {
+      elapsed = NET_WHEEL_SLOTS;
+    }
+
+  for (t = now - elapsed + 1; t - now <= 0; t++)
+    {
+      slot = &wheel->slots[NET_WHEEL_SLOT(t)];
+      dq_for_every_safe(slot, p, tmp)
+        {
+          node = container_of(p, struct net_wheelnode_s, node);
+          if (node->expire - now <= 0)
+            {
+              cb(node, arg);
+            }
+          else if (NET_WHEEL_SLOT(node->expire) != node->slot)
+            {
+              dq_rem(p, slot);
+              node->slot = NET_WHEEL_SLOT(node->expire);
+              dq_addlast(p, &wheel->slots[node->slot]);
+            }
+        }
+    }
+
+  wheel->last = now;
+}
+
+#endif /* CONFIG_NET_WHEEL */
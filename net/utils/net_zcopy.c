@@ -0,0 +1,445 @@
+/****************************************************************************
+ * net/utils/net_zcopy.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/atomic.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/queue.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+
+#include "devif/devif.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_ZEROCOPY
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One MSG_ZEROCOPY send.  It is referenced by the sender until the send
+ * call returns and by each I/O buffer holding the user data.  Once all the
+ * references are released, it becomes the completion notification of the
+ * range of sends [zc_lo, zc_hi], queued until read from the error queue.
+ */
+
+struct net_zcopy_s
+{
+  dq_entry_t zc_node;                 /* s_zcpend or s_zcdone entry */
+  FAR struct socket_conn_s *zc_conn;  /* The socket, NULL once closed */
+  atomic_t zc_refs;                   /* Number of references */
+  uint32_t zc_lo;                     /* First send of the range */
+  uint32_t zc_hi;                     /* Last send of the range */
+  uint8_t zc_code;                    /* SO_EE_CODE_* of the notification */
+  bool zc_report;                     /* Notify the completion */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The last reference may be released by a network driver, from any
+ * context, so the queues are protected by a spinlock.
+ */
+
+static spinlock_t g_zcopy_lock = SP_UNLOCKED;
+
+/* The poll waiters are notified with the socket locked, which cannot be
+ * done from the context releasing the last reference.  The sockets with new
+ * completions are queued to a work, and g_zcopy_notifylock keeps a socket
+ * from being freed while the work notifies it.
+ */
+
+static dq_queue_t g_zcopy_notify;
+static struct work_s g_zcopy_work;
+static mutex_t g_zcopy_notifylock = NXMUTEX_INITIALIZER;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_zcopy_notify
+ *
+ * Description:
+ *   Notify the poll waiters of the sockets with new completions.
+ *
+ ****************************************************************************/
+
+static void net_zcopy_notify(FAR void *arg)
+{
+  FAR struct socket_conn_s *conn;
+  FAR dq_entry_t *node;
+  irqstate_t flags;
+
+  nxmutex_lock(&g_zcopy_notifylock);
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&g_zcopy_lock);
+      node  = dq_remfirst(&g_zcopy_notify);
+      if (node == NULL)
+        {
+          spin_unlock_irqrestore(&g_zcopy_lock, flags);
+          break;
+        }
+
+      conn = container_of(node, struct socket_conn_s, s_zcnode);
+      conn->s_zcnotify = false;
+      spin_unlock_irqrestore(&g_zcopy_lock, flags);
+
+      conn_lock(conn);
+      devif_conn_event(NULL, ZCOPY_DONE, conn->list);
+      conn_unlock(conn);
+    }
+
+  nxmutex_unlock(&g_zcopy_notifylock);
+}
+
+/****************************************************************************
+ * Name: net_zcopy_release
+ *
+ * Description:
+ *   Release a reference.  The last one turns the send into a completion
+ *   notification, merged with the last one queued if they are contiguous.
+ *
+ ****************************************************************************/
+
+static void net_zcopy_release(FAR void *arg)
+{
+  FAR struct net_zcopy_s *zc = arg;
+  FAR struct net_zcopy_s *tail;
+  FAR struct socket_conn_s *conn;
+  irqstate_t flags;
+
+  if (atomic_fetch_sub(&zc->zc_refs, 1) != 1)
+    {
+      return;
+    }
+
+  flags = spin_lock_irqsave(&g_zcopy_lock);
+
+  conn = zc->zc_conn;
+  if (conn != NULL)
+    {
+      dq_rem(&zc->zc_node, &conn->s_zcpend);
+    }
+
+  if (conn == NULL || !zc->zc_report)
+    {
+      spin_unlock_irqrestore(&g_zcopy_lock, flags);
+      kmm_free(zc);
+      return;
+    }
+
+  tail = (FAR struct net_zcopy_s *)dq_tail(&conn->s_zcdone);
+  if (tail != NULL && tail->zc_code == zc->zc_code &&
+      tail->zc_hi + 1 == zc->zc_lo)
+    {
+      tail->zc_hi = zc->zc_hi;
+      spin_unlock_irqrestore(&g_zcopy_lock, flags);
+      kmm_free(zc);
+      return;
+    }
+
+  dq_addlast(&zc->zc_node, &conn->s_zcdone);
+
+  /* Wake up the poll waiters, a completion merged into the tail above was
+   * already pending when they polled.
+   */
+
+  if (!conn->s_zcnotify)
+    {
+      conn->s_zcnotify = true;
+      dq_addlast(&conn->s_zcnode, &g_zcopy_notify);
+    }
+
+  spin_unlock_irqrestore(&g_zcopy_lock, flags);
+
+  work_queue(LPWORK, &g_zcopy_work, net_zcopy_notify, NULL, 0);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_zcopy_alloc
+ *
+ * Description:
+ *   Start a MSG_ZEROCOPY send on the socket conn.  The send holds a
+ *   reference until net_zcopy_done() is called.
+ *
+ * Returned Value:
+ *   The send, or NULL if it could not be allocated.
+ *
+ ****************************************************************************/
+
+FAR struct net_zcopy_s *net_zcopy_alloc(FAR struct socket_conn_s *conn)
+{
+  FAR struct net_zcopy_s *zc;
+  irqstate_t flags;
+
+  zc = kmm_zalloc(sizeof(struct net_zcopy_s));
+  if (zc == NULL)
+    {
+      return NULL;
+    }
+
+  zc->zc_conn = conn;
+  atomic_set(&zc->zc_refs, 1);
+
+  flags = spin_lock_irqsave(&g_zcopy_lock);
+  dq_addlast(&zc->zc_node, &conn->s_zcpend);
+  spin_unlock_irqrestore(&g_zcopy_lock, flags);
+
+  return zc;
+}
+
+/****************************************************************************
+ * Name: net_zcopy_copyin
+ *
+ * Description:
+ *   Append len bytes of user data at buf to the I/O buffer chain iob, with
+ *   I/O buffers that reference the user data rather than a copy of it.
+ *
+ * Returned Value:
+ *   len on success.  -ENOMEM if not all of the data could be appended, the
+ *   packet length of iob tells how much was.
+ *
+ ****************************************************************************/
+
+int net_zcopy_copyin(FAR struct net_zcopy_s *zc, FAR struct iob_s *iob,
+                     FAR const void *buf, unsigned int len)
+{
+  FAR const uint8_t *data = buf;
+  FAR struct iob_s *tail = iob;
+  FAR struct iob_s *next;
+  unsigned int remain = len;
+  unsigned int chunk;
+
+  while (tail->io_flink != NULL)
+    {
+      tail = tail->io_flink;
+    }
+
+  while (remain > 0)
+    {
+      chunk = MIN(remain, UINT16_MAX);
+      next  = iob_alloc_with_arg((FAR void *)data, chunk,
+                                 net_zcopy_release, zc);
+      if (next == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      atomic_fetch_add(&zc->zc_refs, 1);
+
+      next->io_len   = chunk;
+      tail->io_flink = next;
+      tail           = next;
+      data          += chunk;
+      remain        -= chunk;
+
+      iob->io_pktlen += chunk;
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: net_zcopy_done
+ *
+ * Description:
+ *   End a MSG_ZEROCOPY send and release the reference of the sender.  If
+ *   data was sent, the send is given the next ID of the socket, notified
+ *   once the data is no longer referenced.
+ *
+ ****************************************************************************/
+
+void net_zcopy_done(FAR struct net_zcopy_s *zc, bool sent)
+{
+  irqstate_t flags;
+
+  if (sent)
+    {
+      flags = spin_lock_irqsave(&g_zcopy_lock);
+      zc->zc_lo     = zc->zc_conn->s_zcnext++;
+      zc->zc_hi     = zc->zc_lo;
+      zc->zc_report = true;
+      spin_unlock_irqrestore(&g_zcopy_lock, flags);
+    }
+
+  net_zcopy_release(zc);
+}
+
+/****************************************************************************
+ * Name: net_zcopy_copied
+ *
+ * Description:
+ *   Notify a MSG_ZEROCOPY send whose data had to be copied, it completes
+ *   immediately.
+ *
+ ****************************************************************************/
+
+void net_zcopy_copied(FAR struct socket_conn_s *conn)
+{
+  FAR struct net_zcopy_s *zc;
+
+  zc = net_zcopy_alloc(conn);
+  if (zc == NULL)
+    {
+      nerr("ERROR: Failed to allocate the zero-copy notification\n");
+      return;
+    }
+
+  zc->zc_code = SO_EE_CODE_ZEROCOPY_COPIED;
+  net_zcopy_done(zc, true);
+}
+
+/****************************************************************************
+ * Name: net_zcopy_pending
+ *
+ * Description:
+ *   Return true if a completion notification can be read from the error
+ *   queue of the socket.
+ *
+ ****************************************************************************/
+
+bool net_zcopy_pending(FAR struct socket_conn_s *conn)
+{
+  return !dq_empty(&conn->s_zcdone);
+}
+
+/****************************************************************************
+ * Name: net_zcopy_recverr
+ *
+ * Description:
+ *   Read the first completion notification of the error queue of the
+ *   socket into the control data of msg, recvmsg() with MSG_ERRQUEUE.
+ *
+ * Returned Value:
+ *   Zero (no data is read) on success, -EAGAIN if there is no completion
+ *   notification.
+ *
+ ****************************************************************************/
+
+ssize_t net_zcopy_recverr(FAR struct socket_conn_s *conn,
+                          FAR struct msghdr *msg, int domain)
+{
+  FAR struct net_zcopy_s *zc;
+  struct sock_extended_err ee;
+  irqstate_t flags;
+  int level = SOL_IP;
+  int type = IP_RECVERR;
+
+  flags = spin_lock_irqsave(&g_zcopy_lock);
+  zc = (FAR struct net_zcopy_s *)dq_remfirst(&conn->s_zcdone);
+  spin_unlock_irqrestore(&g_zcopy_lock, flags);
+
+  if (zc == NULL)
+    {
+      return -EAGAIN;
+    }
+
+  memset(&ee, 0, sizeof(ee));
+  ee.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+  ee.ee_code   = zc->zc_code;
+  ee.ee_info   = zc->zc_lo;
+  ee.ee_data   = zc->zc_hi;
+  kmm_free(zc);
+
+#ifdef CONFIG_NET_IPv6
+  if (domain == PF_INET6)
+    {
+      level = SOL_IPV6;
+      type  = IPV6_RECVERR;
+    }
+#endif
+
+  msg->msg_flags |= MSG_ERRQUEUE;
+  if (cmsg_append(msg, level, type, &ee, sizeof(ee)) == NULL)
+    {
+      msg->msg_flags |= MSG_CTRUNC;
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: net_zcopy_free
+ *
+ * Description:
+ *   Discard the completion notifications of a socket being freed, and
+ *   detach it from the sends still referenced.  It must be called before
+ *   the lock of the socket is destroyed.
+ *
+ ****************************************************************************/
+
+void net_zcopy_free(FAR struct socket_conn_s *conn)
+{
+  FAR struct net_zcopy_s *zc;
+  irqstate_t flags;
+
+  nxmutex_lock(&g_zcopy_notifylock);
+  flags = spin_lock_irqsave(&g_zcopy_lock);
+
+  if (conn->s_zcnotify)
+    {
+      dq_rem(&conn->s_zcnode, &g_zcopy_notify);
+      conn->s_zcnotify = false;
+    }
+
+  while ((zc = (FAR struct net_zcopy_s *)
+               dq_remfirst(&conn->s_zcpend)) != NULL)
+    {
+      zc->zc_conn = NULL;
+    }
+
+  spin_unlock_irqrestore(&g_zcopy_lock, flags);
+  nxmutex_unlock(&g_zcopy_notifylock);
+
+  while ((zc = (FAR struct net_zcopy_s *)
+               dq_remfirst(&conn->s_zcdone)) != NULL)
+    {
+      kmm_free(zc);
+    }
+}
+
+#endif /* CONFIG_NET_ZEROCOPY */
@@ -111,6 +111,26 @@
 #define NET_BUFPOOL_LOCK(p)         net_bufpool_lock(&p)
 #define NET_BUFPOOL_UNLOCK(p)       net_bufpool_unlock(&p)
 
+/* Connection hash table related macros, in which:
+ *   tab:      The name of the hash table
+ *   nbuckets: The initial number of buckets, a power of two
+ */
+
+#define NET_HASHTAB_DECLARE(tab, nbuckets) \
+  static FAR struct net_hashnode_s *tab##_buckets[nbuckets]; \
+  static struct net_hashtab_s tab = \
+    { \
+      tab##_buckets, \
+      tab##_buckets, \
+      nbuckets, \
+      0, \
+      0 \
+    };
+
+/* The number of slots of a timer wheel, one per second, a power of two */
+
+#define NET_WHEEL_SLOTS 64
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -141,6 +161,35 @@ struct net_bufpool_s
   sq_queue_t freebuffers;
 };
 
+/* This structure is a hash table of connections, which grows as the
+ * connections are added.  It is protected by the lock of the connection
+ * list it indexes.
+ */
+
+struct net_hashtab_s
+{
+  FAR struct net_hashnode_s **buckets; /* The chains of the nodes */
+  FAR struct net_hashnode_s **initial; /* The statically allocated buckets */
+  uint32_t nbuckets;                   /* Number of buckets, power of two */
+  uint32_t count;                      /* Number of nodes in the table */
+  uint32_t seed;                       /* Random seed of the hash function */
+};
+
+/* This structure is a timer wheel of idle timeouts, in seconds.  The
+ * timers are kept in the slot of their expiration second, so that only the
+ * slots of the seconds elapsed since the last run are visited.  It is
+ * protected by the lock of the objects it times.
+ */
+
+struct net_wheel_s
+{
+  dq_queue_t slots[NET_WHEEL_SLOTS];   /* The timers by expiration second */
+  int32_t last;                        /* The last second run */
+};
+
+typedef CODE void (*net_wheel_cb_t)(FAR struct net_wheelnode_s *node,
+                                    FAR void *arg);
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -157,6 +206,44 @@ extern "C"
  * Inline Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: net_hash_first, net_hash_next
+ *
+ * Description:
+ *   Return the first node having this hash, or the next node having the
+ *   same hash as node.  Only these nodes may match the key of the lookup.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_HASH
+static inline_function FAR struct net_hashnode_s *
+net_hash_next(FAR struct net_hashnode_s *node)
+{
+  uint32_t hash = node->hash;
+
+  do
+    {
+      node = node->next;
+    }
+  while (node != NULL && node->hash != hash);
+
+  return node;
+}
+
+static inline_function FAR struct net_hashnode_s *
+net_hash_first(FAR struct net_hashtab_s *tab, uint32_t hash)
+{
+  FAR struct net_hashnode_s *node = tab->buckets[hash & (tab->nbuckets - 1)];
+
+  while (node != NULL && node->hash != hash)
+    {
+      node = node->next;
+    }
+
+  return node;
+}
+#endif
+
 /****************************************************************************
  * Name: conn_lock, conn_unlock, conn_dev_lock, conn_dev_unlock
  *
@@ -523,6 +610,94 @@ void net_bufpool_lock(FAR struct net_bufpool_s *pool);
 
 void net_bufpool_unlock(FAR struct net_bufpool_s *pool);
 
+/****************************************************************************
+ * Name: net_hash_seed
+ *
+ * Description:
+ *   Return the initial value of the hashes of a table, which is chosen at
+ *   random so that the peers can't flood one bucket.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_HASH
+uint32_t net_hash_seed(FAR struct net_hashtab_s *tab);
+
+/****************************************************************************
+ * Name: net_hash_mix
+ *
+ * Description:
+ *   Add len bytes of data to the hash (FNV-1a).  The hash of a key is
+ *   computed by mixing its fields into net_hash_seed().
+ *
+ ****************************************************************************/
+
+uint32_t net_hash_mix(uint32_t hash, FAR const void *data, size_t len);
+
+/****************************************************************************
+ * Name: net_hash_add
+ *
+ * Description:
+ *   Add a node with this hash to the table.  The table is doubled when it
+ *   holds more than two nodes per bucket, it keeps its size if the new
+ *   buckets can't be allocated.
+ *
+ ****************************************************************************/
+
+void net_hash_add(FAR struct net_hashtab_s *tab,
+                  FAR struct net_hashnode_s *node, uint32_t hash);
+
+/****************************************************************************
+ * Name: net_hash_remove
+ *
+ * Description:
+ *   Remove a node from the table.  Nothing is done if it is not in the
+ *   table.
+ *
+ ****************************************************************************/
+
+void net_hash_remove(FAR struct net_hashtab_s *tab,
+                     FAR struct net_hashnode_s *node);
+#endif
+
+/****************************************************************************
+ * Name: net_wheel_add
+ *
+ * Description:
+ *   Add a timer expiring at the second expire to the wheel.  The timer may
+ *   be pushed back later by just increasing node->expire, it is moved to
+ *   its new slot when the old one is run.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_WHEEL
+void net_wheel_add(FAR struct net_wheel_s *wheel,
+                   FAR struct net_wheelnode_s *node, int32_t expire);
+
+/****************************************************************************
+ * Name: net_wheel_remove
+ *
+ * Description:
+ *   Remove a timer from the wheel.
+ *
+ ****************************************************************************/
+
+void net_wheel_remove(FAR struct net_wheel_s *wheel,
+                      FAR struct net_wheelnode_s *node);
+
+/****************************************************************************
+ * Name: net_wheel_run
+ *
+ * Description:
+ *   Call cb for each timer expired at the second now.  Only the slots of
+ *   the seconds elapsed since the last run are visited.  cb must remove
+ *   the timer from the wheel, it must not add or remove other timers.
+ *
+ ****************************************************************************/
+
+void net_wheel_run(FAR struct net_wheel_s *wheel, int32_t now,
+                   net_wheel_cb_t cb, FAR void *arg);
+#endif
+
 /****************************************************************************
  * Name: net_chksum_adjust
  *
@@ -670,6 +845,103 @@ uint16_t icmpv6_chksum(FAR struct net_driver_s *dev, unsigned int iplen);
 FAR void *cmsg_append(FAR struct msghdr *msg, int level, int type,
                       FAR void *value, int value_len);
 
+/****************************************************************************
+ * Name: net_zcopy_alloc
+ *
+ * Description:
+ *   Start a MSG_ZEROCOPY send on the socket conn.  The send holds a
+ *   reference until net_zcopy_done() is called.
+ *
+ * Returned Value:
+ *   The send, or NULL if it could not be allocated.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ZEROCOPY
+struct net_zcopy_s;       /* Forward reference */
+struct iob_s;             /* Forward reference */
+
+FAR struct net_zcopy_s *net_zcopy_alloc(FAR struct socket_conn_s *conn);
+
+/****************************************************************************
+ * Name: net_zcopy_copyin
+ *
+ * Description:
+ *   Append len bytes of user data at buf to the I/O buffer chain iob, with
+ *   I/O buffers that reference the user data rather than a copy of it.
+ *
+ * Returned Value:
+ *   len on success.  -ENOMEM if not all of the data could be appended, the
+ *   packet length of iob tells how much was.
+ *
+ ****************************************************************************/
+
+int net_zcopy_copyin(FAR struct net_zcopy_s *zc, FAR struct iob_s *iob,
+                     FAR const void *buf, unsigned int len);
+
+/****************************************************************************
+ * Name: net_zcopy_done
+ *
+ * Description:
+ *   End a MSG_ZEROCOPY send and release the reference of the sender.  If
+ *   data was sent, the send is given the next ID of the socket, notified
+ *   once the data is no longer referenced.
+ *
+ ****************************************************************************/
+
+void net_zcopy_done(FAR struct net_zcopy_s *zc, bool sent);
+
+/****************************************************************************
+ * Name: net_zcopy_copied
+ *
+ * Description:
+ *   Notify a MSG_ZEROCOPY send whose data had to be copied, it completes
+ *   immediately.
+ *
+ ****************************************************************************/
+
+void net_zcopy_copied(FAR struct socket_conn_s *conn);
+
+/****************************************************************************
+ * Name: net_zcopy_pending
+ *
+ * Description:
+ *   Return true if a completion notification can be read from the error
+ *   queue of the socket.
+ *
+ ****************************************************************************/
+
+bool net_zcopy_pending(FAR struct socket_conn_s *conn);
+
+/****************************************************************************
+ * Name: net_zcopy_recverr
+ *
+ * Description:
+ *   Read the first completion notification of the error queue of the
+ *   socket into the control data of msg, recvmsg() with MSG_ERRQUEUE.
+ *
+ * Returned Value:
+ *   Zero (no data is read) on success, -EAGAIN if there is no completion
+ *   notification.
+ *
+ ****************************************************************************/
+
+ssize_t net_zcopy_recverr(FAR struct socket_conn_s *conn,
+                          FAR struct msghdr *msg, int domain);
+
+/****************************************************************************
+ * Name: net_zcopy_free
+ *
+ * Description:
+ *   Discard the completion notifications of a socket being freed, and
+ *   detach it from the sends still referenced.  It must be called before
+ *   the lock of the socket is destroyed.
+ *
+ ****************************************************************************/
+
+void net_zcopy_free(FAR struct socket_conn_s *conn);
+#endif /* CONFIG_NET_ZEROCOPY */
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -138,7 +138,7 @@ int group_allocate(FAR struct tcb_s *tcb, uint8_t ttype)
     }
   else
     {
-      group = kmm_zalloc(sizeof(struct task_group_s));
+      group = nxsched_alloc_group();
     }
 
   if (!group)
@@ -200,7 +200,7 @@ int group_allocate(FAR struct tcb_s *tcb, uint8_t ttype)
   return OK;
 
 errout_with_group:
-  kmm_free(group);
+  nxsched_free_group(group);
   return ret;
 }
 
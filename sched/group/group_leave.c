@@ -41,6 +41,7 @@
 #  include <nuttx/binfmt/binfmt.h>
 #endif
 
+#include "sched/sched.h"
 #include "environ/environ.h"
 #include "signal/signal.h"
 #include "pthread/pthread.h"
@@ -240,6 +241,6 @@ void group_drop(FAR struct task_group_s *group)
     {
       /* Release the group container itself */
 
-      kmm_free(group);
+      nxsched_free_group(group);
     }
 }
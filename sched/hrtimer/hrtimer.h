@@ -31,6 +31,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
 #include <nuttx/hrtimer.h>
+#include <nuttx/spinlock.h>
 
 #ifdef CONFIG_HRTIMER
 
@@ -66,6 +67,15 @@ extern struct hrtimer_tree_s g_hrtimer_tree;
 extern FAR hrtimer_t *g_hrtimer_running[CONFIG_SMP_NCPUS];
 #endif
 
+/* Per-CPU flags set while hrtimer_process() is running the expired
+ * timers.  Timers started or cancelled from the callbacks do not touch the
+ * hardware, hrtimer_process() reprograms it once for the whole batch.
+ */
+
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+extern bool g_hrtimer_processing[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -136,19 +146,47 @@ int hrtimer_starttimer(uint64_t ns)
   struct timespec ts;
   int ret;
 
+#if defined(CONFIG_SCHED_TICKLESS_HRTIMER) && \
+    !defined(CONFIG_SCHED_TICKLESS_ALARM)
+  uint64_t now = hrtimer_gettime();
+
+  /* The tickless interval timer takes a delay relative to now */
+
+  clock_nsec2time(&ts, ns > now ? ns - now : 0);
+  ret = up_timer_start(&ts);
+#else
   /* Convert nanoseconds to timespec */
 
   clock_nsec2time(&ts, ns);
 
-#ifdef CONFIG_ALARM_ARCH
+#  if defined(CONFIG_ALARM_ARCH) || defined(CONFIG_SCHED_TICKLESS_HRTIMER)
   ret = up_alarm_start(&ts);
-#elif defined(CONFIG_TIMER_ARCH)
+#  elif defined(CONFIG_TIMER_ARCH)
   ret = up_timer_start(&ts);
+#  endif
 #endif
 
   return ret;
 }
 
+/****************************************************************************
+ * Name: hrtimer_is_processing
+ *
+ * Description:
+ *   Test whether hrtimer_process() is running the expired timers on this
+ *   CPU.  In that case the hardware timer must not be reprogrammed, this
+ *   is done once when the expiry batch has been processed.
+ *
+ * Returned Value:
+ *   true if an expiry batch is being processed on this CPU.
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+#  define hrtimer_is_processing() (g_hrtimer_processing[this_cpu()])
+#else
+#  define hrtimer_is_processing() (false)
+#endif
+
 /****************************************************************************
  * Name: hrtimer_compare
  *
@@ -140,7 +140,7 @@ int hrtimer_cancel(FAR hrtimer_t *hrtimer)
 
   /* If the canceled timer was the earliest one, update the hardware timer */
 
-  if (hrtimer_is_first(hrtimer))
+  if (hrtimer_is_first(hrtimer) && !hrtimer_is_processing())
     {
       first = hrtimer_get_first();
       if (first != NULL)
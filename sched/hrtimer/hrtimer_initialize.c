@@ -40,6 +40,14 @@
 FAR hrtimer_t *g_hrtimer_running[CONFIG_SMP_NCPUS];
 #endif
 
+/* Per-CPU flags telling that an expiry batch is being processed and the
+ * hardware timer will be reprogrammed when it completes.
+ */
+
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+bool g_hrtimer_processing[CONFIG_SMP_NCPUS];
+#endif
+
 /* Global spinlock protecting the high-resolution timer subsystem.
  *
  * This spinlock serializes access to the hrtimer red-black tree and
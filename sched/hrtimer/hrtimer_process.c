@@ -82,6 +82,12 @@ void hrtimer_process(uint64_t now)
 
   flags = spin_lock_irqsave(&g_hrtimer_spinlock);
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  /* Defer the hardware reprogramming to the end of the expiry batch */
+
+  g_hrtimer_processing[this_cpu()] = true;
+#endif
+
   /* Fetch the earliest active timer */
 
   hrtimer = hrtimer_get_first();
@@ -148,6 +154,10 @@ void hrtimer_process(uint64_t now)
       hrtimer = hrtimer_get_first();
     }
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  g_hrtimer_processing[this_cpu()] = false;
+#endif
+
   /* Schedule the next timer expiration */
 
   if (hrtimer != NULL)
@@ -0,0 +1,70 @@
+/****************************************************************************
+ * sched/hrtimer/hrtimer_remaining.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/clock.h>
+
+#include "hrtimer/hrtimer.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_remaining
+ *
+ * Description:
+ *   Return the time remaining before the specified high-resolution timer
+ *   expires.
+ *
+ * Input Parameters:
+ *   hrtimer - Timer instance to query
+ *
+ * Returned Value:
+ *   The time in nanoseconds remaining until the timer expires.  Zero
+ *   means that the timer is not armed or has already expired.
+ ****************************************************************************/
+
+uint64_t hrtimer_remaining(FAR hrtimer_t *hrtimer)
+{
+  irqstate_t flags;
+  uint64_t expired = 0;
+  uint64_t now;
+
+  DEBUGASSERT(hrtimer != NULL);
+
+  flags = spin_lock_irqsave(&g_hrtimer_spinlock);
+
+  if (hrtimer_is_armed(hrtimer))
+    {
+      expired = hrtimer->expired;
+    }
+
+  spin_unlock_irqrestore(&g_hrtimer_spinlock, flags);
+
+  now = hrtimer_gettime();
+  return expired > now ? expired - now : 0;
+}
@@ -99,9 +99,12 @@ int hrtimer_start(FAR hrtimer_t *hrtimer, hrtimer_entry_t func,
 
   hrtimer_insert(hrtimer);
 
-  /* If the inserted timer is now the earliest, start hardware timer */
+  /* If the inserted timer is now the earliest, start hardware timer.
+   * This is deferred to the end of hrtimer_process() when called from
+   * a timer callback.
+   */
 
-  if (hrtimer_is_first(hrtimer))
+  if (hrtimer_is_first(hrtimer) && !hrtimer_is_processing())
     {
       ret = hrtimer_starttimer(hrtimer->expired);
     }
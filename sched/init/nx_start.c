@@ -94,6 +94,14 @@
 
 dq_queue_t g_readytorun;
 
+/* With CONFIG_SCHED_READYTORUN_BITMAP, each ready-to-run list is indexed by
+ * priority so that tasks can be inserted without searching the list.
+ */
+
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+struct rtrindex_s g_readytorunidx;
+#endif
+
 /* In order to support SMP, the function of the g_readytorun list changes,
  * The g_readytorun is still used but in the SMP case it will contain only:
  *
@@ -117,6 +125,20 @@ FAR struct tcb_s *g_assignedtasks[CONFIG_SMP_NCPUS];
 enum task_deliver_e g_delivertasks[CONFIG_SMP_NCPUS];
 #endif
 
+/* With CONFIG_SCHED_PERCPU_READYTORUN, the ready-to-run tasks that are not
+ * running are distributed over one prioritized list per CPU instead of the
+ * shared g_readytorun list.  The list that holds a task is selected by
+ * tcb->cpu.  A CPU that has nothing better to run in its own list may steal
+ * eligible tasks from the lists of the other CPUs.
+ */
+
+#ifdef CONFIG_SCHED_PERCPU_READYTORUN
+dq_queue_t g_cpureadytorun[CONFIG_SMP_NCPUS];
+#  ifdef CONFIG_SCHED_READYTORUN_BITMAP
+struct rtrindex_s g_cpureadytorunidx[CONFIG_SMP_NCPUS];
+#  endif
+#endif
+
 /* g_running_tasks[] holds a references to the running task for each CPU.
  * It is valid only when up_interrupt_context() returns true.
  */
@@ -236,8 +258,14 @@ static void tasklist_initialize(void)
 
   /* TSTATE_TASK_READYTORUN */
 
+#  ifdef CONFIG_SCHED_PERCPU_READYTORUN
+  tlist[TSTATE_TASK_READYTORUN].list = g_cpureadytorun;
+  tlist[TSTATE_TASK_READYTORUN].attr = TLIST_ATTR_PRIORITIZED |
+                                       TLIST_ATTR_INDEXED;
+#  else
   tlist[TSTATE_TASK_READYTORUN].list = list_readytorun();
   tlist[TSTATE_TASK_READYTORUN].attr = TLIST_ATTR_PRIORITIZED;
+#  endif
 
 #else
 
@@ -405,7 +433,7 @@ static void idle_task_initialize(void)
 #ifdef CONFIG_SMP
       g_assignedtasks[i] = tcb;
 #else
-      dq_addfirst((FAR dq_entry_t *)tcb, TLIST_HEAD(tcb));
+      nxsched_add_rtrlist(tcb, TLIST_HEAD(tcb));
 #endif
 
       /* Mark the idle task as the running task */
@@ -622,6 +650,12 @@ void nx_start(void)
 
   task_initialize();
 
+#ifdef CONFIG_MM_OBJCACHE
+  /* Initialize the object caches of the TCBs and of the task groups */
+
+  nxsched_objcache_initialize();
+#endif
+
   /* Initialize the instrument function */
 
   instrument_initialize();
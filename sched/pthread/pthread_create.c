@@ -213,7 +213,8 @@ int nx_pthread_create(pthread_trampoline_t trampoline, FAR pthread_t *thread,
 
   /* Allocate a TCB for the new task. */
 
-  ptcb = kmm_zalloc(sizeof(struct tcb_s) + sizeof(struct pthread_entry_s));
+  ptcb = nxsched_alloc_tcb(sizeof(struct tcb_s) +
+                           sizeof(struct pthread_entry_s));
   if (!ptcb)
     {
       serr("ERROR: Failed to allocate TCB\n");
@@ -34,6 +34,7 @@
 #include <sched.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/bits.h>
 #include <nuttx/queue.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/spinlock.h>
@@ -53,6 +54,22 @@
  */
 
 #define list_readytorun()        (&g_readytorun)
+#ifdef CONFIG_SCHED_PERCPU_READYTORUN
+#  define list_cpureadytorun(cpu) (&g_cpureadytorun[cpu])
+#else
+#  define list_cpureadytorun(cpu) list_readytorun()
+#endif
+
+/* Map a ready-to-run list to its priority index */
+
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+#  ifdef CONFIG_SCHED_PERCPU_READYTORUN
+#    define index_readytorun(list) \
+       (&g_cpureadytorunidx[(FAR dq_queue_t *)(list) - g_cpureadytorun])
+#  else
+#    define index_readytorun(list) (&g_readytorunidx)
+#  endif
+#endif
 #ifndef CONFIG_SMP
 #define list_pendingtasks()      (&g_pendingtasks)
 #endif
@@ -135,6 +152,19 @@ struct tasklist_s
 
 /* This enumeration defines smp schedule task switch rule */
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+/* This structure indexes a ready-to-run list by priority.  A bit is set in
+ * the bitmap for each priority that has at least one task in the list and
+ * tail[] holds the last task of that priority in the list.
+ */
+
+struct rtrindex_s
+{
+  DECLARE_BITMAP(bitmap, SCHED_PRIORITY_MAX + 1);
+  FAR struct tcb_s *tail[SCHED_PRIORITY_MAX + 1];
+};
+#endif
+
 enum task_deliver_e
 {
   SWITCH_NONE   = 0, /* No schedule switch pending */
@@ -167,6 +197,12 @@ enum task_deliver_e
 
 extern dq_queue_t g_readytorun;
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+/* The priority index of g_readytorun */
+
+extern struct rtrindex_s g_readytorunidx;
+#endif
+
 #ifdef CONFIG_SMP
 /* In order to support SMP, the function of the g_readytorun list changes,
  * The g_readytorun is still used but in the SMP case it will contain only:
@@ -195,6 +231,18 @@ extern FAR struct tcb_s *g_assignedtasks[CONFIG_SMP_NCPUS];
 
 extern enum task_deliver_e g_delivertasks[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_SCHED_PERCPU_READYTORUN
+/* With per-CPU ready-to-run lists, the tasks that would otherwise be held
+ * in g_readytorun are held in the list of the CPU selected by tcb->cpu.
+ */
+
+extern dq_queue_t g_cpureadytorun[CONFIG_SMP_NCPUS];
+
+#  ifdef CONFIG_SCHED_READYTORUN_BITMAP
+extern struct rtrindex_s g_cpureadytorunidx[CONFIG_SMP_NCPUS];
+#  endif
+#endif
+
 /* This is the list of idle tasks */
 
 extern struct tcb_s g_idletcb[CONFIG_SMP_NCPUS];
@@ -443,6 +491,21 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state,
 
 bool nxsched_verify_tcb(FAR struct tcb_s *tcb);
 
+/* Allocation of the TCBs and of the task groups */
+
+#ifdef CONFIG_MM_OBJCACHE
+void nxsched_objcache_initialize(void);
+FAR void *nxsched_alloc_tcb(size_t size);
+void nxsched_free_tcb(FAR struct tcb_s *tcb);
+FAR struct task_group_s *nxsched_alloc_group(void);
+void nxsched_free_group(FAR struct task_group_s *group);
+#else
+#  define nxsched_alloc_tcb(s)    kmm_zalloc(s)
+#  define nxsched_free_tcb(t)     kmm_free(t)
+#  define nxsched_alloc_group()   kmm_zalloc(sizeof(struct task_group_s))
+#  define nxsched_free_group(g)   kmm_free(g)
+#endif
+
 /* Obtain TLS from kernel */
 
 struct tls_info_s; /* Forward declare */
@@ -532,6 +595,131 @@ static inline_function bool nxsched_add_prioritized(FAR struct tcb_s *tcb,
   return ret;
 }
 
+/* Ready-to-run list manipulation.  These must be used instead of
+ * nxsched_add_prioritized() and dq_rem() for the ready-to-run list(s) so
+ * that the priority index stays consistent with the list.
+ */
+
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+static inline_function bool nxsched_add_rtrlist(FAR struct tcb_s *tcb,
+                                                DSEG dq_queue_t *list)
+{
+  FAR struct rtrindex_s *index = index_readytorun(list);
+  uint8_t sched_priority = tcb->sched_priority;
+  FAR struct tcb_s *prev;
+  FAR struct tcb_s *next;
+  unsigned long higher;
+
+  DEBUGASSERT(sched_priority >= SCHED_PRIORITY_MIN);
+
+  /* The new TCB goes after the last TCB of the same priority.  If there is
+   * none, it goes after the last TCB of the next higher priority present
+   * in the list, or at the head of the list.
+   */
+
+  prev = index->tail[sched_priority];
+  if (prev == NULL)
+    {
+      higher = find_next_bit(index->bitmap, SCHED_PRIORITY_MAX + 1,
+                             sched_priority + 1);
+      if (higher <= SCHED_PRIORITY_MAX)
+        {
+          prev = index->tail[higher];
+        }
+
+      set_bit(sched_priority, index->bitmap);
+    }
+
+  index->tail[sched_priority] = tcb;
+
+  if (prev == NULL)
+    {
+      /* Insert at the head of the list */
+
+      next        = (FAR struct tcb_s *)list->head;
+      tcb->blink  = NULL;
+      list->head  = (FAR dq_entry_t *)tcb;
+    }
+  else
+    {
+      /* Insert just after prev */
+
+      next        = prev->flink;
+      tcb->blink  = prev;
+      prev->flink = tcb;
+    }
+
+  tcb->flink = next;
+  if (next == NULL)
+    {
+      list->tail = (FAR dq_entry_t *)tcb;
+    }
+  else
+    {
+      next->blink = tcb;
+    }
+
+  return prev == NULL;
+}
+
+static inline_function void nxsched_remove_rtrlist(FAR struct tcb_s *tcb,
+                                                   DSEG dq_queue_t *list)
+{
+  FAR struct rtrindex_s *index = index_readytorun(list);
+  uint8_t sched_priority = tcb->sched_priority;
+  FAR struct tcb_s *prev = tcb->blink;
+
+  if (index->tail[sched_priority] == tcb)
+    {
+      if (prev != NULL && prev->sched_priority == sched_priority)
+        {
+          index->tail[sched_priority] = prev;
+        }
+      else
+        {
+          index->tail[sched_priority] = NULL;
+          clear_bit(sched_priority, index->bitmap);
+        }
+    }
+
+  dq_rem((FAR dq_entry_t *)tcb, list);
+}
+
+/* Change the priority of the TCB at the head of a ready-to-run list in
+ * place.  The caller must assure that the TCB remains the highest priority
+ * TCB of the list.
+ */
+
+static inline_function void
+nxsched_reprioritize_rtrhead(FAR struct tcb_s *tcb, DSEG dq_queue_t *list,
+                            int sched_priority)
+{
+  FAR struct rtrindex_s *index = index_readytorun(list);
+
+  DEBUGASSERT(tcb->blink == NULL);
+
+  if (index->tail[tcb->sched_priority] == tcb)
+    {
+      index->tail[tcb->sched_priority] = NULL;
+      clear_bit(tcb->sched_priority, index->bitmap);
+    }
+
+  tcb->sched_priority = (uint8_t)sched_priority;
+
+  if (index->tail[sched_priority] == NULL)
+    {
+      index->tail[sched_priority] = tcb;
+      set_bit(sched_priority, index->bitmap);
+    }
+}
+#else
+#  define nxsched_add_rtrlist(tcb, list) nxsched_add_prioritized(tcb, list)
+#  define nxsched_remove_rtrlist(tcb, list) \
+     dq_rem((FAR dq_entry_t *)(tcb), list)
+#  define nxsched_reprioritize_rtrhead(tcb, list, prio) \
+     ((tcb)->sched_priority = (uint8_t)(prio))
+#endif
+
 #  ifdef CONFIG_SMP
 
 /* Try to switch the head of the ready-to-run list to active on "target_cpu".
@@ -606,5 +794,37 @@ static inline_function int nxsched_select_cpu(cpu_set_t affinity)
 
   return cpu;
 }
+
+/* Return the highest priority task waiting in the ready-to-run list(s).
+ * With per-CPU lists, the heads of the lists of all CPUs are considered,
+ * so the task returned is only a hint and may not be eligible to run on
+ * "cpu".
+ */
+
+static inline_function FAR struct tcb_s *nxsched_peek_readytorun(int cpu)
+{
+#ifdef CONFIG_SCHED_PERCPU_READYTORUN
+  FAR struct tcb_s *btcb;
+  FAR struct tcb_s *tcb;
+  int i;
+
+  btcb = (FAR struct tcb_s *)dq_peek(list_cpureadytorun(cpu));
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      tcb = (FAR struct tcb_s *)dq_peek(list_cpureadytorun(i));
+      if (tcb != NULL &&
+          (btcb == NULL || tcb->sched_priority > btcb->sched_priority))
+        {
+          btcb = tcb;
+        }
+    }
+
+  return btcb;
+#else
+  UNUSED(cpu);
+  return (FAR struct tcb_s *)dq_peek(list_readytorun());
+#endif
+}
 #  endif
 #endif /* __SCHED_SCHED_SCHED_H */
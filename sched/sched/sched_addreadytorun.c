@@ -33,6 +33,102 @@
 #include "sched/queue.h"
 #include "sched/sched.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+/****************************************************************************
+ * Name:  nxsched_search_readytorun
+ *
+ * Description:
+ *   Search one ready-to-run list for the highest priority task that is
+ *   allowed to run on "cpu" and has a priority above "sched_priority".
+ *
+ * Input Parameters:
+ *   cpu            - The CPU that will run the task
+ *   list           - The ready-to-run list to search
+ *   sched_priority - Only tasks with a higher priority are considered
+ *
+ * Returned Value:
+ *   The TCB of the task found or NULL if there is no such task.
+ *
+ ****************************************************************************/
+
+static FAR struct tcb_s *nxsched_search_readytorun(int cpu,
+                                                   FAR dq_queue_t *list,
+                                                   int sched_priority)
+{
+  FAR struct tcb_s *btcb;
+
+  for (btcb = (FAR struct tcb_s *)dq_peek(list);
+       btcb && btcb->sched_priority > sched_priority;
+       btcb = btcb->flink)
+    {
+      /* Check if the task found in ready-to-run list is allowed to run on
+       * this CPU. TCB_FLAG_CPU_LOCKED may be used to override affinity. If
+       * the flag is set, assume that btcb->cpu is valid, and it is the only
+       * CPU on which the btcb can run.
+       */
+
+      if (CPU_ISSET(cpu, &btcb->affinity) &&
+          ((btcb->flags & TCB_FLAG_CPU_LOCKED) == 0 || btcb->cpu == cpu))
+        {
+          return btcb;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name:  nxsched_select_readytorun
+ *
+ * Description:
+ *   Select the per-CPU ready-to-run list that will hold a task.  The list
+ *   of the CPU that was selected to run the task is preferred.  If no CPU
+ *   can run the task now, the task stays on the CPU that it last ran on
+ *   when its affinity permits, otherwise it moves to the first CPU in its
+ *   affinity mask.
+ *
+ * Input Parameters:
+ *   btcb       - The TCB of the task that is being made ready-to-run
+ *   target_cpu - The CPU selected to run the task or CONFIG_SMP_NCPUS
+ *
+ * Returned Value:
+ *   The index of the CPU whose ready-to-run list should hold the task.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PERCPU_READYTORUN
+static int nxsched_select_readytorun(FAR struct tcb_s *btcb, int target_cpu)
+{
+  int cpu;
+
+  if (target_cpu < CONFIG_SMP_NCPUS)
+    {
+      return target_cpu;
+    }
+
+  if (CPU_ISSET(btcb->cpu, &btcb->affinity))
+    {
+      return btcb->cpu;
+    }
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      if (CPU_ISSET(cpu, &btcb->affinity))
+        {
+          break;
+        }
+    }
+
+  DEBUGASSERT(cpu < CONFIG_SMP_NCPUS);
+  return cpu;
+}
+#endif
+#endif /* CONFIG_SMP */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -91,7 +187,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 
   /* Otherwise, add the new task to the ready-to-run task list */
 
-  else if (nxsched_add_prioritized(btcb, list_readytorun()))
+  else if (nxsched_add_rtrlist(btcb, list_readytorun()))
     {
       /* The new btcb was added at the head of the ready-to-run list.  It
        * is now the new active task!
@@ -126,6 +222,11 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
  *   If the running task can't be swapped out, the btcb is pushed to
  *   the ready-to-run list.
  *
+ *   With CONFIG_SCHED_PERCPU_READYTORUN, only the ready-to-run list of this
+ *   CPU is searched, unless the CPU would otherwise run its idle task.  The
+ *   lists of the other CPUs are then searched for the highest priority
+ *   eligible task, which is migrated to this CPU (work stealing).
+ *
  * Input Parameters:
  *   cpu          - Always this_cpu(). Given as argument only for
  *                  optimization
@@ -149,7 +250,10 @@ bool nxsched_switch_running(int cpu, bool switch_equal)
   FAR struct tcb_s *rtcb = current_task(cpu);
   int sched_priority = rtcb->sched_priority;
   FAR struct tcb_s *btcb;
-  bool ret = false;
+#ifdef CONFIG_SCHED_PERCPU_READYTORUN
+  FAR struct tcb_s *tcb;
+  int i;
+#endif
 
   DEBUGASSERT(cpu == this_cpu());
 
@@ -168,46 +272,60 @@ bool nxsched_switch_running(int cpu, bool switch_equal)
    * switch the current task to that one.
    */
 
-  for (btcb = (FAR struct tcb_s *)dq_peek(list_readytorun());
-       btcb && btcb->sched_priority > sched_priority;
-       btcb = btcb->flink)
-    {
-      /* Check if the task found in ready-to-run list is allowed to run on
-       * this CPU. TCB_FLAG_CPU_LOCKED may be used to override affinity. If
-       * the flag is set, assume that btcb->cpu is valid, and it is the only
-       * CPU on which the btcb can run.
-       */
+  btcb = nxsched_search_readytorun(cpu, list_cpureadytorun(cpu),
+                                   sched_priority);
 
-      if (CPU_ISSET(cpu, &btcb->affinity) &&
-          ((btcb->flags & TCB_FLAG_CPU_LOCKED) == 0 || btcb->cpu == cpu))
-        {
-          /* Found a task, remove it from ready-to-run list */
-
-          dq_rem((FAR struct dq_entry_s *)btcb, list_readytorun());
+#ifdef CONFIG_SCHED_PERCPU_READYTORUN
+  /* A task is queued on the CPU selected to run it, so the other CPUs are
+   * only searched when this one would go idle rather than on every
+   * reschedule.
+   */
 
-          if (!is_idle_task(rtcb))
-            {
-              /* Put currently running task back to ready-to-run list */
+  if (btcb == NULL && is_idle_task(rtcb))
+    {
+      for (i = 1; i < CONFIG_SMP_NCPUS; i++)
+        {
+          int other = (cpu + i) % CONFIG_SMP_NCPUS;
 
-              rtcb->task_state = TSTATE_TASK_READYTORUN;
-              nxsched_add_prioritized(rtcb, list_readytorun());
-            }
-          else
+          tcb = nxsched_search_readytorun(cpu, list_cpureadytorun(other),
+                                          btcb != NULL ?
+                                          btcb->sched_priority :
+                                          sched_priority);
+          if (tcb != NULL)
             {
-              rtcb->task_state = TSTATE_TASK_ASSIGNED;
+              btcb = tcb;
             }
+        }
+    }
+#endif
 
-          g_assignedtasks[cpu] = btcb;
-          up_update_task(btcb);
+  if (btcb == NULL)
+    {
+      return false;
+    }
 
-          btcb->cpu = cpu;
-          btcb->task_state = TSTATE_TASK_RUNNING;
-          ret = true;
-          break;
-        }
+  /* Found a task, remove it from ready-to-run list */
+
+  nxsched_remove_rtrlist(btcb, list_cpureadytorun(btcb->cpu));
+
+  if (!is_idle_task(rtcb))
+    {
+      /* Put currently running task back to ready-to-run list */
+
+      rtcb->task_state = TSTATE_TASK_READYTORUN;
+      nxsched_add_rtrlist(rtcb, list_cpureadytorun(cpu));
+    }
+  else
+    {
+      rtcb->task_state = TSTATE_TASK_ASSIGNED;
     }
 
-  return ret;
+  g_assignedtasks[cpu] = btcb;
+  up_update_task(btcb);
+
+  btcb->cpu = cpu;
+  btcb->task_state = TSTATE_TASK_RUNNING;
+  return true;
 }
 
 /****************************************************************************
@@ -218,7 +336,8 @@ bool nxsched_switch_running(int cpu, bool switch_equal)
  *   will be:
  *
  *   1. The g_readytorun list if the task is ready-to-run but not running
- *      and not assigned to a CPU.
+ *      and not assigned to a CPU.  With CONFIG_SCHED_PERCPU_READYTORUN
+ *      this is the g_cpureadytorun list of the CPU selected for the task.
  *   2. The g_assignedtask[cpu] list if the task is running or if has been
  *      assigned to a CPU.
  *
@@ -256,7 +375,10 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
    */
 
   btcb->task_state = TSTATE_TASK_READYTORUN;
-  nxsched_add_prioritized(btcb, list_readytorun());
+#ifdef CONFIG_SCHED_PERCPU_READYTORUN
+  btcb->cpu = nxsched_select_readytorun(btcb, target_cpu);
+#endif
+  nxsched_add_rtrlist(btcb, list_cpureadytorun(btcb->cpu));
 
   if (target_cpu < CONFIG_SMP_NCPUS)
     {
@@ -0,0 +1,138 @@
+/****************************************************************************
+ * sched/sched/sched_objcache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <string.h>
+
+#include <nuttx/mm/objcache.h>
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_MM_OBJCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The TCB of a pthread is followed by its startup information */
+
+#ifndef CONFIG_DISABLE_PTHREAD
+#  define TCB_CACHE_OBJSIZE \
+     (sizeof(struct tcb_s) + sizeof(struct pthread_entry_s))
+#else
+#  define TCB_CACHE_OBJSIZE sizeof(struct tcb_s)
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct objcache_s *g_tcb_cache;
+static FAR struct objcache_s *g_group_cache;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* The objects are handed out zeroed, the same as with kmm_zalloc() */
+
+static void nxsched_objcache_ctor(FAR void *obj, size_t size)
+{
+  memset(obj, 0, size);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_objcache_initialize
+ *
+ * Description:
+ *   Create the object caches of the TCBs and of the task groups.  Called
+ *   once by nx_start() when the kernel heap is available.
+ *
+ ****************************************************************************/
+
+void nxsched_objcache_initialize(void)
+{
+  g_tcb_cache = objcache_create("tcb", TCB_CACHE_OBJSIZE, 0,
+                                CONFIG_MM_OBJCACHE_NEXPAND,
+                                nxsched_objcache_ctor);
+  DEBUGASSERT(g_tcb_cache != NULL);
+
+  g_group_cache = objcache_create("group", sizeof(struct task_group_s), 0,
+                                  CONFIG_MM_OBJCACHE_NEXPAND,
+                                  nxsched_objcache_ctor);
+  DEBUGASSERT(g_group_cache != NULL);
+}
+
+/****************************************************************************
+ * Name: nxsched_alloc_tcb
+ *
+ * Description:
+ *   Allocate a zeroed TCB of size bytes, either a plain TCB or a TCB
+ *   followed by the pthread startup information.
+ *
+ ****************************************************************************/
+
+FAR void *nxsched_alloc_tcb(size_t size)
+{
+  DEBUGASSERT(size <= TCB_CACHE_OBJSIZE);
+  return objcache_alloc(g_tcb_cache);
+}
+
+/****************************************************************************
+ * Name: nxsched_free_tcb
+ ****************************************************************************/
+
+void nxsched_free_tcb(FAR struct tcb_s *tcb)
+{
+  objcache_free(g_tcb_cache, tcb);
+}
+
+/****************************************************************************
+ * Name: nxsched_alloc_group
+ ****************************************************************************/
+
+FAR struct task_group_s *nxsched_alloc_group(void)
+{
+  return objcache_alloc(g_group_cache);
+}
+
+/****************************************************************************
+ * Name: nxsched_free_group
+ ****************************************************************************/
+
+void nxsched_free_group(FAR struct task_group_s *group)
+{
+  objcache_free(g_group_cache, group);
+}
+
+#endif /* CONFIG_MM_OBJCACHE */
@@ -93,7 +93,14 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
-  dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+  if (tasklist == list_readytorun())
+    {
+      nxsched_remove_rtrlist(rtcb, tasklist);
+    }
+  else
+    {
+      dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+    }
 
   /* Since the TCB is not in any list, it is now invalid */
 
@@ -185,7 +192,14 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *tcb)
 
       /* The task is not running.  Just remove its TCB from the task list */
 
-      dq_rem((FAR dq_entry_t *)tcb, tasklist);
+      if (tcb->task_state == TSTATE_TASK_READYTORUN)
+        {
+          nxsched_remove_rtrlist(tcb, tasklist);
+        }
+      else
+        {
+          dq_rem((FAR dq_entry_t *)tcb, tasklist);
+        }
 
       /* Since the TCB is no longer in any list, it is now invalid */
 
@@ -71,7 +71,7 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
   /* Get the TCB of the next highest priority, ready to run task */
 
 #ifdef CONFIG_SMP
-  nxttcb = (FAR struct tcb_s *)dq_peek(list_readytorun());
+  nxttcb = nxsched_peek_readytorun(tcb->cpu);
 #else
   nxttcb = tcb->flink;
 #endif
@@ -113,7 +113,8 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
 
           /* Change the task priority */
 
-          tcb->sched_priority = (uint8_t)sched_priority;
+          nxsched_reprioritize_rtrhead(tcb, list_readytorun(),
+                                       sched_priority);
         }
       else
         {
@@ -133,7 +134,11 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
     {
       /* Change the task priority */
 
+#ifdef CONFIG_SMP
       tcb->sched_priority = (uint8_t)sched_priority;
+#else
+      nxsched_reprioritize_rtrhead(tcb, list_readytorun(), sched_priority);
+#endif
     }
 }
 
@@ -162,7 +167,7 @@ static void nxsched_readytorun_setpriority(FAR struct tcb_s *tcb,
   rtcb = this_task();
 
 #ifdef CONFIG_SMP
-  dq_rem((FAR struct dq_entry_s *)tcb, list_readytorun());
+  nxsched_remove_rtrlist(tcb, list_cpureadytorun(tcb->cpu));
   tcb->sched_priority = sched_priority;
   if (nxsched_add_readytorun(tcb))
 #else
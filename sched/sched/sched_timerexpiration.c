@@ -41,6 +41,10 @@
 #include "wdog/wdog.h"
 #include "clock/clock.h"
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+#  include "hrtimer/hrtimer.h"
+#endif
+
 #ifdef CONFIG_CLOCK_TIMEKEEPING
 #  include "clock/clock_timekeeping.h"
 #endif
@@ -380,6 +384,10 @@ static clock_t nxsched_timer_start(clock_t ticks, clock_t interval)
  *   the RTOS base code and called from platform-specific code when the
  *   interval timer used to implement the tick-less OS expires.
  *
+ *   If CONFIG_SCHED_TICKLESS_HRTIMER is selected, the timer hardware is
+ *   owned by the hrtimer subsystem and the watchdog queue is processed
+ *   as part of the hrtimer expiry batch.
+ *
  * Input Parameters:
  *
  * Returned Value:
@@ -388,6 +396,12 @@ static clock_t nxsched_timer_start(clock_t ticks, clock_t interval)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+void nxsched_process_timer(void)
+{
+  hrtimer_process(hrtimer_gettime());
+}
+#else
 void nxsched_process_timer(void)
 {
   irqstate_t flags;
@@ -401,6 +415,7 @@ void nxsched_process_timer(void)
 
   leave_critical_section(flags);
 }
+#endif
 
 /****************************************************************************
  * Name:  nxsched_reassess_timer
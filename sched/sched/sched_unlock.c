@@ -90,7 +90,7 @@ void sched_unlock(void)
            */
 
 #ifdef CONFIG_SMP
-          ptcb = (FAR struct tcb_s *)dq_peek(list_readytorun());
+          ptcb = nxsched_peek_readytorun(rtcb->cpu);
           if (ptcb && ptcb->sched_priority > rtcb->sched_priority &&
               nxsched_deliver_task(rtcb->cpu, rtcb->cpu, SWITCH_HIGHER))
 #else
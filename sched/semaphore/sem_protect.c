@@ -76,7 +76,11 @@ int nxsem_protect_wait(FAR sem_t *sem)
         }
 
       sem->saved = rtcb->sched_priority;
+#ifdef CONFIG_SMP
       rtcb->sched_priority = sem->ceiling;
+#else
+      nxsched_reprioritize_rtrhead(rtcb, list_readytorun(), sem->ceiling);
+#endif
     }
 
   return OK;
@@ -32,11 +32,16 @@
  * Private Functions
  ****************************************************************************/
 
-static inline void up_wait(FAR rw_semaphore_t *rwsem)
+/* The waiters are woken up once the counts are unlocked: the counts are
+ * protected by a spinlock so that a read lock costs no more than the
+ * accounting, and no semaphore is posted with it held.
+ */
+
+static inline void up_wait(FAR rw_semaphore_t *rwsem, int waiter)
 {
   int i;
 
-  for (i = 0; i < rwsem->waiter; i++)
+  for (i = 0; i < waiter; i++)
     {
       /* If there are some waiter for unlock, then post the lock wait queue.
        */
@@ -65,7 +70,9 @@ static inline void up_wait(FAR rw_semaphore_t *rwsem)
 
 int down_read_trylock(FAR rw_semaphore_t *rwsem)
 {
-  nxmutex_lock(&rwsem->protected);
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&rwsem->protected);
 
   /* if the write lock is already held by oneself and since the write lock
    * can be recursively held, so, this operation can be converted to a write
@@ -80,7 +87,7 @@ int down_read_trylock(FAR rw_semaphore_t *rwsem)
 
   if (rwsem->writer > 0)
     {
-      nxmutex_unlock(&rwsem->protected);
+      spin_unlock_irqrestore(&rwsem->protected, flags);
       return 0;
     }
 
@@ -91,7 +98,7 @@ int down_read_trylock(FAR rw_semaphore_t *rwsem)
   rwsem->reader++;
 
 out:
-  nxmutex_unlock(&rwsem->protected);
+  spin_unlock_irqrestore(&rwsem->protected, flags);
 
   return 1;
 }
@@ -109,11 +116,13 @@ out:
 
 void down_read(FAR rw_semaphore_t *rwsem)
 {
+  irqstate_t flags;
+
   /* we have to check if there is a write-lock scenario, if there is then we
    * block and wait for the write-lock to be unlocked.
    */
 
-  nxmutex_lock(&rwsem->protected);
+  flags = spin_lock_irqsave(&rwsem->protected);
 
   /* if the write lock is already held by oneself and since the write lock
    * can be recursively held, so, this operation can be converted to a write
@@ -129,9 +138,9 @@ void down_read(FAR rw_semaphore_t *rwsem)
   while (rwsem->writer > 0)
     {
       rwsem->waiter++;
-      nxmutex_unlock(&rwsem->protected);
+      spin_unlock_irqrestore(&rwsem->protected, flags);
       nxsem_wait(&rwsem->waiting);
-      nxmutex_lock(&rwsem->protected);
+      flags = spin_lock_irqsave(&rwsem->protected);
       rwsem->waiter--;
     }
 
@@ -142,7 +151,7 @@ void down_read(FAR rw_semaphore_t *rwsem)
   rwsem->reader++;
 
 out:
-  nxmutex_unlock(&rwsem->protected);
+  spin_unlock_irqrestore(&rwsem->protected, flags);
 }
 
 /****************************************************************************
@@ -158,7 +167,10 @@ out:
 
 void up_read(FAR rw_semaphore_t *rwsem)
 {
-  nxmutex_lock(&rwsem->protected);
+  irqstate_t flags;
+  int waiter = 0;
+
+  flags = spin_lock_irqsave(&rwsem->protected);
 
   /* when releasing a read lock and holder is oneself, the read lock is a
    * write lock that has been converted, so it should be released according
@@ -178,14 +190,11 @@ void up_read(FAR rw_semaphore_t *rwsem)
   DEBUGASSERT(rwsem->reader > 0);
 
   rwsem->reader--;
-
-  if (rwsem->waiter > 0)
-    {
-      up_wait(rwsem);
-    }
+  waiter = rwsem->waiter;
 
 out:
-  nxmutex_unlock(&rwsem->protected);
+  spin_unlock_irqrestore(&rwsem->protected, flags);
+  up_wait(rwsem, waiter);
 }
 
 /****************************************************************************
@@ -205,12 +214,13 @@ out:
 int down_write_trylock(FAR rw_semaphore_t *rwsem)
 {
   pid_t tid = _SCHED_GETTID();
+  irqstate_t flags;
 
-  nxmutex_lock(&rwsem->protected);
+  flags = spin_lock_irqsave(&rwsem->protected);
 
   if (rwsem->reader > 0 || (rwsem->writer > 0 && tid != rwsem->holder))
     {
-      nxmutex_unlock(&rwsem->protected);
+      spin_unlock_irqrestore(&rwsem->protected, flags);
       return 0;
     }
 
@@ -219,7 +229,7 @@ int down_write_trylock(FAR rw_semaphore_t *rwsem)
   rwsem->writer++;
   rwsem->holder = tid;
 
-  nxmutex_unlock(&rwsem->protected);
+  spin_unlock_irqrestore(&rwsem->protected, flags);
 
   return 1;
 }
@@ -238,15 +248,16 @@ int down_write_trylock(FAR rw_semaphore_t *rwsem)
 void down_write(FAR rw_semaphore_t *rwsem)
 {
   pid_t tid = _SCHED_GETTID();
+  irqstate_t flags;
 
-  nxmutex_lock(&rwsem->protected);
+  flags = spin_lock_irqsave(&rwsem->protected);
 
   while (rwsem->reader > 0 || (rwsem->writer > 0 && rwsem->holder != tid))
     {
       rwsem->waiter++;
-      nxmutex_unlock(&rwsem->protected);
+      spin_unlock_irqrestore(&rwsem->protected, flags);
       nxsem_wait(&rwsem->waiting);
-      nxmutex_lock(&rwsem->protected);
+      flags = spin_lock_irqsave(&rwsem->protected);
       rwsem->waiter--;
     }
 
@@ -255,7 +266,7 @@ void down_write(FAR rw_semaphore_t *rwsem)
   rwsem->writer++;
   rwsem->holder = tid;
 
-  nxmutex_unlock(&rwsem->protected);
+  spin_unlock_irqrestore(&rwsem->protected, flags);
 }
 
 /****************************************************************************
@@ -271,7 +282,10 @@ void down_write(FAR rw_semaphore_t *rwsem)
 
 void up_write(FAR rw_semaphore_t *rwsem)
 {
-  nxmutex_lock(&rwsem->protected);
+  irqstate_t flags;
+  int waiter;
+
+  flags = spin_lock_irqsave(&rwsem->protected);
 
   DEBUGASSERT(rwsem->writer > 0);
   DEBUGASSERT(rwsem->holder == _SCHED_GETTID());
@@ -281,9 +295,9 @@ void up_write(FAR rw_semaphore_t *rwsem)
       rwsem->holder = RWSEM_NO_HOLDER;
     }
 
-  up_wait(rwsem);
-
-  nxmutex_unlock(&rwsem->protected);
+  waiter = rwsem->waiter;
+  spin_unlock_irqrestore(&rwsem->protected, flags);
+  up_wait(rwsem, waiter);
 }
 
 /****************************************************************************
@@ -299,7 +313,10 @@ void up_write(FAR rw_semaphore_t *rwsem)
 
 void downgrade_write(FAR rw_semaphore_t *rwsem)
 {
-  nxmutex_lock(&rwsem->protected);
+  irqstate_t flags;
+  int waiter;
+
+  flags = spin_lock_irqsave(&rwsem->protected);
 
   DEBUGASSERT(rwsem->writer == 1);
   DEBUGASSERT(rwsem->reader == 0);
@@ -309,8 +326,9 @@ void downgrade_write(FAR rw_semaphore_t *rwsem)
   rwsem->reader++;
   rwsem->holder = RWSEM_NO_HOLDER;
 
-  up_wait(rwsem);
-  nxmutex_unlock(&rwsem->protected);
+  waiter = rwsem->waiter;
+  spin_unlock_irqrestore(&rwsem->protected, flags);
+  up_wait(rwsem, waiter);
 }
 
 /****************************************************************************
@@ -334,16 +352,11 @@ int init_rwsem(FAR rw_semaphore_t *rwsem)
 
   /* Initialize structure information */
 
-  ret = nxmutex_init(&rwsem->protected);
-  if (ret < 0)
-    {
-      return ret;
-    }
+  spin_lock_init(&rwsem->protected);
 
   ret = nxsem_init(&rwsem->waiting, 0, 0);
   if (ret < 0)
     {
-      nxmutex_destroy(&rwsem->protected);
       return ret;
     }
 
@@ -374,6 +387,5 @@ void destroy_rwsem(FAR rw_semaphore_t *rwsem)
   DEBUGASSERT(rwsem->waiter == 0 && rwsem->reader == 0 &&
               rwsem->writer == 0 && rwsem->holder == RWSEM_NO_HOLDER);
 
-  nxmutex_destroy(&rwsem->protected);
   nxsem_destroy(&rwsem->waiting);
 }
@@ -37,6 +37,7 @@
 #include <errno.h>
 
 #include <nuttx/irq.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
 #include <nuttx/signal.h>
@@ -47,6 +48,10 @@
 #include "signal/signal.h"
 #include "clock/clock.h"
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+#  include "hrtimer/hrtimer.h"
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -91,6 +96,29 @@ static void nxsig_timeout(wdparm_t arg)
   leave_critical_section(flags);
 }
 
+/****************************************************************************
+ * Name: nxsig_hrtimeout
+ *
+ * Description:
+ *   The sub-tick sleep armed on the per-thread hrtimer has elapsed.
+ *
+ * Assumptions:
+ *   This function executes in the context of the hrtimer expiry batch.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+static uint64_t nxsig_hrtimeout(FAR const hrtimer_t *hrtimer,
+                                uint64_t expired)
+{
+  FAR struct tcb_s *wtcb = container_of(hrtimer, struct tcb_s,
+                                        waithrtimer);
+
+  nxsig_timeout((wdparm_t)(uintptr_t)wtcb);
+  return 0;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -188,6 +216,10 @@ int nxsig_clockwait(int clockid, int flags,
   irqstate_t        iflags;
   clock_t expect = 0;
   clock_t stop;
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  uint64_t hrexpect = 0;
+  uint64_t hrstop = 0;
+#endif
 
   if (rqtp && (rqtp->tv_nsec < 0 || rqtp->tv_nsec >= 1000000000))
     {
@@ -233,6 +265,24 @@ int nxsig_clockwait(int clockid, int flags,
 
   if (rqtp)
     {
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+      /* Relative sleeps and the deadlines of the clocks the hrtimer counts
+       * are armed on the per-thread hrtimer and get sub-tick resolution.
+       * The other deadlines, such as CLOCK_REALTIME ones which may be
+       * stepped, still go through the watchdog.
+       */
+
+      if ((flags & TIMER_ABSTIME) == 0 || clockid == CLOCK_MONOTONIC ||
+          clockid == CLOCK_BOOTTIME)
+        {
+          hrexpect = clock_time2nsec(rqtp);
+          if ((flags & TIMER_ABSTIME) == 0)
+            {
+              hrexpect += hrtimer_gettime();
+            }
+        }
+
+#endif
       /* Start the watchdog timer */
 
       if ((flags & TIMER_ABSTIME) == 0)
@@ -255,8 +305,18 @@ int nxsig_clockwait(int clockid, int flags,
           expect = clock_time2ticks(rqtp);
         }
 
-        wd_start_abstick(&rtcb->waitdog, expect,
-                         nxsig_timeout, (uintptr_t)rtcb);
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+      if (hrexpect)
+        {
+          hrtimer_start(&rtcb->waithrtimer, nxsig_hrtimeout, hrexpect,
+                        HRTIMER_MODE_ABS);
+        }
+      else
+#endif
+        {
+          wd_start_abstick(&rtcb->waitdog, expect,
+                           nxsig_timeout, (uintptr_t)rtcb);
+        }
     }
 
   /* Remove the tcb task from the ready-to-run list. */
@@ -279,8 +339,25 @@ int nxsig_clockwait(int clockid, int flags,
       stop = clock_systime_ticks();
     }
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  if (hrexpect)
+    {
+      /* The hrtimer is still armed if a signal woke us up */
+
+      hrtimer_cancel(&rtcb->waithrtimer);
+      hrstop = hrtimer_gettime();
+    }
+#endif
+
   leave_critical_section(iflags);
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  if (rmtp && hrexpect)
+    {
+      clock_nsec2time(rmtp, hrexpect > hrstop ? hrexpect - hrstop : 0);
+    }
+  else
+#endif
   if (rqtp && rmtp && expect)
     {
       clock_ticks2time(rmtp,
@@ -73,6 +73,9 @@ void nxtask_recover(FAR struct tcb_s *tcb)
   /* The task is being deleted.  Cancel in pending timeout events. */
 
   wd_cancel(&tcb->waitdog);
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+  hrtimer_cancel(&tcb->waithrtimer);
+#endif
 
   /* If the thread holds semaphore counts or is waiting for a semaphore
    *  count, then release the counts.
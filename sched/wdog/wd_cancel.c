@@ -76,11 +76,11 @@ int wd_cancel(FAR struct wdog_s *wdog)
 
       if (WDOG_ISACTIVE(wdog))
         {
-          first = list_first_entry(&g_wdactivelist, struct wdog_s, node);
+          first = wd_first();
 
           /* Now, remove the watchdog from the timer queue */
 
-          list_delete_fast(&wdog->node);
+          wd_remove(wdog);
 
           /* Mark the watchdog inactive */
 
@@ -93,7 +93,7 @@ int wd_cancel(FAR struct wdog_s *wdog)
                * generate the next interval event.
                */
 
-              if (!list_is_empty(&g_wdactivelist))
+              if (!wd_is_empty())
                 {
                   wd_timer_start(wd_next_expire());
                 }
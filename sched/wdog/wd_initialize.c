@@ -34,17 +34,46 @@
  * Public Data
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_WDOG_RBTREE
+/* The g_wdactivetree holds the active watchdogs sorted by expiration time,
+ * g_wdfirst caches the earliest expiring one.
+ */
+
+struct wdog_tree_s g_wdactivetree = RB_INITIALIZER(g_wdactivetree);
+FAR struct wdog_s *g_wdfirst;
+#else
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 struct list_node g_wdactivelist = LIST_INITIAL_VALUE(g_wdactivelist);
+#endif
 
 #ifdef CONFIG_SCHED_TICKLESS
 bool g_wdtimernested;
 #endif
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+/* The hrtimer that drives the watchdog queue */
+
+hrtimer_t g_wdhrtimer;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WDOG_RBTREE
+/****************************************************************************
+ * Name: RB_GENERATE
+ *
+ * Description:
+ *   Instantiate the red-black tree helper functions for the active
+ *   watchdog tree.  All accesses to the tree must be done inside a
+ *   critical section.
+ *
+ ****************************************************************************/
+
+RB_GENERATE(wdog_tree_s, wdog_s, entry, wd_compare);
+#endif
@@ -120,9 +120,9 @@ static inline_function void wd_expiration(clock_t ticks)
    * other watchdogs that became ready to run at this time
    */
 
-  while (!list_is_empty(&g_wdactivelist))
+  while (!wd_is_empty())
     {
-      wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
+      wdog = wd_first();
 
       /* Check if watchdog has expired;
        * re-evaluate after updating current ticks if needed
@@ -136,7 +136,7 @@ static inline_function void wd_expiration(clock_t ticks)
 
       /* Remove the watchdog from the head of the list */
 
-      list_delete_fast(&wdog->node);
+      wd_remove(wdog);
 
       /* Indicate that the watchdog is no longer active. */
 
@@ -164,7 +164,7 @@ static inline_function void wd_expiration(clock_t ticks)
  * Name: wd_insert
  *
  * Description:
- *   Insert the timer into the global list to ensure that
+ *   Insert the timer into the global list (or tree) to ensure that
  *   the list is sorted in increasing order of expiration absolute time.
  *
  * Input Parameters:
@@ -185,6 +185,26 @@ static inline_function
 bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
                wdentry_t wdentry, wdparm_t arg)
 {
+#ifdef CONFIG_SCHED_WDOG_RBTREE
+  wdog->func = wdentry;
+  up_getpicbase(&wdog->picbase);
+  wdog->arg = arg;
+  wdog->expired = expired;
+
+  RB_INSERT(wdog_tree_s, &g_wdactivetree, wdog);
+
+  /* Update the cached earliest watchdog.  The new watchdog becomes the
+   * head only if it expires strictly before the current head.
+   */
+
+  if (g_wdfirst == NULL || wd_compare(wdog, g_wdfirst) < 0)
+    {
+      g_wdfirst = wdog;
+      return true;
+    }
+
+  return false;
+#else
   FAR struct wdog_s *curr;
   FAR struct wdog_s *head;
 
@@ -219,6 +239,7 @@ bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
   /* Return whether the head of the watchdog list has changed. */
 
   return head == curr;
+#endif
 }
 
 /****************************************************************************
@@ -288,8 +309,8 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 
       if (WDOG_ISACTIVE(wdog))
         {
-          reassess |= list_is_head(&g_wdactivelist, &wdog->node);
-          list_delete_fast(&wdog->node);
+          reassess |= wd_is_head(wdog);
+          wd_remove(wdog);
         }
 
       reassess |= wd_insert(wdog, ticks, wdentry, arg);
@@ -311,7 +332,7 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 
       if (WDOG_ISACTIVE(wdog))
         {
-          list_delete_fast(&wdog->node);
+          wd_remove(wdog);
         }
 
       wd_insert(wdog, ticks, wdentry, arg);
@@ -356,3 +377,31 @@ void wd_timer(clock_t ticks)
 
   wd_expiration(ticks);
 }
+
+/****************************************************************************
+ * Name: wd_hrtimer_expire
+ *
+ * Description:
+ *   The callback of g_wdhrtimer.  It runs the expired watchdogs from the
+ *   hrtimer expiry batch.  wd_expiration() re-arms g_wdhrtimer for the
+ *   next watchdog; the hardware is reprogrammed once by hrtimer_process()
+ *   when the whole batch has been handled.
+ *
+ * Input Parameters:
+ *   hrtimer - The watchdog hrtimer (g_wdhrtimer)
+ *   expired - The expiration time of the hrtimer (nsec)
+ *
+ * Returned Value:
+ *   Zero, g_wdhrtimer is never re-armed periodically.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+uint64_t wd_hrtimer_expire(FAR const hrtimer_t *hrtimer, uint64_t expired)
+{
+  /* g_wdhrtimer is always armed at the exact nsec time of a tick */
+
+  wd_expiration((clock_t)(expired / NSEC_PER_TICK));
+  return 0;
+}
+#endif
@@ -38,6 +38,26 @@
 #include <nuttx/wdog.h>
 #include <nuttx/arch.h>
 
+#ifdef CONFIG_SCHED_WDOG_RBTREE
+#  include <sys/tree.h>
+#endif
+
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+#  include <nuttx/hrtimer.h>
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WDOG_RBTREE
+/* Red-black tree head for the active watchdog timers.  The earliest
+ * expiring watchdog is the left-most node of the tree.
+ */
+
+RB_HEAD(wdog_tree_s, wdog_s);
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -54,17 +74,35 @@ extern "C"
 #define EXTERN extern
 #endif
 
+#ifdef CONFIG_SCHED_WDOG_RBTREE
+/* The g_wdactivetree holds the active watchdogs sorted by expiration time.
+ * g_wdfirst caches the left-most (earliest expiring) watchdog, or NULL if
+ * the tree is empty.
+ */
+
+extern struct wdog_tree_s g_wdactivetree;
+extern FAR struct wdog_s *g_wdfirst;
+#else
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 extern struct list_node g_wdactivelist;
+#endif
 
 #ifdef CONFIG_SCHED_TICKLESS
 extern bool g_wdtimernested;
 #endif
 
+#ifdef CONFIG_SCHED_TICKLESS_HRTIMER
+/* The hrtimer that drives the watchdog queue.  It is always armed at the
+ * expiration time of the earliest watchdog.
+ */
+
+extern hrtimer_t g_wdhrtimer;
+#endif
+
 /****************************************************************************
  * Inline functions
  ****************************************************************************/
@@ -77,7 +115,19 @@ extern bool g_wdtimernested;
 #  define wd_set_nested(f)
 #endif
 
-#ifdef CONFIG_SCHED_TICKLESS
+#if defined(CONFIG_SCHED_TICKLESS_HRTIMER)
+uint64_t wd_hrtimer_expire(FAR const hrtimer_t *hrtimer, uint64_t expired);
+
+static inline_function void wd_timer_start(clock_t next_tick)
+{
+  hrtimer_start(&g_wdhrtimer, wd_hrtimer_expire,
+                TICK2NSEC((uint64_t)next_tick), HRTIMER_MODE_ABS);
+}
+static inline_function void wd_timer_cancel(void)
+{
+  hrtimer_cancel(&g_wdhrtimer);
+}
+#elif defined(CONFIG_SCHED_TICKLESS)
 static inline_function void wd_timer_start(clock_t next_tick)
 {
 #ifdef CONFIG_SCHED_TICKLESS_ALARM
@@ -115,9 +165,44 @@ static inline_function void wd_timer_cancel(void)
 #  define wd_timer_cancel()
 #endif
 
+#ifdef CONFIG_SCHED_WDOG_RBTREE
+/* Order watchdogs by expiration time.  A watchdog never compares equal to
+ * another one, a newer watchdog is placed after the older watchdogs with
+ * the same expiration time.
+ */
+
+static inline_function int wd_compare(FAR const struct wdog_s *a,
+                                      FAR const struct wdog_s *b)
+{
+  return clock_compare(b->expired, a->expired) ? 1 : -1;
+}
+
+RB_PROTOTYPE(wdog_tree_s, wdog_s, entry, wd_compare);
+
+#  define wd_is_empty()    (g_wdfirst == NULL)
+#  define wd_first()       (g_wdfirst)
+#  define wd_is_head(wdog) (g_wdfirst == (wdog))
+
+static inline_function void wd_remove(FAR struct wdog_s *wdog)
+{
+  if (g_wdfirst == wdog)
+    {
+      g_wdfirst = RB_NEXT(wdog_tree_s, &g_wdactivetree, wdog);
+    }
+
+  RB_REMOVE(wdog_tree_s, &g_wdactivetree, wdog);
+}
+#else
+#  define wd_is_empty()    list_is_empty(&g_wdactivelist)
+#  define wd_first() \
+     list_first_entry(&g_wdactivelist, struct wdog_s, node)
+#  define wd_is_head(wdog) list_is_head(&g_wdactivelist, &(wdog)->node)
+#  define wd_remove(wdog)  list_delete_fast(&(wdog)->node)
+#endif
+
 static inline_function clock_t wd_next_expire(void)
 {
-  return list_first_entry(&g_wdactivelist, struct wdog_s, node)->expired;
+  return wd_first()->expired;
 }
 
 /****************************************************************************